@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/main/test/audio_latency_test.cpp" "CMakeFiles/audio_latency_test.dir/audio_latency_test.cpp.o" "gcc" "CMakeFiles/audio_latency_test.dir/audio_latency_test.cpp.o.d"
+  "/root/repo/main/test/host/freertos_host.cpp" "CMakeFiles/audio_latency_test.dir/host/freertos_host.cpp.o" "gcc" "CMakeFiles/audio_latency_test.dir/host/freertos_host.cpp.o.d"
+  "/root/repo/main/audio_source.cpp" "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_source.cpp.o" "gcc" "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_source.cpp.o.d"
+  "/root/repo/main/audio_streamer.cpp" "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_streamer.cpp.o" "gcc" "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_streamer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_main/CMakeFiles/datachannel_host.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_main/libsrtp/CMakeFiles/srtp2.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_main/CMakeFiles/juice_host.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_main/CMakeFiles/usrsctp_host.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
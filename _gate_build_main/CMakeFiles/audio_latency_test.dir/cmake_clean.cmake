@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/audio_latency_test.dir/audio_latency_test.cpp.o"
+  "CMakeFiles/audio_latency_test.dir/audio_latency_test.cpp.o.d"
+  "CMakeFiles/audio_latency_test.dir/host/freertos_host.cpp.o"
+  "CMakeFiles/audio_latency_test.dir/host/freertos_host.cpp.o.d"
+  "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_source.cpp.o"
+  "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_source.cpp.o.d"
+  "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_streamer.cpp.o"
+  "CMakeFiles/audio_latency_test.dir/root/repo/main/audio_streamer.cpp.o.d"
+  "audio_latency_test"
+  "audio_latency_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/audio_latency_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
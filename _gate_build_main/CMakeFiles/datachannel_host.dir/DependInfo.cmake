@@ -0,0 +1,78 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/components/libdatachannel/src/av1rtppacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/av1rtppacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/av1rtppacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/candidate.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/candidate.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/candidate.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/channel.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/channel.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/channel.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/configuration.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/configuration.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/configuration.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/datachannel.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/datachannel.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/datachannel.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/dependencydescriptor.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/dependencydescriptor.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/dependencydescriptor.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/description.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/description.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/description.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/framearena.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/framearena.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/framearena.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/global.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/global.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/global.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/h264rtpdepacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtpdepacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtpdepacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/h264rtppacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtppacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtppacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/h265nalunit.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265nalunit.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265nalunit.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/h265rtpdepacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtpdepacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtpdepacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/h265rtppacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtppacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtppacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/heapprofiler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/heapprofiler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/heapprofiler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/certificate.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/certificate.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/certificate.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/channel.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/channel.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/channel.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/datachannel.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/datachannel.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/datachannel.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/dtlssrtptransport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlssrtptransport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlssrtptransport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/dtlstransport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlstransport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlstransport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/epoch.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/epoch.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/epoch.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/heapprofiler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/heapprofiler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/heapprofiler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/icetransport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/icetransport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/icetransport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/init.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/init.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/init.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/logcounter.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/logcounter.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/logcounter.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/memorytracker.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/peerconnection.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/peerconnection.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/peerconnection.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/pollinterrupter.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/pollinterrupter.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/pollinterrupter.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/processor.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/processor.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/processor.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/reactor.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/reactor.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/reactor.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/sctptransport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/sctptransport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/sctptransport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/streamscheduler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/streamscheduler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/streamscheduler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/threadpool.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/threadpool.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/threadpool.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/tls.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tls.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tls.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/tlstransport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tlstransport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tlstransport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/track.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/track.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/track.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/transport.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/transport.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/transport.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/impl/utils.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/utils.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/utils.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/mediahandler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/mediahandler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/mediahandler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/memoryplacement.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/memoryplacement.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/memoryplacement.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/message.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/message.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/message.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/nalunit.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/nalunit.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/nalunit.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/pacinghandler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/pacinghandler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/pacinghandler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/peerconnection.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/peerconnection.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/peerconnection.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/plihandler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/plihandler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/plihandler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/qos.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/qos.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/qos.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rembhandler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rembhandler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rembhandler.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtcpnackresponder.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpnackresponder.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpnackresponder.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtcpreceivingsession.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpreceivingsession.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpreceivingsession.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtcpsrreporter.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpsrreporter.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpsrreporter.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtp.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtp.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtp.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtpdepacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtpdepacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtpdepacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtppacketizationconfig.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizationconfig.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizationconfig.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/rtppacketizer.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizer.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizer.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/temporallayerselector.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/temporallayerselector.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/temporallayerselector.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/track.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/track.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/track.cpp.o.d"
+  "/root/repo/components/libdatachannel/src/transportcchandler.cpp" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/transportcchandler.cpp.o" "gcc" "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/transportcchandler.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build_main/libsrtp/CMakeFiles/srtp2.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_main/CMakeFiles/juice_host.dir/DependInfo.cmake"
+  "/root/repo/_gate_build_main/CMakeFiles/usrsctp_host.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
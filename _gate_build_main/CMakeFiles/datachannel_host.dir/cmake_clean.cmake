@@ -0,0 +1,123 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/av1rtppacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/av1rtppacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/candidate.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/candidate.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/channel.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/channel.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/configuration.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/configuration.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/datachannel.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/datachannel.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/dependencydescriptor.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/dependencydescriptor.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/description.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/description.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/framearena.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/framearena.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/global.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/global.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtpdepacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtpdepacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtppacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h264rtppacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265nalunit.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265nalunit.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtpdepacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtpdepacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtppacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/h265rtppacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/heapprofiler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/heapprofiler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/certificate.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/certificate.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/channel.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/channel.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/datachannel.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/datachannel.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlssrtptransport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlssrtptransport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlstransport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/dtlstransport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/epoch.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/epoch.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/heapprofiler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/heapprofiler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/icetransport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/icetransport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/init.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/init.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/logcounter.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/logcounter.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/peerconnection.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/peerconnection.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/pollinterrupter.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/pollinterrupter.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/processor.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/processor.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/reactor.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/reactor.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/sctptransport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/sctptransport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/streamscheduler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/streamscheduler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/threadpool.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/threadpool.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tls.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tls.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tlstransport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/tlstransport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/track.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/track.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/transport.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/transport.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/utils.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/impl/utils.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/mediahandler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/mediahandler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/memoryplacement.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/memoryplacement.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/message.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/message.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/nalunit.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/nalunit.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/pacinghandler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/pacinghandler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/peerconnection.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/peerconnection.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/plihandler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/plihandler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/qos.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/qos.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rembhandler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rembhandler.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpnackresponder.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpnackresponder.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpreceivingsession.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpreceivingsession.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpsrreporter.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtcpsrreporter.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtp.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtp.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtpdepacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtpdepacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizationconfig.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizationconfig.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizer.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/rtppacketizer.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/temporallayerselector.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/temporallayerselector.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/track.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/track.cpp.o.d"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/transportcchandler.cpp.o"
+  "CMakeFiles/datachannel_host.dir/root/repo/components/libdatachannel/src/transportcchandler.cpp.o.d"
+  "libdatachannel_host.a"
+  "libdatachannel_host.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/datachannel_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
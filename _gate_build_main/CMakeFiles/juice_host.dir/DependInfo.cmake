@@ -0,0 +1,39 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/components/libjuice/src/addr.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/addr.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/addr.c.o.d"
+  "/root/repo/components/libjuice/src/agent.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/agent.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/agent.c.o.d"
+  "/root/repo/components/libjuice/src/base64.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/base64.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/base64.c.o.d"
+  "/root/repo/components/libjuice/src/conn.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn.c.o.d"
+  "/root/repo/components/libjuice/src/conn_mux.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_mux.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_mux.c.o.d"
+  "/root/repo/components/libjuice/src/conn_poll.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_poll.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_poll.c.o.d"
+  "/root/repo/components/libjuice/src/conn_thread.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_thread.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_thread.c.o.d"
+  "/root/repo/components/libjuice/src/conn_user.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_user.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_user.c.o.d"
+  "/root/repo/components/libjuice/src/const_time.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/const_time.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/const_time.c.o.d"
+  "/root/repo/components/libjuice/src/crc32.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/crc32.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/crc32.c.o.d"
+  "/root/repo/components/libjuice/src/hash.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hash.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hash.c.o.d"
+  "/root/repo/components/libjuice/src/hmac.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hmac.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hmac.c.o.d"
+  "/root/repo/components/libjuice/src/ice.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/ice.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/ice.c.o.d"
+  "/root/repo/components/libjuice/src/juice.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/juice.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/juice.c.o.d"
+  "/root/repo/components/libjuice/src/log.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/log.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/log.c.o.d"
+  "/root/repo/components/libjuice/src/random.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/random.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/random.c.o.d"
+  "/root/repo/components/libjuice/src/server.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/server.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/server.c.o.d"
+  "/root/repo/components/libjuice/src/stun.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/stun.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/stun.c.o.d"
+  "/root/repo/components/libjuice/src/timestamp.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/timestamp.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/timestamp.c.o.d"
+  "/root/repo/components/libjuice/src/turn.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/turn.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/turn.c.o.d"
+  "/root/repo/components/libjuice/src/udp.c" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/udp.c.o" "gcc" "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/udp.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,51 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/addr.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/addr.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/agent.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/agent.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/base64.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/base64.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_mux.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_mux.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_poll.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_poll.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_thread.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_thread.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_user.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/conn_user.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/const_time.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/const_time.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/crc32.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/crc32.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hash.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hash.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hmac.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/hmac.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/ice.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/ice.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/juice.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/juice.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/log.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/log.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/random.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/random.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/server.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/server.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/stun.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/stun.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/timestamp.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/timestamp.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/turn.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/turn.c.o.d"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/udp.c.o"
+  "CMakeFiles/juice_host.dir/root/repo/components/libjuice/src/udp.c.o.d"
+  "libjuice_host.a"
+  "libjuice_host.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/juice_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
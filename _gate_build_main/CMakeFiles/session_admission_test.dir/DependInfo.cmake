@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/components/libdatachannel/src/impl/memorytracker.cpp" "CMakeFiles/session_admission_test.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o" "gcc" "CMakeFiles/session_admission_test.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o.d"
+  "/root/repo/main/test/session_admission_test.cpp" "CMakeFiles/session_admission_test.dir/session_admission_test.cpp.o" "gcc" "CMakeFiles/session_admission_test.dir/session_admission_test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
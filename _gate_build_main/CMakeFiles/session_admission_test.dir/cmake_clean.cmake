@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/session_admission_test.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o"
+  "CMakeFiles/session_admission_test.dir/root/repo/components/libdatachannel/src/impl/memorytracker.cpp.o.d"
+  "CMakeFiles/session_admission_test.dir/session_admission_test.cpp.o"
+  "CMakeFiles/session_admission_test.dir/session_admission_test.cpp.o.d"
+  "session_admission_test"
+  "session_admission_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/session_admission_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
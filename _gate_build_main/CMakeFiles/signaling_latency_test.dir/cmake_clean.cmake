@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/signaling_latency_test.dir/signaling_latency_test.cpp.o"
+  "CMakeFiles/signaling_latency_test.dir/signaling_latency_test.cpp.o.d"
+  "signaling_latency_test"
+  "signaling_latency_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/signaling_latency_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
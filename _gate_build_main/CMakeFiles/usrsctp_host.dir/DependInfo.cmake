@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/components/usrsctp/src/netinet/sctp_asconf.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_asconf.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_asconf.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_auth.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_auth.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_auth.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_bsd_addr.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_bsd_addr.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_bsd_addr.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_callout.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_callout.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_callout.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_cc_functions.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_cc_functions.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_cc_functions.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_crc32.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_crc32.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_crc32.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_indata.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_indata.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_indata.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_input.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_input.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_input.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_output.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_output.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_output.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_pcb.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_pcb.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_pcb.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_peeloff.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_peeloff.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_peeloff.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_sha1.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sha1.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sha1.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_ss_functions.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_ss_functions.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_ss_functions.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_sysctl.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sysctl.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sysctl.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_timer.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_timer.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_timer.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_userspace.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_userspace.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_userspace.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctp_usrreq.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_usrreq.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_usrreq.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet/sctputil.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctputil.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctputil.c.o.d"
+  "/root/repo/components/usrsctp/src/netinet6/sctp6_usrreq.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet6/sctp6_usrreq.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet6/sctp6_usrreq.c.o.d"
+  "/root/repo/components/usrsctp/src/user_environment.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_environment.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_environment.c.o.d"
+  "/root/repo/components/usrsctp/src/user_mbuf.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_mbuf.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_mbuf.c.o.d"
+  "/root/repo/components/usrsctp/src/user_recv_thread.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_recv_thread.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_recv_thread.c.o.d"
+  "/root/repo/components/usrsctp/src/user_socket.c" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_socket.c.o" "gcc" "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_socket.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_asconf.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_asconf.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_auth.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_auth.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_bsd_addr.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_bsd_addr.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_callout.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_callout.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_cc_functions.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_cc_functions.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_crc32.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_crc32.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_indata.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_indata.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_input.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_input.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_output.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_output.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_pcb.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_pcb.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_peeloff.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_peeloff.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sha1.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sha1.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_ss_functions.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_ss_functions.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sysctl.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_sysctl.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_timer.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_timer.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_userspace.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_userspace.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_usrreq.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctp_usrreq.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctputil.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet/sctputil.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet6/sctp6_usrreq.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/netinet6/sctp6_usrreq.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_environment.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_environment.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_mbuf.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_mbuf.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_recv_thread.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_recv_thread.c.o.d"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_socket.c.o"
+  "CMakeFiles/usrsctp_host.dir/root/repo/components/usrsctp/src/user_socket.c.o.d"
+  "libusrsctp_host.a"
+  "libusrsctp_host.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/usrsctp_host.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/main/test
+# Build directory: /root/repo/_gate_build_main
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(session_admission "/root/repo/_gate_build_main/session_admission_test")
+set_tests_properties(session_admission PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/main/test/CMakeLists.txt;38;add_test;/root/repo/main/test/CMakeLists.txt;0;")
+add_test(signaling_latency "/root/repo/_gate_build_main/signaling_latency_test")
+set_tests_properties(signaling_latency PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/main/test/CMakeLists.txt;48;add_test;/root/repo/main/test/CMakeLists.txt;0;")
+add_test(audio_latency "/root/repo/_gate_build_main/audio_latency_test")
+set_tests_properties(audio_latency PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/main/test/CMakeLists.txt;64;add_test;/root/repo/main/test/CMakeLists.txt;0;")
+subdirs("libsrtp")
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/cipher/aes_gcm_ossl.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/aes_gcm_ossl.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/aes_gcm_ossl.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/cipher/aes_icm_ossl.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/aes_icm_ossl.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/aes_icm_ossl.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/cipher/cipher.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/cipher.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/cipher.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/cipher/cipher_test_cases.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/cipher_test_cases.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/cipher_test_cases.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/cipher/null_cipher.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/null_cipher.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/cipher/null_cipher.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/hash/auth.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/auth.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/auth.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/hash/auth_test_cases.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/auth_test_cases.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/auth_test_cases.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/hash/hmac_ossl.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/hmac_ossl.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/hmac_ossl.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/hash/null_auth.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/null_auth.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/hash/null_auth.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/kernel/alloc.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/alloc.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/alloc.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/kernel/crypto_kernel.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/crypto_kernel.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/crypto_kernel.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/kernel/err.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/err.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/err.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/kernel/key.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/key.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/kernel/key.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/math/datatypes.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/math/datatypes.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/math/datatypes.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/replay/rdb.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/replay/rdb.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/replay/rdb.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/crypto/replay/rdbx.c" "libsrtp/CMakeFiles/srtp2.dir/crypto/replay/rdbx.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/crypto/replay/rdbx.c.o.d"
+  "/root/repo/components/libdatachannel/deps/libsrtp/srtp/srtp.c" "libsrtp/CMakeFiles/srtp2.dir/srtp/srtp.c.o" "gcc" "libsrtp/CMakeFiles/srtp2.dir/srtp/srtp.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
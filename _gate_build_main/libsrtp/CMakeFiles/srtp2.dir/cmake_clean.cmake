@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/srtp2.dir/crypto/cipher/aes_gcm_ossl.c.o"
+  "CMakeFiles/srtp2.dir/crypto/cipher/aes_gcm_ossl.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/cipher/aes_icm_ossl.c.o"
+  "CMakeFiles/srtp2.dir/crypto/cipher/aes_icm_ossl.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/cipher/cipher.c.o"
+  "CMakeFiles/srtp2.dir/crypto/cipher/cipher.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/cipher/cipher_test_cases.c.o"
+  "CMakeFiles/srtp2.dir/crypto/cipher/cipher_test_cases.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/cipher/null_cipher.c.o"
+  "CMakeFiles/srtp2.dir/crypto/cipher/null_cipher.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/hash/auth.c.o"
+  "CMakeFiles/srtp2.dir/crypto/hash/auth.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/hash/auth_test_cases.c.o"
+  "CMakeFiles/srtp2.dir/crypto/hash/auth_test_cases.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/hash/hmac_ossl.c.o"
+  "CMakeFiles/srtp2.dir/crypto/hash/hmac_ossl.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/hash/null_auth.c.o"
+  "CMakeFiles/srtp2.dir/crypto/hash/null_auth.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/kernel/alloc.c.o"
+  "CMakeFiles/srtp2.dir/crypto/kernel/alloc.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/kernel/crypto_kernel.c.o"
+  "CMakeFiles/srtp2.dir/crypto/kernel/crypto_kernel.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/kernel/err.c.o"
+  "CMakeFiles/srtp2.dir/crypto/kernel/err.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/kernel/key.c.o"
+  "CMakeFiles/srtp2.dir/crypto/kernel/key.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/math/datatypes.c.o"
+  "CMakeFiles/srtp2.dir/crypto/math/datatypes.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/replay/rdb.c.o"
+  "CMakeFiles/srtp2.dir/crypto/replay/rdb.c.o.d"
+  "CMakeFiles/srtp2.dir/crypto/replay/rdbx.c.o"
+  "CMakeFiles/srtp2.dir/crypto/replay/rdbx.c.o.d"
+  "CMakeFiles/srtp2.dir/srtp/srtp.c.o"
+  "CMakeFiles/srtp2.dir/srtp/srtp.c.o.d"
+  "libsrtp2.a"
+  "libsrtp2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/srtp2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
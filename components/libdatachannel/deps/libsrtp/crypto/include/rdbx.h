@@ -80,10 +80,15 @@ typedef uint64_t srtp_xtd_seq_num_t;
 /*
  * An srtp_rdbx_t is a replay database with extended range; it uses an
  * xtd_seq_num_t and a bitmask of recently received indices.
+ *
+ * The bitmask is a ring indexed by the low bits of the packet index, at
+ * least one word longer than the window, so that moving the window forward
+ * only clears the words it enters instead of shifting the whole bitmask.
  */
 typedef struct {
     srtp_xtd_seq_num_t index;
     bitvector_t bitmask;
+    unsigned long window_size;
 } srtp_rdbx_t;
 
 /*
@@ -82,10 +82,17 @@
  *
  * A srtp_rdbx_t consists of a srtp_xtd_seq_num_t and a bitmask.  The index is
  * highest sequence number that has been received, and the bitmask indicates
- * which of the recent indicies have been received as well.  The
- * highest bit in the bitmask corresponds to the index in the bitmask.
+ * which of the recent indicies have been received as well.  The bitmask is a
+ * ring: index i is recorded at bit i modulo its length, a power of two.  When
+ * the index moves into a new word, that word is cleared before use, so every
+ * bit of the current word above the index is clear, and the ring always holds
+ * at least the window size of valid history behind the index.
  */
 
+/* position of the packet index i in the ring */
+#define rdbx_ring_bit(rdbx, i)                                                 \
+    ((uint32_t)(i) & (bitvector_get_length(&(rdbx)->bitmask) - 1))
+
 void srtp_index_init(srtp_xtd_seq_num_t *pi)
 {
 #ifdef NO_64BIT_MATH
@@ -174,13 +181,24 @@ int32_t srtp_index_guess(const srtp_xtd_seq_num_t *local,
  */
 srtp_err_status_t srtp_rdbx_init(srtp_rdbx_t *rdbx, unsigned long ws)
 {
+    unsigned long ring = bits_per_word;
+
     if (ws == 0) {
         return srtp_err_status_bad_param;
     }
 
-    if (bitvector_alloc(&rdbx->bitmask, ws) != 0) {
+    /* the window size is reported rounded up to a word, as it used to be */
+    ws = (ws + bits_per_word - 1) & ~(unsigned long)(bits_per_word - 1);
+
+    /* leave a spare word for the partially filled word holding the index */
+    while (ring < ws + bits_per_word) {
+        ring <<= 1;
+    }
+
+    if (bitvector_alloc(&rdbx->bitmask, ring) != 0) {
         return srtp_err_status_alloc_fail;
     }
+    rdbx->window_size = ws;
 
     srtp_index_init(&rdbx->index);
 
@@ -241,7 +259,7 @@ srtp_xtd_seq_num_t srtp_rdbx_get_packet_index(const srtp_rdbx_t *rdbx)
  */
 unsigned long srtp_rdbx_get_window_size(const srtp_rdbx_t *rdbx)
 {
-    return bitvector_get_length(&rdbx->bitmask);
+    return rdbx->window_size;
 }
 
 /*
@@ -250,16 +268,18 @@ unsigned long srtp_rdbx_get_window_size(const srtp_rdbx_t *rdbx)
  */
 srtp_err_status_t srtp_rdbx_check(const srtp_rdbx_t *rdbx, int delta)
 {
+    uint32_t bit;
+
     if (delta > 0) { /* if delta is positive, it's good */
         return srtp_err_status_ok;
-    } else if ((int)(bitvector_get_length(&rdbx->bitmask) - 1) + delta < 0) {
-        /* if delta is lower than the bitmask, it's bad */
+    } else if ((int)(rdbx->window_size - 1) + delta < 0) {
+        /* if delta is lower than the window, it's bad */
         return srtp_err_status_replay_old;
-    } else if (bitvector_get_bit(
-                   &rdbx->bitmask,
-                   (int)(bitvector_get_length(&rdbx->bitmask) - 1) + delta) ==
-               1) {
-        /* delta is within the window, so check the bitmask */
+    }
+
+    /* delta is within the window, so check the bitmask */
+    bit = rdbx_ring_bit(rdbx, rdbx->index + (srtp_xtd_seq_num_t)(int64_t)delta);
+    if (bitvector_get_bit(&rdbx->bitmask, bit) == 1) {
         return srtp_err_status_replay_fail;
     }
     /* otherwise, the index is okay */
@@ -277,19 +297,32 @@ srtp_err_status_t srtp_rdbx_check(const srtp_rdbx_t *rdbx, int delta)
  */
 srtp_err_status_t srtp_rdbx_add_index(srtp_rdbx_t *rdbx, int delta)
 {
+    uint32_t bit;
+
     if (delta > 0) {
-        /* shift forward by delta */
+        /* clear the words the index moves into, whole words at a time */
+        const uint32_t words = bitvector_get_length(&rdbx->bitmask) >> 5;
+        uint32_t word = rdbx_ring_bit(rdbx, rdbx->index) >> 5;
+        srtp_xtd_seq_num_t entered = rdbx->index >> 5;
+
         srtp_index_advance(&rdbx->index, (srtp_sequence_number_t)delta);
-        bitvector_left_shift(&rdbx->bitmask, delta);
-        bitvector_set_bit(&rdbx->bitmask,
-                          bitvector_get_length(&rdbx->bitmask) - 1);
+
+        entered = (rdbx->index >> 5) - entered;
+        if (entered > words) {
+            entered = words;
+        }
+        while (entered-- > 0) {
+            word = (word + 1) & (words - 1);
+            rdbx->bitmask.word[word] = 0;
+        }
+
+        bit = rdbx_ring_bit(rdbx, rdbx->index);
     } else {
         /* delta is in window */
-        bitvector_set_bit(&rdbx->bitmask,
-                          bitvector_get_length(&rdbx->bitmask) - 1 + delta);
+        bit = rdbx_ring_bit(rdbx,
+                            rdbx->index + (srtp_xtd_seq_num_t)(int64_t)delta);
     }
-
-    /* note that we need not consider the case that delta == 0 */
+    bitvector_set_bit(&rdbx->bitmask, bit);
 
     return srtp_err_status_ok;
 }
@@ -158,9 +158,12 @@ typedef struct srtp_stream_ctx_t_ {
  * an srtp_ctx_t holds a stream list and a service description
  */
 typedef struct srtp_ctx_t_ {
-    srtp_stream_list_t stream_list;             /* linked list of streams     */
+    srtp_stream_list_t stream_list;             /* list of streams            */
     struct srtp_stream_ctx_t_ *stream_template; /* act as template for other  */
                                                 /* streams                    */
+    struct srtp_stream_ctx_t_ *last_stream;     /* last stream looked up, or  */
+                                                /* NULL; must be cleared when */
+                                                /* removed from the list      */
     void *user_data;                            /* user custom data           */
 } srtp_ctx_t_;
 
@@ -2919,7 +2919,20 @@ srtp_err_status_t srtp_shutdown(void)
 
 srtp_stream_ctx_t *srtp_get_stream(srtp_t srtp, uint32_t ssrc)
 {
-    return srtp_stream_list_get(srtp->stream_list, ssrc);
+    srtp_stream_ctx_t *stream = srtp->last_stream;
+
+    /* a session usually carries a single SSRC per direction, so the last
+     * stream looked up is almost always the one wanted */
+    if (stream != NULL && stream->ssrc == ssrc) {
+        return stream;
+    }
+
+    stream = srtp_stream_list_get(srtp->stream_list, ssrc);
+    if (stream != NULL) {
+        srtp->last_stream = stream;
+    }
+
+    return stream;
 }
 
 srtp_err_status_t srtp_dealloc(srtp_t session)
@@ -3051,6 +3064,7 @@ srtp_err_status_t srtp_create(srtp_t *session, /* handle for session     */
 
     ctx->stream_template = NULL;
     ctx->stream_list = NULL;
+    ctx->last_stream = NULL;
     ctx->user_data = NULL;
 
     /* allocate stream list */
@@ -3098,6 +3112,9 @@ srtp_err_status_t srtp_remove_stream(srtp_t session, uint32_t ssrc)
     }
 
     srtp_stream_list_remove(session->stream_list, stream);
+    if (session->last_stream == stream) {
+        session->last_stream = NULL;
+    }
 
     /* deallocate the stream */
     status = srtp_stream_dealloc(stream, session->stream_template);
@@ -3236,6 +3253,7 @@ static srtp_err_status_t update_template_streams(srtp_t session,
                               &data);
     if (data.status) {
         /* free new allocations */
+        session->last_stream = NULL;
         srtp_remove_and_dealloc_streams(new_stream_list, new_stream_template);
         srtp_stream_list_dealloc(new_stream_list);
         srtp_stream_dealloc(new_stream_template, NULL);
@@ -3251,6 +3269,7 @@ static srtp_err_status_t update_template_streams(srtp_t session,
     /* set new list / template */
     session->stream_template = new_stream_template;
     session->stream_list = new_stream_list;
+    session->last_stream = NULL;
     return srtp_err_status_ok;
 }
 
@@ -4891,13 +4910,67 @@ srtp_err_status_t srtp_get_stream_roc(srtp_t session,
 
 #ifndef SRTP_NO_STREAM_LIST
 
-/* in the default implementation, we have an intrusive doubly-linked list */
+/*
+ * in the default implementation, we have a hash table keyed by SSRC, each
+ * bucket holding an intrusive doubly-linked list of streams. the table starts
+ * with a few inline buckets and doubles whenever chains would get longer than
+ * two streams on average, so that lookups stay constant-time
+ */
+#define SRTP_STREAM_LIST_INLINE_BUCKETS 4
+
 typedef struct srtp_stream_list_ctx_t_ {
-    /* a stub stream that just holds pointers to the beginning and end of the
-     * list */
-    srtp_stream_ctx_t data;
+    srtp_stream_t *buckets;
+    size_t capacity; /* number of buckets, a power of two */
+    size_t size;
+    srtp_stream_t inline_buckets[SRTP_STREAM_LIST_INLINE_BUCKETS];
 } srtp_stream_list_ctx_t_;
 
+static size_t srtp_stream_list_bucket(srtp_stream_list_t list, uint32_t ssrc)
+{
+    uint32_t hash = ssrc * 0x9e3779b1u;
+    return (hash ^ (hash >> 16)) & (list->capacity - 1);
+}
+
+static void srtp_stream_list_link(srtp_stream_list_t list, srtp_stream_t stream)
+{
+    srtp_stream_t *head = &list->buckets[srtp_stream_list_bucket(list,
+                                                                 stream->ssrc)];
+    stream->prev = NULL;
+    stream->next = *head;
+    if (stream->next != NULL) {
+        stream->next->prev = stream;
+    }
+    *head = stream;
+}
+
+static void srtp_stream_list_grow(srtp_stream_list_t list)
+{
+    size_t i;
+    size_t old_capacity = list->capacity;
+    srtp_stream_t *old_buckets = list->buckets;
+    srtp_stream_t *buckets =
+        srtp_crypto_alloc(2 * old_capacity * sizeof(srtp_stream_t));
+    if (buckets == NULL) {
+        /* keep going with longer chains */
+        return;
+    }
+
+    list->buckets = buckets;
+    list->capacity = 2 * old_capacity;
+    for (i = 0; i < old_capacity; i++) {
+        srtp_stream_t stream = old_buckets[i];
+        while (stream != NULL) {
+            srtp_stream_t next = stream->next;
+            srtp_stream_list_link(list, stream);
+            stream = next;
+        }
+    }
+
+    if (old_buckets != list->inline_buckets) {
+        srtp_crypto_free(old_buckets);
+    }
+}
+
 srtp_err_status_t srtp_stream_list_alloc(srtp_stream_list_t *list_ptr)
 {
     srtp_stream_list_t list =
@@ -4906,8 +4979,9 @@ srtp_err_status_t srtp_stream_list_alloc(srtp_stream_list_t *list_ptr)
         return srtp_err_status_alloc_fail;
     }
 
-    list->data.next = NULL;
-    list->data.prev = NULL;
+    list->buckets = list->inline_buckets;
+    list->capacity = SRTP_STREAM_LIST_INLINE_BUCKETS;
+    list->size = 0;
 
     *list_ptr = list;
     return srtp_err_status_ok;
@@ -4916,9 +4990,12 @@ srtp_err_status_t srtp_stream_list_alloc(srtp_stream_list_t *list_ptr)
 srtp_err_status_t srtp_stream_list_dealloc(srtp_stream_list_t list)
 {
     /* list must be empty */
-    if (list->data.next) {
+    if (list->size) {
         return srtp_err_status_fail;
     }
+    if (list->buckets != list->inline_buckets) {
+        srtp_crypto_free(list->buckets);
+    }
     srtp_crypto_free(list);
     return srtp_err_status_ok;
 }
@@ -4926,21 +5003,21 @@ srtp_err_status_t srtp_stream_list_dealloc(srtp_stream_list_t list)
 srtp_err_status_t srtp_stream_list_insert(srtp_stream_list_t list,
                                           srtp_stream_t stream)
 {
-    /* insert at the head of the list */
-    stream->next = list->data.next;
-    if (stream->next != NULL) {
-        stream->next->prev = stream;
+    if (list->size >= 2 * list->capacity) {
+        srtp_stream_list_grow(list);
     }
-    list->data.next = stream;
-    stream->prev = &(list->data);
+
+    /* insert at the head of the bucket */
+    srtp_stream_list_link(list, stream);
+    list->size++;
 
     return srtp_err_status_ok;
 }
 
 srtp_stream_t srtp_stream_list_get(srtp_stream_list_t list, uint32_t ssrc)
 {
-    /* walk down list until ssrc is found */
-    srtp_stream_t stream = list->data.next;
+    /* walk down the bucket until ssrc is found */
+    srtp_stream_t stream = list->buckets[srtp_stream_list_bucket(list, ssrc)];
     while (stream != NULL) {
         if (stream->ssrc == ssrc) {
             return stream;
@@ -4955,24 +5032,31 @@ srtp_stream_t srtp_stream_list_get(srtp_stream_list_t list, uint32_t ssrc)
 void srtp_stream_list_remove(srtp_stream_list_t list,
                              srtp_stream_t stream_to_remove)
 {
-    (void)list;
-
-    stream_to_remove->prev->next = stream_to_remove->next;
+    if (stream_to_remove->prev != NULL) {
+        stream_to_remove->prev->next = stream_to_remove->next;
+    } else {
+        list->buckets[srtp_stream_list_bucket(list, stream_to_remove->ssrc)] =
+            stream_to_remove->next;
+    }
     if (stream_to_remove->next != NULL) {
         stream_to_remove->next->prev = stream_to_remove->prev;
     }
+    list->size--;
 }
 
 void srtp_stream_list_for_each(srtp_stream_list_t list,
                                int (*callback)(srtp_stream_t, void *),
                                void *data)
 {
-    srtp_stream_t stream = list->data.next;
-    while (stream != NULL) {
-        srtp_stream_t tmp = stream;
-        stream = stream->next;
-        if (callback(tmp, data))
-            break;
+    size_t i;
+    for (i = 0; i < list->capacity; i++) {
+        srtp_stream_t stream = list->buckets[i];
+        while (stream != NULL) {
+            srtp_stream_t tmp = stream;
+            stream = stream->next;
+            if (callback(tmp, data))
+                return;
+        }
     }
 }
 
@@ -5,6 +5,7 @@
 #ifndef ESP32_PSRAM_INIT_H
 #define ESP32_PSRAM_INIT_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -29,6 +30,47 @@ void enable_psram_malloc(void);
 // Note: This affects the current task only
 void set_task_malloc_target(uint32_t caps);
 
+// Allocate/free PSRAM-only buffers, accounted to the current connection if any
+// Used by PSRAMAllocator (rtc::binary), returns NULL if PSRAM is exhausted
+void* esp32_psram_buffer_alloc(size_t size);
+void esp32_psram_buffer_free(void* ptr);
+
+// Allocation classes, deciding where allocations are placed regardless of the malloc target
+// Hot and DMA allocations are served from dedicated internal RAM pools whose size is the class
+// budget. Once a pool is full, hot allocations spill to the default target and DMA allocations
+// to the general DMA-capable heap. Blocks from any class are released with free() or delete.
+typedef enum {
+    ESP32_MEM_DEFAULT = 0, // Follow the task malloc target
+    ESP32_MEM_HOT,         // Small, frequently touched state (crypto contexts, indexes): internal RAM
+    ESP32_MEM_BULK,        // Large buffers: PSRAM
+    ESP32_MEM_DMA,         // Buffers handed to peripherals: DMA-capable internal RAM
+} esp32_mem_class_t;
+
+typedef struct {
+    size_t budget;    // Pool size in bytes, 0 if the class has no pool
+    size_t used;      // Bytes in use in the pool, including allocator overhead
+    size_t peak;      // High watermark of used
+    size_t fallbacks; // Allocations that did not fit the budget and were placed elsewhere
+} esp32_mem_class_stats_t;
+
+// Get/set the allocation class of the current task (uses FreeRTOS TLS)
+esp32_mem_class_t esp32_get_task_mem_class(void);
+void esp32_set_task_mem_class(esp32_mem_class_t mem_class);
+
+// Set the budget of a pooled class (hot or DMA), only effective before its first allocation
+// Defaults are ESP32_HOT_POOL_SIZE and ESP32_DMA_POOL_SIZE, a budget of 0 disables the pool
+void esp32_mem_class_set_budget(esp32_mem_class_t mem_class, size_t budget);
+
+// Allocate directly in a class, returns NULL if no memory is left
+void* esp32_mem_class_alloc(esp32_mem_class_t mem_class, size_t size);
+
+void esp32_mem_class_get_stats(esp32_mem_class_t mem_class, esp32_mem_class_stats_t* stats);
+
+// Get/set the per-connection memory accounting tag of the current task (uses FreeRTOS TLS)
+// Tags are managed by libdatachannel, allocations made under a tag are accounted to it
+uint32_t esp32_get_task_memory_tag(void);
+void esp32_set_task_memory_tag(uint32_t tag);
+
 // Print memory statistics
 void print_rtc_memory_stats(void);
 
@@ -57,6 +57,7 @@
 // ESP32 PSRAM allocator - must be defined before rtc namespace
 #ifdef ESP32_PORT
 #include <esp_heap_caps.h>
+#include "esp32_psram_init.h"
 
 template<typename T>
 class PSRAMAllocator {
@@ -68,14 +69,14 @@ public:
 
 	T* allocate(std::size_t n) {
 		size_t bytes = n * sizeof(T);
-		if (auto p = static_cast<T*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM))) {
+		if (auto p = static_cast<T*>(esp32_psram_buffer_alloc(bytes))) {
 			return p;
 		}
 		throw std::bad_alloc();
 	}
 
 	void deallocate(T* p, std::size_t) {
-		heap_caps_free(p);
+		esp32_psram_buffer_free(p);
 	}
 };
 
@@ -11,6 +11,7 @@
 
 #include "common.hpp"
 
+#include <chrono>
 #include <vector>
 
 namespace rtc {
@@ -78,6 +79,7 @@ struct RTC_CPP_EXPORT Configuration {
 	bool disableAutoGathering = false;
 	bool forceMediaTransport = false;
 	bool disableFingerprintVerification = false;
+	bool disableSctpMessageInterleaving = false; // RFC 8260 I-DATA is negotiated by default
 
 	// Port range
 	uint16_t portRangeBegin = 1024;
@@ -86,6 +88,11 @@ struct RTC_CPP_EXPORT Configuration {
 	// Network MTU
 	optional<size_t> mtu;
 
+	// DTLS handshake retransmission timeouts, the initial one is shortened from the round-trip
+	// time when known, the handshake fails when the backoff would exceed the maximum
+	optional<std::chrono::milliseconds> dtlsInitialRetransmitTimeout; // default 1s
+	optional<std::chrono::milliseconds> dtlsMaxRetransmitTimeout;     // default 30s
+
 	// Local maximum message size for Data Channels
 	optional<size_t> maxMessageSize;
 
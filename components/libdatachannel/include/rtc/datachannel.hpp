@@ -34,6 +34,7 @@ public:
 	string label() const;
 	string protocol() const;
 	Reliability reliability() const;
+	uint16_t priority() const;
 
 	bool isOpen(void) const override;
 	bool isClosed(void) const override;
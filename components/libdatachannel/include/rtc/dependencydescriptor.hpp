@@ -11,7 +11,9 @@
 
 #include "common.hpp"
 
+#include <array>
 #include <bitset>
+#include <vector>
 
 namespace rtc {
 
@@ -79,6 +81,21 @@ struct DependencyDescriptorContext {
 	DependencyDescriptor descriptor;
 	std::bitset<32> activeChains;
 	FrameDependencyStructure structure;
+
+	/// Context for a single spatial layer with 1 to 3 temporal layers (L1T1, L1T2 or L1T3)
+	/// Decode target i contains temporal layers up to i. A base layer frame references the previous
+	/// base layer frame and an upper layer frame the previous frame of a lower layer, as encoders
+	/// produce them, so any upper layers can be skipped. The packetizer then describes each frame
+	/// from its FrameInfo instead of using the descriptor set by the application.
+	static DependencyDescriptorContext TemporalLayers(int count);
+
+	/// Describes a frame of a context created with TemporalLayers()
+	/// activeDecodeTargetsBitmask is left as is, the sender sets it when it skips upper layers.
+	void describeFrame(uint32_t frameNumber, int temporalId, bool keyframe);
+
+	int temporalLayerCount = 0; // 0 if the descriptor is set by the application
+	uint32_t nextFrameNumber = 0;
+	std::array<optional<uint32_t>, 3> lastFrameNumbers; // Last frame of each temporal layer
 };
 
 // Write dependency descriptor to RTP Header Extension
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_FRAME_ARENA_H
+#define RTC_FRAME_ARENA_H
+
+#include "common.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace rtc {
+
+/// Bump allocator for temporaries that die with the frame being processed
+/// Chunks are kept across reset(), so once the arena has grown to fit a typical frame, further
+/// frames are served without touching the heap.
+class RTC_CPP_EXPORT FrameArena final {
+public:
+	inline static const size_t DefaultChunkSize = 16 * 1024;
+
+	FrameArena(size_t chunkSize = DefaultChunkSize);
+	~FrameArena();
+
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator=(const FrameArena &) = delete;
+
+	/// Returns memory valid until the next reset()
+	/// @param size Size in bytes
+	/// @param alignment Alignment, at most alignof(std::max_align_t)
+	void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	/// Releases everything allocated since the last reset, keeping the chunks for reuse
+	void reset();
+
+	size_t capacity() const;         // Bytes held in chunks
+	size_t chunkAllocations() const; // Heap allocations made over the arena lifetime
+
+private:
+	struct Chunk {
+		byte *data;
+		size_t size;
+	};
+
+	const size_t mChunkSize;
+#ifdef ESP32_PORT
+	psram_vector<Chunk> mChunks;
+#else
+	std::vector<Chunk> mChunks;
+#endif
+	size_t mCurrent = 0; // Chunk being filled
+	size_t mOffset = 0;  // Offset in the chunk being filled
+	size_t mChunkAllocations = 0;
+};
+
+/// Standard allocator serving from a FrameArena, deallocation is a no-op
+template <typename T> class ArenaAllocator {
+public:
+	using value_type = T;
+
+	ArenaAllocator(FrameArena &arena) : mArena(&arena) {}
+	template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : mArena(other.arena()) {}
+
+	T *allocate(std::size_t n) {
+		return static_cast<T *>(mArena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T *, std::size_t) {}
+
+	FrameArena *arena() const { return mArena; }
+
+private:
+	FrameArena *mArena;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+	return a.arena() != b.arena();
+}
+
+template <typename T> using arena_vector = std::vector<T, ArenaAllocator<T>>;
+
+/// Payload described without copying: a short prefix (e.g. a fragmentation header) followed by
+/// a slice of the frame or of arena memory
+struct RTC_CPP_EXPORT FramePayload {
+	std::array<byte, 4> prefix = {};
+	size_t prefixSize = 0;
+	const byte *data = nullptr;
+	size_t size = 0;
+
+	size_t totalSize() const { return prefixSize + size; }
+};
+
+} // namespace rtc
+
+#endif // RTC_FRAME_ARENA_H
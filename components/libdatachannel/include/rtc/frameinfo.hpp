@@ -26,12 +26,17 @@ struct RTC_CPP_EXPORT FrameInfo {
 
 	optional<std::chrono::duration<double>> timestampSeconds;
 
-#ifdef ESP32_PORT
-	// ESP32 optimization: Frame type hint for H.264
-	// I-frames (keyframes) have multiple NAL units (SPS, PPS, IDR)
+	// Frame type hint, keyframes are sent with TrafficClass::KeyFrame
+	// ESP32 optimization for H.264: I-frames (keyframes) have multiple NAL units (SPS, PPS, IDR)
 	// P-frames typically have fewer NAL units (sometimes just slice, sometimes SEI + slice)
 	bool isKeyframe = false;
-#endif
+
+	// Temporal scalability: layer of the frame, 0 for the base layer, and number of the frame in
+	// the encoded stream, so that dependencies stay right on tracks skipping upper layer frames.
+	// Frames are then described by the dependency descriptor, see
+	// DependencyDescriptorContext::TemporalLayers().
+	uint8_t temporalLayer = 0;
+	optional<uint32_t> frameNumber;
 };
 
 } // namespace rtc
@@ -10,6 +10,7 @@
 #define RTC_GLOBAL_H
 
 #include "common.hpp"
+#include "configuration.hpp" // for CertificateType
 
 #include <chrono>
 #include <future>
@@ -52,6 +53,23 @@ struct SctpSettings {
 
 RTC_CPP_EXPORT void SetSctpSettings(SctpSettings s);
 
+struct ThreadingSettings {
+	// Serve ICE sockets, SCTP timers and delayed tasks (DTLS retransmissions, pacing) from a
+	// single event loop thread instead of dedicated threads, which saves their stacks. Workers
+	// only run CPU-bound tasks. Not applicable to ICE UDP mux.
+	bool singleReactor = false;
+	optional<unsigned int> workerCount; // not set means one per core, with a minimum
+};
+
+// Must be called before initialization, i.e. before any PeerConnection is created
+RTC_CPP_EXPORT void SetThreadingSettings(ThreadingSettings s);
+
+// Keep certificates of the given type generated in the background, so that creating a
+// PeerConnection does not wait for key generation. Each certificate is used by a single
+// PeerConnection. A size of 0, the default, disables the pool.
+RTC_CPP_EXPORT void SetCertificatePoolSize(size_t size,
+                                           CertificateType type = CertificateType::Default);
+
 #ifdef ESP_PLATFORM
 // ESP32: Start networking threads after system initialization is complete
 RTC_CPP_EXPORT void StartNetworking();
@@ -40,6 +40,8 @@ public:
 	    size_t maxFragmentSize = DefaultMaxFragmentSize);
 
 private:
+	void fragmentPayloads(binary &data, arena_vector<FramePayload> &payloads) override;
+
 #ifdef ESP32_PORT
 	psram_vector<binary> fragment(binary data) override;
 	psram_vector<NalUnit> splitFrame(const binary &frame);
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_HEAP_PROFILER_H
+#define RTC_HEAP_PROFILER_H
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rtc {
+
+/// Counters of the sampling heap profiler
+struct RTC_CPP_EXPORT HeapProfilerStats {
+	bool running = false;
+	size_t samplingInterval = 0; // Mean number of bytes allocated between two samples
+	size_t samples = 0;          // Allocations sampled since started
+	size_t liveSamples = 0;      // Sampled allocations not freed yet
+	size_t sites = 0;            // Distinct call stacks
+	size_t dropped = 0;          // Samples not attributed because a table was full
+};
+
+/// Sampling heap profiler
+/// Every samplingInterval bytes allocated on average, the allocator hooks record the call stack of
+/// the allocation, and the profile reports the estimated allocated and in-use bytes by call site.
+/// Hooks are installed by the ESP32 allocator wrappers. On Linux, build with
+/// RTC_HEAP_PROFILER_HOOKS defined and link with -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,
+/// --wrap=realloc. Elsewhere the profiler records nothing.
+/// Call stacks are walked with frame pointers on ESP32 (CONFIG_ESP_SYSTEM_USE_FRAME_POINTER).
+RTC_CPP_EXPORT bool StartHeapProfiler(size_t samplingInterval = 16 * 1024); // Resets the profile
+RTC_CPP_EXPORT void StopHeapProfiler(); // Stops sampling, frees are still accounted
+RTC_CPP_EXPORT HeapProfilerStats GetHeapProfilerStats();
+
+/// Exports the profile in the pprof format (uncompressed profile.proto), addresses are left for
+/// pprof to symbolize against the firmware ELF, e.g. "pprof -top firmware.elf heap.pb"
+RTC_CPP_EXPORT binary ExportHeapProfile();
+
+} // namespace rtc
+
+#endif
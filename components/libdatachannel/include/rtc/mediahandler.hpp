@@ -14,6 +14,8 @@
 #include "description.hpp"
 #include "message.hpp"
 
+#include <atomic>
+
 namespace rtc {
 
 class RTC_CPP_EXPORT MediaHandler : public std::enable_shared_from_this<MediaHandler> {
@@ -45,12 +47,16 @@ public:
 	shared_ptr<MediaHandler> last();             // never null
 	shared_ptr<const MediaHandler> last() const; // never null
 
+	/// Chain calls walk the handlers through non-owning pointers: the caller holds the head and
+	/// each handler owns its successor. A successor replaced with setNext() while media flows is
+	/// released once the chain calls that might be in it have returned.
 	void mediaChain(const Description::Media &desc);
 	void incomingChain(message_vector &messages, const message_callback &send);
 	void outgoingChain(message_vector &messages, const message_callback &send);
 
 private:
 	shared_ptr<MediaHandler> mNext;
+	std::atomic<MediaHandler *> mNextRaw = nullptr;
 };
 
 } // namespace rtc
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_MEDIA_PIPELINE_H
+#define RTC_MEDIA_PIPELINE_H
+
+#include "mediahandler.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rtc {
+
+/// Media handler composed at compile time of a fixed sequence of stages
+/// Stages are held by value and called directly instead of walking a chain of handlers with a
+/// virtual call per hop, so the compiler may inline the whole pipeline. Outgoing messages go
+/// through the stages in order and incoming messages in reverse order, like a chain built with
+/// addToChain(). Each stage is a MediaHandler type constructed in place from a tuple of arguments:
+///
+///   auto pipeline = std::make_shared<MediaPipeline<H264RtpPacketizer, RtcpSrReporter,
+///                                                  RtcpNackResponder>>(
+///       std::make_tuple(separator, rtpConfig), std::make_tuple(rtpConfig), std::make_tuple());
+///   track->setMediaHandler(pipeline);
+///
+/// The pipeline is a MediaHandler itself, so further handlers may still be chained after it. Stages
+/// are not owned by a shared_ptr, so they must not rely on shared_from_this().
+template <typename... Stages> class MediaPipeline final : public MediaHandler {
+	static_assert(sizeof...(Stages) > 0, "A media pipeline needs at least one stage");
+	static_assert((std::is_base_of_v<MediaHandler, Stages> && ...),
+	              "Media pipeline stages must be media handlers");
+
+public:
+	static constexpr size_t StagesCount = sizeof...(Stages);
+
+	template <typename... Args,
+	          typename = std::enable_if_t<sizeof...(Args) == sizeof...(Stages)>>
+	explicit MediaPipeline(Args &&...args) : mStages(std::forward<Args>(args)...) {}
+
+	/// Access to a stage, for instance to read its state or change its settings
+	template <size_t I> auto &stage() { return std::get<I>(mStages).handler; }
+	template <size_t I> const auto &stage() const { return std::get<I>(mStages).handler; }
+
+	void media(const Description::Media &desc) override {
+		forEach([&](auto &handler) { callMedia(handler, desc); });
+	}
+
+	void incoming(message_vector &messages, const message_callback &send) override {
+		incomingStages(messages, send, std::make_index_sequence<StagesCount>());
+	}
+
+	void outgoing(message_vector &messages, const message_callback &send) override {
+		outgoingStages(messages, send, std::make_index_sequence<StagesCount>());
+	}
+
+	bool requestKeyframe(const message_callback &send) override {
+		bool handled = false;
+		forEach([&](auto &handler) {
+			if (!handled)
+				handled = callRequestKeyframe(handler, send);
+		});
+		return handled || MediaHandler::requestKeyframe(send);
+	}
+
+	bool requestBitrate(unsigned int bitrate, const message_callback &send) override {
+		bool handled = false;
+		forEach([&](auto &handler) {
+			if (!handled)
+				handled = callRequestBitrate(handler, bitrate, send);
+		});
+		return handled || MediaHandler::requestBitrate(bitrate, send);
+	}
+
+private:
+	// Constructs the stage in place, as handlers are neither copyable nor movable
+	template <typename Stage> struct Holder {
+		template <typename Tuple,
+		          typename = std::enable_if_t<!std::is_same_v<std::decay_t<Tuple>, Holder>>>
+		explicit Holder(Tuple &&args)
+		    : handler(std::make_from_tuple<Stage>(std::forward<Tuple>(args))) {}
+
+		Holder(const Holder &) = delete;
+		Holder &operator=(const Holder &) = delete;
+
+		Stage handler;
+	};
+
+	template <typename F> void forEach(F &&f) {
+		std::apply([&](auto &...holders) { (f(holders.handler), ...); }, mStages);
+	}
+
+	// Calls are qualified with the stage type so they are not dispatched virtually. The stage's
+	// own next handler, if any, is not followed: within a pipeline, order is given by Stages.
+	template <typename Stage>
+	static void callMedia(Stage &handler, const Description::Media &desc) {
+		handler.Stage::media(desc);
+	}
+
+	template <typename Stage>
+	static bool callRequestKeyframe(Stage &handler, const message_callback &send) {
+		return handler.Stage::requestKeyframe(send);
+	}
+
+	template <typename Stage>
+	static bool callRequestBitrate(Stage &handler, unsigned int bitrate,
+	                               const message_callback &send) {
+		return handler.Stage::requestBitrate(bitrate, send);
+	}
+
+	template <size_t... I>
+	void outgoingStages(message_vector &messages, const message_callback &send,
+	                    std::index_sequence<I...>) {
+		(outgoingStage<I>(messages, send), ...);
+	}
+
+	template <size_t... I>
+	void incomingStages(message_vector &messages, const message_callback &send,
+	                    std::index_sequence<I...>) {
+		(incomingStage<StagesCount - 1 - I>(messages, send), ...);
+	}
+
+	template <size_t I> void outgoingStage(message_vector &messages, const message_callback &send) {
+		using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+		std::get<I>(mStages).handler.Stage::outgoing(messages, send);
+	}
+
+	template <size_t I> void incomingStage(message_vector &messages, const message_callback &send) {
+		using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+		std::get<I>(mStages).handler.Stage::incoming(messages, send);
+	}
+
+	std::tuple<Holder<Stages>...> mStages;
+};
+
+} // namespace rtc
+
+#endif // RTC_MEDIA_PIPELINE_H
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_MEMORY_PLACEMENT_H
+#define RTC_MEMORY_PLACEMENT_H
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rtc {
+
+/// Where allocations are placed, honored by the ESP32 port and ignored elsewhere
+enum class MemoryClass : uint8_t {
+	Default = 0, // Follow the thread malloc target
+	Hot,         // Small state touched for every packet (crypto contexts, indexes): internal RAM
+	Bulk,        // Large buffers: PSRAM
+	Dma,         // Buffers handed to peripherals: DMA-capable internal RAM
+};
+
+/// Usage of a memory class, the hot and DMA classes are pools sized by their budget
+struct RTC_CPP_EXPORT MemoryClassUsage {
+	size_t budget = 0;    // Bytes reserved for the class, 0 if it has no pool
+	size_t used = 0;      // Bytes in use, including allocator overhead
+	size_t peak = 0;      // High watermark of used
+	size_t fallbacks = 0; // Allocations that exceeded the budget and were placed elsewhere
+};
+
+/// Places allocations made by the current thread in a memory class until destroyed, scopes nest
+/// Blocks keep their placement when freed or reallocated outside of the scope.
+class RTC_CPP_EXPORT MemoryPlacement final {
+public:
+	explicit MemoryPlacement(MemoryClass memoryClass);
+	~MemoryPlacement();
+
+	MemoryPlacement(const MemoryPlacement &) = delete;
+	MemoryPlacement &operator=(const MemoryPlacement &) = delete;
+
+	/// Sets the budget of the hot or DMA class, only effective before its first allocation
+	static void SetBudget(MemoryClass memoryClass, size_t budget);
+	static MemoryClassUsage Usage(MemoryClass memoryClass);
+
+private:
+	MemoryClass mPrevious;
+};
+
+} // namespace rtc
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_MEMORY_USAGE_H
+#define RTC_MEMORY_USAGE_H
+
+#include "common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtc {
+
+/// Subsystems that allocations made on behalf of a PeerConnection are attributed to
+enum class MemorySubsystem : uint8_t {
+	Other = 0, // Signaling, descriptions, callbacks
+	Ice,
+	Dtls,
+	Sctp,
+	Srtp,
+	Media, // Media handler chains and outgoing media queues
+	Nack,  // Packets retained for retransmission
+};
+
+inline constexpr size_t MemorySubsystemCount = 7;
+
+/// Heap usage of a PeerConnection, as measured by the allocator hooks
+/// Usage is only measured where the allocator reports it (the ESP32 port), elsewhere it stays
+/// zero and tracked is false.
+struct RTC_CPP_EXPORT MemoryUsage {
+	bool tracked = false;
+	size_t internal = 0;     // Bytes currently allocated in internal RAM
+	size_t external = 0;     // Bytes currently allocated in external RAM (PSRAM)
+	size_t internalPeak = 0; // High watermarks since the connection was created
+	size_t externalPeak = 0;
+	std::array<size_t, MemorySubsystemCount> subsystems = {}; // Current bytes by subsystem
+
+	size_t current() const { return internal + external; }
+	size_t operator[](MemorySubsystem subsystem) const {
+		return subsystems[static_cast<size_t>(subsystem)];
+	}
+};
+
+} // namespace rtc
+
+#endif
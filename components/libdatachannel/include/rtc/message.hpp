@@ -11,6 +11,7 @@
 
 #include "common.hpp"
 #include "frameinfo.hpp"
+#include "qos.hpp"
 #include "reliability.hpp"
 
 #include <functional>
@@ -32,8 +33,9 @@ struct RTC_CPP_EXPORT Message : binary {
 	Type type;
 	unsigned int stream = 0; // Stream id (SCTP stream or SSRC)
 	unsigned int dscp = 0;   // Differentiated Services Code Point
+	TrafficClass trafficClass = TrafficClass::Default;
 	shared_ptr<Reliability> reliability;
-	shared_ptr<FrameInfo> frameInfo;
+	optional<FrameInfo> frameInfo; // held by value, so a frame costs no extra allocation
 };
 
 using message_ptr = shared_ptr<Message>;
@@ -58,10 +60,18 @@ message_ptr make_message(Iterator begin, Iterator end, Message::Type type = Mess
 	return message;
 }
 
+template <typename Iterator>
+message_ptr make_message(Iterator begin, Iterator end, FrameInfo frameInfo) {
+	auto message = std::make_shared<Message>(begin, end);
+	message->frameInfo.emplace(std::move(frameInfo));
+	return message;
+}
+
 template <typename Iterator>
 message_ptr make_message(Iterator begin, Iterator end, shared_ptr<FrameInfo> frameInfo) {
 	auto message = std::make_shared<Message>(begin, end);
-	message->frameInfo = frameInfo;
+	if (frameInfo)
+		message->frameInfo.emplace(*frameInfo);
 	return message;
 }
 
@@ -71,7 +81,8 @@ template <typename Iterator>
                          unsigned int stream, shared_ptr<FrameInfo> frameInfo) {
 	auto message = std::make_shared<Message>(begin, end, type);
 	message->stream = stream;
-	message->frameInfo = frameInfo;
+	if (frameInfo)
+		message->frameInfo.emplace(*frameInfo);
 	return message;
 }
 
@@ -83,6 +94,8 @@ RTC_CPP_EXPORT message_ptr make_message(binary &&data, Message::Type type = Mess
                                         unsigned int stream = 0,
                                         shared_ptr<Reliability> reliability = nullptr);
 
+RTC_CPP_EXPORT message_ptr make_message(binary &&data, FrameInfo frameInfo);
+
 RTC_CPP_EXPORT message_ptr make_message(binary &&data, shared_ptr<FrameInfo> frameInfo);
 
 RTC_CPP_EXPORT message_ptr make_message(size_t size, message_ptr orig);
@@ -12,6 +12,7 @@
 #if RTC_ENABLE_MEDIA
 
 #include "common.hpp"
+#include "framearena.hpp"
 
 #include <vector>
 #include <cassert>
@@ -67,14 +68,25 @@ struct NalUnitFragmentA;
 
 /// NAL unit
 struct RTC_CPP_EXPORT NalUnit : binary {
+	/// Generates RTP payloads for NAL units: FU-A fragments for units larger than
+	/// maxFragmentSize and, if aggregate is set, STAP-A packets for runs of consecutive small
+	/// units (RFC 6184, packetization-mode=1).
 #ifdef ESP32_PORT
 	static psram_vector<binary> GenerateFragments(const psram_vector<NalUnit> &nalus,
-	                                             size_t maxFragmentSize);
+	                                             size_t maxFragmentSize, bool aggregate = false);
 #else
 	static std::vector<binary> GenerateFragments(const std::vector<NalUnit> &nalus,
-	                                             size_t maxFragmentSize);
+	                                             size_t maxFragmentSize, bool aggregate = false);
 #endif
 
+	/// Same packetization as GenerateFragments() without copying the NAL units: single units
+	/// and FU-A fragments point into the units, only STAP-A packets are assembled in arena.
+	/// @param nalus NAL units as slices of the frame (prefixes are ignored)
+	/// @param[out] payloads Generated payloads, valid as long as the frame and the arena
+	static void GeneratePayloads(const arena_vector<FramePayload> &nalus, size_t maxFragmentSize,
+	                             bool aggregate, FrameArena &arena,
+	                             arena_vector<FramePayload> &payloads);
+
 	enum class Separator {
 		Length = RTC_NAL_SEPARATOR_LENGTH, // first 4 bytes are NAL unit length
 		LongStartSequence = RTC_NAL_SEPARATOR_LONG_START_SEQUENCE,   // 0x00, 0x00, 0x00, 0x01
@@ -85,6 +97,44 @@ struct RTC_CPP_EXPORT NalUnit : binary {
 	static NalUnitStartSequenceMatch StartSequenceMatchSucc(NalUnitStartSequenceMatch match,
 	                                                 std::byte _byte, Separator separator);
 
+	/// Finds the next start sequence in an Annex-B buffer, scanning a word at a time.
+	/// @param data buffer to scan
+	/// @param size size of the buffer
+	/// @param from offset to start scanning from
+	/// @param separator start sequence separator (must not be Length)
+	/// @param[out] length length of the start sequence found (3 or 4)
+	/// @returns offset of the start sequence, or size if none was found
+	static size_t FindStartSequence(const byte *data, size_t size, size_t from,
+	                                Separator separator, size_t &length);
+
+	/// Calls func(begin, end) with the offsets of each NAL unit of an Annex-B frame.
+	/// Every start sequence in the frame is honored, so multi-slice frames are split correctly.
+	template <typename Func>
+	static void ForEachStartSequenceUnit(const binary &frame, Separator separator, Func &&func) {
+		size_t length = 0;
+		size_t index = FindStartSequence(frame.data(), frame.size(), 0, separator, length);
+		if (index == frame.size())
+			return;
+
+		size_t naluStartIndex = index + length;
+		while (naluStartIndex < frame.size()) {
+			size_t naluEndIndex =
+			    FindStartSequence(frame.data(), frame.size(), naluStartIndex, separator, length);
+			if (naluEndIndex > naluStartIndex)
+				func(naluStartIndex, naluEndIndex);
+
+			naluStartIndex = naluEndIndex + length;
+		}
+	}
+
+	/// Splits an Annex-B frame into NAL units, appending them to nalus.
+	template <typename Container>
+	static void SplitStartSequences(const binary &frame, Separator separator, Container &nalus) {
+		ForEachStartSequenceUnit(frame, separator, [&](size_t begin, size_t end) {
+			nalus.emplace_back(frame.begin() + begin, frame.begin() + end);
+		});
+	}
+
 	enum class Type { H264, H265 };
 
 	NalUnit(const NalUnit &unit) = default;
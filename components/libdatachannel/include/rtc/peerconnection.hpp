@@ -14,6 +14,8 @@
 #include "configuration.hpp"
 #include "datachannel.hpp"
 #include "description.hpp"
+#include "memoryusage.hpp"
+#include "qos.hpp"
 #include "reliability.hpp"
 #include "track.hpp"
 
@@ -33,6 +35,12 @@ struct RTC_CPP_EXPORT DataChannelInit {
 	bool negotiated = false;
 	optional<uint16_t> id = nullopt;
 	string protocol = "";
+
+	// Send scheduling: channels with a higher priority are served first, and channels sharing a
+	// priority get bandwidth in proportion to their weight.
+	// Priority values are those of RFC 8832: 128 below normal, 256 normal, 512 high, 1024 extra high
+	uint16_t priority = 256;
+	unsigned int weight = 1;
 };
 
 struct RTC_CPP_EXPORT LocalDescriptionInit {
@@ -130,6 +138,11 @@ public:
 	size_t bytesSent();
 	size_t bytesReceived();
 	optional<std::chrono::milliseconds> rtt();
+	optional<std::chrono::milliseconds> handshakeDuration(); // DTLS, once connected
+	QosStats qosStats(); // Outgoing datagrams by class and access category, and socket marking
+
+	// Heap usage, live and high watermarks, of this connection
+	MemoryUsage memoryUsage() const;
 };
 
 RTC_CPP_EXPORT std::ostream &operator<<(std::ostream &out, PeerConnection::State state);
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_QOS_H
+#define RTC_QOS_H
+
+#include "common.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace rtc {
+
+/// Class of an outgoing packet, it selects the DSCP value of the datagram
+enum class TrafficClass : uint8_t {
+	Default = 0,    // Resolved by the sender: RTCP, track media or DataChannel data
+	Audio,          // Audio RTP
+	Rtcp,           // RTCP reports and feedback
+	Retransmission, // RTP retransmitted after a NACK
+	KeyFrame,       // Video RTP of a keyframe
+	DeltaFrame,     // Video RTP of other frames
+	Control,        // DTLS handshake, SCTP control chunks and DataChannel establishment
+	Bulk            // DataChannel messages
+};
+
+const size_t TrafficClassCount = 8;
+
+/// Wi-Fi Multimedia access category, the 802.11 transmit queue
+enum class AccessCategory : uint8_t { Background = 0, BestEffort, Video, Voice };
+
+const size_t AccessCategoryCount = 4;
+
+/// Sets the DSCP value (0-63) of a class, for instance to match the policy of a managed network
+/// Defaults follow RFC 8837: EF for audio, AF41 for RTCP, retransmissions and keyframes, AF42 for
+/// other video frames, AF21 for control and AF11 for DataChannel data.
+RTC_CPP_EXPORT void SetTrafficClassDscp(TrafficClass trafficClass, unsigned int dscp);
+RTC_CPP_EXPORT unsigned int GetTrafficClassDscp(TrafficClass trafficClass);
+
+/// Access category of a DSCP value according to RFC 8325, as a standard access point or station
+/// maps it: EF, VA and CS6 to Voice, CS3-CS5, AF3x and AF4x to Video, CS1 to Background,
+/// others to Best Effort
+RTC_CPP_EXPORT AccessCategory DscpAccessCategory(unsigned int dscp);
+
+/// Counters of outgoing datagrams, see PeerConnection::qosStats()
+struct RTC_CPP_EXPORT QosStats {
+	std::array<size_t, TrafficClassCount> datagrams = {};         // Indexed by TrafficClass
+	std::array<size_t, AccessCategoryCount> accessCategory = {};   // Indexed by AccessCategory
+	size_t marked = 0;       // Datagrams with a DSCP value sent while the socket carried it
+	size_t unmarked = 0;     // Datagrams with a DSCP value the socket could not apply
+	size_t markUpdates = 0;  // Changes of the socket DS field
+	size_t markFailures = 0; // Changes rejected by the network stack
+};
+
+} // namespace rtc
+
+#endif
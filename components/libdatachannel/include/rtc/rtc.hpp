@@ -12,6 +12,9 @@
 // C++ API
 #include "common.hpp"
 #include "global.hpp"
+#include "heapprofiler.hpp"
+#include "memoryplacement.hpp"
+#include "qos.hpp"
 //
 #include "datachannel.hpp"
 #include "peerconnection.hpp"
@@ -36,6 +39,7 @@
 #include "h265rtppacketizer.hpp"
 #include "h265rtpdepacketizer.hpp"
 #include "mediahandler.hpp"
+#include "mediapipeline.hpp"
 #include "plihandler.hpp"
 #include "rembhandler.hpp"
 #include "pacinghandler.hpp"
@@ -44,5 +48,7 @@
 #include "rtcpsrreporter.hpp"
 #include "rtppacketizer.hpp"
 #include "rtpdepacketizer.hpp"
+#include "temporallayerselector.hpp"
+#include "transportcchandler.hpp"
 
 #endif // RTC_ENABLE_MEDIA
@@ -13,8 +13,8 @@
 
 #include "mediahandler.hpp"
 
-#include <queue>
-#include <unordered_map>
+#include <mutex>
+#include <vector>
 
 namespace rtc {
 
@@ -37,40 +37,26 @@ public:
 private:
 	// Packet storage
 	class RTC_CPP_EXPORT Storage {
-
-		/// Packet storage element
-		struct RTC_CPP_EXPORT Element {
-			Element(message_ptr packet, uint16_t sequenceNumber, shared_ptr<Element> next = nullptr);
-			const message_ptr packet;
-			const uint16_t sequenceNumber;
-			/// Pointer to newer element
-			shared_ptr<Element> next = nullptr;
+	private:
+		/// Slot of the ring, indexed by sequence number modulo its size
+		struct Slot {
+			message_ptr packet;
+			uint16_t sequenceNumber = 0;
 		};
 
-	private:
-		/// Oldest packet in storage
-		shared_ptr<Element> oldest = nullptr;
-		/// Newest packet in storage
-		shared_ptr<Element> newest = nullptr;
-		/// Inner storage
-		std::unordered_map<uint16_t, shared_ptr<Element>> storage{};
+		/// Inner storage, allocated once so storing a packet never allocates
+		std::vector<Slot> slots;
 		std::mutex mutex;
 
-		/// Maximum storage size
-		const size_t maxSize;
-
-		/// Returns current size
-		size_t size();
-
 	public:
-		Storage(size_t _maxSize);
+		Storage(size_t maxSize);
 
 		/// Returns packet with given sequence number
 		message_ptr get(uint16_t sequenceNumber);
 
-		/// Stores packet
-		/// @param packet Packet
-		void store(message_ptr packet);
+		/// Stores the RTP packets of a batch, replacing the packets sent maxSize sequence numbers
+		/// earlier
+		void store(const message_vector &packets);
 	};
 
 	const shared_ptr<Storage> mStorage;
@@ -44,6 +44,12 @@ struct RTC_CPP_EXPORT RtpExtensionHeader {
 	size_t writeTwoByteHeader(size_t offset, uint8_t id, const byte *value, size_t size);
 	size_t writeHeader(bool twoByteHeader, size_t offset, uint8_t id, const byte *value,
 	                   size_t size);
+
+	/// Finds an extension element (RFC 8285), the caller must have checked the header fits
+	/// @param id Extension id
+	/// @param[out] size Size of the element value
+	/// @returns Pointer to the element value, or nullptr if absent
+	[[nodiscard]] byte *findHeader(uint8_t id, size_t &size);
 };
 
 struct RTC_CPP_EXPORT RtpHeader {
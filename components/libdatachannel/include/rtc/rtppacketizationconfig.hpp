@@ -14,6 +14,8 @@
 #include "dependencydescriptor.hpp"
 #include "rtp.hpp"
 
+#include <chrono>
+
 namespace rtc {
 
 // RTP configuration used in packetization process
@@ -74,6 +76,18 @@ public:
 	uint16_t playoutDelayMin = 0;
 	uint16_t playoutDelayMax = 0;
 
+	// Transport-wide sequence number and abs-send-time extension headers
+	// The packetizer only reserves them, values are written by the transport when the packet is
+	// actually sent, so they must match the extmap ids in the track description.
+	uint8_t transportSequenceNumberId = 0;
+	uint8_t absSendTimeId = 0;
+
+	// Local time of frame timestamp zero, for tracks whose frame timestamps (in seconds) come
+	// from a capture clock shared with other tracks. Sender reports then carry the RTP timestamp
+	// of the instant they are sent instead of the one of the last packet, which is late by the
+	// capture to send delay of its track, so that receivers can synchronize the tracks.
+	optional<std::chrono::steady_clock::time_point> timestampOrigin;
+
 	/// Construct RTP configuration used in packetization process
 	/// @param ssrc SSRC of source
 	/// @param cname CNAME of source
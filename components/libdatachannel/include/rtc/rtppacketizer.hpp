@@ -11,6 +11,7 @@
 
 #if RTC_ENABLE_MEDIA
 
+#include "framearena.hpp"
 #include "mediahandler.hpp"
 #include "message.hpp"
 #include "rtppacketizationconfig.hpp"
@@ -39,6 +40,9 @@ public:
 	/// RTP packetization config
 	const shared_ptr<RtpPacketizationConfig> rtpConfig;
 
+	/// Arena for per-frame temporaries, to check that it stopped growing
+	const FrameArena &arena() const { return mArena; }
+
 protected:
 	/// Fragment data into payloads
 	/// Default implementation returns data as a single payload
@@ -49,11 +53,22 @@ protected:
 	virtual std::vector<binary> fragment(binary data);
 #endif
 
+	/// Describe the payloads for a frame without copying it
+	/// Payloads may point into data or into memory from frameArena(), which stay valid until the
+	/// frame is packetized. Default implementation forwards to fragment().
+	/// @param data Input data, may be moved from
+	/// @param[out] payloads Payloads to packetize
+	virtual void fragmentPayloads(binary &data, arena_vector<FramePayload> &payloads);
+
 	/// Creates an RTP packet for a payload
 	/// @note This function increases the sequence number.
 	/// @param payload RTP payload
 	/// @param mark Set marker flag in RTP packet if true
 	virtual message_ptr packetize(const binary &payload, bool mark);
+	message_ptr packetize(const FramePayload &payload, bool mark);
+
+	/// Arena for per-frame temporaries, reset after each outgoing() call
+	FrameArena &frameArena() { return mArena; }
 
 	// For backward compatibility, do not use
 	[[deprecated]] virtual message_ptr packetize(shared_ptr<binary> payload, bool mark);
@@ -61,6 +76,45 @@ protected:
 private:
 	static const auto RtpHeaderSize = 12;
 	static const auto RtpExtHeaderCvoSize = 8;
+
+	// RTP header with extensions compiled from the config, so a packet header is a copy plus
+	// sequence number, timestamp and dependency descriptor
+	struct HeaderTemplate {
+		bool matches(const RtpPacketizationConfig &config, size_t ddSize) const;
+
+		bool valid = false;
+		uint8_t payloadType = 0;
+		SSRC ssrc = 0;
+		uint8_t videoOrientationId = 0;
+		uint8_t videoOrientation = 0;
+		uint8_t midId = 0;
+		optional<std::string> mid;
+		uint8_t ridId = 0;
+		optional<std::string> rid;
+		uint8_t dependencyDescriptorId = 0;
+		size_t ddSize = 0;   // 0 if there is no dependency descriptor
+		size_t ddOffset = 0; // 0 if no dependency descriptor is written
+		uint8_t playoutDelayId = 0;
+		uint16_t playoutDelayMin = 0;
+		uint16_t playoutDelayMax = 0;
+		uint8_t transportSequenceNumberId = 0;
+		uint8_t absSendTimeId = 0;
+
+		binary bytes;
+	};
+
+	void compileHeaderTemplate(HeaderTemplate &header, bool mark, size_t ddSize);
+
+	HeaderTemplate mHeaderTemplates[2]; // Indexed by marker bit
+
+	// Scratch storage reused from frame to frame
+	FrameArena mArena;
+	message_vector mPackets;
+#ifdef ESP32_PORT
+	psram_vector<binary> mFragments;
+#else
+	std::vector<binary> mFragments;
+#endif
 };
 
 // Generic audio RTP packetizer
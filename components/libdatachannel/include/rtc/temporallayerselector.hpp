@@ -0,0 +1,50 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_TEMPORAL_LAYER_SELECTOR_H
+#define RTC_TEMPORAL_LAYER_SELECTOR_H
+
+#if RTC_ENABLE_MEDIA
+
+#include "mediahandler.hpp"
+#include "rtppacketizationconfig.hpp"
+
+#include <atomic>
+
+namespace rtc {
+
+/// Skips frames of upper temporal layers for a track, to lower its frame rate without breaking
+/// decoding. It must come before the packetizer, so that sequence numbers have no gap.
+/// Frames are selected by FrameInfo::temporalLayer. If the packetizer config has a dependency
+/// descriptor context with temporal layers, active decode targets are signalled to the receiver.
+class RTC_CPP_EXPORT TemporalLayerSelector final : public MediaHandler {
+public:
+	TemporalLayerSelector(shared_ptr<RtpPacketizationConfig> rtpConfig = nullptr);
+
+	/// Sets the highest temporal layer sent, it takes effect on the next frame
+	/// With L1T3, 2 sends every frame, 1 half of them and 0 a quarter of them.
+	void setMaxTemporalLayer(uint8_t layer);
+	uint8_t maxTemporalLayer() const;
+
+	/// Number of frames skipped
+	size_t skippedFrames() const;
+
+	void outgoing(message_vector &messages, const message_callback &send) override;
+
+private:
+	const shared_ptr<RtpPacketizationConfig> mRtpConfig;
+	std::atomic<uint8_t> mMaxTemporalLayer = 255;
+	std::atomic<size_t> mSkippedFrames = 0;
+	bool mBitmaskSignalled = false; // Only accessed on the sending thread
+};
+
+} // namespace rtc
+
+#endif // RTC_ENABLE_MEDIA
+
+#endif // RTC_TEMPORAL_LAYER_SELECTOR_H
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_TRANSPORT_CC_HANDLER_H
+#define RTC_TRANSPORT_CC_HANDLER_H
+
+#if RTC_ENABLE_MEDIA
+
+#include "mediahandler.hpp"
+#include "rtp.hpp"
+#include "utils.hpp"
+
+#include <vector>
+
+namespace rtc {
+
+/// Transport-wide congestion control feedback
+/// See https://datatracker.ietf.org/doc/html/draft-holmer-rmcat-transport-wide-cc-extensions-01
+struct RTC_CPP_EXPORT TransportFeedback {
+	struct Packet {
+		uint16_t sequenceNumber = 0;
+		bool received = false;
+		int64_t arrivalTimeUs = 0; // Receiver clock, only meaningful if received
+	};
+
+	SSRC senderSsrc = 0;
+	SSRC mediaSsrc = 0;
+	uint16_t baseSequenceNumber = 0;
+	int64_t referenceTimeUs = 0; // Multiple of 64ms
+	uint8_t feedbackCount = 0;
+	std::vector<Packet> packets; // Consecutive sequence numbers from baseSequenceNumber
+
+	/// Parses a single RTCP transport feedback packet (RTPFB, FMT 15)
+	/// @returns The feedback, or nullopt if the packet is not a valid transport feedback
+	static optional<TransportFeedback> Parse(const byte *data, size_t size);
+
+	/// Serializes to an RTCP transport feedback packet
+	/// Throws std::invalid_argument if an arrival time delta does not fit the wire format.
+	binary serialize() const;
+};
+
+/// Reports transport-wide congestion control feedback sent by the receiver.
+/// Set it as the PeerConnection media handler, as feedback covers all tracks of the transport.
+class RTC_CPP_EXPORT TransportCcHandler final : public MediaHandler {
+	rtc::synchronized_callback<const TransportFeedback &> mOnFeedback;
+
+public:
+	/// Constructs the handler
+	/// @param onFeedback The callback that gets called with each feedback packet
+	TransportCcHandler(std::function<void(const TransportFeedback &)> onFeedback);
+
+	void incoming(message_vector &messages, const message_callback &send) override;
+};
+
+} // namespace rtc
+
+#endif // RTC_ENABLE_MEDIA
+
+#endif // RTC_TRANSPORT_CC_HANDLER_H
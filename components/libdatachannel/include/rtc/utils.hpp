@@ -9,6 +9,9 @@
 #ifndef RTC_UTILS_H
 #define RTC_UTILS_H
 
+#include "common.hpp"
+
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -49,83 +52,152 @@ private:
 	std::function<void()> function;
 };
 
+namespace impl {
+
+// Epoch guard for callback invocations, see impl/epoch.hpp
+class RTC_CPP_EXPORT CallbackGuard final {
+public:
+	CallbackGuard();
+	~CallbackGuard();
+
+	CallbackGuard(const CallbackGuard &) = delete;
+	CallbackGuard &operator=(const CallbackGuard &) = delete;
+};
+
+// Waits for invocations of an unpublished callback on other threads, then deletes it, or retires
+// it if it might still be running
+RTC_CPP_EXPORT void ReleaseCallback(void *ptr, void (*deleter)(void *));
+
+} // namespace impl
+
 // callback with built-in synchronization
+// The function is published atomically and invoked inside an epoch guard, with no lock. Setting
+// or resetting the callback waits for the invocations running on other threads, and a callback
+// may set or reset itself. Unlike a lock, it does not serialize invocations from several threads.
 template <typename... Args> class synchronized_callback {
 public:
+	using function_type = std::function<void(Args...)>;
+
 	synchronized_callback() = default;
 	synchronized_callback(synchronized_callback &&cb) { *this = std::move(cb); }
 	synchronized_callback(const synchronized_callback &cb) { *this = cb; }
-	synchronized_callback(std::function<void(Args...)> func) { *this = std::move(func); }
+	synchronized_callback(function_type func) { *this = std::move(func); }
 	virtual ~synchronized_callback() { *this = nullptr; }
 
 	synchronized_callback &operator=(synchronized_callback &&cb) {
-		std::scoped_lock lock(mutex, cb.mutex);
-		set(std::exchange(cb.callback, nullptr));
+		if (&cb == this)
+			return *this;
+
+		// The function might be running on other threads, so it is copied, then reset in cb
+		set(cb.get());
+		cb.set(nullptr);
 		return *this;
 	}
 
 	synchronized_callback &operator=(const synchronized_callback &cb) {
-		std::scoped_lock lock(mutex, cb.mutex);
-		set(cb.callback);
+		set(cb.get());
 		return *this;
 	}
 
-	synchronized_callback &operator=(std::function<void(Args...)> func) {
-		std::lock_guard lock(mutex);
+	synchronized_callback &operator=(function_type func) {
 		set(std::move(func));
 		return *this;
 	}
 
-	bool operator()(Args... args) const {
-		std::lock_guard lock(mutex);
-		return call(std::move(args)...);
-	}
+	bool operator()(Args... args) const { return call(std::move(args)...); }
 
-	operator bool() const {
-		std::lock_guard lock(mutex);
-		return callback ? true : false;
-	}
+	operator bool() const { return callback.load() != nullptr; }
 
 protected:
-	virtual void set(std::function<void(Args...)> func) { callback = std::move(func); }
+	virtual void set(function_type func) {
+		auto published = func ? new function_type(std::move(func)) : nullptr;
+		if (auto previous = callback.exchange(published))
+			impl::ReleaseCallback(previous, [](void *p) { delete static_cast<function_type *>(p); });
+	}
+
 	virtual bool call(Args... args) const {
-		if (!callback)
+		if (!callback.load(std::memory_order_relaxed))
+			return false; // unset callbacks need no guard
+
+		impl::CallbackGuard guard;
+		auto func = callback.load(std::memory_order_acquire);
+		if (!func)
 			return false;
 
-		callback(std::move(args)...);
+		(*func)(std::move(args)...);
 		return true;
 	}
 
-	std::function<void(Args...)> callback;
-	mutable std::recursive_mutex mutex;
+	function_type get() const {
+		impl::CallbackGuard guard;
+		auto func = callback.load(std::memory_order_acquire);
+		return func ? *func : nullptr;
+	}
+
+	std::atomic<function_type *> callback = nullptr;
 };
 
 // callback with built-in synchronization and replay of the last missed call
 template <typename... Args>
 class synchronized_stored_callback final : public synchronized_callback<Args...> {
 public:
+	using function_type = typename synchronized_callback<Args...>::function_type;
+
 	template <typename... CArgs>
 	synchronized_stored_callback(CArgs &&...cargs)
 	    : synchronized_callback<Args...>(std::forward<CArgs>(cargs)...) {}
 	~synchronized_stored_callback() {}
 
+	synchronized_stored_callback &operator=(synchronized_stored_callback &&cb) {
+		if (&cb == this)
+			return *this;
+
+		synchronized_callback<Args...>::operator=(std::move(cb));
+		std::scoped_lock lock(storedMutex, cb.storedMutex);
+		stored = std::exchange(cb.stored, std::nullopt);
+		return *this;
+	}
+
+	synchronized_stored_callback &operator=(const synchronized_stored_callback &cb) {
+		if (&cb == this)
+			return *this;
+
+		synchronized_callback<Args...>::operator=(cb);
+		std::scoped_lock lock(storedMutex, cb.storedMutex);
+		stored = cb.stored;
+		return *this;
+	}
+
 private:
-	void set(std::function<void(Args...)> func) {
+	void set(function_type func) override {
 		synchronized_callback<Args...>::set(func);
-		if (func && stored) {
-			std::apply(func, std::move(*stored));
-			stored.reset();
+		if (!func)
+			return;
+
+		std::optional<std::tuple<Args...>> missed;
+		{
+			std::lock_guard lock(storedMutex);
+			std::swap(missed, stored);
 		}
+		if (missed)
+			std::apply(func, std::move(*missed));
 	}
 
-	bool call(Args... args) const {
-		if (!synchronized_callback<Args...>::call(args...))
-			stored.emplace(std::move(args)...);
-
+	bool call(Args... args) const override {
+		// set() publishes the function before taking the missed call, so check again under the
+		// lock, which is only taken while no function is set
+		while (!synchronized_callback<Args...>::call(args...)) {
+			std::lock_guard lock(storedMutex);
+			if (!this->callback.load()) {
+				stored.emplace(std::move(args)...);
+				break;
+			}
+		}
 		return true;
 	}
 
 	mutable std::optional<std::tuple<Args...>> stored;
+	mutable std::mutex storedMutex;
 };
 
 // pimpl base class
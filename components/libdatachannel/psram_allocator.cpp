@@ -6,10 +6,23 @@
 #include <esp_log.h>
 #include <esp_system.h>
 #include <esp_debug_helpers.h>
+#include <esp_memory_utils.h>
+#include <multi_heap.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <new>
 
+#include "esp32_psram_init.h"
+
+#include "impl/heapprofiler.hpp"
+#include "memorytracker.hpp"
+
+using rtc::impl::HeapProfiler;
+using rtc::impl::MemoryTracker;
+
 static const char* TAG = "rtc_psram";
 
 // FreeRTOS TLS index for malloc target
@@ -23,11 +36,43 @@ static const char* TAG = "rtc_psram";
 struct tls_caps_data {
     uint32_t magic;
     uint32_t caps;
+    uint32_t memory_tag;  // Connection and subsystem allocations are accounted to, 0 if none
+    uint32_t mem_class;   // esp32_mem_class_t, ESP32_MEM_DEFAULT to follow caps
 };
 
 // Global default malloc target (starts as INTERNAL for early boot, switched to PSRAM later)
 static uint32_t g_default_malloc_target = MALLOC_CAP_INTERNAL;
 
+// Default budgets of the pooled allocation classes
+// The hot pool holds the SRTP contexts and NACK indexes of the first viewers, later ones spill to
+// PSRAM. Nothing is placed in the DMA class by default, so its pool is only carved on demand.
+#ifndef ESP32_HOT_POOL_SIZE
+#define ESP32_HOT_POOL_SIZE (48 * 1024)
+#endif
+#ifndef ESP32_DMA_POOL_SIZE
+#define ESP32_DMA_POOL_SIZE (16 * 1024)
+#endif
+
+// Dedicated internal RAM pool of an allocation class, carved on first use
+// Pools never grow: their size is the class budget, and blocks are recognized by address on free.
+struct mem_pool {
+    const char* name;
+    uint32_t caps;        // Where the pool is carved from
+    uint32_t spill_caps;  // Where allocations go once the pool is full, 0 for the task target
+    size_t budget;
+    std::atomic<multi_heap_handle_t> heap{nullptr};
+    uintptr_t start = 0;  // Valid once heap is set
+    uintptr_t end = 0;
+    bool failed = false;
+    std::atomic<size_t> fallbacks{0};
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;  // multi_heap does no locking of its own
+};
+
+static mem_pool g_hot_pool = {"hot", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, 0, ESP32_HOT_POOL_SIZE};
+static mem_pool g_dma_pool = {"DMA", MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL,
+                              MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL, ESP32_DMA_POOL_SIZE};
+static portMUX_TYPE g_pools_lock = portMUX_INITIALIZER_UNLOCKED;
+
 extern "C" {
 
 // TLS deletion callback - called when task is deleted to free our TLS structure
@@ -40,54 +85,289 @@ static void tls_caps_delete_callback(int index, void* data) {
     }
 }
 
-// Get current task's malloc target capability flags
-uint32_t get_malloc_target() {
+// Get current task's TLS structure, or NULL if the task has none (or no scheduler yet)
+static struct tls_caps_data* get_task_tls_data() {
     TaskHandle_t task = xTaskGetCurrentTaskHandle();
     if (!task) {
-        // No scheduler yet (early boot) - use global default
-        return g_default_malloc_target;
+        return NULL;
     }
 
     void* tls_value = pvTaskGetThreadLocalStoragePointer(task, MALLOC_TARGET_TLS_INDEX);
     if (tls_value == NULL) {
-        // Task hasn't set a preference - use global default
-        return g_default_malloc_target;
+        return NULL;
     }
 
     // Verify it's actually our data (not some other component's data)
     struct tls_caps_data* data = (struct tls_caps_data*)tls_value;
     if (data->magic != TLS_CAPS_MAGIC) {
-        // TLS slot contains something else, use global default
-        return g_default_malloc_target;
+        return NULL;
     }
 
-    return data->caps;
+    return data;
 }
 
-// Set current task's malloc target capability flags
-void set_task_malloc_target(uint32_t caps) {
+// Get or create current task's TLS structure
+static struct tls_caps_data* ensure_task_tls_data() {
     TaskHandle_t task = xTaskGetCurrentTaskHandle();
     if (!task) {
-        return;
+        return NULL;
     }
 
-    void* tls_value = pvTaskGetThreadLocalStoragePointer(task, MALLOC_TARGET_TLS_INDEX);
-    struct tls_caps_data* data = (struct tls_caps_data*)tls_value;
-
-    // Check if we need to allocate TLS structure
-    if (!data || data->magic != TLS_CAPS_MAGIC) {
+    struct tls_caps_data* data = get_task_tls_data();
+    if (!data) {
         // Allocate from internal RAM to avoid recursion (we're inside malloc override!)
         data = (struct tls_caps_data*)heap_caps_malloc(sizeof(struct tls_caps_data), MALLOC_CAP_INTERNAL);
         if (!data) {
-            return; // Allocation failed, can't set TLS
+            return NULL; // Allocation failed, can't set TLS
         }
         data->magic = TLS_CAPS_MAGIC;
+        data->caps = 0;  // No preference, follow the global default
+        data->memory_tag = 0;
+        data->mem_class = ESP32_MEM_DEFAULT;
 
         // Set TLS with deletion callback (automatically frees when task dies)
         vTaskSetThreadLocalStoragePointerAndDelCallback(task, MALLOC_TARGET_TLS_INDEX, data, tls_caps_delete_callback);
     }
 
-    data->caps = caps;
+    return data;
+}
+
+// Malloc target of a task, given its TLS structure
+static inline uint32_t target_caps(const struct tls_caps_data* data) {
+    if (data && data->mem_class == ESP32_MEM_BULK) {
+        return MALLOC_CAP_SPIRAM;
+    }
+    // Tasks without a preference (or early boot) use the global default
+    return (data && data->caps) ? data->caps : g_default_malloc_target;
+}
+
+// Get current task's malloc target capability flags
+uint32_t get_malloc_target() {
+    return target_caps(get_task_tls_data());
+}
+
+// Set current task's malloc target capability flags
+void set_task_malloc_target(uint32_t caps) {
+    struct tls_caps_data* data = ensure_task_tls_data();
+    if (data) {
+        data->caps = caps;
+    }
+}
+
+// Get current task's memory accounting tag
+uint32_t esp32_get_task_memory_tag() {
+    struct tls_caps_data* data = get_task_tls_data();
+    return data ? data->memory_tag : 0;
+}
+
+// Set current task's memory accounting tag
+void esp32_set_task_memory_tag(uint32_t tag) {
+    // Clearing a tag must not allocate
+    struct tls_caps_data* data = tag ? ensure_task_tls_data() : get_task_tls_data();
+    if (data) {
+        data->memory_tag = tag;
+    }
+}
+
+// Get current task's allocation class
+esp32_mem_class_t esp32_get_task_mem_class() {
+    struct tls_caps_data* data = get_task_tls_data();
+    return data ? (esp32_mem_class_t)data->mem_class : ESP32_MEM_DEFAULT;
+}
+
+// Set current task's allocation class
+void esp32_set_task_mem_class(esp32_mem_class_t mem_class) {
+    // Going back to the default must not allocate
+    struct tls_caps_data* data =
+        mem_class != ESP32_MEM_DEFAULT ? ensure_task_tls_data() : get_task_tls_data();
+    if (data) {
+        data->mem_class = mem_class;
+    }
+}
+
+static mem_pool* class_pool(uint32_t mem_class) {
+    switch (mem_class) {
+    case ESP32_MEM_HOT:
+        return &g_hot_pool;
+    case ESP32_MEM_DMA:
+        return &g_dma_pool;
+    default:
+        return NULL;
+    }
+}
+
+// Pool a block was allocated from, if any
+static inline mem_pool* pool_of(const void* ptr) {
+    uintptr_t address = (uintptr_t)ptr;
+    for (mem_pool* pool : {&g_hot_pool, &g_dma_pool}) {
+        if (pool->heap.load(std::memory_order_acquire) && address >= pool->start &&
+            address < pool->end) {
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+// Get the pool heap, carving it on first use
+static multi_heap_handle_t pool_heap(mem_pool* pool) {
+    multi_heap_handle_t heap = pool->heap.load(std::memory_order_acquire);
+    if (heap || pool->failed || pool->budget == 0) {
+        return heap;
+    }
+
+    // heap_caps_malloc is not wrapped, so this does not recurse
+    void* region = heap_caps_malloc(pool->budget, pool->caps);
+    multi_heap_handle_t created = region ? multi_heap_register(region, pool->budget) : NULL;
+    if (created) {
+        multi_heap_set_lock(created, &pool->lock);
+    }
+
+    portENTER_CRITICAL_SAFE(&g_pools_lock);
+    heap = pool->heap.load(std::memory_order_relaxed);
+    bool installed = !heap && created;
+    if (installed) {
+        pool->start = (uintptr_t)region;
+        pool->end = pool->start + pool->budget;
+        pool->heap.store(created, std::memory_order_release);
+        heap = created;
+    } else if (!heap) {
+        pool->failed = true;  // Don't retry on every allocation
+    }
+    portEXIT_CRITICAL_SAFE(&g_pools_lock);
+
+    if (!installed && region) {
+        heap_caps_free(region);
+    }
+    return heap;
+}
+
+static inline void* caps_alloc(size_t size, size_t align, uint32_t caps) {
+    return align ? heap_caps_aligned_alloc(align, size, caps) : heap_caps_malloc(size, caps);
+}
+
+// Allocate in a pooled class, spilling once its budget is exhausted
+static void* pool_alloc(mem_pool* pool, size_t size, size_t align, uint32_t caps) {
+    void* ptr = NULL;
+    if (multi_heap_handle_t heap = pool_heap(pool)) {
+        ptr = align ? multi_heap_aligned_alloc(heap, size, align) : multi_heap_malloc(heap, size);
+    }
+    if (!ptr && size > 0) {
+        pool->fallbacks.fetch_add(1, std::memory_order_relaxed);
+        ptr = caps_alloc(size, align, pool->spill_caps ? pool->spill_caps : caps);
+    }
+    return ptr;
+}
+
+// Reallocate a pool block, moving it out of the pool if it cannot grow in place
+static void* pool_realloc(mem_pool* pool, void* ptr, size_t size, uint32_t caps) {
+    multi_heap_handle_t heap = pool->heap.load(std::memory_order_relaxed);
+    if (size == 0) {
+        multi_heap_free(heap, ptr);
+        return NULL;
+    }
+
+    void* new_ptr = multi_heap_realloc(heap, ptr, size);
+    if (new_ptr) {
+        return new_ptr;
+    }
+
+    pool->fallbacks.fetch_add(1, std::memory_order_relaxed);
+    new_ptr = heap_caps_malloc(size, pool->spill_caps ? pool->spill_caps : caps);
+    if (!new_ptr) {
+        new_ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL);
+    }
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, std::min(size, multi_heap_get_allocated_size(heap, ptr)));
+        multi_heap_free(heap, ptr);
+    }
+    return new_ptr;
+}
+
+// Free a block wherever it was allocated
+static inline void raw_free(void* ptr) {
+    if (mem_pool* pool = pool_of(ptr)) {
+        multi_heap_free(pool->heap.load(std::memory_order_relaxed), ptr);
+    } else {
+        heap_caps_free(ptr);
+    }
+}
+
+void esp32_mem_class_set_budget(esp32_mem_class_t mem_class, size_t budget) {
+    mem_pool* pool = class_pool(mem_class);
+    if (!pool) {
+        return;
+    }
+    if (pool->heap.load(std::memory_order_acquire)) {
+        ESP_LOGW(TAG, "%s pool already in use, budget left at %zu bytes", pool->name, pool->budget);
+        return;
+    }
+    pool->budget = budget;
+    pool->failed = false;
+}
+
+void esp32_mem_class_get_stats(esp32_mem_class_t mem_class, esp32_mem_class_stats_t* stats) {
+    *stats = esp32_mem_class_stats_t{};
+    mem_pool* pool = class_pool(mem_class);
+    if (!pool) {
+        return;
+    }
+    stats->budget = pool->budget;
+    stats->fallbacks = pool->fallbacks.load(std::memory_order_relaxed);
+    if (multi_heap_handle_t heap = pool->heap.load(std::memory_order_acquire)) {
+        stats->used = pool->budget - multi_heap_free_size(heap);
+        stats->peak = pool->budget - multi_heap_minimum_free_size(heap);
+    }
+}
+
+// Report an allocation to per-connection accounting and to the heap profiler
+static inline void track_alloc(void* ptr, size_t size) {
+    MemoryTracker::Allocated(ptr, size, ptr && !esp_ptr_external_ram(ptr));
+    HeapProfiler::Allocated(ptr, size);
+}
+
+static inline void track_realloc(void* ptr, void* new_ptr, size_t size) {
+    MemoryTracker::Reallocated(ptr, new_ptr, size, new_ptr && !esp_ptr_external_ram(new_ptr));
+    HeapProfiler::Reallocated(ptr, new_ptr, size);
+}
+
+// Free and credit back the connection the block was accounted to
+static inline void tracked_free(void* ptr) {
+    MemoryTracker::Freed(ptr);
+    HeapProfiler::Freed(ptr);
+    raw_free(ptr);
+}
+
+// Debug: count internal RAM allocations and total malloc calls
+static int g_internal_alloc_count = 0;
+static size_t g_internal_alloc_bytes = 0;
+static int g_malloc_call_count = 0;
+
+// Allocate for the current task, honoring its allocation class, then its malloc target
+static void* placed_alloc(size_t size, size_t align) {
+    struct tls_caps_data* data = get_task_tls_data();
+    uint32_t caps = target_caps(data);
+    mem_pool* pool = data ? class_pool(data->mem_class) : NULL;
+    void* ptr = pool ? pool_alloc(pool, size, align, caps) : caps_alloc(size, align, caps);
+    if (!ptr && caps != MALLOC_CAP_INTERNAL) {
+        // Fallback to internal RAM if target heap fails
+        ptr = caps_alloc(size, align, MALLOC_CAP_INTERNAL);
+        if (ptr && g_default_malloc_target == MALLOC_CAP_SPIRAM) {
+            // Count fallbacks
+            g_internal_alloc_count++;
+            g_internal_alloc_bytes += size;
+        }
+    }
+
+    track_alloc(ptr, size);
+    return ptr;
+}
+
+void* esp32_mem_class_alloc(esp32_mem_class_t mem_class, size_t size) {
+    uint32_t caps = mem_class == ESP32_MEM_BULK ? MALLOC_CAP_SPIRAM : get_malloc_target();
+    mem_pool* pool = class_pool(mem_class);
+    void* ptr = pool ? pool_alloc(pool, size, 0, caps) : heap_caps_malloc(size, caps);
+    track_alloc(ptr, size);
+    return ptr;
 }
 
 // Enable PSRAM as default malloc target (called after PSRAM is initialized)
@@ -103,11 +383,12 @@ void* esp32_psram_malloc(size_t size) {
         // Fallback to internal RAM if PSRAM allocation fails
         ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL);
     }
+    track_alloc(ptr, size);
     return ptr;
 }
 
 void esp32_psram_free(void* ptr) {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 void* esp32_psram_calloc(size_t n, size_t size) {
@@ -115,63 +396,77 @@ void* esp32_psram_calloc(size_t n, size_t size) {
     if (!ptr) {
         ptr = heap_caps_calloc(n, size, MALLOC_CAP_INTERNAL);
     }
+    track_alloc(ptr, n * size);
     return ptr;
 }
 
 void* esp32_psram_realloc(void* ptr, size_t size) {
-    // Try PSRAM first
-    void* new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM);
-    if (!new_ptr && size > 0) {
-        // Fallback to internal
-        new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL);
+    void* new_ptr;
+    if (mem_pool* pool = pool_of(ptr)) {
+        new_ptr = pool_realloc(pool, ptr, size, MALLOC_CAP_SPIRAM);
+    } else {
+        // Try PSRAM first
+        new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM);
+        if (!new_ptr && size > 0) {
+            // Fallback to internal
+            new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL);
+        }
     }
+    track_realloc(ptr, new_ptr, size);
     return new_ptr;
 }
 
-// Debug: count internal RAM allocations and total malloc calls
-static int g_internal_alloc_count = 0;
-static size_t g_internal_alloc_bytes = 0;
-static int g_malloc_call_count = 0;
+// PSRAM-only buffers (rtc::binary and other PSRAMAllocator containers)
+void* esp32_psram_buffer_alloc(size_t size) {
+    void* ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    track_alloc(ptr, size);
+    return ptr;
+}
+
+void esp32_psram_buffer_free(void* ptr) {
+    tracked_free(ptr);
+}
 
 // Global malloc override - uses FreeRTOS TLS to allow per-task control
 // This intercepts STL allocations (std::make_shared, etc.) which call malloc directly
 // Using __wrap_ prefix for linker --wrap mechanism
 void* __wrap_malloc(size_t size) {
     g_malloc_call_count++;
-    uint32_t caps = get_malloc_target();
-    void* ptr = heap_caps_malloc(size, caps);
-    if (!ptr && caps != MALLOC_CAP_INTERNAL) {
-        // Fallback to internal RAM if target heap fails
-        ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL);
-        if (ptr && g_default_malloc_target == MALLOC_CAP_SPIRAM) {
-            // Count fallbacks
-            g_internal_alloc_count++;
-            g_internal_alloc_bytes += size;
-        }
-    }
-
-    return ptr;
+    return placed_alloc(size, 0);
 }
 
 void __wrap_free(void* ptr) {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 void* __wrap_calloc(size_t n, size_t size) {
-    uint32_t caps = get_malloc_target();
-    void* ptr = heap_caps_calloc(n, size, caps);
-    if (!ptr && caps != MALLOC_CAP_INTERNAL) {
-        ptr = heap_caps_calloc(n, size, MALLOC_CAP_INTERNAL);
+    size_t total;
+    if (__builtin_mul_overflow(n, size, &total)) {
+        return NULL;
+    }
+    void* ptr = placed_alloc(total, 0);
+    if (ptr) {
+        memset(ptr, 0, total);
     }
     return ptr;
 }
 
 void* __wrap_realloc(void* ptr, size_t size) {
+    if (!ptr) {
+        return placed_alloc(size, 0);
+    }
+
     uint32_t caps = get_malloc_target();
-    void* new_ptr = heap_caps_realloc(ptr, size, caps);
-    if (!new_ptr && size > 0 && caps != MALLOC_CAP_INTERNAL) {
-        new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL);
+    void* new_ptr;
+    if (mem_pool* pool = pool_of(ptr)) {
+        new_ptr = pool_realloc(pool, ptr, size, caps);
+    } else {
+        new_ptr = heap_caps_realloc(ptr, size, caps);
+        if (!new_ptr && size > 0 && caps != MALLOC_CAP_INTERNAL) {
+            new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL);
+        }
     }
+    track_realloc(ptr, new_ptr, size);
     return new_ptr;
 }
 
@@ -222,34 +517,29 @@ void* operator new[](size_t size) {
 
 // Single-object deallocation
 void operator delete(void* ptr) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // Array deallocation
 void operator delete[](void* ptr) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // C++14 sized deallocation (single object)
 void operator delete(void* ptr, size_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // C++14 sized deallocation (array)
 void operator delete[](void* ptr, size_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // get_malloc_target is defined above in extern "C" block
 
 // C++17 aligned allocation (single object) - use TLS-aware target
 void* operator new(size_t size, std::align_val_t align) {
-    uint32_t caps = get_malloc_target();
-    void* ptr = heap_caps_aligned_alloc(static_cast<size_t>(align), size, caps);
-    if (!ptr && caps != MALLOC_CAP_INTERNAL) {
-        // Fallback to internal RAM if target fails
-        ptr = heap_caps_aligned_alloc(static_cast<size_t>(align), size, MALLOC_CAP_INTERNAL);
-    }
+    void* ptr = placed_alloc(size, static_cast<size_t>(align));
     if (!ptr) {
         throw std::bad_alloc();
     }
@@ -258,11 +548,7 @@ void* operator new(size_t size, std::align_val_t align) {
 
 // C++17 aligned allocation (array) - use TLS-aware target
 void* operator new[](size_t size, std::align_val_t align) {
-    uint32_t caps = get_malloc_target();
-    void* ptr = heap_caps_aligned_alloc(static_cast<size_t>(align), size, caps);
-    if (!ptr && caps != MALLOC_CAP_INTERNAL) {
-        ptr = heap_caps_aligned_alloc(static_cast<size_t>(align), size, MALLOC_CAP_INTERNAL);
-    }
+    void* ptr = placed_alloc(size, static_cast<size_t>(align));
     if (!ptr) {
         throw std::bad_alloc();
     }
@@ -271,22 +557,22 @@ void* operator new[](size_t size, std::align_val_t align) {
 
 // C++17 aligned deallocation (single object)
 void operator delete(void* ptr, std::align_val_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // C++17 aligned deallocation (array)
 void operator delete[](void* ptr, std::align_val_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // C++17 sized aligned deallocation (single object)
 void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // C++17 sized aligned deallocation (array)
 void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
-    heap_caps_free(ptr);
+    tracked_free(ptr);
 }
 
 // Configure pthread to use PSRAM for thread stacks
@@ -347,6 +633,16 @@ extern "C" void print_rtc_memory_stats() {
     ESP_LOGI(TAG, "PSRAM free: %d KB, Internal free: %d KB",
              heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024,
              heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024);
+
+    for (esp32_mem_class_t mem_class : {ESP32_MEM_HOT, ESP32_MEM_DMA}) {
+        esp32_mem_class_stats_t stats;
+        esp32_mem_class_get_stats(mem_class, &stats);
+        if (stats.used > 0 || stats.fallbacks > 0) {
+            ESP_LOGI(TAG, "%s pool: %zu/%zu bytes used (peak %zu), %zu spilled",
+                     class_pool(mem_class)->name, stats.used, stats.budget, stats.peak,
+                     stats.fallbacks);
+        }
+    }
 }
 
 // Debug: print allocation statistics
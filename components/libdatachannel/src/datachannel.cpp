@@ -40,6 +40,8 @@ string DataChannel::protocol() const { return impl()->protocol(); }
 
 Reliability DataChannel::reliability() const { return impl()->reliability(); }
 
+uint16_t DataChannel::priority() const { return impl()->priority(); }
+
 bool DataChannel::isOpen(void) const { return impl()->isOpen(); }
 
 bool DataChannel::isClosed(void) const { return impl()->isClosed(); }
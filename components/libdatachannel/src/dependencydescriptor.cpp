@@ -406,4 +406,83 @@ void DependencyDescriptorWriter::writeNonSymmetric(BitWriter &writer, uint64_t v
 	}
 }
 
+DependencyDescriptorContext DependencyDescriptorContext::TemporalLayers(int count) {
+	if (count < 1 || count > 3)
+		throw std::invalid_argument("Invalid number of temporal layers");
+
+	using Dti = DecodeTargetIndication;
+	const Dti S = Dti::Switch, D = Dti::Discardable, N = Dti::NotPresent;
+
+	// Same templates as the L1T1, L1T2 and L1T3 scalability structures of libwebrtc
+	DependencyDescriptorContext context;
+	auto &structure = context.structure;
+	structure.decodeTargetCount = count;
+	structure.chainCount = 1; // The base layer protects every decode target
+	structure.decodeTargetProtectedBy.assign(count, 0);
+	switch (count) {
+	case 1:
+		structure.templates = {{0, 0, {S}, {}, {0}}, {0, 0, {S}, {1}, {1}}};
+		break;
+	case 2:
+		structure.templates = {
+		    {0, 0, {S, S}, {}, {0}}, {0, 0, {S, S}, {2}, {2}}, {0, 1, {N, D}, {1}, {1}}};
+		break;
+	default:
+		structure.templates = {{0, 0, {S, S, S}, {}, {0}},
+		                       {0, 0, {S, S, S}, {4}, {4}},
+		                       {0, 1, {N, D, S}, {2}, {2}},
+		                       {0, 2, {N, N, D}, {1}, {1}},
+		                       {0, 2, {N, N, D}, {1}, {3}}};
+		break;
+	}
+	context.activeChains.set(0);
+	context.temporalLayerCount = count;
+	context.descriptor.structureAttached = false;
+	return context;
+}
+
+void DependencyDescriptorContext::describeFrame(uint32_t frameNumber, int temporalId,
+                                                bool keyframe) {
+	if (temporalLayerCount <= 0)
+		throw std::logic_error("Dependency descriptor context has no temporal layers");
+
+	temporalId = std::clamp(temporalId, 0, temporalLayerCount - 1);
+	if (keyframe)
+		temporalId = 0;
+
+	// Templates of a layer are contiguous, the first one of the base layer is the keyframe
+	const auto &templates = structure.templates;
+	auto it = std::find_if(templates.begin(), templates.end(), [&](const auto &t) {
+		return t.temporalId == temporalId && (keyframe || !t.frameDiffs.empty());
+	});
+	assert(it != templates.end());
+	descriptor.dependencyTemplate = *it;
+	descriptor.frameNumber = int(frameNumber & 0xFFFF);
+	descriptor.structureAttached = keyframe;
+
+	if (keyframe) {
+		lastFrameNumbers = {frameNumber, nullopt, nullopt};
+		return;
+	}
+
+	// Base layer frames reference the previous base layer frame, upper layer frames the most
+	// recent frame of a lower layer
+	optional<uint32_t> reference;
+	for (int layer = 0; layer < std::max(temporalId, 1); ++layer)
+		if (auto last = lastFrameNumbers[layer])
+			if (!reference || uint32_t(*last - *reference) < (1u << 31))
+				reference = last;
+
+	// Without a known reference, like before the first keyframe, the template is kept as is
+	if (reference) {
+		uint32_t diff = frameNumber - *reference;
+		if (diff > 0 && diff <= (1u << 12))
+			descriptor.dependencyTemplate.frameDiffs = {int(diff)};
+	}
+	if (auto base = lastFrameNumbers[0])
+		descriptor.dependencyTemplate.chainDiffs = {int(std::min(frameNumber - *base, 255u))};
+
+	lastFrameNumbers[temporalId] = frameNumber;
+}
+
 } // namespace rtc
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "framearena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#ifdef ESP32_PORT
+#include "esp32_psram_init.h"
+#endif
+
+namespace rtc {
+
+namespace {
+
+byte *allocateChunk(size_t size) {
+#ifdef ESP32_PORT
+	void *data = esp32_psram_buffer_alloc(size);
+#else
+	void *data = std::malloc(size);
+#endif
+	if (!data)
+		throw std::bad_alloc();
+
+	return static_cast<byte *>(data);
+}
+
+void freeChunk(byte *data) {
+#ifdef ESP32_PORT
+	esp32_psram_buffer_free(data);
+#else
+	std::free(data);
+#endif
+}
+
+} // namespace
+
+FrameArena::FrameArena(size_t chunkSize) : mChunkSize(chunkSize) {}
+
+FrameArena::~FrameArena() {
+	for (auto &chunk : mChunks)
+		freeChunk(chunk.data);
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+	assert(alignment <= alignof(std::max_align_t) && (alignment & (alignment - 1)) == 0);
+
+	while (mCurrent < mChunks.size()) {
+		const auto &chunk = mChunks[mCurrent];
+		size_t offset = (mOffset + alignment - 1) & ~(alignment - 1);
+		if (offset + size <= chunk.size) {
+			mOffset = offset + size;
+			return chunk.data + offset;
+		}
+		++mCurrent;
+		mOffset = 0;
+	}
+
+	// Chunks come from malloc, so they are aligned for any fundamental type
+	size_t chunkSize = std::max(size, mChunkSize);
+	mChunks.push_back(Chunk{allocateChunk(chunkSize), chunkSize});
+	++mChunkAllocations;
+	mCurrent = mChunks.size() - 1;
+	mOffset = size;
+	return mChunks.back().data;
+}
+
+void FrameArena::reset() {
+	mCurrent = 0;
+	mOffset = 0;
+}
+
+size_t FrameArena::capacity() const {
+	size_t total = 0;
+	for (const auto &chunk : mChunks)
+		total += chunk.size;
+
+	return total;
+}
+
+size_t FrameArena::chunkAllocations() const { return mChunkAllocations; }
+
+} // namespace rtc
@@ -16,13 +16,12 @@
 //
 #include "global.hpp"
 
+#include "impl/certificate.hpp"
 #include "impl/init.hpp"
 
 #ifdef ESP_PLATFORM
-#include "impl/threadpool.hpp"
 #include "impl/pollservice.hpp"
 #include "esp32_psram_init.h"
-#include <thread>
 #endif
 
 #include <mutex>
@@ -101,6 +100,14 @@ std::shared_future<void> Cleanup() { return impl::Init::Instance().cleanup(); }
 
 void SetSctpSettings(SctpSettings s) { impl::Init::Instance().setSctpSettings(std::move(s)); }
 
+void SetThreadingSettings(ThreadingSettings s) {
+	impl::Init::Instance().setThreadingSettings(std::move(s));
+}
+
+void SetCertificatePoolSize(size_t size, CertificateType type) {
+	impl::CertificatePool::Instance().setSize(size, type);
+}
+
 #ifdef ESP_PLATFORM
 void StartNetworking() {
 	// ESP32: Configure pthread to use PSRAM BEFORE creating any threads
@@ -108,10 +115,7 @@ void StartNetworking() {
 	esp32_configure_pthread_psram();
 
 	// ESP32: Start threads that were deferred during initialization
-	int concurrency = std::thread::hardware_concurrency();
-	int count = std::max(concurrency, 2); // MIN_THREADPOOL_SIZE
-
-	impl::ThreadPool::Instance().spawn(count);
+	impl::Init::Instance().startThreads();
 
 #if RTC_ENABLE_WEBSOCKET
 	impl::PollService::Instance().startThreads();
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -36,6 +37,40 @@ extern bool g_log_frame_timing;  // Defined in httpd_server.cpp
 
 namespace rtc {
 
+namespace {
+
+// Calls func(begin, end) with the offsets of each NAL unit in the frame
+template <typename Func>
+void forEachNalUnit(const binary &frame, NalUnit::Separator separator, Func &&func) {
+	if (separator == NalUnit::Separator::Length) {
+		size_t index = 0;
+		while (index < frame.size()) {
+			assert(index + 4 < frame.size());
+			if (index + 4 >= frame.size()) {
+				LOG_WARNING << "Invalid NAL Unit data (incomplete length), ignoring!";
+				break;
+			}
+			uint32_t length;
+			std::memcpy(&length, frame.data() + index, sizeof(uint32_t));
+			length = ntohl(length);
+			auto naluStartIndex = index + 4;
+			auto naluEndIndex = naluStartIndex + length;
+
+			assert(naluEndIndex <= frame.size());
+			if (naluEndIndex > frame.size()) {
+				LOG_WARNING << "Invalid NAL Unit data (incomplete unit), ignoring!";
+				break;
+			}
+			func(naluStartIndex, naluEndIndex);
+			index = naluEndIndex;
+		}
+	} else {
+		NalUnit::ForEachStartSequenceUnit(frame, separator, func);
+	}
+}
+
+} // namespace
+
 H264RtpPacketizer::H264RtpPacketizer(shared_ptr<RtpPacketizationConfig> rtpConfig,
                                      size_t maxFragmentSize)
     : RtpPacketizer(std::move(rtpConfig)), mSeparator(Separator::Length), mMaxFragmentSize(maxFragmentSize) {}
@@ -45,12 +80,21 @@ H264RtpPacketizer::H264RtpPacketizer(Separator separator,
                                      size_t maxFragmentSize)
     : RtpPacketizer(rtpConfig), mSeparator(separator), mMaxFragmentSize(maxFragmentSize) {}
 
+void H264RtpPacketizer::fragmentPayloads(binary &data, arena_vector<FramePayload> &payloads) {
 #ifdef ESP32_PORT
-psram_vector<binary> H264RtpPacketizer::fragment(binary data) {
 	uint64_t start = esp_timer_get_time();
-	auto nalus = splitFrame(data);
+#endif
+	// NAL units and FU-A fragments are slices of the frame, no NAL unit is copied
+	arena_vector<FramePayload> nalus(frameArena());
+	forEachNalUnit(data, mSeparator, [&](size_t begin, size_t end) {
+		if (end > begin)
+			nalus.push_back(FramePayload{{}, 0, data.data() + begin, end - begin});
+	});
+#ifdef ESP32_PORT
 	uint64_t split_end = esp_timer_get_time();
-	auto fragments = NalUnit::GenerateFragments(nalus, mMaxFragmentSize);
+#endif
+	NalUnit::GeneratePayloads(nalus, mMaxFragmentSize, true, frameArena(), payloads);
+#ifdef ESP32_PORT
 	uint64_t frag_end = esp_timer_get_time();
 
 	// Log if flag is set (synchronized with other pipeline layers)
@@ -59,122 +103,29 @@ psram_vector<binary> H264RtpPacketizer::fragment(binary data) {
 		uint32_t gen_ms = (frag_end - split_end) / 1000;
 		PLOG_INFO << "  H264: " << data.size() << "B, split=" << split_ms
 		          << "ms, gen=" << gen_ms << "ms (" << nalus.size()
-		          << " NALs -> " << fragments.size() << " frags)";
+		          << " NALs -> " << payloads.size() << " frags)";
 	}
+#endif
+}
 
-	return fragments;
+#ifdef ESP32_PORT
+psram_vector<binary> H264RtpPacketizer::fragment(binary data) {
+	return NalUnit::GenerateFragments(splitFrame(data), mMaxFragmentSize, true);
 }
 
 psram_vector<NalUnit> H264RtpPacketizer::splitFrame(const binary &frame) {
 	psram_vector<NalUnit> nalus;
-
-	// ESP32 optimization: All NAL boundaries are in first ~30 bytes
-	// Scan only the header region instead of the entire frame
-	const size_t HEADER_SCAN_SIZE = 100;
 #else
 std::vector<binary> H264RtpPacketizer::fragment(binary data) {
-	return NalUnit::GenerateFragments(splitFrame(data), mMaxFragmentSize);
+	return NalUnit::GenerateFragments(splitFrame(data), mMaxFragmentSize, true);
 }
 
 std::vector<NalUnit> H264RtpPacketizer::splitFrame(const binary &frame) {
 	std::vector<NalUnit> nalus;
 #endif
-	if (mSeparator == Separator::Length) {
-		size_t index = 0;
-		while (index < frame.size()) {
-			assert(index + 4 < frame.size());
-			if (index + 4 >= frame.size()) {
-				LOG_WARNING << "Invalid NAL Unit data (incomplete length), ignoring!";
-				break;
-			}
-			uint32_t length;
-			std::memcpy(&length, frame.data() + index, sizeof(uint32_t));
-			length = ntohl(length);
-			auto naluStartIndex = index + 4;
-			auto naluEndIndex = naluStartIndex + length;
-
-			assert(naluEndIndex <= frame.size());
-			if (naluEndIndex > frame.size()) {
-				LOG_WARNING << "Invalid NAL Unit data (incomplete unit), ignoring!";
-				break;
-			}
-			auto begin = frame.begin() + naluStartIndex;
-			auto end = frame.begin() + naluEndIndex;
-			nalus.emplace_back(begin, end);
-			index = naluEndIndex;
-		}
-	} else {
-#ifdef ESP32_PORT
-		// ESP32 optimization: Scan only first HEADER_SCAN_SIZE bytes for NAL boundaries
-		// All start codes are in the first ~30 bytes (SPS, PPS, IDR headers)
-		// After that, it's all payload data for the final NAL unit
-		NalUnitStartSequenceMatch match = NUSM_noMatch;
-		size_t index = 0;
-
-		// Skip first start code
-		while (index < frame.size()) {
-			match = NalUnit::StartSequenceMatchSucc(match, frame[index++], mSeparator);
-			if (match == NUSM_longMatch || match == NUSM_shortMatch) {
-				match = NUSM_noMatch;
-				break;
-			}
-		}
-
-		size_t naluStartIndex = index;
-		size_t scanLimit = std::min(HEADER_SCAN_SIZE, frame.size());
-
-		// Scan header region for additional NAL boundaries
-		while (index < scanLimit) {
-			match = NalUnit::StartSequenceMatchSucc(match, frame[index], mSeparator);
-			if (match == NUSM_longMatch || match == NUSM_shortMatch) {
-				auto sequenceLength = match == NUSM_longMatch ? 4 : 3;
-				size_t naluEndIndex = index - sequenceLength;
-				match = NUSM_noMatch;
-				auto begin = frame.begin() + naluStartIndex;
-				auto end = frame.begin() + naluEndIndex + 1;
-				nalus.emplace_back(begin, end);
-				naluStartIndex = index + 1;
-			}
-			index++;
-		}
-
-		// Final NAL unit extends from last boundary to end of frame
-		auto begin = frame.begin() + naluStartIndex;
-		auto end = frame.end();
-		nalus.emplace_back(begin, end);
-#else
-		// Non-ESP32: Full frame scan (original logic)
-		NalUnitStartSequenceMatch match = NUSM_noMatch;
-		size_t index = 0;
-		while (index < frame.size()) {
-			match = NalUnit::StartSequenceMatchSucc(match, frame[index++], mSeparator);
-			if (match == NUSM_longMatch || match == NUSM_shortMatch) {
-				match = NUSM_noMatch;
-				break;
-			}
-		}
-
-		size_t naluStartIndex = index;
-
-		while (index < frame.size()) {
-			match = NalUnit::StartSequenceMatchSucc(match, frame[index], mSeparator);
-			if (match == NUSM_longMatch || match == NUSM_shortMatch) {
-				auto sequenceLength = match == NUSM_longMatch ? 4 : 3;
-				size_t naluEndIndex = index - sequenceLength;
-				match = NUSM_noMatch;
-				auto begin = frame.begin() + naluStartIndex;
-				auto end = frame.begin() + naluEndIndex + 1;
-				nalus.emplace_back(begin, end);
-				naluStartIndex = index + 1;
-			}
-			index++;
-		}
-		auto begin = frame.begin() + naluStartIndex;
-		auto end = frame.end();
-		nalus.emplace_back(begin, end);
-#endif
-	}
-
+	forEachNalUnit(frame, mSeparator, [&](size_t begin, size_t end) {
+		nalus.emplace_back(frame.begin() + begin, frame.begin() + end);
+	});
 	return nalus;
 }
 
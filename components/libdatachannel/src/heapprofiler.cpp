@@ -0,0 +1,25 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "heapprofiler.hpp"
+
+#include "impl/heapprofiler.hpp"
+
+namespace rtc {
+
+bool StartHeapProfiler(size_t samplingInterval) {
+	return impl::HeapProfiler::Instance().start(samplingInterval);
+}
+
+void StopHeapProfiler() { impl::HeapProfiler::Instance().stop(); }
+
+HeapProfilerStats GetHeapProfilerStats() { return impl::HeapProfiler::Instance().stats(); }
+
+binary ExportHeapProfile() { return impl::HeapProfiler::Instance().exportProfile(); }
+
+} // namespace rtc
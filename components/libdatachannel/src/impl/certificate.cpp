@@ -609,11 +609,87 @@ string make_fingerprint(X509 *x509, CertificateFingerprint::Algorithm fingerprin
 // Common for GnuTLS, Mbed TLS, and OpenSSL
 
 future_certificate_ptr make_certificate(CertificateType type) {
+	if (auto certificate = CertificatePool::Instance().take(type)) {
+		std::promise<certificate_ptr> promise;
+		promise.set_value(std::move(certificate));
+		return promise.get_future().share();
+	}
+
 	return ThreadPool::Instance().enqueue([type, token = Init::Instance().token()]() {
 		return std::make_shared<Certificate>(Certificate::Generate(type, "libdatachannel"));
 	});
 }
 
+CertificatePool &CertificatePool::Instance() {
+	static CertificatePool *instance = new CertificatePool;
+	return *instance;
+}
+
+void CertificatePool::setSize(size_t size, CertificateType type) {
+	std::vector<certificate_ptr> dropped;
+	std::lock_guard lock(mMutex);
+	if (type != mType) {
+		std::swap(dropped, mCertificates);
+		++mGeneration;
+		mPending = 0;
+	}
+	mSize = size;
+	mType = type;
+	while (mCertificates.size() > mSize) {
+		dropped.push_back(std::move(mCertificates.back()));
+		mCertificates.pop_back();
+	}
+	refill();
+}
+
+certificate_ptr CertificatePool::take(CertificateType type) {
+	std::lock_guard lock(mMutex);
+	if (mSize == 0 || type != mType)
+		return nullptr;
+
+	certificate_ptr certificate;
+	if (!mCertificates.empty()) {
+		certificate = std::move(mCertificates.back());
+		mCertificates.pop_back();
+	}
+	refill();
+	return certificate;
+}
+
+void CertificatePool::clear() {
+	std::vector<certificate_ptr> dropped; // released after unlocking
+	std::lock_guard lock(mMutex);
+	std::swap(dropped, mCertificates);
+	++mGeneration;
+	mPending = 0;
+}
+
+void CertificatePool::refill() {
+	// mMutex needs to be locked
+	while (mCertificates.size() + mPending < mSize) {
+		++mPending;
+		ThreadPool::Instance().enqueueBackground(
+		    [this, type = mType, generation = mGeneration, token = Init::Instance().token()]() {
+			    PLOG_DEBUG << "Generating pooled certificate";
+			    certificate_ptr certificate;
+			    try {
+				    certificate = std::make_shared<Certificate>(
+				        Certificate::Generate(type, "libdatachannel"));
+			    } catch (const std::exception &e) {
+				    PLOG_WARNING << "Pooled certificate generation failed: " << e.what();
+			    }
+
+			    std::lock_guard lock(mMutex);
+			    if (generation != mGeneration)
+				    return; // stale, certificate is released after unlocking
+
+			    --mPending;
+			    if (certificate && mCertificates.size() < mSize)
+				    mCertificates.push_back(std::move(certificate));
+		    });
+	}
+}
+
 CertificateFingerprint Certificate::fingerprint() const {
 	return CertificateFingerprint{CertificateFingerprint::Algorithm::Sha256, mFingerprint};
 }
@@ -16,7 +16,9 @@
 #include "tls.hpp"
 
 #include <future>
+#include <mutex>
 #include <tuple>
+#include <vector>
 
 namespace rtc::impl {
 
@@ -73,6 +75,29 @@ using future_certificate_ptr = std::shared_future<certificate_ptr>;
 
 future_certificate_ptr make_certificate(CertificateType type = CertificateType::Default);
 
+// Certificates generated ahead of time on the background lane, so that a new connection does not
+// wait for key generation. Each certificate is handed out once.
+class CertificatePool final {
+public:
+	static CertificatePool &Instance();
+
+	void setSize(size_t size, CertificateType type);
+	certificate_ptr take(CertificateType type); // null if none is ready, triggers a refill
+	void clear(); // drops pooled certificates, which hold init tokens
+
+private:
+	CertificatePool() = default;
+
+	void refill(); // mMutex needs to be locked
+
+	size_t mSize = 0;
+	CertificateType mType = CertificateType::Default;
+	std::vector<certificate_ptr> mCertificates;
+	size_t mPending = 0;     // generations in flight
+	unsigned mGeneration = 0; // incremented on clear() and setSize() to discard stale results
+	std::mutex mMutex;
+};
+
 } // namespace rtc::impl
 
 #endif
@@ -75,9 +75,9 @@ bool DataChannel::IsOpenMessage(message_ptr message) {
 }
 
 DataChannel::DataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
-                         Reliability reliability)
+                         Reliability reliability, uint16_t priority, unsigned int weight)
     : mPeerConnection(pc), mLabel(std::move(label)), mProtocol(std::move(protocol)),
-      mRecvQueue(RECV_QUEUE_LIMIT, message_size_func) {
+      mPriority(priority), mWeight(weight), mRecvQueue(RECV_QUEUE_LIMIT, message_size_func) {
 
 	if(reliability.maxPacketLifeTime && reliability.maxRetransmits)
 		throw std::invalid_argument("Both maxPacketLifeTime and maxRetransmits are set");
@@ -146,6 +146,11 @@ Reliability DataChannel::reliability() const {
 	return *mReliability;
 }
 
+uint16_t DataChannel::priority() const {
+	std::shared_lock lock(mMutex);
+	return mPriority;
+}
+
 bool DataChannel::isOpen(void) const { return !mIsClosed && mIsOpen; }
 
 bool DataChannel::isClosed(void) const { return mIsClosed; }
@@ -168,6 +173,9 @@ void DataChannel::open(shared_ptr<SctpTransport> transport) {
 	{
 		std::unique_lock lock(mMutex);
 		mSctpTransport = transport;
+
+		if (mStream.has_value())
+			transport->setStreamPriority(mStream.value(), mPriority, mWeight);
 	}
 
 	if (!mIsClosed && !mIsOpen.exchange(true))
@@ -243,8 +251,10 @@ void DataChannel::incoming(message_ptr message) {
 }
 
 OutgoingDataChannel::OutgoingDataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
-                                         Reliability reliability)
-    : DataChannel(pc, std::move(label), std::move(protocol), std::move(reliability)) {}
+                                         Reliability reliability, uint16_t priority,
+                                         unsigned int weight)
+    : DataChannel(pc, std::move(label), std::move(protocol), std::move(reliability), priority,
+                  weight) {}
 
 OutgoingDataChannel::~OutgoingDataChannel() {}
 
@@ -295,7 +305,7 @@ void OutgoingDataChannel::open(shared_ptr<SctpTransport> transport) {
 	auto &open = *reinterpret_cast<OpenMessage *>(buffer.data());
 	open.type = MESSAGE_OPEN;
 	open.channelType = channelType;
-	open.priority = htons(0);
+	open.priority = htons(mPriority);
 	open.reliabilityParameter = htonl(reliabilityParameter);
 	open.labelLength = htons(to_uint16(mLabel.size()));
 	open.protocolLength = htons(to_uint16(mProtocol.size()));
@@ -304,6 +314,9 @@ void OutgoingDataChannel::open(shared_ptr<SctpTransport> transport) {
 	std::copy(mLabel.begin(), mLabel.end(), end);
 	std::copy(mProtocol.begin(), mProtocol.end(), end + mLabel.size());
 
+	// Set before the open message is queued so it is already sent with the right priority
+	transport->setStreamPriority(mStream.value(), mPriority, mWeight);
+
 	lock.unlock();
 
 	transport->send(make_message(buffer.begin(), buffer.end(), Message::Control, mStream.value()));
@@ -351,6 +364,10 @@ void IncomingDataChannel::processOpenMessage(message_ptr message) {
 	mLabel.assign(end, open.labelLength);
 	mProtocol.assign(end + open.labelLength, open.protocolLength);
 
+	// Adopt the priority requested by the remote peer (RFC 8832 section 5.1)
+	mPriority = open.priority;
+	transport->setStreamPriority(mStream.value(), mPriority, mWeight);
+
 	mReliability->unordered = (open.channelType & 0x80) != 0;
 	mReliability->maxPacketLifeTime.reset();
 	mReliability->maxRetransmits.reset();
@@ -11,6 +11,7 @@
 
 #include "channel.hpp"
 #include "common.hpp"
+#include "internals.hpp"
 #include "message.hpp"
 #include "peerconnection.hpp"
 #include "queue.hpp"
@@ -28,7 +29,8 @@ struct DataChannel : Channel, std::enable_shared_from_this<DataChannel> {
 	static bool IsOpenMessage(message_ptr message);
 
 	DataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
-	            Reliability reliability);
+	            Reliability reliability, uint16_t priority = DEFAULT_DATACHANNEL_PRIORITY,
+	            unsigned int weight = 1);
 	virtual ~DataChannel();
 
 	void close();
@@ -44,6 +46,7 @@ struct DataChannel : Channel, std::enable_shared_from_this<DataChannel> {
 	string label() const;
 	string protocol() const;
 	Reliability reliability() const;
+	uint16_t priority() const;
 
 	bool isOpen(void) const;
 	bool isClosed(void) const;
@@ -61,6 +64,8 @@ protected:
 	string mLabel;
 	string mProtocol;
 	shared_ptr<Reliability> mReliability;
+	uint16_t mPriority;
+	unsigned int mWeight;
 
 	mutable std::shared_mutex mMutex;
 
@@ -73,7 +78,7 @@ private:
 
 struct OutgoingDataChannel final : public DataChannel {
 	OutgoingDataChannel(weak_ptr<PeerConnection> pc, string label, string protocol,
-	                    Reliability reliability);
+	                    Reliability reliability, uint16_t priority, unsigned int weight);
 	~OutgoingDataChannel();
 
 	void open(shared_ptr<SctpTransport> transport) override;
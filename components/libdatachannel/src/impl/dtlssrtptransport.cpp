@@ -8,11 +8,14 @@
 
 #include "dtlssrtptransport.hpp"
 #include "logcounter.hpp"
+#include "memoryplacement.hpp"
 #include "rtp.hpp"
 #include "tls.hpp"
 
 #if RTC_ENABLE_MEDIA
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <exception>
 
@@ -75,36 +78,102 @@ DtlsSrtpTransport::DtlsSrtpTransport(shared_ptr<IceTransport> lower,
                                      state_callback stateChangeCallback)
     : DtlsTransport(lower, certificate, mtu, fingerprintAlgorithm, std::move(verifierCallback),
                     std::move(stateChangeCallback)),
-      mSrtpRecvCallback(std::move(srtpRecvCallback)) { // distinct from Transport recv callback
+      mSrtpRecvCallback(std::move(srtpRecvCallback)), // distinct from Transport recv callback
+      mSession(std::make_shared<Session>()) {
 
 	PLOG_DEBUG << "Initializing DTLS-SRTP transport";
+}
 
-	if (srtp_err_status_t err = srtp_create(&mSrtpIn, nullptr)) {
-		throw std::runtime_error("srtp_create failed, status=" + to_string(static_cast<int>(err)));
+DtlsSrtpTransport::~DtlsSrtpTransport() {
+	stop(); // stop before deallocating
+
+	// Tracks might still be sending with the context, which points back to the transport
+	if (auto context = mSession->context.exchange(nullptr, std::memory_order_acq_rel)) {
+		Epoch::Instance().synchronize();
+		delete context;
 	}
-	if (srtp_err_status_t err = srtp_create(&mSrtpOut, nullptr)) {
-		srtp_dealloc(mSrtpIn);
-		throw std::runtime_error("srtp_create failed, status=" + to_string(static_cast<int>(err)));
+}
+
+DtlsSrtpTransport::CryptoContext::CryptoContext(DtlsSrtpTransport *transport)
+    : transport(transport) {}
+
+DtlsSrtpTransport::CryptoContext::~CryptoContext() {
+	if (in)
+		srtp_dealloc(in);
+	if (out)
+		srtp_dealloc(out);
+}
+
+bool DtlsSrtpTransport::Session::send(message_ptr message, SendExtensions extensions) {
+	Epoch::Guard guard;
+	auto current = context.load(std::memory_order_acquire);
+	if (!current) {
+		PLOG_ERROR << "SRTP media sent before keys are derived";
+		return false;
 	}
+
+	return current->transport->sendMedia(*current, std::move(message), extensions);
 }
 
-DtlsSrtpTransport::~DtlsSrtpTransport() {
-	stop(); // stop before deallocating
+bool DtlsSrtpTransport::Session::sendMultiple(message_vector &messages,
+                                              SendExtensions extensions) {
+	Epoch::Guard guard;
+	auto current = context.load(std::memory_order_acquire);
+	if (!current) {
+		PLOG_ERROR << "SRTP media sent before keys are derived";
+		return false;
+	}
 
-	srtp_dealloc(mSrtpIn);
-	srtp_dealloc(mSrtpOut);
+	return current->transport->sendMedia(*current, messages, extensions);
 }
 
 bool DtlsSrtpTransport::sendMedia(message_ptr message) {
-	std::lock_guard lock(sendMutex);
+	return sendMedia(std::move(message), SendExtensions{});
+}
+
+bool DtlsSrtpTransport::sendMedia(message_ptr message, SendExtensions extensions) {
+	return mSession->send(std::move(message), extensions);
+}
+
+bool DtlsSrtpTransport::sendMedia(CryptoContext &context, message_ptr message,
+                                  SendExtensions extensions) {
+	MemoryTracker::Scope scope(memoryTag(), MemorySubsystem::Srtp);
 	if (!message)
 		return false;
 
-	if (!mInitDone) {
-		PLOG_ERROR << "SRTP media sent before keys are derived";
-		return false;
+	{
+		std::lock_guard lock(context.sendMutex);
+		message = protectMedia(context, std::move(message), extensions);
 	}
 
+	// Sent outside the lock, the ICE transport is thread-safe
+	return Transport::outgoing(message); // bypass DTLS DSCP marking
+}
+
+bool DtlsSrtpTransport::sendMedia(CryptoContext &context, message_vector &messages,
+                                  SendExtensions extensions) {
+	MemoryTracker::Scope scope(memoryTag(), MemorySubsystem::Srtp);
+	bool result = true;
+	for (size_t begin = 0; begin < messages.size(); begin += SendSliceSize) {
+		// The lock is released between slices, so that a sender of another track of the
+		// connection, typically audio from a higher priority task, does not wait for a whole
+		// keyframe to be protected
+		size_t end = std::min(begin + SendSliceSize, messages.size());
+		std::lock_guard lock(context.sendMutex);
+		for (size_t i = begin; i < end; ++i) {
+			if (messages[i])
+				messages[i] = protectMedia(context, std::move(messages[i]), extensions);
+			else
+				result = false;
+		}
+	}
+
+	// The ICE transport sends the batch grouped by DSCP value, concurrently with other senders
+	return Transport::outgoingMultiple(messages) && result; // bypass DTLS DSCP marking
+}
+
+message_ptr DtlsSrtpTransport::protectMedia(CryptoContext &context, message_ptr message,
+                                            SendExtensions extensions) {
 	int size = int(message->size());
 	PLOG_VERBOSE << "Send size=" << size;
 
@@ -113,36 +182,82 @@ bool DtlsSrtpTransport::sendMedia(message_ptr message) {
 	// Copy instead of resizing so we don't interfere with media handlers keeping references
 	message = make_message(size + SRTP_MAX_TRAILER_LEN, message);
 
-	if (IsRtcp(*message)) { // Demultiplex RTCP and RTP using payload type
-		if (srtp_err_status_t err = srtp_protect_rtcp(mSrtpOut, message->data(), &size)) {
-			if (err == srtp_err_status_replay_fail)
-				throw std::runtime_error("Outgoing SRTCP packet is a replay");
-			else
-				throw std::runtime_error("SRTCP protect error, status=" +
-				                         to_string(static_cast<int>(err)));
-		}
-		PLOG_VERBOSE << "Protected SRTCP packet, size=" << size;
-
-	} else {
-		if (srtp_err_status_t err = srtp_protect(mSrtpOut, message->data(), &size)) {
-			if (err == srtp_err_status_replay_fail)
-				throw std::runtime_error("Outgoing SRTP packet is a replay");
-			else
-				throw std::runtime_error("SRTP protect error, status=" +
-				                         to_string(static_cast<int>(err)));
+	bool rtcp = IsRtcp(*message); // Demultiplex RTCP and RTP using payload type
+	{
+		// Streams cloned from the template on first use of an SSRC are kept with the session state
+		MemoryPlacement placement(MemoryClass::Hot);
+
+		if (rtcp) {
+			if (srtp_err_status_t err = srtp_protect_rtcp(context.out, message->data(), &size)) {
+				if (err == srtp_err_status_replay_fail)
+					throw std::runtime_error("Outgoing SRTCP packet is a replay");
+				else
+					throw std::runtime_error("SRTCP protect error, status=" +
+					                         to_string(static_cast<int>(err)));
+			}
+			PLOG_VERBOSE << "Protected SRTCP packet, size=" << size;
+
+		} else {
+			if (extensions.transportSequenceNumberId || extensions.absSendTimeId)
+				stampExtensions(context, *message, extensions);
+
+			if (srtp_err_status_t err = srtp_protect(context.out, message->data(), &size)) {
+				if (err == srtp_err_status_replay_fail)
+					throw std::runtime_error("Outgoing SRTP packet is a replay");
+				else
+					throw std::runtime_error("SRTP protect error, status=" +
+					                         to_string(static_cast<int>(err)));
+			}
+			PLOG_VERBOSE << "Protected SRTP packet, size=" << size;
 		}
-		PLOG_VERBOSE << "Protected SRTP packet, size=" << size;
 	}
 
 	message->resize(size);
 
 	if (message->dscp == 0) { // Track might override the value
-		// Set recommended medium-priority DSCP value
-		// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-		message->dscp = 36; // AF42: Assured Forwarding class 4, medium drop probability
+		if (message->trafficClass == TrafficClass::Default)
+			message->trafficClass = rtcp ? TrafficClass::Rtcp : TrafficClass::DeltaFrame;
+
+		message->dscp = GetTrafficClassDscp(message->trafficClass);
 	}
 
-	return Transport::outgoing(message); // bypass DTLS DSCP marking
+	return message;
+}
+
+void DtlsSrtpTransport::stampExtensions(CryptoContext &context, Message &message,
+                                        SendExtensions extensions) {
+	if (message.size() < sizeof(RtpHeader))
+		return;
+
+	auto rtp = reinterpret_cast<RtpHeader *>(message.data());
+	auto extHeader = rtp->getExtensionHeader();
+	if (!extHeader || message.size() < rtp->getSize() + sizeof(RtpExtensionHeader) ||
+	    message.size() < rtp->getSize() + rtp->getExtensionHeaderSize())
+		return;
+
+	size_t size = 0;
+	if (extensions.transportSequenceNumberId) {
+		// draft-holmer-rmcat-transport-wide-cc-extensions-01 2: one counter across all streams
+		auto value = extHeader->findHeader(extensions.transportSequenceNumberId, size);
+		if (value && size == 2) {
+			uint16_t seq = context.transportSequenceNumber++;
+			value[0] = byte(seq >> 8);
+			value[1] = byte(seq & 0xFF);
+		}
+	}
+
+	if (extensions.absSendTimeId) {
+		// abs-send-time is 6.18 fixed point seconds, wrapping every 64 seconds
+		auto value = extHeader->findHeader(extensions.absSendTimeId, size);
+		if (value && size == 3) {
+			auto now = std::chrono::steady_clock::now().time_since_epoch();
+			uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+			uint32_t time = uint32_t(((us << 18) / 1000000) & 0xFFFFFF);
+			value[0] = byte(time >> 16);
+			value[1] = byte((time >> 8) & 0xFF);
+			value[2] = byte(time & 0xFF);
+		}
+	}
 }
 
 void DtlsSrtpTransport::recvMedia(message_ptr message) {
@@ -159,44 +274,54 @@ void DtlsSrtpTransport::recvMedia(message_ptr message) {
 	PLOG_VERBOSE << "Demultiplexing SRTCP and SRTP with RTP payload type, value="
 	             << unsigned(value2);
 
-	if (IsRtcp(*message)) { // Demultiplex RTCP and RTP using payload type
-		PLOG_VERBOSE << "Incoming SRTCP packet, size=" << size;
-		if (srtp_err_status_t err = srtp_unprotect_rtcp(mSrtpIn, message->data(), &size)) {
-			if (err == srtp_err_status_replay_fail) {
-				PLOG_VERBOSE << "Incoming SRTCP packet is a replay";
-				COUNTER_SRTCP_REPLAY++;
-			} else if (err == srtp_err_status_auth_fail) {
-				PLOG_DEBUG << "Incoming SRTCP packet failed authentication check";
-				COUNTER_SRTCP_AUTH_FAIL++;
-			} else {
-				PLOG_DEBUG << "SRTCP unprotect error, status=" << err;
-				COUNTER_SRTCP_FAIL++;
-			}
-
+	{
+		Epoch::Guard guard;
+		auto context = mSession->context.load(std::memory_order_acquire);
+		if (!context)
 			return;
-		}
-		PLOG_VERBOSE << "Unprotected SRTCP packet, size=" << size;
-		message->type = Message::Control;
-		message->stream = reinterpret_cast<RtcpSr *>(message->data())->senderSSRC();
 
-	} else {
-		PLOG_VERBOSE << "Incoming SRTP packet, size=" << size;
-		if (srtp_err_status_t err = srtp_unprotect(mSrtpIn, message->data(), &size)) {
-			if (err == srtp_err_status_replay_fail) {
-				PLOG_VERBOSE << "Incoming SRTP packet is a replay";
-				COUNTER_SRTP_REPLAY++;
-			} else if (err == srtp_err_status_auth_fail) {
-				PLOG_DEBUG << "Incoming SRTP packet failed authentication check";
-				COUNTER_SRTP_AUTH_FAIL++;
-			} else {
-				PLOG_DEBUG << "SRTP unprotect error, status=" << err;
-				COUNTER_SRTP_FAIL++;
+		// Streams cloned from the template on first use of an SSRC are kept with the session state
+		MemoryPlacement placement(MemoryClass::Hot);
+
+		if (IsRtcp(*message)) { // Demultiplex RTCP and RTP using payload type
+			PLOG_VERBOSE << "Incoming SRTCP packet, size=" << size;
+			if (srtp_err_status_t err = srtp_unprotect_rtcp(context->in, message->data(), &size)) {
+				if (err == srtp_err_status_replay_fail) {
+					PLOG_VERBOSE << "Incoming SRTCP packet is a replay";
+					COUNTER_SRTCP_REPLAY++;
+				} else if (err == srtp_err_status_auth_fail) {
+					PLOG_DEBUG << "Incoming SRTCP packet failed authentication check";
+					COUNTER_SRTCP_AUTH_FAIL++;
+				} else {
+					PLOG_DEBUG << "SRTCP unprotect error, status=" << err;
+					COUNTER_SRTCP_FAIL++;
+				}
+
+				return;
 			}
-			return;
+			PLOG_VERBOSE << "Unprotected SRTCP packet, size=" << size;
+			message->type = Message::Control;
+			message->stream = reinterpret_cast<RtcpSr *>(message->data())->senderSSRC();
+
+		} else {
+			PLOG_VERBOSE << "Incoming SRTP packet, size=" << size;
+			if (srtp_err_status_t err = srtp_unprotect(context->in, message->data(), &size)) {
+				if (err == srtp_err_status_replay_fail) {
+					PLOG_VERBOSE << "Incoming SRTP packet is a replay";
+					COUNTER_SRTP_REPLAY++;
+				} else if (err == srtp_err_status_auth_fail) {
+					PLOG_DEBUG << "Incoming SRTP packet failed authentication check";
+					COUNTER_SRTP_AUTH_FAIL++;
+				} else {
+					PLOG_DEBUG << "SRTP unprotect error, status=" << err;
+					COUNTER_SRTP_FAIL++;
+				}
+				return;
+			}
+			PLOG_VERBOSE << "Unprotected SRTP packet, size=" << size;
+			message->type = Message::Binary;
+			message->stream = reinterpret_cast<RtpHeader *>(message->data())->ssrc();
 		}
-		PLOG_VERBOSE << "Unprotected SRTP packet, size=" << size;
-		message->type = Message::Binary;
-		message->stream = reinterpret_cast<RtpHeader *>(message->data())->ssrc();
 	}
 
 	message->resize(size);
@@ -204,7 +329,7 @@ void DtlsSrtpTransport::recvMedia(message_ptr message) {
 }
 
 bool DtlsSrtpTransport::demuxMessage(message_ptr message) {
-	if (!mInitDone) {
+	if (!mSession->isOpen()) {
 		// Bypass
 		return false;
 	}
@@ -238,8 +363,7 @@ bool DtlsSrtpTransport::demuxMessage(message_ptr message) {
 }
 
 void DtlsSrtpTransport::postHandshake() {
-	if (mInitDone)
-		return;
+	MemoryTracker::Scope scope(memoryTag(), MemorySubsystem::Srtp);
 
 #if USE_GNUTLS
 	PLOG_INFO << "Deriving SRTP keying material (GnuTLS)";
@@ -336,13 +460,20 @@ void DtlsSrtpTransport::postHandshake() {
 	const unsigned char *serverSalt = clientSalt + saltSize;
 #endif
 
-	mClientSessionKey.resize(keySizeWithSalt);
-	mServerSessionKey.resize(keySizeWithSalt);
-	std::memcpy(mClientSessionKey.data(), clientKey, keySize);
-	std::memcpy(mClientSessionKey.data() + keySize, clientSalt, saltSize);
+	// libSRTP expands the keys into its own contexts, they are only needed while creating them
+	if (keySizeWithSalt > SRTP_MAX_KEY_LEN)
+		throw std::logic_error("Unexpected SRTP key length: " + to_string(keySizeWithSalt));
+
+	unsigned char clientSessionKey[SRTP_MAX_KEY_LEN];
+	unsigned char serverSessionKey[SRTP_MAX_KEY_LEN];
+	std::memcpy(clientSessionKey, clientKey, keySize);
+	std::memcpy(clientSessionKey + keySize, clientSalt, saltSize);
 
-	std::memcpy(mServerSessionKey.data(), serverKey, keySize);
-	std::memcpy(mServerSessionKey.data() + keySize, serverSalt, saltSize);
+	std::memcpy(serverSessionKey, serverKey, keySize);
+	std::memcpy(serverSessionKey + keySize, serverSalt, saltSize);
+
+	// Key schedules, auth contexts and replay windows are touched for every packet
+	MemoryPlacement placement(MemoryClass::Hot);
 
 	srtp_policy_t inbound = {};
 	if (srtp_crypto_policy_set_from_profile_for_rtp(&inbound.rtp, srtpProfile))
@@ -351,15 +482,11 @@ void DtlsSrtpTransport::postHandshake() {
 		throw std::runtime_error("SRTP profile is not supported");
 
 	inbound.ssrc.type = ssrc_any_inbound;
-	inbound.key = mIsClient ? mServerSessionKey.data() : mClientSessionKey.data();
+	inbound.key = mIsClient ? serverSessionKey : clientSessionKey;
 	inbound.window_size = 1024;
 	inbound.allow_repeat_tx = true;
 	inbound.next = nullptr;
 
-	if (srtp_err_status_t err = srtp_add_stream(mSrtpIn, &inbound))
-		throw std::runtime_error("SRTP add inbound stream failed, status=" +
-		                         to_string(static_cast<int>(err)));
-
 	srtp_policy_t outbound = {};
 	if (srtp_crypto_policy_set_from_profile_for_rtp(&outbound.rtp, srtpProfile))
 		throw std::runtime_error("SRTP profile is not supported");
@@ -367,16 +494,26 @@ void DtlsSrtpTransport::postHandshake() {
 		throw std::runtime_error("SRTP profile is not supported");
 
 	outbound.ssrc.type = ssrc_any_outbound;
-	outbound.key = mIsClient ? mClientSessionKey.data() : mServerSessionKey.data();
+	outbound.key = mIsClient ? clientSessionKey : serverSessionKey;
 	outbound.window_size = 1024;
 	outbound.allow_repeat_tx = true;
 	outbound.next = nullptr;
 
-	if (srtp_err_status_t err = srtp_add_stream(mSrtpOut, &outbound))
+	auto context = std::make_unique<CryptoContext>(this);
+	if (srtp_err_status_t err = srtp_create(&context->in, &inbound))
+		throw std::runtime_error("SRTP add inbound stream failed, status=" +
+		                         to_string(static_cast<int>(err)));
+
+	if (srtp_err_status_t err = srtp_create(&context->out, &outbound))
 		throw std::runtime_error("SRTP add outbound stream failed, status=" +
 		                         to_string(static_cast<int>(err)));
 
-	mInitDone = true;
+	// Publish the context, senders switch to it atomically and a previous one is reclaimed once
+	// they are done with it
+	if (auto previous = mSession->context.exchange(context.release(), std::memory_order_acq_rel)) {
+		PLOG_DEBUG << "Replacing SRTP keying material";
+		Epoch::Instance().retire(previous);
+	}
 }
 
 #if !USE_GNUTLS && !USE_MBEDTLS
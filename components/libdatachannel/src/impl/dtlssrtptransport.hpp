@@ -11,6 +11,7 @@
 
 #include "common.hpp"
 #include "dtlstransport.hpp"
+#include "epoch.hpp"
 
 #if RTC_ENABLE_MEDIA
 
@@ -21,6 +22,7 @@
 #endif
 
 #include <atomic>
+#include <mutex>
 
 namespace rtc::impl {
 
@@ -36,9 +38,49 @@ public:
 	                  state_callback stateChangeCallback);
 	~DtlsSrtpTransport();
 
+	/// Header extensions stamped when the packet is actually sent, 0 if not negotiated
+	struct SendExtensions {
+		uint8_t transportSequenceNumberId = 0;
+		uint8_t absSendTimeId = 0;
+	};
+
+	// libSRTP sessions keyed by a handshake, published once the keys are derived
+	struct CryptoContext {
+		explicit CryptoContext(DtlsSrtpTransport *transport);
+		~CryptoContext();
+
+		DtlsSrtpTransport *const transport; // the transport waits for readers before destruction
+		srtp_t in = nullptr;
+		srtp_t out = nullptr;
+		std::mutex sendMutex;                 // libSRTP streams are not thread-safe
+		uint16_t transportSequenceNumber = 1; // shared by all tracks, protected by sendMutex
+	};
+
+	// Send entry point shared with tracks, it outlives the transport so that they may send
+	// without locking or promoting a weak_ptr, the context is read within an Epoch::Guard
+	struct Session {
+		std::atomic<CryptoContext *> context = nullptr;
+
+		bool isOpen() const { return context.load(std::memory_order_acquire) != nullptr; }
+		bool send(message_ptr message, SendExtensions extensions);
+		bool sendMultiple(message_vector &messages, SendExtensions extensions); // false if any dropped
+	};
+
+	shared_ptr<Session> session() const { return mSession; }
+
 	bool sendMedia(message_ptr message);
+	bool sendMedia(message_ptr message, SendExtensions extensions);
 
 private:
+	// Packets of a batch protected under one lock, packets are sent outside of it
+	static const size_t SendSliceSize = 8;
+
+	bool sendMedia(CryptoContext &context, message_ptr message, SendExtensions extensions);
+	bool sendMedia(CryptoContext &context, message_vector &messages, SendExtensions extensions);
+	message_ptr protectMedia(CryptoContext &context, message_ptr message,
+	                         SendExtensions extensions); // under sendMutex
+	void stampExtensions(CryptoContext &context, Message &message, SendExtensions extensions);
+
 	void recvMedia(message_ptr message);
 	bool demuxMessage(message_ptr message) override;
 	void postHandshake() override;
@@ -54,11 +96,7 @@ private:
 #endif
 
 	message_callback mSrtpRecvCallback;
-	srtp_t mSrtpIn, mSrtpOut;
-	std::atomic<bool> mInitDone = false;
-	std::vector<unsigned char> mClientSessionKey;
-	std::vector<unsigned char> mServerSessionKey;
-	std::mutex sendMutex;
+	const shared_ptr<Session> mSession;
 };
 
 } // namespace rtc::impl
@@ -16,6 +16,7 @@
 #include <chrono>
 #include <cstring>
 #include <exception>
+#include <limits>
 
 #if !USE_GNUTLS
 #ifdef _WIN32
@@ -35,10 +36,61 @@ void DtlsTransport::enqueueRecv() {
 
 	++mPendingRecvCount;
 
-	ThreadPool::Instance().enqueue([weak_this = weak_from_this()]() {
-		if (auto locked = weak_this.lock())
+	auto task = [weak_this = weak_from_this()]() {
+		if (auto locked = weak_this.lock()) {
+			MemoryTracker::Scope scope(locked->memoryTag());
 			locked->doRecv();
-	});
+		}
+	};
+
+	// Handshake flights involve key exchange and signatures, keep them off the regular lane so
+	// they don't delay media of established connections
+	if (state() == State::Connecting)
+		ThreadPool::Instance().enqueueBackground(std::move(task));
+	else
+		ThreadPool::Instance().enqueue(std::move(task));
+}
+
+optional<milliseconds> DtlsTransport::handshakeDuration() const {
+	int duration = mHandshakeDurationMs;
+	return duration >= 0 ? std::make_optional(milliseconds(duration)) : nullopt;
+}
+
+void DtlsTransport::handshakeStarted() { mHandshakeStart = steady_clock::now(); }
+
+void DtlsTransport::handshakeFinished() {
+	auto duration = duration_cast<milliseconds>(steady_clock::now() - mHandshakeStart);
+	mHandshakeDurationMs = int(duration.count());
+	PLOG_INFO << "DTLS handshake finished in " << duration.count() << " ms";
+}
+
+void DtlsTransport::setRetransmitTimeouts(milliseconds initial, milliseconds max) {
+	mInitialRetransmitTimeout = std::max(initial, MIN_DTLS_RETRANSMIT_TIMEOUT);
+	mMaxRetransmitTimeout = std::max(max, mInitialRetransmitTimeout);
+}
+
+milliseconds DtlsTransport::retransmitTimeout() const {
+	// Waiting for the configured timeout is only needed when the round-trip time is unknown
+	if (!mRtt)
+		return mInitialRetransmitTimeout;
+
+	return std::clamp(*mRtt * DTLS_RETRANSMIT_RTT_FACTOR, MIN_DTLS_RETRANSMIT_TIMEOUT,
+	                  mInitialRetransmitTimeout);
+}
+
+void DtlsTransport::updateRtt(milliseconds sample) {
+	mRtt = mRtt ? (*mRtt * 7 + sample) / 8 : sample;
+	PLOG_VERBOSE << "DTLS round-trip time sample is " << sample.count() << " ms, smoothed "
+	             << mRtt->count() << " ms";
+}
+
+void DtlsTransport::flushDatagram() {
+	// Requires mSslMutex to be locked
+	if (mDatagram.empty())
+		return;
+
+	outgoing(make_message(mDatagram.begin(), mDatagram.end()));
+	mDatagram.clear();
 }
 
 #if USE_GNUTLS
@@ -55,7 +107,7 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
                              verifier_callback verifierCallback, state_callback stateChangeCallback)
     : Transport(lower, std::move(stateChangeCallback)), mMtu(mtu), mCertificate(certificate),
       mFingerprintAlgorithm(fingerprintAlgorithm), mVerifierCallback(std::move(verifierCallback)),
-      mIsClient(lower->role() == Description::Role::Active),
+      mIsClient(lower->role() == Description::Role::Active), mRtt(lower->rtt()),
       mIncomingQueue(RECV_QUEUE_LIMIT, message_size_func) {
 
 	PLOG_DEBUG << "Initializing DTLS transport (GnuTLS)";
@@ -86,9 +138,6 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 
 		gnutls::check(gnutls_credentials_set(mSession, GNUTLS_CRD_CERTIFICATE, creds));
 
-		gnutls_dtls_set_timeouts(mSession,
-		                         1000,   // 1s retransmission timeout recommended by RFC 6347
-		                         30000); // 30s total timeout
 		gnutls_handshake_set_timeout(mSession, 30000);
 
 		gnutls_session_set_ptr(mSession, this);
@@ -102,9 +151,9 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 		throw;
 	}
 
-	// Set recommended medium-priority DSCP value for handshake
-	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-	mCurrentDscp = 10; // AF11: Assured Forwarding class 1, low drop probability
+	// The handshake gates the connection, send it as control traffic
+	mCurrentTrafficClass = TrafficClass::Control;
+	mCurrentDscp = GetTrafficClassDscp(TrafficClass::Control);
 }
 
 DtlsTransport::~DtlsTransport() {
@@ -117,12 +166,17 @@ DtlsTransport::~DtlsTransport() {
 void DtlsTransport::start() {
 	PLOG_DEBUG << "Starting DTLS transport";
 	registerIncoming();
+	handshakeStarted();
 	changeState(State::Connecting);
 
 	size_t mtu = mMtu.value_or(DEFAULT_MTU) - 8 - 40; // UDP/IPv6
 	gnutls_dtls_set_mtu(mSession, static_cast<unsigned int>(mtu));
 	PLOG_VERBOSE << "DTLS MTU set to " << mtu;
 
+	// GnuTLS has no maximum retransmission timeout, it bounds the whole handshake instead
+	gnutls_dtls_set_timeouts(mSession, static_cast<unsigned int>(retransmitTimeout().count()),
+	                         static_cast<unsigned int>(mMaxRetransmitTimeout.count()));
+
 	enqueueRecv(); // to initiate the handshake
 }
 
@@ -143,6 +197,7 @@ bool DtlsTransport::send(message_ptr message) {
 	do {
 		std::lock_guard lock(mSendMutex);
 		mCurrentDscp = message->dscp;
+		mCurrentTrafficClass = message->trafficClass;
 		ret = gnutls_record_send(mSession, message->data(), message->size());
 	} while (ret == GNUTLS_E_INTERRUPTED || ret == GNUTLS_E_AGAIN);
 
@@ -168,6 +223,7 @@ void DtlsTransport::incoming(message_ptr message) {
 
 bool DtlsTransport::outgoing(message_ptr message) {
 	message->dscp = mCurrentDscp;
+	message->trafficClass = mCurrentTrafficClass;
 
 	bool result = Transport::outgoing(std::move(message));
 	mOutgoingResult = result;
@@ -220,7 +276,7 @@ void DtlsTransport::doRecv() {
 			// See https://www.rfc-editor.org/rfc/rfc8261.html#section-5
 			gnutls_dtls_set_mtu(mSession, bufferSize + 1);
 
-			PLOG_INFO << "DTLS handshake finished";
+			handshakeFinished();
 			changeState(State::Connected);
 			postHandshake();
 		}
@@ -377,13 +433,24 @@ const mbedtls_ssl_srtp_profile srtpSupportedProtectionProfiles[] = {
     MBEDTLS_TLS_SRTP_UNSET,
 };
 
+#ifdef ESP32_PORT
+// Groups for the ECDHE key exchange by preference, P-256 goes first since the ECC peripheral
+// accelerates it while X25519 is computed in software
+const uint16_t dtlsPreferredGroups[] = {
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP256R1,
+    MBEDTLS_SSL_IANA_TLS_GROUP_X25519,
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP384R1,
+    MBEDTLS_SSL_IANA_TLS_GROUP_NONE,
+};
+#endif
+
 DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr certificate,
                              optional<size_t> mtu,
                              CertificateFingerprint::Algorithm fingerprintAlgorithm,
                              verifier_callback verifierCallback, state_callback stateChangeCallback)
     : Transport(lower, std::move(stateChangeCallback)), mMtu(mtu), mCertificate(certificate),
       mFingerprintAlgorithm(fingerprintAlgorithm), mVerifierCallback(std::move(verifierCallback)),
-      mIsClient(lower->role() == Description::Role::Active),
+      mIsClient(lower->role() == Description::Role::Active), mRtt(lower->rtt()),
       mIncomingQueue(RECV_QUEUE_LIMIT, message_size_func) {
 
 	PLOG_DEBUG << "Initializing DTLS transport (MbedTLS)";
@@ -407,6 +474,7 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 #ifdef ESP32_PORT
 		// ESP32: Use modern MbedTLS API for version setting
 		mbedtls_ssl_conf_max_tls_version(&mConf, MBEDTLS_SSL_VERSION_TLS1_2);
+		mbedtls_ssl_conf_groups(&mConf, dtlsPreferredGroups);
 #else
 		mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3); // TLS 1.2
 #endif
@@ -420,6 +488,13 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 		mbedtls_ssl_conf_dtls_cookies(&mConf, NULL, NULL, NULL);
 		mbedtls_ssl_conf_dtls_srtp_protection_profiles(&mConf, srtpSupportedProtectionProfiles);
 
+		// The configuration must not change once set up, so Mbed TLS backs off from the minimum
+		// timeout and never gives up by itself. SetTimerCallback() scales its timer to the
+		// adaptive timeout of the flight and fails the handshake past the maximum.
+		mbedtls_ssl_conf_handshake_timeout(&mConf,
+		                                   static_cast<uint32_t>(MIN_DTLS_RETRANSMIT_TIMEOUT.count()),
+		                                   std::numeric_limits<uint32_t>::max());
+
 		mbedtls::check(mbedtls_ssl_setup(&mSsl, &mConf));
 
 		mbedtls_ssl_set_export_keys_cb(&mSsl, DtlsTransport::ExportKeysCallback, this);
@@ -434,9 +509,9 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 		throw;
 	}
 
-	// Set recommended medium-priority DSCP value for handshake
-	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-	mCurrentDscp = 10; // AF11: Assured Forwarding class 1, low drop probability
+	// The handshake gates the connection, send it as control traffic
+	mCurrentTrafficClass = TrafficClass::Control;
+	mCurrentDscp = GetTrafficClassDscp(TrafficClass::Control);
 }
 
 DtlsTransport::~DtlsTransport() {
@@ -460,12 +535,14 @@ void DtlsTransport::Cleanup() {
 void DtlsTransport::start() {
 	PLOG_DEBUG << "Starting DTLS transport";
 	registerIncoming();
+	handshakeStarted();
 	changeState(State::Connecting);
 
 	{
 		std::lock_guard lock(mSslMutex);
 		size_t mtu = mMtu.value_or(DEFAULT_MTU) - 8 - 40; // UDP/IPv6
 		mbedtls_ssl_set_mtu(&mSsl, static_cast<unsigned int>(mtu));
+		mDatagramMaxSize = mtu;
 		PLOG_VERBOSE << "DTLS MTU set to " << mtu;
 	}
 
@@ -492,6 +569,7 @@ bool DtlsTransport::send(message_ptr message) {
 			return false;
 
 		mCurrentDscp = message->dscp;
+		mCurrentTrafficClass = message->trafficClass;
 		ret = mbedtls_ssl_write(&mSsl, reinterpret_cast<const unsigned char *>(message->data()),
 		                        message->size());
 	} while (!mbedtls::check(ret));
@@ -499,6 +577,54 @@ bool DtlsTransport::send(message_ptr message) {
 	return mOutgoingResult;
 }
 
+bool DtlsTransport::sendMultiple(message_vector &messages) {
+	if (state() != State::Connected)
+		return false;
+
+	// Encrypt the whole batch under a single lock, and since DTLS allows multiple records per
+	// datagram (RFC 6347 4.1.1), coalesce small records, for instance SCTP packets carrying only a
+	// SACK, instead of sending one datagram each.
+	std::lock_guard lock(mSslMutex);
+	bool result = true;
+	mPacking = true;
+	try {
+		for (const auto &message : messages) {
+			if (!message)
+				continue;
+
+			PLOG_VERBOSE << "Send size=" << message->size();
+
+			if (message->size() > size_t(mbedtls_ssl_get_max_out_record_payload(&mSsl))) {
+				result = false;
+				continue;
+			}
+
+			if (mCurrentDscp != message->dscp || mCurrentTrafficClass != message->trafficClass) {
+				flushDatagram(); // a datagram has a single DSCP value
+				mCurrentDscp = message->dscp;
+				mCurrentTrafficClass = message->trafficClass;
+			}
+
+			int ret;
+			do {
+				ret = mbedtls_ssl_write(&mSsl,
+				                        reinterpret_cast<const unsigned char *>(message->data()),
+				                        message->size());
+			} while (!mbedtls::check(ret));
+		}
+
+		flushDatagram();
+
+	} catch (...) {
+		mPacking = false;
+		mDatagram.clear();
+		throw;
+	}
+
+	mPacking = false;
+	return result && mOutgoingResult;
+}
+
 void DtlsTransport::incoming(message_ptr message) {
 	if (!message) {
 		mIncomingQueue.stop();
@@ -512,6 +638,7 @@ void DtlsTransport::incoming(message_ptr message) {
 
 bool DtlsTransport::outgoing(message_ptr message) {
 	message->dscp = mCurrentDscp;
+	message->trafficClass = mCurrentTrafficClass;
 
 	bool result = Transport::outgoing(std::move(message));
 	mOutgoingResult = result;
@@ -542,12 +669,20 @@ void DtlsTransport::doRecv() {
 		if (state() == State::Connecting) {
 			while (true) {
 				int ret;
+				bool timedOut;
 				{
 					std::lock_guard lock(mSslMutex);
+					mPacking = true;
 					ret = mbedtls_ssl_handshake(&mSsl);
+					flushDatagram();
+					mPacking = false;
+					timedOut = mTimedOut;
 				}
 
 				if (ret == MBEDTLS_ERR_SSL_WANT_READ) {
+					if (timedOut)
+						throw std::runtime_error("Handshake timeout");
+
 					ThreadPool::Instance().schedule(mTimerSetAt + milliseconds(mFinMs),
 					                                [weak_this = weak_from_this()]() {
 						                                if (auto locked = weak_this.lock())
@@ -564,7 +699,7 @@ void DtlsTransport::doRecv() {
 						mbedtls_ssl_set_mtu(&mSsl, static_cast<unsigned int>(bufferSize + 1));
 					}
 
-					PLOG_INFO << "DTLS handshake finished";
+					handshakeFinished();
 					changeState(State::Connected);
 					postHandshake();
 					break;
@@ -640,7 +775,14 @@ int DtlsTransport::WriteCallback(void *ctx, const unsigned char *buf, size_t len
 	try {
 		if (len > 0) {
 			auto b = reinterpret_cast<const byte *>(buf);
-			t->outgoing(make_message(b, b + len));
+			if (t->mPacking) {
+				if (t->mDatagram.size() + len > t->mDatagramMaxSize)
+					t->flushDatagram();
+
+				t->mDatagram.insert(t->mDatagram.end(), b, b + len);
+			} else {
+				t->outgoing(make_message(b, b + len));
+			}
 		}
 		return int(len);
 
@@ -678,14 +820,35 @@ int DtlsTransport::ReadCallback(void *ctx, unsigned char *buf, size_t len) {
 	}
 }
 
-void DtlsTransport::SetTimerCallback(void *ctx, uint32_t int_ms, uint32_t fin_ms) {
+void DtlsTransport::SetTimerCallback(void *ctx, uint32_t /*int_ms*/, uint32_t fin_ms) {
 	auto dtlsTransport = static_cast<DtlsTransport *>(ctx);
-	dtlsTransport->mIntMs = int_ms;
-	dtlsTransport->mFinMs = fin_ms;
-
-	if (fin_ms != 0) {
-		dtlsTransport->mTimerSetAt = std::chrono::steady_clock::now();
+	auto now = std::chrono::steady_clock::now();
+	if (fin_ms == 0) {
+		// The peer answered the flight, which gives a round-trip sample unless the flight was
+		// retransmitted, as the answer might then be to any of the copies
+		if (dtlsTransport->mFinMs != 0 && dtlsTransport->mBackoff == 1 &&
+		    !dtlsTransport->mTimerExpired)
+			dtlsTransport->updateRtt(duration_cast<milliseconds>(now - dtlsTransport->mTimerSetAt));
+
+		dtlsTransport->mIntMs = 0;
+		dtlsTransport->mFinMs = 0;
+		dtlsTransport->mTimerExpired = false;
+		return;
 	}
+
+	// Mbed TLS doubles the timer from the configured minimum on each retransmission, apply the same
+	// backoff to the adaptive timeout, and fail once it exceeds the maximum like handleTimeout()
+	// does with OpenSSL
+	uint32_t backoff = std::max(fin_ms / static_cast<uint32_t>(MIN_DTLS_RETRANSMIT_TIMEOUT.count()),
+	                            uint32_t(1));
+	auto timeout = dtlsTransport->retransmitTimeout() * backoff;
+	if (timeout > dtlsTransport->mMaxRetransmitTimeout)
+		dtlsTransport->mTimedOut = true;
+
+	dtlsTransport->mBackoff = backoff;
+	dtlsTransport->mFinMs = static_cast<uint32_t>(timeout.count());
+	dtlsTransport->mIntMs = dtlsTransport->mFinMs / 4;
+	dtlsTransport->mTimerSetAt = now;
 }
 
 int DtlsTransport::GetTimerCallback(void *ctx) {
@@ -695,6 +858,7 @@ int DtlsTransport::GetTimerCallback(void *ctx) {
 	if (dtlsTransport->mFinMs == 0) {
 		return -1;
 	} else if (now >= dtlsTransport->mTimerSetAt + milliseconds(dtlsTransport->mFinMs)) {
+		dtlsTransport->mTimerExpired = true; // Mbed TLS retransmits the flight
 		return 2;
 	} else if (now >= dtlsTransport->mTimerSetAt + milliseconds(dtlsTransport->mIntMs)) {
 		return 1;
@@ -738,7 +902,7 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
                              verifier_callback verifierCallback, state_callback stateChangeCallback)
     : Transport(lower, std::move(stateChangeCallback)), mMtu(mtu), mCertificate(certificate),
       mFingerprintAlgorithm(fingerprintAlgorithm), mVerifierCallback(std::move(verifierCallback)),
-      mIsClient(lower->role() == Description::Role::Active),
+      mIsClient(lower->role() == Description::Role::Active), mRtt(lower->rtt()),
       mIncomingQueue(RECV_QUEUE_LIMIT, message_size_func) {
 
 	PLOG_DEBUG << "Initializing DTLS transport (OpenSSL)";
@@ -789,6 +953,9 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 			throw std::runtime_error("Failed to create SSL instance");
 
 		SSL_set_ex_data(mSsl, TransportExIndex, this);
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+		DTLS_set_timer_cb(mSsl, TimerCallback);
+#endif
 
 		if (mIsClient)
 			SSL_set_connect_state(mSsl);
@@ -830,9 +997,9 @@ DtlsTransport::DtlsTransport(shared_ptr<IceTransport> lower, certificate_ptr cer
 		throw;
 	}
 
-	// Set recommended medium-priority DSCP value for handshake
-	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-	mCurrentDscp = 10; // AF11: Assured Forwarding class 1, low drop probability
+	// The handshake gates the connection, send it as control traffic
+	mCurrentTrafficClass = TrafficClass::Control;
+	mCurrentDscp = GetTrafficClassDscp(TrafficClass::Control);
 }
 
 DtlsTransport::~DtlsTransport() {
@@ -846,6 +1013,7 @@ DtlsTransport::~DtlsTransport() {
 void DtlsTransport::start() {
 	PLOG_DEBUG << "Starting DTLS transport";
 	registerIncoming();
+	handshakeStarted();
 	changeState(State::Connecting);
 
 	int ret, err;
@@ -854,11 +1022,16 @@ void DtlsTransport::start() {
 
 		size_t mtu = mMtu.value_or(DEFAULT_MTU) - 8 - 40; // UDP/IPv6
 		SSL_set_mtu(mSsl, static_cast<unsigned int>(mtu));
+		mDatagramMaxSize = mtu;
 		PLOG_VERBOSE << "DTLS MTU set to " << mtu;
 
+		// OpenSSL writes one record per message, pack them until the handshake is finished
+		mPacking = true;
+
 		// Initiate the handshake
 		ret = SSL_do_handshake(mSsl);
 		err = SSL_get_error(mSsl, ret);
+		flushDatagram();
 	}
 
 	openssl::check_error(err, "Handshake failed");
@@ -883,6 +1056,7 @@ bool DtlsTransport::send(message_ptr message) {
 	{
 		std::lock_guard lock(mSslMutex);
 		mCurrentDscp = message->dscp;
+		mCurrentTrafficClass = message->trafficClass;
 		ret = SSL_write(mSsl, message->data(), int(message->size()));
 		err = SSL_get_error(mSsl, ret);
 	}
@@ -893,6 +1067,45 @@ bool DtlsTransport::send(message_ptr message) {
 	return mOutgoingResult;
 }
 
+bool DtlsTransport::sendMultiple(message_vector &messages) {
+	if (state() != State::Connected)
+		return false;
+
+	// As with Mbed TLS, SSL_write() makes one record per message, which BioMethodWrite() packs in
+	// datagrams up to the MTU
+	std::lock_guard lock(mSslMutex);
+	bool result = true;
+	mPacking = true;
+	try {
+		for (const auto &message : messages) {
+			if (!message)
+				continue;
+
+			PLOG_VERBOSE << "Send size=" << message->size();
+
+			if (mCurrentDscp != message->dscp || mCurrentTrafficClass != message->trafficClass) {
+				flushDatagram(); // a datagram has a single DSCP value
+				mCurrentDscp = message->dscp;
+				mCurrentTrafficClass = message->trafficClass;
+			}
+
+			int ret = SSL_write(mSsl, message->data(), int(message->size()));
+			if (!openssl::check_error(SSL_get_error(mSsl, ret)))
+				result = false;
+		}
+
+		flushDatagram();
+
+	} catch (...) {
+		mPacking = false;
+		mDatagram.clear();
+		throw;
+	}
+
+	mPacking = false;
+	return result && mOutgoingResult;
+}
+
 void DtlsTransport::incoming(message_ptr message) {
 	if (!message) {
 		mIncomingQueue.stop();
@@ -907,6 +1120,7 @@ void DtlsTransport::incoming(message_ptr message) {
 
 bool DtlsTransport::outgoing(message_ptr message) {
 	message->dscp = mCurrentDscp;
+	message->trafficClass = mCurrentTrafficClass;
 
 	bool result = Transport::outgoing(std::move(message));
 	mOutgoingResult = result;
@@ -957,6 +1171,7 @@ void DtlsTransport::doRecv() {
 					std::lock_guard lock(mSslMutex);
 					ret = SSL_do_handshake(mSsl);
 					err = SSL_get_error(mSsl, ret);
+					flushDatagram();
 				}
 
 				if (openssl::check_error(err, "Handshake failed")) {
@@ -965,29 +1180,38 @@ void DtlsTransport::doRecv() {
 					{
 						std::lock_guard lock(mSslMutex);
 						SSL_set_mtu(mSsl, bufferSize + 1);
+						mPacking = false;
 					}
 
-					PLOG_INFO << "DTLS handshake finished";
+					handshakeFinished();
 					postHandshake();
 					changeState(State::Connected);
 				}
 			}
 
 			if (state() == State::Connected) {
+				// SSL_read() returns a single record, read until the datagram is consumed as it
+				// may hold several
 				int ret, err;
-				{
-					std::lock_guard lock(mSslMutex);
-					ret = SSL_read(mSsl, buffer, bufferSize);
-					err = SSL_get_error(mSsl, ret);
-				}
+				do {
+					{
+						std::lock_guard lock(mSslMutex);
+						ret = SSL_read(mSsl, buffer, bufferSize);
+						err = SSL_get_error(mSsl, ret);
+					}
+
+					if (err == SSL_ERROR_ZERO_RETURN)
+						break;
+
+					if (openssl::check_error(err))
+						recv(make_message(buffer, buffer + ret));
+
+				} while (err == SSL_ERROR_NONE);
 
 				if (err == SSL_ERROR_ZERO_RETURN) {
 					PLOG_DEBUG << "TLS connection cleanly closed";
 					break;
 				}
-
-				if (openssl::check_error(err))
-					recv(make_message(buffer, buffer + ret));
 			}
 		}
 
@@ -1013,6 +1237,7 @@ void DtlsTransport::handleTimeout() {
 
 	// Warning: This function breaks the usual return value convention
 	int ret = DTLSv1_handle_timeout(mSsl);
+	flushDatagram();
 	if (ret < 0) {
 		throw std::runtime_error("Handshake timeout"); // write BIO can't fail
 	} else if (ret > 0) {
@@ -1023,10 +1248,9 @@ void DtlsTransport::handleTimeout() {
 	if (DTLSv1_get_timeout(mSsl, &tv)) {
 		auto timeout = milliseconds(tv.tv_sec * 1000 + tv.tv_usec / 1000);
 		// Also handle handshake timeout manually because OpenSSL actually
-		// doesn't... OpenSSL backs off exponentially in base 2 starting from the
-		// recommended 1s so this allows for 5 retransmissions and fails after
-		// roughly 30s.
-		if (timeout > 30s)
+		// doesn't... OpenSSL backs off exponentially in base 2 from the initial
+		// timeout, so fail once the backoff exceeds the maximum.
+		if (timeout > mMaxRetransmitTimeout)
 			throw std::runtime_error("Handshake timeout");
 
 		LOG_VERBOSE << "DTLS retransmit timeout is " << timeout.count() << "ms";
@@ -1037,6 +1261,14 @@ void DtlsTransport::handleTimeout() {
 	}
 }
 
+unsigned int DtlsTransport::TimerCallback(SSL *ssl, unsigned int timer_us) {
+	DtlsTransport *t = static_cast<DtlsTransport *>(SSL_get_ex_data(ssl, TransportExIndex));
+	if (timer_us == 0) // new flight
+		return static_cast<unsigned int>(duration_cast<microseconds>(t->retransmitTimeout()).count());
+
+	return 2 * timer_us; // handleTimeout() fails past the maximum
+}
+
 int DtlsTransport::CertificateCallback(int /*preverify_ok*/, X509_STORE_CTX *ctx) {
 	SSL *ssl =
 	    static_cast<SSL *>(X509_STORE_CTX_get_ex_data(ctx, SSL_get_ex_data_X509_STORE_CTX_idx()));
@@ -1082,13 +1314,23 @@ int DtlsTransport::BioMethodWrite(BIO *bio, const char *in, int inl) {
 	if (!transport)
 		return -1;
 	auto b = reinterpret_cast<const byte *>(in);
-	transport->outgoing(make_message(b, b + inl));
+	if (transport->mPacking) {
+		if (transport->mDatagram.size() + inl > transport->mDatagramMaxSize)
+			transport->flushDatagram();
+
+		transport->mDatagram.insert(transport->mDatagram.end(), b, b + inl);
+	} else {
+		transport->outgoing(make_message(b, b + inl));
+	}
 	return inl; // can't fail
 }
 
-long DtlsTransport::BioMethodCtrl(BIO * /*bio*/, int cmd, long /*num*/, void * /*ptr*/) {
+long DtlsTransport::BioMethodCtrl(BIO *bio, int cmd, long /*num*/, void * /*ptr*/) {
 	switch (cmd) {
 	case BIO_CTRL_FLUSH:
+		// OpenSSL flushes at the end of each flight
+		if (auto transport = reinterpret_cast<DtlsTransport *>(BIO_get_data(bio)))
+			transport->flushDatagram();
 		return 1;
 	case BIO_CTRL_DGRAM_QUERY_MTU:
 		return 0; // SSL_OP_NO_QUERY_MTU must be set
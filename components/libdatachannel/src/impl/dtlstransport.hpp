@@ -11,11 +11,13 @@
 
 #include "certificate.hpp"
 #include "common.hpp"
+#include "internals.hpp"
 #include "queue.hpp"
 #include "tls.hpp"
 #include "transport.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -39,8 +41,15 @@ public:
 	virtual void start() override;
 	virtual void stop() override;
 	virtual bool send(message_ptr message) override; // false if dropped
+#if !USE_GNUTLS
+	virtual bool sendMultiple(message_vector &messages) override; // packs records in datagrams
+#endif
 
 	bool isClient() const { return mIsClient; }
+	optional<std::chrono::milliseconds> handshakeDuration() const; // once connected
+
+	// Must be called before start()
+	void setRetransmitTimeouts(std::chrono::milliseconds initial, std::chrono::milliseconds max);
 
 protected:
 	virtual void incoming(message_ptr message) override;
@@ -50,6 +59,11 @@ protected:
 
 	void enqueueRecv();
 	void doRecv();
+	void handshakeStarted();
+	void handshakeFinished();
+	std::chrono::milliseconds retransmitTimeout() const; // initial timeout for the next flight
+	void updateRtt(std::chrono::milliseconds sample);
+	void flushDatagram();
 
 	const optional<size_t> mMtu;
 	const certificate_ptr mCertificate;
@@ -57,11 +71,24 @@ protected:
 	const verifier_callback mVerifierCallback;
 	const bool mIsClient;
 
+	std::chrono::milliseconds mInitialRetransmitTimeout = DEFAULT_DTLS_INITIAL_RETRANSMIT_TIMEOUT;
+	std::chrono::milliseconds mMaxRetransmitTimeout = DEFAULT_DTLS_MAX_RETRANSMIT_TIMEOUT;
+	optional<std::chrono::milliseconds> mRtt; // smoothed, seeded from ICE connectivity checks
+
+	// Handshake flights, and except with GnuTLS records written in sendMultiple(), are coalesced
+	// into datagrams up to the MTU
+	bool mPacking = false;
+	binary mDatagram;
+	size_t mDatagramMaxSize = 0;
+
 	Queue<message_ptr> mIncomingQueue;
 	std::atomic<int> mPendingRecvCount = 0;
 	std::mutex mRecvMutex;
 	std::atomic<unsigned int> mCurrentDscp = 0;
+	std::atomic<TrafficClass> mCurrentTrafficClass = TrafficClass::Default;
 	std::atomic<bool> mOutgoingResult = true;
+	std::chrono::steady_clock::time_point mHandshakeStart;
+	std::atomic<int> mHandshakeDurationMs = -1;
 
 #if USE_GNUTLS
 	gnutls_session_t mSession;
@@ -81,6 +108,9 @@ protected:
 	std::recursive_mutex mSslMutex;
 
 	uint32_t mFinMs = 0, mIntMs = 0;
+	uint32_t mBackoff = 0;      // of the current flight, 1 until it is retransmitted
+	bool mTimerExpired = false; // since the timer was set
+	bool mTimedOut = false;     // the backoff went past the maximum timeout
 	std::chrono::time_point<std::chrono::steady_clock> mTimerSetAt;
 
 	char mMasterSecret[48];
@@ -106,6 +136,8 @@ protected:
 
 	void handleTimeout();
 
+	static unsigned int TimerCallback(SSL *ssl, unsigned int timer_us);
+
 	static BIO_METHOD *BioMethods;
 	static int TransportExIndex;
 	static std::mutex GlobalMutex;
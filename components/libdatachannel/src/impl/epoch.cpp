@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "epoch.hpp"
+#include "threadpool.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace rtc::impl {
+
+namespace {
+
+const auto CollectDelay = std::chrono::milliseconds(10);
+
+}
+
+// Plain data, so that Guards reach it without going through thread-local initialization
+struct Epoch::ThreadState {
+	std::atomic<uint64_t> *slot = nullptr;
+	int depth = 0;
+	bool overflow = false; // outermost Guard is counted in the overflow counter
+	bool released = false; // the thread is exiting, Guards are counted as overflow
+};
+
+struct Epoch::SlotRelease {
+	~SlotRelease() {
+		auto &local = Local();
+		Epoch::Instance().releaseSlot(local.slot);
+		local.slot = nullptr;
+		local.released = true;
+	}
+};
+
+Epoch &Epoch::Instance() {
+	static Epoch *instance = new Epoch; // Never destroyed, threads may exit after static destruction
+	return *instance;
+}
+
+Epoch::ThreadState &Epoch::Local() {
+	thread_local ThreadState state;
+	return state;
+}
+
+void Epoch::Enter() {
+	auto &local = Local();
+	if (local.depth++ > 0)
+		return; // nested
+
+	auto &epoch = Epoch::Instance();
+	if (!local.slot && !local.released) {
+		local.slot = epoch.acquireSlot();
+		if (local.slot) {
+			thread_local SlotRelease release; // releases the slot when the thread exits
+			(void)release;
+		}
+	}
+
+	// The announcement must be visible before any protected pointer is read
+	if (local.slot) {
+		uint64_t current = epoch.mGlobalEpoch.load(std::memory_order_relaxed);
+#if defined(__x86_64__) || defined(__i386__)
+		// A locked exchange is a full barrier on x86, and cheaper than a store and a fence
+		local.slot->exchange(current, std::memory_order_seq_cst);
+#else
+		local.slot->store(current, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+		local.overflow = false;
+	} else {
+		epoch.mOverflowReaders.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		local.overflow = true;
+	}
+}
+
+void Epoch::Leave() {
+	auto &local = Local();
+	if (--local.depth > 0)
+		return; // nested
+
+	auto &epoch = Epoch::Instance();
+	if (local.overflow)
+		epoch.mOverflowReaders.fetch_sub(1, std::memory_order_release);
+	else
+		local.slot->store(0, std::memory_order_release);
+}
+
+Epoch::Guard::Guard() { Enter(); }
+
+Epoch::Guard::~Guard() { Leave(); }
+
+void Epoch::retire(void *ptr, void (*deleter)(void *)) {
+	// Readers announcing a later epoch entered after the object was unpublished
+	uint64_t epoch = mGlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+	{
+		std::lock_guard lock(mRetiredMutex);
+		mRetired.push_back(Retired{ptr, deleter, epoch});
+	}
+
+	if (!collect())
+		scheduleCollect();
+}
+
+void Epoch::synchronize() {
+	uint64_t epoch = mGlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+	wait(epoch, false);
+}
+
+bool Epoch::drain() {
+	uint64_t epoch = mGlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+	bool drained = wait(epoch, true);
+
+	// Our own Guard might still hold the object
+	return drained && Local().depth == 0;
+}
+
+bool Epoch::collect() {
+	std::vector<Retired> ready;
+	bool done;
+	{
+		std::lock_guard lock(mRetiredMutex);
+		auto it = mRetired.begin();
+		while (it != mRetired.end()) {
+			if (isQuiescent(it->epoch)) {
+				ready.push_back(*it);
+				it = mRetired.erase(it);
+			} else {
+				++it;
+			}
+		}
+		done = mRetired.empty();
+	}
+
+	// Deleters might retire other objects
+	for (auto &r : ready)
+		r.deleter(r.ptr);
+
+	return done;
+}
+
+void Epoch::clear() {
+	std::vector<Retired> retired;
+	{
+		std::lock_guard lock(mRetiredMutex);
+		std::swap(retired, mRetired);
+	}
+
+	for (auto &r : retired)
+		r.deleter(r.ptr);
+}
+
+std::atomic<uint64_t> *Epoch::acquireSlot() {
+	for (size_t i = 0; i < MaxThreads; ++i)
+		if (!mSlotOwned[i].load(std::memory_order_relaxed) &&
+		    !mSlotOwned[i].exchange(true, std::memory_order_acquire))
+			return &mSlots[i];
+
+	return nullptr;
+}
+
+void Epoch::releaseSlot(std::atomic<uint64_t> *slot) {
+	slot->store(0, std::memory_order_release);
+	mSlotOwned[slot - mSlots.data()].store(false, std::memory_order_release);
+}
+
+bool Epoch::isQuiescent(uint64_t epoch) const {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mOverflowReaders.load(std::memory_order_acquire) > 0)
+		return false;
+
+	for (const auto &slot : mSlots) {
+		uint64_t announced = slot.load(std::memory_order_acquire);
+		if (announced != 0 && announced <= epoch)
+			return false;
+	}
+
+	return true;
+}
+
+bool Epoch::wait(uint64_t epoch, bool skipWaiting) {
+	auto &local = Local();
+	auto *self = local.slot;
+	size_t index = self ? size_t(self - mSlots.data()) : MaxThreads;
+	if (index < MaxThreads)
+		mSlotWaiting[index].store(true, std::memory_order_seq_cst);
+
+	// Our own Guard must not block the wait, even if it is counted as an overflow reader
+	int ownOverflow = local.overflow && local.depth > 0 ? 1 : 0;
+	bool skipped;
+	int spins = 0;
+	while (true) {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		bool quiescent = mOverflowReaders.load(std::memory_order_acquire) <= ownOverflow;
+		skipped = false;
+		for (size_t i = 0; quiescent && i < MaxThreads; ++i) {
+			if (i == index)
+				continue;
+
+			uint64_t announced = mSlots[i].load(std::memory_order_acquire);
+			if (announced == 0 || announced > epoch)
+				continue;
+
+			if (skipWaiting && mSlotWaiting[i].load(std::memory_order_acquire))
+				skipped = true;
+			else
+				quiescent = false;
+		}
+		if (quiescent)
+			break;
+
+		// Readers only hold a Guard for a packet, but they might have a lower priority
+		if (++spins < 16)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	if (index < MaxThreads)
+		mSlotWaiting[index].store(false, std::memory_order_release);
+
+	return !skipped;
+}
+
+void Epoch::scheduleCollect() {
+	{
+		std::lock_guard lock(mRetiredMutex);
+		if (std::exchange(mCollectScheduled, true))
+			return;
+	}
+
+	// If the thread pool is stopped, Init cleanup clears what is left
+	ThreadPool::Instance().schedule(CollectDelay, [this]() {
+		{
+			std::lock_guard lock(mRetiredMutex);
+			mCollectScheduled = false;
+		}
+		if (!collect())
+			scheduleCollect();
+	});
+}
+
+CallbackGuard::CallbackGuard() { Epoch::Enter(); }
+
+CallbackGuard::~CallbackGuard() { Epoch::Leave(); }
+
+void ReleaseCallback(void *ptr, void (*deleter)(void *)) {
+	auto &epoch = Epoch::Instance();
+	if (epoch.drain())
+		deleter(ptr);
+	else
+		epoch.retire(ptr, deleter);
+}
+
+} // namespace rtc::impl
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_EPOCH_H
+#define RTC_IMPL_EPOCH_H
+
+#include "common.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace rtc::impl {
+
+// Epoch-based reclamation
+// Readers dereference atomically published pointers inside a Guard, which announces the global
+// epoch in a slot owned by the thread. A writer unpublishes an object then retires it, and the
+// object is deleted once every reader that might still see it has left its Guard. Entering and
+// leaving a Guard costs two stores, with no lock and no reference count.
+class Epoch final {
+public:
+	static const size_t MaxThreads = 32; // Threads beyond share an overflow counter
+
+	static Epoch &Instance();
+
+	class Guard final {
+	public:
+		Guard();
+		~Guard();
+
+		Guard(const Guard &) = delete;
+		Guard &operator=(const Guard &) = delete;
+	};
+
+	// Deletes the object once no Guard entered before the call is active
+	template <typename T> void retire(T *ptr) {
+		if (ptr)
+			retire(ptr, [](void *p) { delete static_cast<T *>(p); });
+	}
+
+	void retire(void *ptr, void (*deleter)(void *));
+	void synchronize(); // Waits until no Guard entered before the call is active, except ours
+	bool collect();     // Returns false if retired objects are still pending
+	void clear();       // Deletes everything, for cleanup when no reader remains
+
+	// Like synchronize(), but does not wait for threads which are themselves waiting, so that
+	// threads waiting from inside Guards cannot deadlock. Returns true if the unpublished object
+	// may be deleted right away, false if it must be retired.
+	bool drain();
+
+private:
+	Epoch() = default;
+
+	struct ThreadState;
+	struct SlotRelease;
+	static ThreadState &Local();
+	static void Enter();
+	static void Leave();
+
+	friend class CallbackGuard;
+
+	struct Retired {
+		void *ptr;
+		void (*deleter)(void *);
+		uint64_t epoch;
+	};
+
+	std::atomic<uint64_t> *acquireSlot();
+	void releaseSlot(std::atomic<uint64_t> *slot);
+	bool isQuiescent(uint64_t epoch) const;
+	bool wait(uint64_t epoch, bool skipWaiting); // Returns false if a waiting thread was skipped
+	void scheduleCollect();
+
+	std::atomic<uint64_t> mGlobalEpoch = 1; // 0 is never a valid epoch, it marks idle slots
+	std::array<std::atomic<uint64_t>, MaxThreads> mSlots = {};
+	std::array<std::atomic<bool>, MaxThreads> mSlotOwned = {};
+	std::array<std::atomic<bool>, MaxThreads> mSlotWaiting = {};
+	std::atomic<int> mOverflowReaders = 0; // Readers without a slot block reclamation
+
+	std::mutex mRetiredMutex;
+	std::vector<Retired> mRetired;
+	bool mCollectScheduled = false;
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -0,0 +1,612 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "heapprofiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef ESP32_PORT
+#include "sdkconfig.h"
+#include <esp_memory_utils.h>
+#ifdef __XTENSA__
+#include <esp_cpu_utils.h>
+#include <esp_debug_helpers.h>
+#endif
+#else
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
+#ifdef __linux__
+#include <link.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace rtc::impl {
+
+namespace {
+
+std::atomic<HeapProfiler *> instance = nullptr;
+
+#ifndef ESP32_PORT
+thread_local bool inProfiler = false; // backtrace() may allocate on first use
+#endif
+
+const size_t SiteLoadLimit = HeapProfiler::SiteCapacity / 8 * 7;
+const size_t SampleLoadLimit = HeapProfiler::SampleCapacity / 8 * 7;
+const uintptr_t MaxFrameSize = 64 * 1024;
+
+// Frames of the allocator itself, pruned by pprof along with everything below them
+const char *const AllocatorFrames =
+    "__wrap_(malloc|calloc|realloc)|__real_.*|malloc|calloc|realloc|operator new.*|"
+    "placed_alloc.*|track_.*|esp32_psram_.*alloc.*|esp32_mem_class_alloc.*|"
+    "rtc::impl::HeapProfiler::.*";
+
+size_t home(uintptr_t address) {
+	return size_t(uint32_t(address >> 3) * 2654435761u) & (HeapProfiler::SampleCapacity - 1);
+}
+
+uint32_t hashFrames(const uintptr_t *frames, size_t depth) {
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < depth; ++i) {
+		uint64_t frame = frames[i];
+		for (int shift = 0; shift < int(sizeof(uintptr_t) * 8); shift += 8)
+			hash = (hash ^ uint32_t((frame >> shift) & 0xFF)) * 16777619u;
+	}
+	return hash;
+}
+
+// Weight of a sample, the inverse of the probability for an allocation of this size to be
+// sampled, so that weighted sums are unbiased estimates of the actual counts
+float sampleWeight(size_t size, size_t interval) {
+	double probability = -std::expm1(-double(size) / double(interval));
+	return probability > 0.0 ? float(1.0 / probability) : 1.f;
+}
+
+// Captures return addresses, starting with the caller of the function calling this one
+__attribute__((noinline)) size_t captureStack(uintptr_t *frames, size_t max) {
+	size_t depth = 0;
+#if defined(ESP32_PORT) && defined(__riscv) && CONFIG_ESP_SYSTEM_USE_FRAME_POINTER
+	// The frame pointer points past the saved return address and the caller frame pointer
+	auto fp = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+	bool skipped = false;
+	while (depth < max && fp % sizeof(uintptr_t) == 0) {
+		auto ptr = reinterpret_cast<void *>(fp);
+		if (!esp_ptr_in_dram(ptr) && !esp_ptr_external_ram(ptr))
+			break;
+
+		auto slots = reinterpret_cast<const uintptr_t *>(fp);
+		uintptr_t ra = slots[-1];
+		uintptr_t next = slots[-2];
+		if (!esp_ptr_executable(reinterpret_cast<void *>(ra)))
+			break;
+
+		if (skipped)
+			frames[depth++] = ra;
+		else
+			skipped = true;
+
+		if (next <= fp || next - fp > MaxFrameSize)
+			break;
+
+		fp = next;
+	}
+#elif defined(ESP32_PORT) && defined(__XTENSA__)
+	esp_backtrace_frame_t frame;
+	esp_backtrace_get_start(&frame.pc, &frame.sp, &frame.next_pc);
+	bool skipped = false;
+	while (depth < max && esp_backtrace_get_next_frame(&frame)) {
+		if (!esp_ptr_executable(reinterpret_cast<void *>(esp_cpu_process_stack_pc(frame.pc))))
+			break;
+
+		if (skipped)
+			frames[depth++] = esp_cpu_process_stack_pc(frame.pc);
+		else
+			skipped = true;
+	}
+#elif !defined(ESP32_PORT) && defined(__GLIBC__)
+	void *buffer[HeapProfiler::MaxDepth + 2];
+	int count = backtrace(buffer, int(std::min(max, HeapProfiler::MaxDepth) + 2));
+	for (int i = 2; i < count; ++i) // Skip this function and its caller
+		frames[depth++] = reinterpret_cast<uintptr_t>(buffer[i]);
+#else
+	(void)frames;
+	(void)max;
+#endif
+	return depth;
+}
+
+// Minimal protobuf encoder for profile.proto
+class ProtoWriter {
+public:
+	void varint(uint32_t field, uint64_t value) {
+		key(field, 0);
+		raw(value);
+	}
+
+	void bytes(uint32_t field, const void *data, size_t size) {
+		key(field, 2);
+		raw(size);
+		auto begin = static_cast<const uint8_t *>(data);
+		mBuffer.insert(mBuffer.end(), begin, begin + size);
+	}
+
+	void string(uint32_t field, const std::string &str) { bytes(field, str.data(), str.size()); }
+	void message(uint32_t field, const ProtoWriter &sub) { bytes(field, sub.data(), sub.size()); }
+
+	void packed(uint32_t field, const uint64_t *values, size_t count) {
+		ProtoWriter sub;
+		for (size_t i = 0; i < count; ++i)
+			sub.raw(values[i]);
+		message(field, sub);
+	}
+
+	const uint8_t *data() const { return mBuffer.data(); }
+	size_t size() const { return mBuffer.size(); }
+
+private:
+	void key(uint32_t field, uint32_t type) { raw(uint64_t(field) << 3 | type); }
+
+	void raw(uint64_t value) {
+		while (value >= 0x80) {
+			mBuffer.push_back(uint8_t(value | 0x80));
+			value >>= 7;
+		}
+		mBuffer.push_back(uint8_t(value));
+	}
+
+	std::vector<uint8_t> mBuffer;
+};
+
+struct Mapping {
+	uintptr_t start;
+	uintptr_t limit;
+	uintptr_t offset;
+	std::string filename;
+};
+
+std::vector<Mapping> listMappings() {
+	std::vector<Mapping> mappings;
+#if !defined(ESP32_PORT) && defined(__linux__)
+	dl_iterate_phdr(
+	    [](struct dl_phdr_info *info, size_t, void *data) {
+		    auto mappings = static_cast<std::vector<Mapping> *>(data);
+		    std::string filename = info->dlpi_name ? info->dlpi_name : "";
+		    if (filename.empty() && mappings->empty()) { // the executable comes first
+			    char path[512];
+			    ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+			    if (len > 0)
+				    filename.assign(path, size_t(len));
+		    }
+		    if (filename.empty())
+			    return 0;
+
+		    for (int i = 0; i < info->dlpi_phnum; ++i) {
+			    const auto &phdr = info->dlpi_phdr[i];
+			    if (phdr.p_type == PT_LOAD && (phdr.p_flags & PF_X)) {
+				    uintptr_t start = info->dlpi_addr + phdr.p_vaddr;
+				    mappings->push_back(
+				        Mapping{start, start + phdr.p_memsz, phdr.p_offset, filename});
+			    }
+		    }
+		    return 0;
+	    },
+	    &mappings);
+#else
+	// Firmware addresses are absolute, a single mapping lets pprof symbolize with the ELF
+	mappings.push_back(Mapping{0, UINTPTR_MAX, 0, "firmware.elf"});
+#endif
+	return mappings;
+}
+
+} // namespace
+
+HeapProfiler &HeapProfiler::Instance() {
+	static HeapProfiler *profiler = [] {
+		auto created = new HeapProfiler;
+		instance.store(created, std::memory_order_release);
+		return created;
+	}();
+	return *profiler;
+}
+
+HeapProfiler *HeapProfiler::Get() { return instance.load(std::memory_order_acquire); }
+
+HeapProfiler::HeapProfiler() {}
+
+bool HeapProfiler::start(size_t samplingInterval) {
+	// Must not happen under the lock, as the lock may be taken from within malloc
+	auto sites = static_cast<Site *>(std::calloc(SiteCapacity + 1, sizeof(Site)));
+	auto samples = static_cast<Sample *>(std::calloc(SampleCapacity, sizeof(Sample)));
+	if (!sites || !samples) {
+		std::free(sites);
+		std::free(samples);
+		return false;
+	}
+
+#if !defined(ESP32_PORT) && defined(__GLIBC__)
+	uintptr_t frames[MaxDepth];
+	captureStack(frames, MaxDepth); // load the unwinder now rather than from within malloc
+#endif
+
+	lock();
+	std::swap(mSites, sites);
+	std::swap(mSamples, samples);
+	mInterval = std::max(samplingInterval, size_t(1));
+	mSampleCount = 0;
+	mSiteCount = 0;
+	mDropped = 0;
+	mStartTime = std::chrono::system_clock::now();
+	mLive.store(0, std::memory_order_relaxed);
+	mCountdown.store(ptrdiff_t(nextCountdown()), std::memory_order_relaxed);
+	mRunning.store(true, std::memory_order_relaxed);
+	unlock();
+
+	std::free(sites);
+	std::free(samples);
+	return true;
+}
+
+void HeapProfiler::stop() { mRunning.store(false, std::memory_order_relaxed); }
+
+HeapProfilerStats HeapProfiler::stats() const {
+	HeapProfilerStats result;
+	lock();
+	result.running = mRunning.load(std::memory_order_relaxed);
+	result.samplingInterval = mInterval;
+	result.samples = mSampleCount;
+	result.liveSamples = mLive.load(std::memory_order_relaxed);
+	result.sites = mSiteCount;
+	result.dropped = mDropped;
+	unlock();
+	return result;
+}
+
+void HeapProfiler::Allocated(void *ptr, size_t size) {
+	auto profiler = Get();
+	if (!ptr || !profiler || !profiler->mRunning.load(std::memory_order_relaxed))
+		return;
+
+	ptrdiff_t amount = ptrdiff_t(std::min(size, size_t(PTRDIFF_MAX)));
+	if (profiler->mCountdown.fetch_sub(amount, std::memory_order_relaxed) > amount)
+		return;
+
+#ifndef ESP32_PORT
+	if (inProfiler)
+		return;
+
+	inProfiler = true;
+	profiler->sample(ptr, size);
+	inProfiler = false;
+#else
+	profiler->sample(ptr, size);
+#endif
+}
+
+void HeapProfiler::Reallocated(void *previous, void *ptr, size_t size) {
+	if (!ptr && size > 0) // failed, the previous block is untouched
+		return;
+
+	if (previous)
+		Freed(previous);
+
+	Allocated(ptr, size);
+}
+
+void HeapProfiler::Freed(void *ptr) {
+	auto profiler = Get();
+	if (!ptr || !profiler || !profiler->mLive.load(std::memory_order_relaxed))
+		return;
+
+	profiler->lock();
+	profiler->release(ptr);
+	profiler->unlock();
+}
+
+__attribute__((noinline)) void HeapProfiler::sample(void *ptr, size_t size) {
+	uintptr_t frames[MaxDepth];
+	size_t depth = captureStack(frames, MaxDepth);
+
+	lock();
+	mCountdown.store(ptrdiff_t(nextCountdown()), std::memory_order_relaxed);
+	if (!mSites || !mSamples) {
+		unlock();
+		return;
+	}
+
+	++mSampleCount;
+	Sample entry{reinterpret_cast<uintptr_t>(ptr), uint32_t(std::min(size, size_t(UINT32_MAX))),
+	             intern(frames, depth), sampleWeight(size, mInterval)};
+	Site &site = mSites[entry.site];
+	if (mLive.load(std::memory_order_relaxed) >= SampleLoadLimit) {
+		// Count the allocation but do not remember it, it would never be credited back
+		site.allocObjects += uint64_t(std::lround(entry.weight));
+		site.allocBytes += uint64_t(std::llround(double(entry.weight) * entry.size));
+		++mDropped;
+		unlock();
+		return;
+	}
+
+	size_t i = home(entry.address);
+	while (mSamples[i].address && mSamples[i].address != entry.address)
+		i = (i + 1) & (SampleCapacity - 1);
+
+	if (mSamples[i].address) // stale entry for a block freed unsampled
+		credit(mSites[mSamples[i].site], mSamples[i], false);
+	else
+		mLive.fetch_add(1, std::memory_order_relaxed);
+
+	mSamples[i] = entry;
+	credit(site, entry, true);
+	unlock();
+}
+
+void HeapProfiler::release(const void *ptr) {
+	// Requires the lock
+	if (!mSamples)
+		return;
+
+	auto address = reinterpret_cast<uintptr_t>(ptr);
+	size_t i = home(address);
+	while (mSamples[i].address != address) {
+		if (!mSamples[i].address)
+			return;
+
+		i = (i + 1) & (SampleCapacity - 1);
+	}
+
+	credit(mSites[mSamples[i].site], mSamples[i], false);
+	mLive.fetch_sub(1, std::memory_order_relaxed);
+
+	// Backward shift deletion, as in the memory tracker
+	size_t j = i;
+	while (true) {
+		j = (j + 1) & (SampleCapacity - 1);
+		if (!mSamples[j].address)
+			break;
+
+		size_t k = home(mSamples[j].address);
+		bool movable = (j > i) ? (k <= i || k > j) : (k <= i && k > j);
+		if (movable) {
+			mSamples[i] = mSamples[j];
+			i = j;
+		}
+	}
+	mSamples[i].address = 0;
+}
+
+uint32_t HeapProfiler::intern(const uintptr_t *frames, size_t depth) {
+	// Requires the lock, sites are never removed until the profiler is restarted
+	if (depth == 0)
+		return SiteCapacity;
+
+	uint32_t hash = hashFrames(frames, depth);
+	size_t i = hash & (SiteCapacity - 1);
+	while (mSites[i].depth) {
+		if (mSites[i].hash == hash && mSites[i].depth == depth &&
+		    std::equal(frames, frames + depth, mSites[i].frames))
+			return uint32_t(i);
+
+		i = (i + 1) & (SiteCapacity - 1);
+	}
+
+	if (mSiteCount >= SiteLoadLimit) {
+		++mDropped;
+		return SiteCapacity;
+	}
+
+	++mSiteCount;
+	mSites[i].hash = hash;
+	mSites[i].depth = uint32_t(depth);
+	std::copy(frames, frames + depth, mSites[i].frames);
+	return uint32_t(i);
+}
+
+void HeapProfiler::credit(Site &site, const Sample &sample, bool add) {
+	// Requires the lock
+	auto objects = uint64_t(std::lround(sample.weight));
+	auto bytes = uint64_t(std::llround(double(sample.weight) * sample.size));
+	if (add) {
+		site.allocObjects += objects;
+		site.allocBytes += bytes;
+		site.liveObjects += objects;
+		site.liveBytes += bytes;
+	} else {
+		site.liveObjects -= std::min(site.liveObjects, objects);
+		site.liveBytes -= std::min(site.liveBytes, bytes);
+	}
+}
+
+size_t HeapProfiler::nextCountdown() {
+	// Requires the lock, xorshift is plenty for spreading samples
+	mRandom ^= mRandom << 13;
+	mRandom ^= mRandom >> 17;
+	mRandom ^= mRandom << 5;
+	double uniform = double((mRandom >> 8) + 1) / double(1 << 24); // in (0, 1]
+	double countdown = -std::log(uniform) * double(mInterval);
+	return size_t(std::clamp(countdown, 1.0, double(mInterval) * 32));
+}
+
+binary HeapProfiler::exportProfile() const {
+	std::vector<Site> sites;
+	sites.reserve(SiteCapacity + 1); // allocate before taking the lock
+
+	lock();
+	if (mSites)
+		std::copy_if(mSites, mSites + SiteCapacity + 1, std::back_inserter(sites),
+		             [](const Site &site) { return site.allocObjects > 0; });
+	size_t interval = mInterval;
+	auto startTime = mStartTime;
+	unlock();
+
+	std::vector<std::string> strings{""};
+	auto index = [&strings](const std::string &str) {
+		auto it = std::find(strings.begin(), strings.end(), str);
+		if (it != strings.end())
+			return uint64_t(it - strings.begin());
+
+		strings.push_back(str);
+		return uint64_t(strings.size() - 1);
+	};
+
+	ProtoWriter profile;
+	auto valueType = [&](uint32_t field, const char *type, const char *unit) {
+		ProtoWriter vt;
+		vt.varint(1, index(type));
+		vt.varint(2, index(unit));
+		profile.message(field, vt);
+	};
+
+	// Same sample types as Go heap profiles, so that pprof picks sensible defaults
+	valueType(1, "alloc_objects", "count");
+	valueType(1, "alloc_space", "bytes");
+	valueType(1, "inuse_objects", "count");
+	valueType(1, "inuse_space", "bytes");
+
+	auto mappings = listMappings();
+	auto mappingOf = [&mappings](uintptr_t address) -> uint64_t {
+		for (size_t i = 0; i < mappings.size(); ++i)
+			if (address >= mappings[i].start && address < mappings[i].limit)
+				return i + 1;
+		return 0;
+	};
+
+	std::map<uintptr_t, uint64_t> locations;
+	for (const auto &site : sites) {
+		std::vector<uint64_t> ids;
+		for (size_t i = 0; i < site.depth; ++i) {
+			// Return addresses point after the call, pprof expects an address within it
+			uintptr_t address = site.frames[i] - 1;
+			auto [it, inserted] = locations.emplace(address, locations.size() + 1);
+			if (inserted) {
+				ProtoWriter location;
+				location.varint(1, it->second);
+				if (uint64_t mapping = mappingOf(address))
+					location.varint(2, mapping);
+				location.varint(3, address);
+				profile.message(4, location);
+			}
+			ids.push_back(it->second);
+		}
+
+		uint64_t values[] = {site.allocObjects, site.allocBytes, site.liveObjects, site.liveBytes};
+		ProtoWriter sample;
+		if (!ids.empty())
+			sample.packed(1, ids.data(), ids.size());
+		sample.packed(2, values, 4);
+		profile.message(2, sample);
+	}
+
+	for (size_t i = 0; i < mappings.size(); ++i) {
+		ProtoWriter mapping;
+		mapping.varint(1, i + 1);
+		mapping.varint(2, mappings[i].start);
+		mapping.varint(3, mappings[i].limit);
+		mapping.varint(4, mappings[i].offset);
+		mapping.varint(5, index(mappings[i].filename));
+		profile.message(3, mapping);
+	}
+
+	uint64_t dropFrames = index(AllocatorFrames);
+	uint64_t defaultType = index("inuse_space");
+	valueType(11, "space", "bytes");
+	auto now = std::chrono::system_clock::now();
+	using std::chrono::nanoseconds;
+	profile.varint(7, dropFrames);
+	profile.varint(9, uint64_t(std::chrono::duration_cast<nanoseconds>(now.time_since_epoch()).count()));
+	profile.varint(10, uint64_t(std::chrono::duration_cast<nanoseconds>(now - startTime).count()));
+	profile.varint(12, interval);
+	profile.varint(14, defaultType);
+
+	for (const auto &str : strings)
+		profile.string(6, str);
+
+	auto data = reinterpret_cast<const byte *>(profile.data());
+	return binary(data, data + profile.size());
+}
+
+void HeapProfiler::lock() const {
+#ifdef ESP32_PORT
+	portENTER_CRITICAL_SAFE(&mMux);
+#else
+	mMutex.lock();
+#endif
+}
+
+void HeapProfiler::unlock() const {
+#ifdef ESP32_PORT
+	portEXIT_CRITICAL_SAFE(&mMux);
+#else
+	mMutex.unlock();
+#endif
+}
+
+} // namespace rtc::impl
+
+#if !defined(ESP32_PORT) && defined(RTC_HEAP_PROFILER_HOOKS)
+
+// Allocator hooks for Linux, the program must be linked with
+// -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+
+#include <new>
+
+using rtc::impl::HeapProfiler;
+
+extern "C" {
+
+void *__real_malloc(size_t size);
+void __real_free(void *ptr);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+	void *ptr = __real_malloc(size);
+	HeapProfiler::Allocated(ptr, size);
+	return ptr;
+}
+
+void __wrap_free(void *ptr) {
+	HeapProfiler::Freed(ptr);
+	__real_free(ptr);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+	void *ptr = __real_calloc(n, size);
+	HeapProfiler::Allocated(ptr, n * size);
+	return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	void *new_ptr = __real_realloc(ptr, size);
+	HeapProfiler::Reallocated(ptr, new_ptr, size);
+	return new_ptr;
+}
+
+} // extern "C"
+
+// The C++ runtime calls malloc from its own library, which the linker does not wrap
+void *operator new(size_t size) {
+	void *ptr = __wrap_malloc(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { __wrap_free(ptr); }
+void operator delete[](void *ptr) noexcept { __wrap_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { __wrap_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { __wrap_free(ptr); }
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_HEAP_PROFILER_H
+#define RTC_IMPL_HEAP_PROFILER_H
+
+#include "common.hpp"
+
+#include "rtc/heapprofiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+#ifdef ESP32_PORT
+#include "freertos/FreeRTOS.h"
+#endif
+
+namespace rtc::impl {
+
+// Sampling heap profiler
+// The hooks decrement a shared byte countdown, and the allocation crossing zero is sampled: its
+// call stack is interned in a fixed table of sites, and its address remembered so that the free
+// credits the site back. Countdowns are drawn from an exponential distribution, so each byte has
+// the same chance of being sampled, and samples are weighted to estimate the real totals. Like
+// the memory tracker, the hooks never allocate and cost a single load when not sampling.
+class HeapProfiler final {
+public:
+	static const size_t MaxDepth = 16;
+	static const size_t SiteCapacity = 1024;   // Distinct call stacks
+	static const size_t SampleCapacity = 4096; // Live sampled allocations
+
+	static HeapProfiler &Instance();
+
+	bool start(size_t samplingInterval);
+	void stop();
+	HeapProfilerStats stats() const;
+	binary exportProfile() const;
+
+	// Allocator hooks, to be called for every allocation and free
+	static void Allocated(void *ptr, size_t size);
+	static void Reallocated(void *previous, void *ptr, size_t size);
+	static void Freed(void *ptr);
+
+private:
+	struct Site {
+		uint32_t hash;
+		uint32_t depth; // 0 if empty
+		uintptr_t frames[MaxDepth];
+		uint64_t allocObjects;
+		uint64_t allocBytes;
+		uint64_t liveObjects;
+		uint64_t liveBytes;
+	};
+
+	struct Sample {
+		uintptr_t address; // 0 if empty
+		uint32_t size;
+		uint32_t site;
+		float weight; // Allocations represented by the sample
+	};
+
+	HeapProfiler();
+	~HeapProfiler() = default;
+
+	static HeapProfiler *Get(); // nullptr until instantiated, safe from the hooks
+
+	void sample(void *ptr, size_t size);
+	void release(const void *ptr);
+	uint32_t intern(const uintptr_t *frames, size_t depth);
+	void credit(Site &site, const Sample &sample, bool add);
+	size_t nextCountdown();
+
+	void lock() const;
+	void unlock() const;
+
+	Site *mSites = nullptr;     // SiteCapacity + 1 entries, the last one for unattributed samples
+	Sample *mSamples = nullptr; // SampleCapacity entries
+	size_t mInterval = 0;
+	size_t mSampleCount = 0;
+	size_t mSiteCount = 0;
+	size_t mDropped = 0;
+	uint32_t mRandom = 0x9E3779B9;
+	std::chrono::system_clock::time_point mStartTime;
+	std::atomic<bool> mRunning = false;
+	std::atomic<ptrdiff_t> mCountdown = 0;
+	std::atomic<size_t> mLive = 0;
+
+#ifdef ESP32_PORT
+	mutable portMUX_TYPE mMux = portMUX_INITIALIZER_UNLOCKED; // callable from within malloc
+#else
+	mutable std::mutex mMutex;
+#endif
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -97,6 +97,11 @@ IceTransport::IceTransport(const Configuration &config, candidate_callback candi
 	if (config.enableIceUdpMux) {
 		PLOG_DEBUG << "Enabling ICE UDP mux";
 		jconfig.concurrency_mode = JUICE_CONCURRENCY_MODE_MUX;
+	} else if (Reactor::Instance().enabled()) {
+		PLOG_DEBUG << "Polling ICE agent from the reactor";
+		jconfig.concurrency_mode = JUICE_CONCURRENCY_MODE_USER;
+		jconfig.cb_user_interrupt = IceTransport::UserInterruptCallback;
+		mUserMode = true;
 	} else {
 		jconfig.concurrency_mode = JUICE_CONCURRENCY_MODE_POLL;
 	}
@@ -181,6 +186,15 @@ void IceTransport::addIceServer(IceServer server) {
 
 IceTransport::~IceTransport() {
 	PLOG_DEBUG << "Destroying ICE transport";
+	if (mUserMode) {
+		auto &reactor = Reactor::Instance();
+		if (mUserSocket != INVALID_SOCKET)
+			reactor.remove(mUserSocket);
+
+		std::lock_guard lock(mPollMutex);
+		if (mPollTimer)
+			reactor.cancel(mPollTimer);
+	}
 	mAgent.reset();
 }
 
@@ -246,6 +260,17 @@ void IceTransport::gatherLocalCandidates(string mid, std::vector<IceServer> addi
 	if (juice_gather_candidates(mAgent.get()) < 0) {
 		throw std::runtime_error("Failed to gather local ICE candidates");
 	}
+
+	if (mUserMode && mUserSocket == INVALID_SOCKET) {
+		int sock = juice_user_get_socket(mAgent.get());
+		if (sock < 0)
+			throw std::runtime_error("Failed to get the ICE agent socket");
+
+		mUserSocket = socket_t(sock);
+		auto &reactor = Reactor::Instance();
+		reactor.add(mUserSocket, weak_bind(&IceTransport::pollAgent, this));
+		reactor.schedule(Reactor::clock::now(), weak_bind(&IceTransport::pollAgent, this));
+	}
 }
 
 optional<string> IceTransport::getLocalAddress() const {
@@ -283,6 +308,14 @@ bool IceTransport::getSelectedCandidatePair(Candidate *local, Candidate *remote)
 	return false;
 }
 
+optional<std::chrono::milliseconds> IceTransport::rtt() const {
+	int rtt = juice_get_selected_rtt(mAgent.get());
+	if (rtt <= 0)
+		return nullopt;
+
+	return std::chrono::milliseconds(rtt);
+}
+
 bool IceTransport::send(message_ptr message) {
 	auto s = state();
 	if (!message || (s != State::Connected && s != State::Completed))
@@ -295,8 +328,30 @@ bool IceTransport::send(message_ptr message) {
 bool IceTransport::outgoing(message_ptr message) {
 	// Explicit Congestion Notification takes the least-significant 2 bits of the DS field
 	int ds = int(message->dscp << 2);
-	return juice_send_diffserv(mAgent.get(), reinterpret_cast<const char *>(message->data()),
-	                           message->size(), ds) >= 0;
+	if (juice_send_diffserv(mAgent.get(), reinterpret_cast<const char *>(message->data()),
+	                        message->size(), ds) < 0)
+		return false;
+
+	countOutgoing(*message);
+	return true;
+}
+
+QosStats IceTransport::qosStats() const {
+	QosStats stats;
+	for (size_t i = 0; i < TrafficClassCount; ++i)
+		stats.datagrams[i] = mClassDatagrams[i].load(std::memory_order_relaxed);
+	for (size_t i = 0; i < AccessCategoryCount; ++i)
+		stats.accessCategory[i] = mCategoryDatagrams[i].load(std::memory_order_relaxed);
+
+	// libjuice counts what the socket actually carried
+	juice_diffserv_stats_t diffserv = {};
+	if (juice_get_diffserv_stats(mAgent.get(), &diffserv) == JUICE_ERR_SUCCESS) {
+		stats.marked = diffserv.marked;
+		stats.unmarked = diffserv.unmarked;
+		stats.markUpdates = diffserv.updates;
+		stats.markFailures = diffserv.failures;
+	}
+	return stats;
 }
 
 void IceTransport::changeGatheringState(GatheringState state) {
@@ -368,6 +423,44 @@ void IceTransport::RecvCallback(juice_agent_t *, const char *data, size_t size,
 	}
 }
 
+void IceTransport::UserInterruptCallback(juice_agent_t *, void *user_ptr) {
+	auto iceTransport = static_cast<rtc::impl::IceTransport *>(user_ptr);
+	try {
+		Reactor::Instance().schedule(Reactor::clock::now(),
+		                             weak_bind(&IceTransport::pollAgent, iceTransport));
+	} catch (const std::exception &e) {
+		PLOG_WARNING << e.what();
+	}
+}
+
+void IceTransport::pollAgent() {
+	// Called on the reactor thread
+	int timeout = juice_user_poll(mAgent.get());
+	if (timeout < 0)
+		return;
+
+	auto &reactor = Reactor::Instance();
+	auto deadline = Reactor::clock::now() + std::chrono::milliseconds(timeout);
+	std::lock_guard lock(mPollMutex);
+	if (mPollTimer) {
+		if (mPollDeadline <= deadline)
+			return; // the armed timer fires first
+
+		reactor.cancel(mPollTimer);
+	}
+
+	mPollDeadline = deadline;
+	mPollTimer = reactor.schedule(deadline, [weak_this = weak_from_this()]() {
+		if (auto locked = weak_this.lock()) {
+			{
+				std::lock_guard lock(locked->mPollMutex);
+				locked->mPollTimer = 0;
+			}
+			locked->pollAgent();
+		}
+	});
+}
+
 void IceTransport::LogCallback(juice_log_level_t level, const char *message) {
 	plog::Severity severity;
 	switch (level) {
@@ -785,9 +878,28 @@ bool IceTransport::outgoing(message_ptr message) {
 		// Explicit Congestion Notification takes the least-significant 2 bits of the DS field
 		int ds = int(message->dscp << 2);
 		nice_agent_set_stream_tos(mNiceAgent.get(), mStreamId, ds); // ToS is the legacy name for DS
+		++mMarkUpdates;
 	}
-	return nice_agent_send(mNiceAgent.get(), mStreamId, 1, message->size(),
-	                       reinterpret_cast<const char *>(message->data())) >= 0;
+	if (nice_agent_send(mNiceAgent.get(), mStreamId, 1, message->size(),
+	                    reinterpret_cast<const char *>(message->data())) < 0)
+		return false;
+
+	countOutgoing(*message);
+	if (message->dscp != 0)
+		++mMarked; // libnice does not report failures to set the DS field
+	return true;
+}
+
+QosStats IceTransport::qosStats() const {
+	QosStats stats;
+	for (size_t i = 0; i < TrafficClassCount; ++i)
+		stats.datagrams[i] = mClassDatagrams[i].load(std::memory_order_relaxed);
+	for (size_t i = 0; i < AccessCategoryCount; ++i)
+		stats.accessCategory[i] = mCategoryDatagrams[i].load(std::memory_order_relaxed);
+
+	stats.marked = mMarked.load(std::memory_order_relaxed);
+	stats.markUpdates = mMarkUpdates.load(std::memory_order_relaxed);
+	return stats;
 }
 
 void IceTransport::changeGatheringState(GatheringState state) {
@@ -944,6 +1056,43 @@ bool IceTransport::getSelectedCandidatePair(Candidate *local, Candidate *remote)
 	return true;
 }
 
+optional<std::chrono::milliseconds> IceTransport::rtt() const {
+	return nullopt; // not exposed by libnice
+}
+
 #endif
 
+bool IceTransport::sendMultiple(message_vector &messages) {
+	auto s = state();
+	if (s != State::Connected && s != State::Completed)
+		return false;
+
+	// The DS field is a socket option, so send datagrams by DSCP value in order of first
+	// appearance, changing the option at most once per value instead of possibly once per datagram
+	bool result = true;
+	for (size_t i = 0; i < messages.size(); ++i) {
+		if (!messages[i])
+			continue;
+
+		unsigned int dscp = messages[i]->dscp;
+		for (size_t j = i; j < messages.size(); ++j) {
+			if (messages[j] && messages[j]->dscp == dscp) {
+				PLOG_VERBOSE << "Send size=" << messages[j]->size();
+				if (!outgoing(std::move(messages[j])))
+					result = false;
+			}
+		}
+	}
+	return result;
+}
+
+void IceTransport::countOutgoing(const Message &message) {
+	size_t index = size_t(message.trafficClass);
+	if (index < TrafficClassCount)
+		mClassDatagrams[index].fetch_add(1, std::memory_order_relaxed);
+
+	auto category = DscpAccessCategory(message.dscp);
+	mCategoryDatagrams[size_t(category)].fetch_add(1, std::memory_order_relaxed);
+}
+
 } // namespace rtc::impl
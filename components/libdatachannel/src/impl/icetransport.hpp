@@ -15,6 +15,7 @@
 #include "description.hpp"
 #include "global.hpp"
 #include "peerconnection.hpp"
+#include "reactor.hpp"
 #include "transport.hpp"
 
 #if !USE_NICE
@@ -23,6 +24,7 @@
 #include <nice/agent.h>
 #endif
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <mutex>
@@ -30,7 +32,7 @@
 
 namespace rtc::impl {
 
-class IceTransport : public Transport {
+class IceTransport : public Transport, public std::enable_shared_from_this<IceTransport> {
 public:
 	static void Init();
 	static void Cleanup();
@@ -57,11 +59,16 @@ public:
 	optional<string> getRemoteAddress() const;
 
 	bool send(message_ptr message) override; // false if dropped
+	bool sendMultiple(message_vector &messages) override; // grouped by DSCP value
+
+	QosStats qosStats() const;
 
 	bool getSelectedCandidatePair(Candidate *local, Candidate *remote);
+	optional<std::chrono::milliseconds> rtt() const; // of connectivity checks on the selected pair
 
 private:
 	bool outgoing(message_ptr message) override;
+	void countOutgoing(const Message &message);
 
 	void changeGatheringState(GatheringState state);
 
@@ -80,14 +87,26 @@ private:
 	candidate_callback mCandidateCallback;
 	gathering_state_callback mGatheringStateChangeCallback;
 
+	std::array<std::atomic<size_t>, TrafficClassCount> mClassDatagrams = {};
+	std::array<std::atomic<size_t>, AccessCategoryCount> mCategoryDatagrams = {};
+
 #if !USE_NICE
 	unique_ptr<juice_agent_t, void (*)(juice_agent_t *)> mAgent;
 	int mTurnServersAdded = 0;
 
+	// User mode, the agent is polled by the reactor
+	void pollAgent();
+	bool mUserMode = false;
+	socket_t mUserSocket = INVALID_SOCKET;
+	Reactor::TimerId mPollTimer = 0;
+	Reactor::clock::time_point mPollDeadline;
+	std::mutex mPollMutex;
+
 	static void StateChangeCallback(juice_agent_t *agent, juice_state_t state, void *user_ptr);
 	static void CandidateCallback(juice_agent_t *agent, const char *sdp, void *user_ptr);
 	static void GatheringDoneCallback(juice_agent_t *agent, void *user_ptr);
 	static void RecvCallback(juice_agent_t *agent, const char *data, size_t size, void *user_ptr);
+	static void UserInterruptCallback(juice_agent_t *agent, void *user_ptr);
 	static void LogCallback(juice_log_level_t level, const char *message);
 #else
 	class MainLoopWrapper {
@@ -107,6 +126,7 @@ private:
 	guint mTimeoutId = 0;
 	std::mutex mOutgoingMutex;
 	unsigned int mOutgoingDscp;
+	std::atomic<size_t> mMarked = 0, mMarkUpdates = 0;
 
 	static string AddressToString(const NiceAddress &addr);
 
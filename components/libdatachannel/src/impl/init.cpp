@@ -9,9 +9,11 @@
 #include "init.hpp"
 #include "certificate.hpp"
 #include "dtlstransport.hpp"
+#include "epoch.hpp"
 #include "icetransport.hpp"
 #include "internals.hpp"
 #include "pollservice.hpp"
+#include "reactor.hpp"
 #include "sctptransport.hpp"
 #include "threadpool.hpp"
 #include "tls.hpp"
@@ -91,6 +93,8 @@ void Init::preload() {
 }
 
 std::shared_future<void> Init::cleanup() {
+	CertificatePool::Instance().clear(); // pooled certificates hold tokens
+
 	std::lock_guard lock(mMutex);
 	mGlobal.reset();
 	return mCleanupFuture;
@@ -104,6 +108,46 @@ void Init::setSctpSettings(SctpSettings s) {
 	mCurrentSctpSettings = std::move(s); // store for next init
 }
 
+void Init::setThreadingSettings(ThreadingSettings s) {
+	std::lock_guard lock(mMutex);
+	if (mInitialized || ThreadPool::Instance().count() > 0) {
+		PLOG_WARNING << "Threading settings must be set before initialization, ignoring";
+		return;
+	}
+
+	Reactor::Instance().enable(s.singleReactor);
+	mCurrentThreadingSettings = std::move(s);
+}
+
+void Init::startThreads() {
+	std::lock_guard lock(mMutex);
+	if (ThreadPool::Instance().count() == 0)
+		spawnThreads();
+}
+
+void Init::spawnThreads() {
+	// mMutex needs to be locked
+
+#ifdef ESP_PLATFORM
+	const int minCount = 2;
+#else
+	const int minCount = MIN_THREADPOOL_SIZE;
+#endif
+	int count;
+	if (mCurrentThreadingSettings.workerCount) {
+		count = std::max(int(*mCurrentThreadingSettings.workerCount), 1);
+	} else {
+		int concurrency = std::thread::hardware_concurrency();
+		count = std::max(concurrency, minCount);
+	}
+
+	PLOG_DEBUG << "Spawning " << count << " threads";
+	ThreadPool::Instance().spawn(count);
+
+	if (Reactor::Instance().enabled())
+		Reactor::Instance().start();
+}
+
 void Init::doInit() {
 	// mMutex needs to be locked
 
@@ -118,16 +162,13 @@ void Init::doInit() {
 		throw std::runtime_error("WSAStartup failed, error=" + std::to_string(WSAGetLastError()));
 #endif
 
-	int concurrency = std::thread::hardware_concurrency();
-	int count = std::max(concurrency, MIN_THREADPOOL_SIZE);
-	PLOG_DEBUG << "Spawning " << count << " threads";
-
 #ifdef ESP_PLATFORM
 	// ESP32: Create singletons but don't spawn threads during early init
 	// Threads will be spawned later when networking is explicitly started
 	ThreadPool::Instance(); // Creates singleton, no threads yet
+	Reactor::Instance();
 #else
-	ThreadPool::Instance().spawn(count);
+	spawnThreads();
 #endif
 
 #if RTC_ENABLE_WEBSOCKET
@@ -164,8 +205,11 @@ void Init::doCleanup() {
 
 	PLOG_DEBUG << "Global cleanup";
 
+	// The reactor feeds delayed tasks to the thread pool, it must stop first
+	Reactor::Instance().join();
 	ThreadPool::Instance().join();
 	ThreadPool::Instance().clear();
+	Epoch::Instance().clear(); // no reader is left, deferred collection stopped with the pool
 #if RTC_ENABLE_WEBSOCKET
 	PollService::Instance().join();
 #endif
@@ -10,7 +10,7 @@
 #define RTC_IMPL_INIT_H
 
 #include "common.hpp"
-#include "global.hpp" // for SctpSettings
+#include "global.hpp" // for SctpSettings and ThreadingSettings
 
 #include <chrono>
 #include <future>
@@ -33,6 +33,8 @@ public:
 	void preload();
 	std::shared_future<void> cleanup();
 	void setSctpSettings(SctpSettings s);
+	void setThreadingSettings(ThreadingSettings s);
+	void startThreads(); // ESP32: deferred until networking is started
 
 private:
 	Init();
@@ -40,11 +42,13 @@ private:
 
 	void doInit();
 	void doCleanup();
+	void spawnThreads();
 
 	std::optional<shared_ptr<void>> mGlobal;
 	weak_ptr<void> mWeak;
 	bool mInitialized = false;
 	SctpSettings mCurrentSctpSettings = {};
+	ThreadingSettings mCurrentThreadingSettings = {};
 	std::mutex mMutex;
 	std::shared_future<void> mCleanupFuture;
 
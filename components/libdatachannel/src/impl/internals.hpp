@@ -11,6 +11,8 @@
 
 #include "common.hpp"
 
+#include <chrono>
+
 // Disable warnings before including plog
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -38,6 +40,8 @@ const uint16_t MAX_SCTP_STREAMS_COUNT = 1024; // Max number of negotiated SCTP s
                                               // RFC 8831 recommends 65535 but usrsctp needs a lot
                                               // of memory, Chromium historically limits to 1024.
 
+const uint16_t DEFAULT_DATACHANNEL_PRIORITY = 256; // "normal" priority (RFC 8832)
+
 const size_t DEFAULT_LOCAL_MAX_MESSAGE_SIZE = 256 * 1024; // Default local max message size
 const size_t DEFAULT_REMOTE_MAX_MESSAGE_SIZE = 65536;     // Remote max message size if not in SDP
 
@@ -49,6 +53,13 @@ const int MIN_THREADPOOL_SIZE = 4; // Minimum number of threads in the global th
 
 const size_t DEFAULT_MTU = RTC_DEFAULT_MTU; // defined in rtc.h
 
+// DTLS handshake retransmissions (RFC 6347 4.2.4.1): the first one after 1s, doubling up to 30s,
+// or earlier when the round-trip time is known, but not below the minimum
+const auto DEFAULT_DTLS_INITIAL_RETRANSMIT_TIMEOUT = std::chrono::milliseconds(1000);
+const auto DEFAULT_DTLS_MAX_RETRANSMIT_TIMEOUT = std::chrono::milliseconds(30000);
+const auto MIN_DTLS_RETRANSMIT_TIMEOUT = std::chrono::milliseconds(100);
+const int DTLS_RETRANSMIT_RTT_FACTOR = 3; // Retransmission timeout in round-trip times
+
 } // namespace rtc
 
 #endif
@@ -0,0 +1,373 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "memorytracker.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#ifdef ESP32_PORT
+#include "esp32_psram_init.h"
+#endif
+
+namespace rtc::impl {
+
+namespace {
+
+std::atomic<MemoryTracker *> instance = nullptr;
+
+#ifndef ESP32_PORT
+thread_local MemoryTracker::Tag currentTag = 0;
+#endif
+
+const size_t LoadLimit = MemoryTracker::Capacity / 8 * 7;
+
+size_t slotOf(MemoryTracker::Tag tag) { return (tag >> 8) & 0xFF; }
+uint8_t generationOf(MemoryTracker::Tag tag) { return uint8_t((tag >> 16) & 0xFF); }
+size_t subsystemOf(MemoryTracker::Tag tag) { return tag & 0xFF; }
+
+size_t home(uintptr_t address) {
+	return size_t(uint32_t(address >> 3) * 2654435761u) & (MemoryTracker::Capacity - 1);
+}
+
+// Independent from home() so that filter collisions and probe clusters do not coincide
+size_t filterIndex(uintptr_t address) {
+	return size_t((uint32_t(address >> 3) * 0x9E3779B1u) >> 18) & (MemoryTracker::FilterSize - 1);
+}
+
+const uint8_t FilterSaturated = 0xFF; // Counters stick there, which is only ever conservative
+
+} // namespace
+
+MemoryTracker &MemoryTracker::Instance() {
+	static MemoryTracker *tracker = [] {
+		auto created = new MemoryTracker;
+		instance.store(created, std::memory_order_release);
+		return created;
+	}();
+	return *tracker;
+}
+
+MemoryTracker *MemoryTracker::Get() { return instance.load(std::memory_order_acquire); }
+
+MemoryTracker::MemoryTracker() {}
+
+MemoryTracker::Tag MemoryTracker::acquire() {
+	if (!mTable) {
+		// Must not happen under the lock, as the lock may be taken from within malloc
+		auto table = static_cast<Entry *>(std::calloc(Capacity, sizeof(Entry)));
+		auto filter = static_cast<std::atomic<uint8_t> *>(
+		    std::calloc(FilterSize, sizeof(std::atomic<uint8_t>)));
+		if (!table || !filter) {
+			std::free(table);
+			std::free(filter);
+			return 0;
+		}
+		for (size_t i = 0; i < FilterSize; ++i)
+			new (filter + i) std::atomic<uint8_t>(0);
+
+		lock();
+		bool installed = !mTable;
+		if (installed) {
+			mTable = table;
+			mFilter.store(filter, std::memory_order_release);
+		}
+		unlock();
+
+		if (!installed) {
+			std::free(table);
+			std::free(filter);
+		}
+	}
+
+	lock();
+	Tag tag = 0;
+	for (size_t i = 0; i < MaxConnections; ++i) {
+		auto &acc = mAccounts[i];
+		if (!acc.active) {
+			uint8_t generation = uint8_t(acc.generation + 1);
+			acc = Account{};
+			acc.generation = generation;
+			acc.active = true;
+			tag = Tag(generation) << 16 | Tag(i + 1) << 8;
+			break;
+		}
+	}
+	unlock();
+	return tag;
+}
+
+void MemoryTracker::release(Tag connection) {
+	lock();
+	// Allocations still live keep their entries, they are ignored once freed
+	if (auto acc = account(connection))
+		acc->active = false;
+	unlock();
+}
+
+MemoryUsage MemoryTracker::usage(Tag connection) const {
+	MemoryUsage result;
+	lock();
+	if (auto acc = const_cast<MemoryTracker *>(this)->account(connection)) {
+		result.tracked = true;
+		result.internal = acc->internal;
+		result.external = acc->external;
+		result.internalPeak = acc->internalPeak;
+		result.externalPeak = acc->externalPeak;
+		std::copy(std::begin(acc->subsystems), std::end(acc->subsystems),
+		          result.subsystems.begin());
+	}
+	unlock();
+	return result;
+}
+
+size_t MemoryTracker::dropped() const {
+	lock();
+	size_t result = mDropped;
+	unlock();
+	return result;
+}
+
+MemoryTracker::Tag MemoryTracker::MakeTag(Tag connection, MemorySubsystem subsystem) {
+	return connection ? (connection & ~Tag(0xFF)) | Tag(subsystem) : 0;
+}
+
+MemoryTracker::Tag MemoryTracker::CurrentTag() {
+#ifdef ESP32_PORT
+	return esp32_get_task_memory_tag();
+#else
+	return currentTag;
+#endif
+}
+
+void MemoryTracker::SetCurrentTag(Tag tag) {
+#ifdef ESP32_PORT
+	esp32_set_task_memory_tag(tag);
+#else
+	currentTag = tag;
+#endif
+}
+
+void MemoryTracker::Allocated(void *ptr, size_t size, bool internal) {
+	Tag tag;
+	if (!ptr || !(tag = CurrentTag()))
+		return;
+
+	auto tracker = Get();
+	if (!tracker)
+		return;
+
+	tracker->lock();
+	tracker->insert(ptr, size, tag, internal);
+	tracker->unlock();
+}
+
+void MemoryTracker::Reallocated(void *previous, void *ptr, size_t size, bool internal) {
+	if (!previous) {
+		Allocated(ptr, size, internal);
+		return;
+	}
+
+	if (!ptr && size > 0) // failed, the previous block is untouched
+		return;
+
+	auto tracker = Get();
+	Tag current = CurrentTag();
+	if (!tracker || (!current && !tracker->mayBeTracked(previous)))
+		return;
+
+	tracker->lock();
+	// A moved block keeps the tag it was allocated with
+	Tag tag = current;
+	if (auto entry = tracker->remove(previous))
+		tag = entry->tag & ~InternalFlag;
+
+	if (ptr && tag)
+		tracker->insert(ptr, size, tag, internal);
+	tracker->unlock();
+}
+
+void MemoryTracker::Freed(void *ptr) {
+	auto tracker = Get();
+	if (!ptr || !tracker || !tracker->mayBeTracked(ptr))
+		return;
+
+	tracker->lock();
+	tracker->remove(ptr);
+	tracker->unlock();
+}
+
+void MemoryTracker::Retag(const void *ptr, MemorySubsystem subsystem) {
+	auto tracker = Get();
+	if (!ptr || !tracker || !tracker->mayBeTracked(ptr))
+		return;
+
+	tracker->lock();
+	if (auto entry = tracker->find(ptr)) {
+		tracker->credit(*entry, false);
+		entry->tag = (entry->tag & ~Tag(0xFF)) | Tag(subsystem);
+		tracker->credit(*entry, true);
+	}
+	tracker->unlock();
+}
+
+bool MemoryTracker::mayBeTracked(const void *ptr) const {
+	// Lock-free: a tagged block was inserted before its address could reach the freeing task, so
+	// its counter is visible there, and a zero counter proves the block is not in the table
+	if (!mLive.load(std::memory_order_relaxed))
+		return false;
+
+	auto filter = mFilter.load(std::memory_order_acquire);
+	return filter &&
+	       filter[filterIndex(reinterpret_cast<uintptr_t>(ptr))].load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::insert(void *ptr, size_t size, Tag tag, bool internal) {
+	// Requires the lock
+	if (!mTable || !account(tag))
+		return;
+
+	if (mLive.load(std::memory_order_relaxed) >= LoadLimit) {
+		++mDropped;
+		return;
+	}
+
+	auto address = reinterpret_cast<uintptr_t>(ptr);
+	size_t i = home(address);
+	while (mTable[i].address && mTable[i].address != address)
+		i = (i + 1) & (Capacity - 1);
+
+	if (mTable[i].address) { // stale entry for a block freed untracked
+		credit(mTable[i], false);
+	} else {
+		auto &counter = mFilter.load(std::memory_order_relaxed)[filterIndex(address)];
+		uint8_t count = counter.load(std::memory_order_relaxed);
+		if (count != FilterSaturated)
+			counter.store(count + 1, std::memory_order_relaxed);
+
+		mLive.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	mTable[i] = Entry{address, uint32_t(size), internal ? tag | InternalFlag : tag};
+	credit(mTable[i], true);
+}
+
+optional<MemoryTracker::Entry> MemoryTracker::remove(const void *ptr) {
+	// Requires the lock
+	auto found = find(ptr);
+	if (!found)
+		return nullopt;
+
+	Entry entry = *found;
+	credit(entry, false);
+	mLive.fetch_sub(1, std::memory_order_relaxed);
+
+	auto &counter = mFilter.load(std::memory_order_relaxed)[filterIndex(entry.address)];
+	uint8_t count = counter.load(std::memory_order_relaxed);
+	if (count != FilterSaturated)
+		counter.store(count - 1, std::memory_order_relaxed);
+
+	// Backward shift deletion keeps probe sequences intact without tombstones
+	size_t i = size_t(found - mTable);
+	size_t j = i;
+	while (true) {
+		j = (j + 1) & (Capacity - 1);
+		if (!mTable[j].address)
+			break;
+
+		size_t k = home(mTable[j].address);
+		bool movable = (j > i) ? (k <= i || k > j) : (k <= i && k > j);
+		if (movable) {
+			mTable[i] = mTable[j];
+			i = j;
+		}
+	}
+	mTable[i].address = 0;
+	return entry;
+}
+
+MemoryTracker::Entry *MemoryTracker::find(const void *ptr) {
+	// Requires the lock
+	if (!mTable)
+		return nullptr;
+
+	auto address = reinterpret_cast<uintptr_t>(ptr);
+	size_t i = home(address);
+	while (mTable[i].address) {
+		if (mTable[i].address == address)
+			return &mTable[i];
+
+		i = (i + 1) & (Capacity - 1);
+	}
+	return nullptr;
+}
+
+MemoryTracker::Account *MemoryTracker::account(Tag tag) {
+	size_t slot = slotOf(tag);
+	if (slot == 0 || slot > MaxConnections)
+		return nullptr;
+
+	auto &acc = mAccounts[slot - 1];
+	return acc.active && acc.generation == generationOf(tag) ? &acc : nullptr;
+}
+
+void MemoryTracker::credit(const Entry &entry, bool add) {
+	// Requires the lock
+	auto acc = account(entry.tag & ~InternalFlag);
+	if (!acc)
+		return;
+
+	bool internal = entry.tag & InternalFlag;
+	size_t &total = internal ? acc->internal : acc->external;
+	size_t &bySubsystem = acc->subsystems[std::min(subsystemOf(entry.tag), MemorySubsystemCount - 1)];
+	if (add) {
+		total += entry.size;
+		bySubsystem += entry.size;
+		size_t &peak = internal ? acc->internalPeak : acc->externalPeak;
+		peak = std::max(peak, total);
+	} else {
+		total -= std::min(total, size_t(entry.size));
+		bySubsystem -= std::min(bySubsystem, size_t(entry.size));
+	}
+}
+
+void MemoryTracker::lock() const {
+#ifdef ESP32_PORT
+	portENTER_CRITICAL_SAFE(&mMux);
+#else
+	mMutex.lock();
+#endif
+}
+
+void MemoryTracker::unlock() const {
+#ifdef ESP32_PORT
+	portEXIT_CRITICAL_SAFE(&mMux);
+#else
+	mMutex.unlock();
+#endif
+}
+
+MemoryTracker::Scope::Scope(Tag tag) : mPrevious(0), mActive(tag != 0) {
+	if (mActive) {
+		mPrevious = CurrentTag();
+		SetCurrentTag(tag);
+	}
+}
+
+MemoryTracker::Scope::Scope(Tag connection, MemorySubsystem subsystem)
+    : Scope(MakeTag(connection, subsystem)) {}
+
+MemoryTracker::Scope::Scope(MemorySubsystem subsystem) : Scope(MakeTag(CurrentTag(), subsystem)) {}
+
+MemoryTracker::Scope::~Scope() {
+	if (mActive)
+		SetCurrentTag(mPrevious);
+}
+
+} // namespace rtc::impl
@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_MEMORY_TRACKER_H
+#define RTC_IMPL_MEMORY_TRACKER_H
+
+#include "common.hpp"
+
+#include "rtc/memoryusage.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#ifdef ESP32_PORT
+#include "freertos/FreeRTOS.h"
+#endif
+
+namespace rtc::impl {
+
+// Per-connection heap accounting
+// Each task carries a tag naming the connection and subsystem it is working for. The allocator
+// hooks report allocations made under a tag, which are remembered by address in a fixed table so
+// that frees, wherever they happen, are credited back to the right connection. The hooks never
+// allocate themselves. Untagged allocations cost a single load, and frees of untagged blocks are
+// told apart by a counting filter on their address, without taking the lock.
+class MemoryTracker final {
+public:
+	using Tag = uint32_t; // 0 means untagged
+
+	static const size_t MaxConnections = 8;
+	static const size_t Capacity = 8192; // Live tagged allocations
+	static const size_t FilterSize = 16384; // Filter counters, a byte each
+
+	static MemoryTracker &Instance();
+
+	// Returns the tag of a new connection (subsystem Other), or 0 if all slots are in use
+	Tag acquire();
+	void release(Tag connection);
+	MemoryUsage usage(Tag connection) const;
+	size_t dropped() const; // Allocations left untracked because the table was full
+
+	static Tag MakeTag(Tag connection, MemorySubsystem subsystem);
+	static Tag CurrentTag();
+
+	// Allocator hooks, to be called for every allocation and free
+	static void Allocated(void *ptr, size_t size, bool internal);
+	static void Reallocated(void *previous, void *ptr, size_t size, bool internal);
+	static void Freed(void *ptr);
+
+	// Moves a live allocation to another subsystem of its connection, e.g. once retained
+	static void Retag(const void *ptr, MemorySubsystem subsystem);
+
+	// Tags allocations made by the current task until destroyed, scopes nest
+	class Scope final {
+	public:
+		Scope(Tag tag);
+		Scope(Tag connection, MemorySubsystem subsystem);
+		Scope(MemorySubsystem subsystem); // Current connection, if any
+		~Scope();
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+
+	private:
+		Tag mPrevious;
+		bool mActive;
+	};
+
+private:
+	struct Entry {
+		uintptr_t address; // 0 if empty
+		uint32_t size;
+		Tag tag; // with InternalFlag if allocated in internal RAM
+	};
+
+	struct Account {
+		uint8_t generation = 0;
+		bool active = false;
+		size_t internal = 0;
+		size_t external = 0;
+		size_t internalPeak = 0;
+		size_t externalPeak = 0;
+		size_t subsystems[MemorySubsystemCount] = {};
+	};
+
+	static const Tag InternalFlag = 0x80000000;
+
+	MemoryTracker();
+	~MemoryTracker() = default;
+
+	static void SetCurrentTag(Tag tag);
+	static MemoryTracker *Get(); // nullptr until instantiated, safe from the hooks
+
+	bool mayBeTracked(const void *ptr) const;
+	void insert(void *ptr, size_t size, Tag tag, bool internal);
+	optional<Entry> remove(const void *ptr);
+	Entry *find(const void *ptr);
+	Account *account(Tag tag);
+	void credit(const Entry &entry, bool add);
+
+	void lock() const;
+	void unlock() const;
+
+	Entry *mTable = nullptr;
+	std::atomic<std::atomic<uint8_t> *> mFilter = nullptr; // Live entries by address hash
+	Account mAccounts[MaxConnections];
+	size_t mDropped = 0;
+	std::atomic<size_t> mLive = 0;
+
+#ifdef ESP32_PORT
+	mutable portMUX_TYPE mMux = portMUX_INITIALIZER_UNLOCKED; // callable from within malloc
+#else
+	mutable std::mutex mMutex;
+#endif
+};
+
+} // namespace rtc::impl
+
+#endif
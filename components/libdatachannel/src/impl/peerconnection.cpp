@@ -90,6 +90,7 @@ PeerConnection::PeerConnection(Configuration config_) : config(std::move(config_
 PeerConnection::~PeerConnection() {
 	PLOG_INFO << "PeerConnection::impl destructor called";
 	mProcessor.join();
+	MemoryTracker::Instance().release(mMemoryTag);
 }
 
 void PeerConnection::close() {
@@ -166,6 +167,7 @@ shared_ptr<IceTransport> PeerConnection::initIceTransport() {
 			return transport;
 
 		PLOG_VERBOSE << "Starting ICE transport";
+		MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Ice);
 
 		auto transport = std::make_shared<IceTransport>(
 		    config, weak_bind(&PeerConnection::processLocalCandidate, this, _1),
@@ -233,6 +235,7 @@ shared_ptr<DtlsTransport> PeerConnection::initDtlsTransport() {
 			return transport;
 
 		PLOG_VERBOSE << "Starting DTLS transport";
+		MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Dtls);
 
 		CertificateFingerprint::Algorithm fingerprintAlgorithm;
 		{
@@ -300,6 +303,10 @@ shared_ptr<DtlsTransport> PeerConnection::initDtlsTransport() {
 			                                            dtlsStateChangeCallback);
 		}
 
+		transport->setRetransmitTimeouts(
+		    config.dtlsInitialRetransmitTimeout.value_or(DEFAULT_DTLS_INITIAL_RETRANSMIT_TIMEOUT),
+		    config.dtlsMaxRetransmitTimeout.value_or(DEFAULT_DTLS_MAX_RETRANSMIT_TIMEOUT));
+
 		return emplaceTransport(this, &mDtlsTransport, std::move(transport));
 
 	} catch (const std::exception &e) {
@@ -315,6 +322,7 @@ shared_ptr<SctpTransport> PeerConnection::initSctpTransport() {
 			return transport;
 
 		PLOG_VERBOSE << "Starting SCTP transport";
+		MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Sctp);
 
 		auto lower = std::atomic_load(&mDtlsTransport);
 		if (!lower)
@@ -664,10 +672,12 @@ shared_ptr<DataChannel> PeerConnection::emplaceDataChannel(string label, DataCha
 	auto channel =
 	    init.negotiated
 	        ? std::make_shared<DataChannel>(weak_from_this(), std::move(label),
-	                                        std::move(init.protocol), std::move(init.reliability))
+	                                        std::move(init.protocol), std::move(init.reliability),
+	                                        init.priority, init.weight)
 	        : std::make_shared<OutgoingDataChannel>(weak_from_this(), std::move(label),
 	                                                std::move(init.protocol),
-	                                                std::move(init.reliability));
+	                                                std::move(init.reliability), init.priority,
+	                                                init.weight);
 
 	// If the user supplied a stream id, use it, otherwise assign it later
 	if (init.id) {
@@ -1045,11 +1055,15 @@ void PeerConnection::populateLocalDescription(Description &description) const {
 }
 
 void PeerConnection::processLocalDescription(Description description) {
+	MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Other);
 	PLOG_VERBOSE << "Issuing local description: " << description;
 
 	if (description.mediaCount() == 0)
 		throw std::logic_error("Local description has no media line");
 
+	// Update the SSRC cache for existing tracks, RTCP feedback like NACK carries our SSRCs
+	updateTrackSsrcCache(description);
+
 	{
 		// Set as local description
 		std::lock_guard lock(mLocalDescriptionMutex);
@@ -1089,6 +1103,7 @@ void PeerConnection::processLocalCandidate(Candidate candidate) {
 }
 
 void PeerConnection::processRemoteDescription(Description description) {
+	MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Other);
 	// Create tracks from remote description
 	for (int i = 0; i < description.mediaCount(); ++i) {
 		auto media = description.media(i);
@@ -1155,6 +1170,7 @@ void PeerConnection::processRemoteDescription(Description description) {
 }
 
 void PeerConnection::processRemoteCandidate(Candidate candidate) {
+	MemoryTracker::Scope scope(mMemoryTag, MemorySubsystem::Other);
 	auto iceTransport = std::atomic_load(&mIceTransport);
 	{
 		// Set as remote candidate
@@ -1404,6 +1420,10 @@ CertificateFingerprint PeerConnection::remoteFingerprint() {
 		return {};
 }
 
+MemoryUsage PeerConnection::memoryUsage() const {
+	return MemoryTracker::Instance().usage(mMemoryTag);
+}
+
 void PeerConnection::updateTrackSsrcCache(const Description &description) {
 	std::unique_lock lock(mTracksMutex); // for safely writing to mTracksBySsrc
 
@@ -14,6 +14,7 @@
 #include "dtlstransport.hpp"
 #include "icetransport.hpp"
 #include "init.hpp"
+#include "memorytracker.hpp"
 #include "processor.hpp"
 #include "sctptransport.hpp"
 #include "track.hpp"
@@ -105,6 +106,9 @@ struct PeerConnection : std::enable_shared_from_this<PeerConnection> {
 
 	CertificateFingerprint remoteFingerprint();
 
+	MemoryTracker::Tag memoryTag() const { return mMemoryTag; }
+	MemoryUsage memoryUsage() const;
+
 	// Helper method for asynchronous callback invocation
 	template <typename... Args> void trigger(synchronized_callback<Args...> *cb, Args... args) {
 		try {
@@ -136,6 +140,7 @@ private:
 	void updateTrackSsrcCache(const Description &description);
 
 	const init_token mInitToken = Init::Instance().token();
+	const MemoryTracker::Tag mMemoryTag = MemoryTracker::Instance().acquire();
 	future_certificate_ptr mCertificate;
 
 	Processor mProcessor;
@@ -9,8 +9,6 @@
 #include "pollinterrupter.hpp"
 #include "internals.hpp"
 
-#if RTC_ENABLE_WEBSOCKET
-
 #ifndef _WIN32
 #include <fcntl.h>
 #include <unistd.h>
@@ -121,5 +119,3 @@ void PollInterrupter::interrupt() {
 }
 
 } // namespace rtc::impl
-
-#endif
@@ -12,8 +12,6 @@
 #include "common.hpp"
 #include "socket.hpp"
 
-#if RTC_ENABLE_WEBSOCKET
-
 namespace rtc::impl {
 
 // Utility class to interrupt poll()
@@ -40,5 +38,3 @@ private:
 } // namespace rtc::impl
 
 #endif
-
-#endif
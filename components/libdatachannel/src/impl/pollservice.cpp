@@ -13,14 +13,49 @@
 #if RTC_ENABLE_WEBSOCKET
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 
+#if RTC_POLL_USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
 namespace rtc::impl {
 
 using namespace std::chrono_literals;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 
+namespace {
+
+short pollEvents(PollService::Direction direction) {
+	switch (direction) {
+	case PollService::Direction::In:
+		return POLLIN;
+	case PollService::Direction::Out:
+		return POLLOUT;
+	default:
+		return POLLIN | POLLOUT;
+	}
+}
+
+const size_t TimeoutsCompactionSlack = 64;
+
+#if RTC_POLL_USE_EPOLL
+const int EpollMaxEvents = 64;
+
+uint32_t toEpollEvents(short events) {
+	return (events & POLLIN ? uint32_t(EPOLLIN) : 0) | (events & POLLOUT ? uint32_t(EPOLLOUT) : 0);
+}
+
+short fromEpollEvents(uint32_t events) {
+	return short((events & EPOLLIN ? POLLIN : 0) | (events & EPOLLOUT ? POLLOUT : 0) |
+	             (events & EPOLLERR ? POLLERR : 0) | (events & EPOLLHUP ? POLLHUP : 0));
+}
+#endif
+
+} // namespace
+
 PollService &PollService::Instance() {
 	static PollService *instance = new PollService;
 	return *instance;
@@ -32,9 +67,15 @@ PollService::~PollService() {}
 
 void PollService::start() {
 	mSocks = std::make_unique<SocketMap>();
+#if !RTC_POLL_USE_EPOLL
+	mPollFds.assign(1, pollfd{}); // slot for the interrupter
+#endif
 	// ESP32: Don't create thread/interrupter during early init
 	// Will be created later in startThreads()
 	mStopped = false;
+#ifndef ESP_PLATFORM
+	startThreads();
+#endif
 }
 
 void PollService::startThreads() {
@@ -42,6 +83,28 @@ void PollService::startThreads() {
 	if (!mInterrupter && !mStopped) {
 		// Now it's safe to create threads and pipe()
 		mInterrupter = std::make_unique<PollInterrupter>();
+#if RTC_POLL_USE_EPOLL
+		mEpoll = ::epoll_create1(EPOLL_CLOEXEC);
+		if (mEpoll < 0)
+			throw std::runtime_error("Failed to create epoll instance, errno=" +
+			                         std::to_string(errno));
+
+		struct pollfd pfd;
+		mInterrupter->prepare(pfd);
+		struct epoll_event ev = {};
+		ev.events = toEpollEvents(pfd.events);
+		ev.data.fd = pfd.fd;
+		if (::epoll_ctl(mEpoll, EPOLL_CTL_ADD, pfd.fd, &ev) < 0)
+			throw std::runtime_error("Failed to add interrupter to epoll, errno=" +
+			                         std::to_string(errno));
+
+		// Sockets added before the thread was started
+		for (auto &[sock, entry] : *mSocks)
+			registerSocket(sock, entry, true);
+#else
+		mInterrupter->prepare(mPollFds[0]);
+		mPollFdsChanged = true;
+#endif
 		mThread = std::thread(&PollService::runLoop, this);
 	}
 }
@@ -53,11 +116,23 @@ void PollService::join() {
 
 	lock.unlock();
 
-	mInterrupter->interrupt();
-	mThread.join();
+	// ESP32: threads are only there if networking was started
+	if (mInterrupter) {
+		mInterrupter->interrupt();
+		mThread.join();
+	}
 
 	mSocks.reset();
 	mInterrupter.reset();
+	mTimeouts = {};
+#if RTC_POLL_USE_EPOLL
+	if (mEpoll >= 0) {
+		::close(mEpoll);
+		mEpoll = -1;
+	}
+#else
+	mPollFds.clear();
+#endif
 }
 
 void PollService::add(socket_t sock, Params params) {
@@ -68,10 +143,35 @@ void PollService::add(socket_t sock, Params params) {
 	PLOG_VERBOSE << "Registering socket in poll service, direction=" << params.direction;
 	auto until = params.timeout ? std::make_optional(clock::now() + *params.timeout) : nullopt;
 	assert(mSocks);
-	mSocks->insert_or_assign(sock, SocketEntry{std::move(params), std::move(until)});
+	auto [it, inserted] = mSocks->try_emplace(sock);
+	auto &entry = it->second;
+	short events = pollEvents(params.direction);
+	bool changed = inserted || entry.events != events;
+	entry.params = std::move(params);
+	entry.until = std::move(until);
+	entry.generation = ++mGeneration;
+	entry.events = events;
+
+	if (changed) {
+		try {
+			registerSocket(sock, entry, inserted);
+		} catch (...) {
+			mSocks->erase(it);
+			throw;
+		}
+	}
+
+	bool earlier = schedule(sock, entry);
 
+	// The poll thread only needs to wake up if its fd set or its next deadline changed, an epoll
+	// set is updated while waiting
+#if RTC_POLL_USE_EPOLL
+	bool wake = earlier;
+#else
+	bool wake = changed || earlier;
+#endif
 	// ESP32: Only interrupt if threads are already started
-	if (mInterrupter) {
+	if (wake && mInterrupter) {
 		mInterrupter->interrupt();
 	}
 	// If threads aren't started yet, the socket will be processed when startThreads() is called
@@ -83,98 +183,168 @@ void PollService::remove(socket_t sock) {
 	std::unique_lock lock(mMutex);
 	PLOG_VERBOSE << "Unregistering socket in poll service";
 	assert(mSocks);
-	mSocks->erase(sock);
+	auto it = mSocks->find(sock);
+	if (it == mSocks->end())
+		return;
+
+	unregisterSocket(it); // a pending timeout is skipped when it expires
 
-	assert(mInterrupter);
-	mInterrupter->interrupt();
+#if !RTC_POLL_USE_EPOLL
+	// The socket must not be polled anymore once it is closed
+	if (mInterrupter)
+		mInterrupter->interrupt();
+#endif
 }
 
-void PollService::prepare(std::vector<struct pollfd> &pfds, optional<clock::time_point> &next) {
+size_t PollService::pendingTimeouts() const {
 	std::unique_lock lock(mMutex);
-	pfds.resize(1 + mSocks->size());
-	next.reset();
-
-	auto it = pfds.begin();
-	mInterrupter->prepare(*it++);
-	for (const auto &[sock, entry] : *mSocks) {
-		it->fd = sock;
-		switch (entry.params.direction) {
-		case Direction::In:
-			it->events = POLLIN;
-			break;
-		case Direction::Out:
-			it->events = POLLOUT;
-			break;
-		default:
-			it->events = POLLIN | POLLOUT;
-			break;
-		}
-		if (entry.until)
-			next = next ? std::min(*next, *entry.until) : *entry.until;
+	return mTimeouts.size();
+}
 
-		++it;
+void PollService::registerSocket(socket_t sock, SocketEntry &entry, bool inserted) {
+#if RTC_POLL_USE_EPOLL
+	if (mEpoll < 0)
+		return; // registered in startThreads()
+
+	struct epoll_event ev = {};
+	ev.events = toEpollEvents(entry.events);
+	ev.data.fd = sock;
+	if (::epoll_ctl(mEpoll, inserted ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, sock, &ev) < 0)
+		throw std::runtime_error("Failed to register socket in epoll, errno=" +
+		                         std::to_string(errno));
+#else
+	if (inserted) {
+		entry.index = mPollFds.size();
+		struct pollfd pfd = {};
+		pfd.fd = sock;
+		mPollFds.push_back(pfd);
 	}
+	mPollFds[entry.index].events = entry.events;
+	mPollFdsChanged = true;
+#endif
 }
 
-void PollService::process(std::vector<struct pollfd> &pfds) {
-	using Callback = decltype(std::declval<Params>().callback);
-	std::vector<std::pair<Callback, Event>> todo;
-	{
-		std::unique_lock lock(mMutex);
-		auto it = pfds.begin();
-		if (it != pfds.end()) {
-			mInterrupter->process(*it++);
-		}
-		while (it != pfds.end()) {
-			socket_t sock = it->fd;
-			auto jt = mSocks->find(sock);
-			if (jt != mSocks->end()) {
-				try {
-					auto &entry = jt->second;
-					const auto &params = entry.params;
-
-					if (it->revents & POLLNVAL || it->revents & POLLERR ||
-					    (it->revents & POLLHUP &&
-					     !(it->events & POLLIN))) { // MacOS sets POLLHUP on connection failure
-						PLOG_VERBOSE << "Poll error event";
-						todo.emplace_back(std::move(params.callback), Event::Error);
-						mSocks->erase(sock);
-					} else if (it->revents & POLLIN || it->revents & POLLOUT || it->revents & POLLHUP) {
-						entry.until = params.timeout
-						                  ? std::make_optional(clock::now() + *params.timeout)
-						                  : nullopt;
-
-						const auto &callback = params.callback; // can't move, we may need it below
-						if (it->revents & POLLIN ||
-						    it->revents & POLLHUP) { // Windows does not set POLLIN on close
-							PLOG_VERBOSE << "Poll in event";
-							todo.emplace_back(callback, Event::In);
-						}
-						if (it->revents & POLLOUT) {
-							PLOG_VERBOSE << "Poll out event";
-							todo.emplace_back(callback, Event::Out);
-						}
-
-					} else if (entry.until && clock::now() >= *entry.until) {
-						PLOG_VERBOSE << "Poll timeout event";
-						todo.emplace_back(std::move(params.callback), Event::Timeout);
-						mSocks->erase(sock);
-					}
+void PollService::unregisterSocket(SocketMap::iterator it) {
+#if RTC_POLL_USE_EPOLL
+	// Fails if the socket is already closed, which removed it from the set anyway
+	if (mEpoll >= 0 && ::epoll_ctl(mEpoll, EPOLL_CTL_DEL, it->first, nullptr) < 0) {
+		PLOG_VERBOSE << "Removing socket from epoll failed, errno=" << errno;
+	}
+#else
+	// Move the last pollfd into the hole
+	size_t index = it->second.index;
+	if (index + 1 != mPollFds.size()) {
+		mPollFds[index] = mPollFds.back();
+		auto jt = mSocks->find(mPollFds[index].fd);
+		assert(jt != mSocks->end());
+		jt->second.index = index;
+	}
+	mPollFds.pop_back();
+	mPollFdsChanged = true;
+#endif
+	mSocks->erase(it);
 
-				} catch (const std::exception &e) {
-					PLOG_WARNING << e.what();
-					mSocks->erase(sock);
-				}
-			}
+	// Items of removed sockets are only dropped when they expire, so rebuild the heap once they
+	// outnumber the live ones, amortized over the removals
+	if (mTimeouts.size() > 2 * mSocks->size() + TimeoutsCompactionSlack)
+		compactTimeouts();
+}
+
+void PollService::compactTimeouts() {
+	std::vector<Timeout> timeouts;
+	timeouts.reserve(mSocks->size());
+	for (const auto &[sock, entry] : *mSocks)
+		if (entry.scheduled)
+			timeouts.push_back(Timeout{*entry.scheduled, sock});
+
+	mTimeouts = decltype(mTimeouts)(std::greater<Timeout>(), std::move(timeouts));
+}
+
+bool PollService::schedule(socket_t sock, SocketEntry &entry) {
+	// A pending item that expires earlier is postponed when it expires, so activity, which only
+	// pushes the deadline back, does not touch the heap
+	if (!entry.until || (entry.scheduled && *entry.scheduled <= *entry.until))
+		return false;
+
+	entry.scheduled = entry.until;
+	mTimeouts.push(Timeout{*entry.until, sock});
+	return mTimeouts.top().sock == sock && mTimeouts.top().until == *entry.until;
+}
+
+void PollService::process(socket_t sock, short revents, clock::time_point now) {
+	auto it = mSocks->find(sock);
+	if (it == mSocks->end())
+		return;
+
+	auto &entry = it->second;
+	auto &params = entry.params;
+	if (revents & POLLNVAL || revents & POLLERR ||
+	    (revents & POLLHUP && !(entry.events & POLLIN))) { // MacOS sets POLLHUP on connection failure
+		PLOG_VERBOSE << "Poll error event";
+		mDispatch.push_back(
+		    Dispatch{sock, entry.generation, std::move(params.callback), Event::Error, false, false});
+		unregisterSocket(it);
+
+	} else if (revents & POLLIN || revents & POLLOUT || revents & POLLHUP) {
+		entry.until = params.timeout ? std::make_optional(now + *params.timeout) : nullopt;
+		schedule(sock, entry);
+
+		bool in = revents & POLLIN || revents & POLLHUP; // Windows does not set POLLIN on close
+		bool out = revents & POLLOUT;
+		PLOG_VERBOSE << "Poll " << (in ? (out ? "in and out" : "in") : "out") << " event";
+		mDispatch.push_back(Dispatch{sock, entry.generation, std::move(params.callback),
+		                             in ? Event::In : Event::Out, in && out, true});
+	}
+}
+
+void PollService::processTimeouts(clock::time_point now) {
+	while (!mTimeouts.empty() && mTimeouts.top().until <= now) {
+		Timeout timeout = mTimeouts.top();
+		mTimeouts.pop();
+
+		auto it = mSocks->find(timeout.sock);
+		if (it == mSocks->end() || it->second.scheduled != timeout.until)
+			continue; // stale
 
-			++it;
+		auto &entry = it->second;
+		entry.scheduled.reset();
+		if (!entry.until)
+			continue;
+
+		if (*entry.until > now) {
+			schedule(timeout.sock, entry); // postponed by activity
+			continue;
 		}
+
+		PLOG_VERBOSE << "Poll timeout event";
+		mDispatch.push_back(Dispatch{timeout.sock, entry.generation,
+		                             std::move(entry.params.callback), Event::Timeout, false, false});
+		unregisterSocket(it);
+	}
+}
+
+void PollService::dispatch() {
+	// Callbacks are called without the lock, the entries may change meanwhile
+	for (auto &d : mDispatch) {
+		d.callback(d.event);
+		if (d.out)
+			d.callback(Event::Out);
 	}
 
-	// Now perform the callbacks
-	for (auto &[callback, event] : todo) {
-		callback(event);
+	{
+		std::unique_lock lock(mMutex);
+		for (auto &d : mDispatch) {
+			if (!d.restore)
+				continue;
+
+			// Unless the socket was removed or added again
+			auto it = mSocks->find(d.sock);
+			if (it != mSocks->end() && it->second.generation == d.generation)
+				it->second.params.callback = std::move(d.callback);
+		}
 	}
+
+	mDispatch.clear(); // remaining callbacks may hold the last reference to their transport
 }
 
 void PollService::runLoop() {
@@ -183,10 +353,28 @@ void PollService::runLoop() {
 
 	try {
 		assert(mSocks);
+#if RTC_POLL_USE_EPOLL
+		std::array<struct epoll_event, EpollMaxEvents> events;
+		struct pollfd interrupter;
+		{
+			std::unique_lock lock(mMutex);
+			mInterrupter->prepare(interrupter);
+		}
+#else
 		std::vector<struct pollfd> pfds;
-		optional<clock::time_point> next;
+#endif
 		while (!mStopped) {
-			prepare(pfds, next);
+			optional<clock::time_point> next;
+			{
+				std::unique_lock lock(mMutex);
+				if (!mTimeouts.empty())
+					next = mTimeouts.top().until;
+#if !RTC_POLL_USE_EPOLL
+				// Copy the set as it may change while polling, no allocation once it has grown
+				if (std::exchange(mPollFdsChanged, false))
+					pfds = mPollFds;
+#endif
+			}
 
 			int ret;
 			do {
@@ -201,7 +389,11 @@ void PollService::runLoop() {
 					timeout = -1;
 				}
 
+#if RTC_POLL_USE_EPOLL
+				ret = ::epoll_wait(mEpoll, events.data(), EpollMaxEvents, timeout);
+#else
 				ret = ::poll(pfds.data(), static_cast<nfds_t>(pfds.size()), timeout);
+#endif
 
 				PLOG_VERBOSE << "Exiting poll";
 
@@ -215,7 +407,37 @@ void PollService::runLoop() {
 				throw std::runtime_error("poll failed, errno=" + std::to_string(sockerrno));
 			}
 
-			process(pfds);
+			{
+				std::unique_lock lock(mMutex);
+				auto now = clock::now();
+#if RTC_POLL_USE_EPOLL
+				for (int i = 0; i < ret; ++i) {
+					short revents = fromEpollEvents(events[i].events);
+					if (events[i].data.fd == interrupter.fd) {
+						interrupter.revents = revents;
+						mInterrupter->process(interrupter);
+					} else {
+						process(events[i].data.fd, revents, now);
+					}
+				}
+#else
+				// Only ret entries have events, stop scanning when they are found
+				int count = ret;
+				for (auto it = pfds.begin(); count > 0 && it != pfds.end(); ++it) {
+					if (!it->revents)
+						continue;
+
+					--count;
+					if (it == pfds.begin())
+						mInterrupter->process(*it);
+					else
+						process(it->fd, it->revents, now);
+				}
+#endif
+				processTimeouts(now);
+			}
+
+			dispatch();
 		}
 	} catch (const std::exception &e) {
 		PLOG_FATAL << "Poll service failed: " << e.what();
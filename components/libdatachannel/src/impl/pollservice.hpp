@@ -17,12 +17,23 @@
 #if RTC_ENABLE_WEBSOCKET
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <mutex>
+#include <queue>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+// Linux: epoll, other platforms (including ESP32 lwIP): poll() on a persistent pollfd set
+#ifndef RTC_POLL_USE_EPOLL
+#if defined(__linux__) && !defined(ESP_PLATFORM)
+#define RTC_POLL_USE_EPOLL 1
+#else
+#define RTC_POLL_USE_EPOLL 0
+#endif
+#endif
+
 namespace rtc::impl {
 
 class PollService {
@@ -52,24 +63,65 @@ public:
 	void add(socket_t sock, Params params);
 	void remove(socket_t sock);
 
+	size_t pendingTimeouts() const; // items in the timeout heap, including stale ones
+
 private:
 	PollService();
 	~PollService();
 
-	void prepare(std::vector<struct pollfd> &pfds, optional<clock::time_point> &next);
-	void process(std::vector<struct pollfd> &pfds);
-	void runLoop();
-
 	struct SocketEntry {
 		Params params;
 		optional<clock::time_point> until;
+		optional<clock::time_point> scheduled; // time of the pending item in mTimeouts
+		uint64_t generation = 0;               // changes on every add()
+		short events = 0;                      // poll events for params.direction
+#if !RTC_POLL_USE_EPOLL
+		size_t index = 0; // position in mPollFds
+#endif
 	};
 
 	using SocketMap = std::unordered_map<socket_t, SocketEntry>;
+
+	// Timeout heap item, stale if the socket's entry is not scheduled at that time anymore
+	struct Timeout {
+		clock::time_point until;
+		socket_t sock;
+		bool operator>(const Timeout &other) const { return until > other.until; }
+	};
+
+	// Callback moved out of its entry while it runs, then handed back unless the socket changed
+	struct Dispatch {
+		socket_t sock;
+		uint64_t generation;
+		std::function<void(Event)> callback;
+		Event event;
+		bool out;     // also trigger Event::Out after event
+		bool restore; // false if the entry was removed
+	};
+
+	void registerSocket(socket_t sock, SocketEntry &entry, bool inserted);
+	void unregisterSocket(SocketMap::iterator it);
+	bool schedule(socket_t sock, SocketEntry &entry);
+	void compactTimeouts();
+	void process(socket_t sock, short revents, clock::time_point now);
+	void processTimeouts(clock::time_point now);
+	void dispatch();
+	void runLoop();
+
 	unique_ptr<SocketMap> mSocks;
 	unique_ptr<PollInterrupter> mInterrupter;
+	std::priority_queue<Timeout, std::vector<Timeout>, std::greater<Timeout>> mTimeouts;
+	std::vector<Dispatch> mDispatch; // poll thread only
+	uint64_t mGeneration = 0;
+
+#if RTC_POLL_USE_EPOLL
+	int mEpoll = -1;
+#else
+	std::vector<struct pollfd> mPollFds; // interrupter first, updated in place by add/remove
+	bool mPollFdsChanged = false;
+#endif
 
-	std::recursive_mutex mMutex;
+	mutable std::recursive_mutex mMutex;
 	std::thread mThread;
 	bool mStopped;
 };
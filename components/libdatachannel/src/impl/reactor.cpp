@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "reactor.hpp"
+#include "internals.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace rtc::impl {
+
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
+Reactor &Reactor::Instance() {
+	static Reactor *instance = new Reactor;
+	return *instance;
+}
+
+Reactor::Reactor() : mEpoch(clock::now()) {}
+
+Reactor::~Reactor() {}
+
+void Reactor::enable(bool enabled) { mEnabled = enabled; }
+
+bool Reactor::enabled() const { return mEnabled; }
+
+void Reactor::start() {
+	std::unique_lock lock(mMutex);
+	if (!mStopped)
+		return;
+
+	PLOG_DEBUG << "Starting reactor";
+	mInterrupter = std::make_unique<PollInterrupter>();
+	mSocksChanged = true;
+	mStopped = false;
+	mThread = std::thread(&Reactor::runLoop, this);
+}
+
+void Reactor::join() {
+	std::unique_lock lock(mMutex);
+	if (std::exchange(mStopped, true))
+		return;
+
+	lock.unlock();
+
+	mInterrupter->interrupt();
+	mThread.join();
+
+	lock.lock();
+	for (auto &slot : mWheel)
+		slot.clear();
+
+	mTimerTicks.clear();
+	mSocks.clear();
+	mInterrupter.reset();
+}
+
+bool Reactor::isCurrentThread() const { return mThreadId.load() == std::this_thread::get_id(); }
+
+void Reactor::add(socket_t sock, std::function<void()> callback) {
+	assert(sock != INVALID_SOCKET);
+	assert(callback);
+
+	std::unique_lock lock(mMutex);
+	PLOG_VERBOSE << "Registering socket in reactor";
+	mSocks.insert_or_assign(sock, std::make_shared<std::function<void()>>(std::move(callback)));
+	mSocksChanged = true;
+	if (mWakeTick)
+		interrupt();
+}
+
+void Reactor::remove(socket_t sock) {
+	std::unique_lock lock(mMutex);
+	if (mSocks.erase(sock) == 0)
+		return;
+
+	PLOG_VERBOSE << "Unregistering socket from reactor";
+	mSocksChanged = true;
+	if (mWakeTick)
+		interrupt();
+}
+
+Reactor::TimerId Reactor::schedule(clock::time_point time, std::function<void()> func) {
+	if (!mEnabled)
+		return 0;
+
+	std::unique_lock lock(mMutex);
+	uint64_t tick = std::max(tickOf(time), mCurrentTick);
+	TimerId id = ++mLastTimerId;
+	mWheel[tick % WheelSize].push_back(Timer{id, tick, std::move(func)});
+	mTimerTicks.emplace(id, tick);
+
+	// A stale bound is recomputed by the loop, it must not be raised here
+	if (mNextTick >= mCurrentTick)
+		mNextTick = std::min(mNextTick, tick);
+
+	if (tick < mWakeTick)
+		interrupt();
+
+	return id;
+}
+
+Reactor::TimerId Reactor::schedule(clock::duration delay, std::function<void()> func) {
+	return schedule(clock::now() + delay, std::move(func));
+}
+
+void Reactor::cancel(TimerId id) {
+	std::unique_lock lock(mMutex);
+	auto it = mTimerTicks.find(id);
+	if (it == mTimerTicks.end())
+		return;
+
+	auto &slot = mWheel[it->second % WheelSize];
+	slot.erase(std::find_if(slot.begin(), slot.end(), [id](const Timer &t) { return t.id == id; }));
+	mTimerTicks.erase(it);
+}
+
+size_t Reactor::pendingTimers() const {
+	std::unique_lock lock(mMutex);
+	return mTimerTicks.size();
+}
+
+uint64_t Reactor::tickOf(clock::time_point time) const {
+	// Round up so that timers never fire early
+	if (time <= mEpoch)
+		return 0;
+
+	return uint64_t((time - mEpoch + Tick - clock::duration(1)) / Tick);
+}
+
+void Reactor::advance(uint64_t tick, std::vector<std::function<void()>> &expired) {
+	// mMutex needs to be locked
+	if (tick < mCurrentTick)
+		return;
+
+	// After a long sleep, a single revolution visits every slot
+	uint64_t count = std::min(tick - mCurrentTick + 1, uint64_t(WheelSize));
+	for (uint64_t i = 0; i < count; ++i) {
+		auto &slot = mWheel[(mCurrentTick + i) % WheelSize];
+		auto kept = slot.begin();
+		for (auto it = slot.begin(); it != slot.end(); ++it) {
+			if (it->tick <= tick) {
+				expired.push_back(std::move(it->func));
+				mTimerTicks.erase(it->id);
+			} else {
+				if (kept != it)
+					*kept = std::move(*it);
+				++kept;
+			}
+		}
+		slot.erase(kept, slot.end());
+	}
+	mCurrentTick = tick + 1;
+}
+
+optional<uint64_t> Reactor::nextTick() {
+	// mMutex needs to be locked
+	if (mTimerTicks.empty())
+		return nullopt;
+
+	if (mNextTick >= mCurrentTick)
+		return mNextTick;
+
+	// The bound is stale, look for the first timer due within a revolution
+	for (uint64_t tick = mCurrentTick; tick < mCurrentTick + WheelSize; ++tick) {
+		const auto &slot = mWheel[tick % WheelSize];
+		if (std::any_of(slot.begin(), slot.end(), [tick](const Timer &t) { return t.tick == tick; }))
+			return mNextTick = tick;
+	}
+
+	// Only far timers are left
+	mNextTick = UINT64_MAX;
+	for (const auto &[id, tick] : mTimerTicks)
+		mNextTick = std::min(mNextTick, tick);
+
+	return mNextTick;
+}
+
+void Reactor::interrupt() {
+	// mMutex needs to be locked
+	if (mInterrupter)
+		mInterrupter->interrupt();
+}
+
+void Reactor::runLoop() {
+	utils::this_thread::set_name("RTC reactor");
+	mThreadId = std::this_thread::get_id();
+	PLOG_DEBUG << "Reactor started";
+
+	std::vector<struct pollfd> pfds;
+	std::vector<shared_ptr<std::function<void()>>> callbacks; // parallel to pfds
+	std::vector<shared_ptr<std::function<void()>>> readable;
+	std::vector<std::function<void()>> expired;
+
+	try {
+		while (true) {
+			int timeout;
+			{
+				std::unique_lock lock(mMutex);
+				if (mStopped)
+					break;
+
+				if (std::exchange(mSocksChanged, false)) {
+					pfds.resize(1 + mSocks.size());
+					callbacks.resize(1 + mSocks.size());
+					mInterrupter->prepare(pfds[0]);
+					size_t i = 1;
+					for (const auto &[sock, callback] : mSocks) {
+						pfds[i].fd = sock;
+						pfds[i].events = POLLIN;
+						callbacks[i] = callback;
+						++i;
+					}
+				}
+
+				if (auto next = nextTick()) {
+					auto left = mEpoch + Tick * int64_t(*next) - clock::now();
+					auto ms = duration_cast<milliseconds>(left + milliseconds(1) - clock::duration(1));
+					timeout = int(std::max(ms.count(), milliseconds::rep(0)));
+					mWakeTick = *next;
+				} else {
+					timeout = -1;
+					mWakeTick = UINT64_MAX;
+				}
+			}
+
+			PLOG_VERBOSE << "Entering reactor poll, timeout=" << timeout << "ms";
+			int ret = ::poll(pfds.data(), (nfds_t)pfds.size(), timeout);
+			PLOG_VERBOSE << "Leaving reactor poll";
+
+			{
+				std::unique_lock lock(mMutex);
+				mWakeTick = 0;
+
+				if (ret < 0) {
+					if (sockerrno == SEINTR || sockerrno == SEAGAIN)
+						continue;
+
+					throw std::runtime_error("poll failed, errno=" + std::to_string(sockerrno));
+				}
+
+				mInterrupter->process(pfds[0]);
+				for (size_t i = 1; i < pfds.size(); ++i) {
+					auto &pfd = pfds[i];
+					if (!pfd.revents)
+						continue;
+
+					// Ignore sockets removed in the meantime
+					auto it = mSocks.find(pfd.fd);
+					if (it == mSocks.end() || it->second != callbacks[i])
+						continue;
+
+					if (pfd.revents & POLLNVAL) {
+						PLOG_WARNING << "Invalid socket registered in reactor, removing it";
+						mSocks.erase(it);
+						mSocksChanged = true;
+						continue;
+					}
+
+					// Errors are reported by the next read
+					readable.push_back(callbacks[i]);
+				}
+
+				auto now = clock::now();
+				if (now >= mEpoch)
+					advance(uint64_t((now - mEpoch) / Tick), expired);
+			}
+
+			for (auto &callback : readable) {
+				try {
+					(*callback)();
+				} catch (const std::exception &e) {
+					PLOG_WARNING << "Reactor socket callback: " << e.what();
+				}
+			}
+
+			for (auto &func : expired) {
+				try {
+					func();
+				} catch (const std::exception &e) {
+					PLOG_WARNING << "Reactor timer: " << e.what();
+				}
+			}
+
+			readable.clear();
+			expired.clear();
+		}
+	} catch (const std::exception &e) {
+		PLOG_FATAL << "Reactor failed: " << e.what();
+	}
+
+	PLOG_DEBUG << "Reactor stopped";
+}
+
+} // namespace rtc::impl
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_REACTOR_H
+#define RTC_IMPL_REACTOR_H
+
+#include "common.hpp"
+#include "pollinterrupter.hpp"
+#include "socket.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace rtc::impl {
+
+// Single network event loop
+// When enabled, ICE sockets, SCTP timers and delayed tasks are all served by one thread, which
+// polls the registered sockets and fires timers from a hashed timing wheel. Callbacks run on the
+// reactor thread and must stay short, CPU-bound work belongs to the thread pool.
+class Reactor final {
+public:
+	using clock = std::chrono::steady_clock;
+	using TimerId = uint64_t; // 0 is never a valid timer
+
+	static Reactor &Instance();
+
+	Reactor(const Reactor &) = delete;
+	Reactor &operator=(const Reactor &) = delete;
+	Reactor(Reactor &&) = delete;
+	Reactor &operator=(Reactor &&) = delete;
+
+	void enable(bool enabled = true); // Must be called before initialization
+	bool enabled() const;
+	void start();
+	void join();
+	bool isCurrentThread() const;
+
+	// The callback is called on the reactor thread each time the socket is readable
+	void add(socket_t sock, std::function<void()> callback);
+	void remove(socket_t sock);
+
+	// Returns 0 if the reactor is disabled. A cancelled timer might still fire if it is already
+	// due, callbacks must hold weak references.
+	TimerId schedule(clock::time_point time, std::function<void()> func);
+	TimerId schedule(clock::duration delay, std::function<void()> func);
+	void cancel(TimerId id);
+
+	size_t pendingTimers() const;
+
+private:
+	static constexpr clock::duration Tick = std::chrono::milliseconds(2);
+	static const size_t WheelSize = 256; // ~0.5s per revolution, later timers wait for rounds
+
+	Reactor();
+	~Reactor();
+
+	void runLoop();
+	uint64_t tickOf(clock::time_point time) const;
+	void advance(uint64_t tick, std::vector<std::function<void()>> &expired);
+	optional<uint64_t> nextTick();
+	void interrupt();
+
+	struct Timer {
+		TimerId id;
+		uint64_t tick;
+		std::function<void()> func;
+	};
+
+	using Slot = std::vector<Timer>;
+	std::array<Slot, WheelSize> mWheel;
+	std::unordered_map<TimerId, uint64_t> mTimerTicks; // for cancellation
+	TimerId mLastTimerId = 0;
+	uint64_t mCurrentTick = 0; // next tick to process
+	uint64_t mNextTick = UINT64_MAX; // lower bound of the earliest timer tick
+	uint64_t mWakeTick = 0;          // tick the loop sleeps until, 0 if awake
+	clock::time_point mEpoch;
+
+	using SocketMap = std::unordered_map<socket_t, shared_ptr<std::function<void()>>>;
+	SocketMap mSocks;
+	bool mSocksChanged = true;
+
+	unique_ptr<PollInterrupter> mInterrupter;
+	std::atomic<bool> mEnabled = false;
+	bool mStopped = true;
+	std::thread mThread;
+	std::atomic<std::thread::id> mThreadId;
+	mutable std::mutex mMutex;
+};
+
+} // namespace rtc::impl
+
+#endif
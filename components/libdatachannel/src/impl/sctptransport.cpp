@@ -10,6 +10,7 @@
 #include "dtlstransport.hpp"
 #include "internals.hpp"
 #include "logcounter.hpp"
+#include "reactor.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
@@ -52,6 +53,11 @@
 #endif
 */
 
+// Socket option for RFC 8260 user message interleaving, not exported by usrsctp.h
+#ifndef SCTP_INTERLEAVING_SUPPORTED
+#define SCTP_INTERLEAVING_SUPPORTED 0x00001206
+#endif
+
 using namespace std::chrono_literals;
 using namespace std::chrono;
 
@@ -88,8 +94,75 @@ private:
 
 SctpTransport::InstancesSet* SctpTransport::Instances = nullptr;
 
+class SctpTransport::WriteBatch {
+public:
+	WriteBatch(SctpTransport *transport) : mTransport(transport), mPrevious(Current) {
+		if (!Find(transport)) // the outermost scope sends
+			Current = this;
+	}
+
+	~WriteBatch() {
+		if (Current != this)
+			return;
+
+		Current = mPrevious;
+		try {
+			if (!mPackets.empty())
+				mTransport->outgoingMultiple(mPackets);
+
+		} catch (const std::exception &e) {
+			PLOG_ERROR << "SCTP write: " << e.what();
+		}
+	}
+
+	static WriteBatch *Find(SctpTransport *transport) {
+		for (auto batch = Current; batch; batch = batch->mPrevious)
+			if (batch->mTransport == transport)
+				return batch;
+
+		return nullptr;
+	}
+
+	void push(message_ptr packet) { mPackets.push_back(std::move(packet)); }
+
+private:
+	SctpTransport *const mTransport;
+	WriteBatch *const mPrevious;
+	message_vector mPackets;
+
+	static thread_local WriteBatch *Current;
+};
+
+thread_local SctpTransport::WriteBatch *SctpTransport::WriteBatch::Current = nullptr;
+
+namespace {
+
+// With the reactor, usrsctp runs without its timer thread and is ticked instead
+const auto ReactorTimersPeriod = 10ms;
+std::atomic<bool> ReactorTimers = false;
+
+void scheduleReactorTimers(steady_clock::time_point last) {
+	Reactor::Instance().schedule(ReactorTimersPeriod, [last]() {
+		if (!ReactorTimers)
+			return;
+
+		auto elapsed = duration_cast<milliseconds>(steady_clock::now() - last);
+		usrsctp_handle_timers(uint32_t(elapsed.count()));
+		scheduleReactorTimers(last + elapsed); // keep the remainder for the next tick
+	});
+}
+
+} // namespace
+
 void SctpTransport::Init() {
-	usrsctp_init(0, SctpTransport::WriteCallback, SctpTransport::DebugCallback);
+	if (Reactor::Instance().enabled()) {
+		PLOG_DEBUG << "Driving SCTP timers from the reactor";
+		usrsctp_init_nothreads(0, SctpTransport::WriteCallback, SctpTransport::DebugCallback);
+		ReactorTimers = true;
+		scheduleReactorTimers(steady_clock::now());
+	} else {
+		usrsctp_init(0, SctpTransport::WriteCallback, SctpTransport::DebugCallback);
+	}
 	usrsctp_sysctl_set_sctp_pr_enable(1);  // Enable Partial Reliability Extension (RFC 3758)
 	usrsctp_sysctl_set_sctp_ecn_enable(0); // Disable Explicit Congestion Notification
 #ifndef SCTP_ACCEPT_ZERO_CHECKSUM
@@ -152,8 +225,12 @@ void SctpTransport::SetSettings(const SctpSettings &s) {
 }
 
 void SctpTransport::Cleanup() {
-	while (usrsctp_finish())
+	bool ticked = ReactorTimers.exchange(false);
+	while (usrsctp_finish()) {
 		std::this_thread::sleep_for(100ms);
+		if (ticked) // the reactor is stopped, pending timers must still run
+			usrsctp_handle_timers(100);
+	}
 
 	delete Instances;
 	Instances = nullptr;
@@ -164,7 +241,7 @@ SctpTransport::SctpTransport(shared_ptr<Transport> lower, const Configuration &c
                              state_callback stateChangeCallback)
     : Transport(lower, std::move(stateChangeCallback)),
       mMaxMessageSize(config.maxMessageSize.value_or(DEFAULT_LOCAL_MAX_MESSAGE_SIZE)),
-      mPorts(std::move(ports)), mSendQueue(0, message_size_func),
+      mPorts(std::move(ports)), mSendQueue(message_size_func),
       mBufferedAmountCallback(std::move(bufferedAmountCallback)) {
 	onRecv(std::move(recvCallback));
 	
@@ -271,14 +348,43 @@ SctpTransport::SctpTransport(shared_ptr<Transport> lower, const Configuration &c
 		throw std::runtime_error("Could not set socket option SCTP_INITMSG, errno=" +
 		                         std::to_string(errno));
 
-	// Prevent fragmented interleave of messages (i.e. level 0), see RFC 6458 section 8.1.20.
-	// Unless the user has set the fragmentation interleave level to 0, notifications
-	// may also be interleaved with partially delivered messages.
-	int level = 0;
-	if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_FRAGMENT_INTERLEAVE, &level, sizeof(level)))
-		throw std::runtime_error("Could not disable SCTP fragmented interleave, errno=" +
+	// Serve streams by priority, round robin among streams of equal priority, instead of first
+	// come first served, so small messages are not stuck behind bulk transfers on other streams
+	av.assoc_id = SCTP_ALL_ASSOC;
+	av.assoc_value = SCTP_SS_PRIORITY;
+	if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_PLUGGABLE_SS, &av, sizeof(av)))
+		throw std::runtime_error("Could not set socket option SCTP_PLUGGABLE_SS, errno=" +
 		                         std::to_string(errno));
 
+	if (!config.disableSctpMessageInterleaving) {
+		// RFC 8260 user message interleaving (I-DATA) lets the scheduler switch streams in the
+		// middle of a large message. It requires fragmented interleave level 2, meaning partial
+		// deliveries of messages from different streams may be interleaved on reception, see
+		// RFC 6458 section 8.1.20. I-DATA is only used if the peer supports it too.
+		int level = 2;
+		if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_FRAGMENT_INTERLEAVE, &level,
+		                       sizeof(level)))
+			throw std::runtime_error("Could not set SCTP fragmented interleave, errno=" +
+			                         std::to_string(errno));
+
+		av.assoc_id = SCTP_FUTURE_ASSOC;
+		av.assoc_value = 1;
+		if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_INTERLEAVING_SUPPORTED, &av, sizeof(av)))
+			throw std::runtime_error(
+			    "Could not set socket option SCTP_INTERLEAVING_SUPPORTED, errno=" +
+			    std::to_string(errno));
+
+	} else {
+		// Prevent fragmented interleave of messages (i.e. level 0), see RFC 6458 section 8.1.20.
+		// Unless the user has set the fragmentation interleave level to 0, notifications
+		// may also be interleaved with partially delivered messages.
+		int level = 0;
+		if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_FRAGMENT_INTERLEAVE, &level,
+		                       sizeof(level)))
+			throw std::runtime_error("Could not disable SCTP fragmented interleave, errno=" +
+			                         std::to_string(errno));
+	}
+
 #ifdef SCTP_ACCEPT_ZERO_CHECKSUM // not available in usrsctp v0.9.5.0
 	// When using SCTP over DTLS, the data integrity is ensured by DTLS. Therefore, there's no
 	// need to check CRC32c additionally when receiving. See
@@ -376,10 +482,12 @@ void SctpTransport::connect() {
 }
 
 bool SctpTransport::send(message_ptr message) {
+	MemoryTracker::Scope scope(memoryTag());
 	std::lock_guard lock(mSendMutex);
 	if (state() != State::Connected)
 		return false;
 
+	WriteBatch batch(this);
 	if (!message)
 		return trySendQueue();
 
@@ -403,6 +511,7 @@ bool SctpTransport::flush() {
 		if (state() != State::Connected)
 			return false;
 
+		WriteBatch batch(this);
 		trySendQueue();
 		return true;
 
@@ -424,6 +533,24 @@ void SctpTransport::closeStream(unsigned int stream) {
 	mProcessor.enqueue(&SctpTransport::flush, shared_from_this());
 }
 
+void SctpTransport::setStreamPriority(uint16_t stream, uint16_t priority, unsigned int weight) {
+	PLOG_VERBOSE << "SCTP stream " << stream << " priority=" << priority << ", weight=" << weight;
+
+	// Messages waiting for room in the SCTP send buffer
+	mSendQueue.setPriority(stream, priority, weight);
+
+	// Messages already in the SCTP send buffer, where a lower value means a higher priority
+	// The usrsctp priority scheduler has no notion of weight, streams of equal priority are served
+	// round robin.
+	struct sctp_stream_value sv = {};
+	sv.assoc_id = SCTP_FUTURE_ASSOC;
+	sv.stream_id = stream;
+	sv.stream_value = uint16_t(std::numeric_limits<uint16_t>::max() - priority);
+	if (usrsctp_setsockopt(mSock, IPPROTO_SCTP, SCTP_SS_VALUE, &sv, sizeof(sv))) {
+		PLOG_WARNING << "SCTP set priority for stream " << stream << " failed, errno=" << errno;
+	}
+}
+
 void SctpTransport::close() {
 	mSendQueue.stop();
 	if (state() == State::Connected) {
@@ -468,17 +595,59 @@ void SctpTransport::incoming(message_ptr message) {
 
 	PLOG_VERBOSE << "Incoming size=" << message->size();
 
+	// Packets written in reaction, like SACKs, are sent together
+	WriteBatch batch(this);
 	usrsctp_conninput(this, message->data(), message->size(), 0);
 }
 
 bool SctpTransport::outgoing(message_ptr message) {
-	// Set recommended medium-priority DSCP value
-	// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-	message->dscp = 10; // AF11: Assured Forwarding class 1, low drop probability
+	MarkTrafficClass(*message);
 	return Transport::outgoing(std::move(message));
 }
 
+void SctpTransport::MarkTrafficClass(Message &packet) {
+	// Packets carrying DataChannel data are bulk traffic, while packets carrying only control
+	// chunks (SACK, HEARTBEAT, FORWARD-TSN...) or DataChannel establishment are not delayed behind
+	// them since they unblock the association.
+	// See https://www.rfc-editor.org/rfc/rfc9260.html#section-3
+	const size_t commonHeaderSize = 12;
+	auto byteAt = [&packet](size_t i) { return std::to_integer<uint32_t>(packet[i]); };
+	auto trafficClass = TrafficClass::Control;
+	size_t offset = commonHeaderSize;
+	while (offset + 4 <= packet.size()) {
+		uint8_t type = uint8_t(byteAt(offset));
+		uint8_t flags = uint8_t(byteAt(offset + 1));
+		size_t length = byteAt(offset + 2) << 8 | byteAt(offset + 3);
+		if (length < 4)
+			break;
+
+		// PPID follows TSN, stream and SSN in DATA, and TSN, stream and MID in a first I-DATA
+		// fragment (RFC 8260)
+		size_t ppidOffset = 0;
+		if (type == 0) // DATA
+			ppidOffset = offset + 12;
+		else if (type == 64 && (flags & 0x02)) // I-DATA with the B bit
+			ppidOffset = offset + 16;
+
+		if (type == 0 || type == 64) {
+			if (ppidOffset && ppidOffset + 4 <= packet.size() &&
+			    (byteAt(ppidOffset) << 24 | byteAt(ppidOffset + 1) << 16 |
+			     byteAt(ppidOffset + 2) << 8 | byteAt(ppidOffset + 3)) == PPID_CONTROL) {
+				trafficClass = TrafficClass::Control;
+				break;
+			}
+			trafficClass = TrafficClass::Bulk;
+		}
+
+		offset += (length + 3) & ~size_t(3); // chunks are padded to 4 bytes
+	}
+
+	packet.trafficClass = trafficClass;
+	packet.dscp = GetTrafficClassDscp(trafficClass);
+}
+
 void SctpTransport::doRecv() {
+	MemoryTracker::Scope scope(memoryTag());
 	std::lock_guard lock(mRecvMutex);
 	--mPendingRecvCount;
 	try {
@@ -534,19 +703,22 @@ void SctpTransport::doRecv() {
 
 			} else {
 				// SCTP message
-				mPartialMessage.insert(mPartialMessage.end(), buffer, buffer + len);
-				if (mPartialMessage.size() > mMaxMessageSize) {
+				if (infotype != SCTP_RECVV_RCVINFO)
+					throw std::runtime_error("Missing SCTP recv info");
+
+				// Partial deliveries of messages on different streams may be interleaved
+				auto &partial = mPartialMessages[info.rcv_sid];
+				partial.insert(partial.end(), buffer, buffer + len);
+				if (partial.size() > mMaxMessageSize) {
 					PLOG_WARNING << "SCTP message is too large, truncating it";
-					mPartialMessage.resize(mMaxMessageSize);
+					partial.resize(mMaxMessageSize);
 				}
 
 				if (flags & MSG_EOR) {
 					// Message is complete, process it
 					binary message;
-					mPartialMessage.swap(message);
-					if (infotype != SCTP_RECVV_RCVINFO)
-						throw std::runtime_error("Missing SCTP recv info");
-
+					partial.swap(message);
+					mPartialMessages.erase(info.rcv_sid);
 					processData(std::move(message), info.rcv_sid, PayloadId(ntohl(info.rcv_ppid)));
 				}
 			}
@@ -557,9 +729,11 @@ void SctpTransport::doRecv() {
 }
 
 void SctpTransport::doFlush() {
+	MemoryTracker::Scope scope(memoryTag());
 	std::lock_guard lock(mSendMutex);
 	--mPendingFlushCount;
 	try {
+		WriteBatch batch(this);
 		trySendQueue();
 	} catch (const std::exception &e) {
 		PLOG_WARNING << e.what();
@@ -641,9 +815,6 @@ bool SctpTransport::trySendMessage(message_ptr message) {
 
 	PLOG_VERBOSE << "SCTP try send size=" << message->size();
 
-	// TODO: Implement SCTP ndata specification draft when supported everywhere
-	// See https://datatracker.ietf.org/doc/html/draft-ietf-tsvwg-sctp-ndata-08
-
 	const Reliability reliability = message->reliability ? *message->reliability : Reliability();
 
 	struct sctp_sendv_spa spa = {};
@@ -785,8 +956,15 @@ int SctpTransport::handleWrite(byte *data, size_t len, uint8_t /*tos*/,
 		std::unique_lock lock(mWriteMutex);
 		PLOG_VERBOSE << "Handle write, len=" << len;
 
-		if (!outgoing(make_message(data, data + len)))
+		if (auto batch = WriteBatch::Find(this)) {
+			// Dropped packets in the batch are handled as losses by SCTP
+			auto message = make_message(data, data + len);
+			MarkTrafficClass(*message); // see outgoing()
+			batch->push(std::move(message));
+
+		} else if (!outgoing(make_message(data, data + len))) {
 			return -1;
+		}
 
 		mWritten = true;
 		mWrittenOnce = true;
@@ -14,6 +14,7 @@
 #include "global.hpp"
 #include "processor.hpp"
 #include "queue.hpp"
+#include "streamscheduler.hpp"
 #include "transport.hpp"
 
 #include <condition_variable>
@@ -52,6 +53,9 @@ public:
 	void closeStream(unsigned int stream);
 	void close();
 
+	// Higher priorities are sent first, weights share bandwidth among streams of equal priority
+	void setStreamPriority(uint16_t stream, uint16_t priority, unsigned int weight = 1);
+
 	unsigned int maxStream() const;
 
 	// Stats
@@ -90,6 +94,8 @@ private:
 	void triggerBufferedAmount(uint16_t streamId, size_t amount);
 	void sendReset(uint16_t streamId);
 
+	static void MarkTrafficClass(Message &packet);
+
 	void handleUpcall() noexcept;
 	int handleWrite(byte *data, size_t len, uint8_t tos, uint8_t set_df) noexcept;
 
@@ -106,7 +112,7 @@ private:
 	std::atomic<int> mPendingFlushCount = 0;
 	std::mutex mRecvMutex;
 	std::recursive_mutex mSendMutex; // buffered amount callback is synchronous
-	Queue<message_ptr> mSendQueue;
+	StreamScheduler mSendQueue;
 	bool mSendShutdown = false;
 	std::map<uint16_t, size_t> mBufferedAmount;
 	amount_callback mBufferedAmountCallback;
@@ -116,7 +122,8 @@ private:
 	std::atomic<bool> mWritten = false;     // written outside lock
 	std::atomic<bool> mWrittenOnce = false; // same
 
-	binary mPartialMessage, mPartialNotification;
+	std::map<uint16_t, binary> mPartialMessages; // per stream as I-DATA interleaves messages
+	binary mPartialNotification;
 	binary mPartialStringData, mPartialBinaryData;
 
 	// Stats
@@ -128,6 +135,10 @@ private:
 
 	class InstancesSet;
 	static InstancesSet* Instances;
+
+	// Collects the packets usrsctp writes synchronously while in scope on the current thread, so
+	// they are handed to the lower transport together
+	class WriteBatch;
 };
 
 } // namespace rtc::impl
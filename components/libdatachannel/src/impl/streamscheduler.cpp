@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "streamscheduler.hpp"
+#include "internals.hpp"
+
+#include <algorithm>
+
+namespace rtc::impl {
+
+StreamScheduler::StreamScheduler(amount_function func) {
+	mAmountFunction = func ? func : []([[maybe_unused]] const message_ptr &m) -> size_t {
+		return 1;
+	};
+}
+
+StreamScheduler::~StreamScheduler() { stop(); }
+
+void StreamScheduler::stop() {
+	std::lock_guard lock(mMutex);
+	mStopping = true;
+}
+
+bool StreamScheduler::running() const {
+	std::lock_guard lock(mMutex);
+	return mSize > 0 || !mStopping;
+}
+
+bool StreamScheduler::empty() const {
+	std::lock_guard lock(mMutex);
+	return mSize == 0;
+}
+
+size_t StreamScheduler::size() const {
+	std::lock_guard lock(mMutex);
+	return mSize;
+}
+
+size_t StreamScheduler::amount() const {
+	std::lock_guard lock(mMutex);
+	return mAmount;
+}
+
+void StreamScheduler::setPriority(uint16_t id, uint16_t priority, unsigned int weight) {
+	std::lock_guard lock(mMutex);
+	auto &stream = getStream(id);
+	bool active = stream.active;
+	if (active)
+		deactivate(id, stream);
+
+	stream.priority = priority;
+	stream.weight = std::max(weight, 1u);
+
+	if (active)
+		activate(id, stream);
+}
+
+void StreamScheduler::push(message_ptr message) {
+	std::lock_guard lock(mMutex);
+	if (mStopping)
+		return;
+
+	uint16_t id = uint16_t(message->stream);
+	auto &stream = getStream(id);
+	mAmount += mAmountFunction(message);
+	++mSize;
+	stream.messages.emplace_back(std::move(message));
+	if (!stream.active)
+		activate(id, stream);
+}
+
+optional<message_ptr> StreamScheduler::peek() {
+	std::lock_guard lock(mMutex);
+	auto id = select();
+	return id ? std::make_optional(mStreams[*id].messages.front()) : nullopt;
+}
+
+optional<message_ptr> StreamScheduler::pop() {
+	std::lock_guard lock(mMutex);
+	auto id = select();
+	if (!id)
+		return nullopt;
+
+	auto &stream = mStreams[*id];
+	optional<message_ptr> message{std::move(stream.messages.front())};
+	stream.messages.pop_front();
+	size_t amount = mAmountFunction(*message);
+	stream.deficit -= std::min(stream.deficit, amount);
+	mAmount -= amount;
+	--mSize;
+
+	// An emptied stream leaves the round and forfeits its remaining credit
+	if (stream.messages.empty())
+		deactivate(*id, stream);
+
+	return message;
+}
+
+StreamScheduler::Stream &StreamScheduler::getStream(uint16_t id) {
+	auto it = mStreams.find(id);
+	if (it == mStreams.end()) {
+		Stream stream;
+		stream.priority = DEFAULT_DATACHANNEL_PRIORITY;
+		it = mStreams.emplace(id, std::move(stream)).first;
+	}
+	return it->second;
+}
+
+void StreamScheduler::activate(uint16_t id, Stream &stream) {
+	mRounds[stream.priority].push_back(id);
+	stream.active = true;
+}
+
+void StreamScheduler::deactivate(uint16_t id, Stream &stream) {
+	auto it = mRounds.find(stream.priority);
+	if (it != mRounds.end()) {
+		it->second.remove(id);
+		if (it->second.empty())
+			mRounds.erase(it);
+	}
+	stream.active = false;
+	stream.deficit = 0;
+}
+
+optional<uint16_t> StreamScheduler::select() {
+	// Requires mMutex to be locked
+	if (mRounds.empty())
+		return nullopt;
+
+	// Deficit round robin within the highest priority level: the stream at the front of the round
+	// is selected while it has enough credit for its next message, otherwise it is granted its
+	// quantum and moved to the back. This terminates as every pass grants credit to all streams.
+	auto &round = mRounds.begin()->second;
+	while (true) {
+		uint16_t id = round.front();
+		auto &stream = mStreams[id];
+		if (stream.deficit >= mAmountFunction(stream.messages.front()))
+			return id;
+
+		stream.deficit += Quantum * stream.weight;
+		if (round.size() > 1)
+			round.splice(round.end(), round, round.begin());
+	}
+}
+
+} // namespace rtc::impl
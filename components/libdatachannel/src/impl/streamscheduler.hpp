@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_IMPL_STREAM_SCHEDULER_H
+#define RTC_IMPL_STREAM_SCHEDULER_H
+
+#include "common.hpp"
+#include "message.hpp"
+
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace rtc::impl {
+
+// Send queue with one FIFO per SCTP stream
+// Streams with a higher priority are always served first. Streams sharing a priority are served
+// with deficit round robin, so each gets a share of bytes proportional to its weight. Order is
+// preserved within a stream.
+class StreamScheduler final {
+public:
+	using amount_function = std::function<size_t(const message_ptr &message)>;
+
+	inline static const size_t Quantum = 16 * 1024; // bytes granted per round for weight 1
+
+	StreamScheduler(amount_function func = nullptr);
+	~StreamScheduler();
+
+	void stop();
+	bool running() const;
+	bool empty() const;
+	size_t size() const;   // messages
+	size_t amount() const; // amount
+
+	void setPriority(uint16_t stream, uint16_t priority, unsigned int weight = 1);
+	void push(message_ptr message);
+	optional<message_ptr> peek(); // Next message to send, stable until pop() or push()
+	optional<message_ptr> pop();  // Removes the message returned by peek()
+
+private:
+	struct Stream {
+		std::deque<message_ptr> messages;
+		uint16_t priority;
+		unsigned int weight = 1;
+		size_t deficit = 0;
+		bool active = false;
+	};
+
+	using Round = std::list<uint16_t>; // Active streams of a priority level
+
+	Stream &getStream(uint16_t id);
+	void activate(uint16_t id, Stream &stream);
+	void deactivate(uint16_t id, Stream &stream);
+	optional<uint16_t> select();
+
+	std::unordered_map<uint16_t, Stream> mStreams;
+	std::map<uint16_t, Round, std::greater<uint16_t>> mRounds; // highest priority first
+	amount_function mAmountFunction;
+	size_t mSize = 0;
+	size_t mAmount = 0;
+	bool mStopping = false;
+
+	mutable std::mutex mMutex;
+};
+
+} // namespace rtc::impl
+
+#endif
@@ -9,6 +9,8 @@
 #include "threadpool.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+
 namespace rtc::impl {
 
 ThreadPool &ThreadPool::Instance() {
@@ -29,6 +31,8 @@ void ThreadPool::spawn(int count) {
 	std::unique_lock lock(mWorkersMutex);
 	while (count-- > 0)
 		mWorkers.emplace_back(std::bind(&ThreadPool::run, this));
+
+	mWorkerCount = int(mWorkers.size());
 }
 
 void ThreadPool::join() {
@@ -44,6 +48,7 @@ void ThreadPool::join() {
 		w.join();
 
 	mWorkers.clear();
+	mWorkerCount = 0;
 
 	mJoining = false;
 }
@@ -52,6 +57,8 @@ void ThreadPool::clear() {
 	std::unique_lock lock(mMutex);
 	while (!mTasks.empty())
 		mTasks.pop();
+
+	mBackgroundTasks.clear();
 }
 
 void ThreadPool::run() {
@@ -63,26 +70,68 @@ void ThreadPool::run() {
 }
 
 bool ThreadPool::runOne() {
-	if (auto task = dequeue()) {
+	bool background = false;
+	if (auto task = dequeue(background)) {
 		task();
+		if (background) {
+			std::unique_lock lock(mMutex);
+			--mBackgroundWorkers;
+			if (!mBackgroundTasks.empty())
+				mTasksCondition.notify_one();
+		}
 		return true;
 	}
 	return false;
 }
 
-std::function<void()> ThreadPool::dequeue() {
+void ThreadPool::push(clock::time_point time, std::function<void()> func) {
+	std::unique_lock lock(mMutex);
+	mTasks.push({time, std::move(func)});
+	mTasksCondition.notify_one();
+}
+
+void ThreadPool::pushBackground(std::function<void()> func) {
+	std::unique_lock lock(mMutex);
+	mBackgroundTasks.push_back({clock::now(), std::move(func)});
+	mTasksCondition.notify_one();
+}
+
+bool ThreadPool::backgroundAllowed() const {
+	// mMutex needs to be locked
+	// Keep a worker for regular tasks so handshakes do not hold up media
+	return !mBackgroundTasks.empty() && mBackgroundWorkers < std::max(mWorkerCount - 1, 1);
+}
+
+std::function<void()> ThreadPool::dequeue(bool &background) {
 	std::unique_lock lock(mMutex);
 	while (!mJoining) {
+		auto now = clock::now();
+		auto takeBackground = [&]() {
+			auto func = std::move(mBackgroundTasks.front().func);
+			mBackgroundTasks.pop_front();
+			++mBackgroundWorkers;
+			background = true;
+			return func;
+		};
+
+		// A background task that waited too long goes first so it can't be starved
+		bool allowed = backgroundAllowed();
+		if (allowed && mBackgroundTasks.front().time + BackgroundMaxDelay <= now)
+			return takeBackground();
+
 		std::optional<clock::time_point> time;
 		if (!mTasks.empty()) {
 			time = mTasks.top().time;
-			if (*time <= clock::now()) {
+			if (*time <= now) {
 				auto func = std::move(mTasks.top().func);
 				mTasks.pop();
 				return func;
 			}
 		}
 
+		if (allowed)
+			return takeBackground();
+
 		--mBusyWorkers;
 		scope_guard guard([&]() { ++mBusyWorkers; });
 		mWaitingCondition.notify_all();
@@ -12,6 +12,7 @@
 #include "common.hpp"
 #include "init.hpp"
 #include "internals.hpp"
+#include "reactor.hpp"
 
 #include <chrono>
 #include <condition_variable>
@@ -23,6 +24,7 @@
 #include <queue>
 #include <stdexcept>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 namespace rtc::impl {
@@ -59,15 +61,31 @@ public:
 	auto schedule(clock::time_point time, F &&f, Args &&...args) noexcept
 	    -> invoke_future_t<F, Args...>;
 
+	// Low-priority lane for CPU-heavy work like key generation and handshakes: tasks only run when
+	// no regular task is due, on all workers but one, unless they waited for BackgroundMaxDelay
+	template <class F, class... Args>
+	auto enqueueBackground(F &&f, Args &&...args) noexcept -> invoke_future_t<F, Args...>;
+
+	static constexpr clock::duration BackgroundMaxDelay = std::chrono::milliseconds(50);
+
 private:
 	ThreadPool();
 	~ThreadPool();
 
-	std::function<void()> dequeue(); // returns null function if joining
+	void push(clock::time_point time, std::function<void()> func);
+	void pushBackground(std::function<void()> func);
+	std::function<void()> dequeue(bool &background); // returns null function if joining
+	bool backgroundAllowed() const;
+
+	template <class F, class... Args>
+	static auto package(F &&f, Args &&...args)
+	    -> std::tuple<std::function<void()>, invoke_future_t<F, Args...>>;
 
 	std::vector<std::thread> mWorkers;
+	std::atomic<int> mWorkerCount = 0;
 	std::atomic<int> mBusyWorkers = 0;
 	std::atomic<bool> mJoining = false;
+	int mBackgroundWorkers = 0; // running background tasks
 
 	struct Task {
 		clock::time_point time;
@@ -76,6 +94,7 @@ private:
 		bool operator<(const Task &other) const { return time < other.time; }
 	};
 	std::priority_queue<Task, std::deque<Task>, std::greater<Task>> mTasks;
+	std::deque<Task> mBackgroundTasks; // FIFO, time is the enqueue time
 
 	std::condition_variable mTasksCondition, mWaitingCondition;
 	mutable std::mutex mMutex, mWorkersMutex;
@@ -95,7 +114,31 @@ auto ThreadPool::schedule(clock::duration delay, F &&f, Args &&...args) noexcept
 template <class F, class... Args>
 auto ThreadPool::schedule(clock::time_point time, F &&f, Args &&...args) noexcept
     -> invoke_future_t<F, Args...> {
-	std::unique_lock lock(mMutex);
+	auto [func, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
+
+	// With a reactor, delayed tasks wait on its timer wheel and only occupy the queue once due
+	auto &reactor = Reactor::Instance();
+	if (reactor.enabled() && time > clock::now())
+		reactor.schedule(time, [this, func = std::move(func)]() mutable {
+			push(clock::now(), std::move(func));
+		});
+	else
+		push(time, std::move(func));
+
+	return std::move(result);
+}
+
+template <class F, class... Args>
+auto ThreadPool::enqueueBackground(F &&f, Args &&...args) noexcept
+    -> invoke_future_t<F, Args...> {
+	auto [func, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
+	pushBackground(std::move(func));
+	return std::move(result);
+}
+
+template <class F, class... Args>
+auto ThreadPool::package(F &&f, Args &&...args)
+    -> std::tuple<std::function<void()>, invoke_future_t<F, Args...>> {
 	using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
 	auto bound = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
 	auto task = std::make_shared<std::packaged_task<R()>>([bound = std::move(bound)]() mutable {
@@ -108,9 +151,8 @@ auto ThreadPool::schedule(clock::time_point time, F &&f, Args &&...args) noexcep
 	});
 	std::future<R> result = task->get_future();
 
-	mTasks.push({time, [task = std::move(task)]() { return (*task)(); }});
-	mTasksCondition.notify_one();
-	return result;
+	std::function<void()> func = [task = std::move(task)]() { return (*task)(); };
+	return std::make_tuple(std::move(func), std::move(result));
 }
 
 } // namespace rtc::impl
@@ -7,6 +7,7 @@
  */
 
 #include "track.hpp"
+#include "epoch.hpp"
 #include "internals.hpp"
 #include "logcounter.hpp"
 #include "peerconnection.hpp"
@@ -30,10 +31,55 @@ static LogCounter COUNTER_MEDIA_BAD_DIRECTION(plog::warning,
 static LogCounter COUNTER_QUEUE_FULL(plog::warning,
                                      "Number of media packets dropped due to a full queue");
 
+namespace {
+
+// Class of media packets not marked by handlers, see GetTrafficClassDscp() for DSCP values
+TrafficClass mediaTrafficClass(const Description::Media &desc) {
+	return desc.type() == "audio" ? TrafficClass::Audio : TrafficClass::DeltaFrame;
+}
+
+#if RTC_ENABLE_MEDIA
+
+const string TransportSequenceNumberUri =
+    "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01";
+const string AbsSendTimeUri = "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time";
+
+// Extensions the transport has to stamp at send time for this media
+DtlsSrtpTransport::SendExtensions sendExtensions(Description::Media &desc) {
+	DtlsSrtpTransport::SendExtensions extensions;
+	for (int id : desc.extIds()) {
+		auto map = desc.extMap(id);
+		if (!map || id <= 0 || id > 255)
+			continue;
+
+		if (map->uri == TransportSequenceNumberUri)
+			extensions.transportSequenceNumberId = uint8_t(id);
+		else if (map->uri == AbsSendTimeUri)
+			extensions.absSendTimeId = uint8_t(id);
+	}
+	return extensions;
+}
+
+#endif
+
+MemoryTracker::Tag mediaMemoryTag(const weak_ptr<PeerConnection> &weakPeerConnection) {
+	auto pc = weakPeerConnection.lock();
+	return pc ? MemoryTracker::MakeTag(pc->memoryTag(), MemorySubsystem::Media) : 0;
+}
+
+} // namespace
+
 Track::Track(weak_ptr<PeerConnection> pc, Description::Media desc)
     : mPeerConnection(pc), mMediaDescription(std::move(desc)),
+      mDirection(mMediaDescription.direction()),
+      mTrafficClass(mediaTrafficClass(mMediaDescription)),
+      mMemoryTag(mediaMemoryTag(mPeerConnection)),
       mRecvQueue(RECV_QUEUE_LIMIT, [](const message_ptr &m) { return m->size(); }) {
 
+#if RTC_ENABLE_MEDIA
+	mSendExtensions = sendExtensions(mMediaDescription);
+#endif
+
 	// Discard messages by default if track is send only
 	if (mMediaDescription.direction() == Description::Direction::SendOnly)
 		messageCallback = [](message_variant) {};
@@ -54,8 +100,7 @@ string Track::mid() const {
 }
 
 Description::Direction Track::direction() const {
-	std::shared_lock lock(mMutex);
-	return mMediaDescription.direction();
+	return mDirection.load(std::memory_order_relaxed);
 }
 
 Description::Media Track::description() const {
@@ -70,6 +115,11 @@ void Track::setDescription(Description::Media desc) {
 			throw std::logic_error("Media description mid does not match track mid");
 
 		mMediaDescription = std::move(desc);
+		mDirection = mMediaDescription.direction();
+		mTrafficClass = mediaTrafficClass(mMediaDescription);
+#if RTC_ENABLE_MEDIA
+		mSendExtensions = sendExtensions(mMediaDescription);
+#endif
 	}
 
 	if (auto handler = getMediaHandler())
@@ -134,6 +184,12 @@ void Track::open(shared_ptr<DtlsSrtpTransport> transport) {
 	{
 		std::lock_guard lock(mMutex);
 		mDtlsSrtpTransport = transport;
+
+		// A sender might still be using the previous session, keep it until it is done
+		auto session = transport->session();
+		mSrtpSessionPtr.store(session.get(), std::memory_order_release);
+		if (auto previous = std::exchange(mSrtpSession, std::move(session)))
+			Epoch::Instance().retire(new shared_ptr<DtlsSrtpTransport::Session>(std::move(previous)));
 	}
 
 	if (!mIsClosed)
@@ -145,6 +201,8 @@ void Track::incoming(message_ptr message) {
 	if (!message)
 		return;
 
+	MemoryTracker::Scope scope(mMemoryTag);
+
 	auto dir = direction();
 	if ((dir == Description::Direction::SendOnly || dir == Description::Direction::Inactive) &&
 	    message->type != Message::Control) {
@@ -155,11 +213,7 @@ void Track::incoming(message_ptr message) {
 	message_vector messages{std::move(message)};
 	if (auto handler = getMediaHandler()) {
 		try {
-			handler->incomingChain(messages, [this, weak_this = weak_from_this()](message_ptr m) {
-				if (auto locked = weak_this.lock()) {
-					transportSend(m);
-				}
-			});
+			handler->incomingChain(messages, mSendCallback);
 		} catch (const std::exception &e) {
 			PLOG_WARNING << "Exception in incoming media handler: " << e.what();
 			return;
@@ -182,6 +236,8 @@ bool Track::outgoing(message_ptr message) {
 	if (mIsClosed)
 		throw std::runtime_error("Track is closed");
 
+	MemoryTracker::Scope scope(mMemoryTag);
+
 	auto handler = getMediaHandler();
 
 	// If there is no handler, the track expects RTP or RTCP packets
@@ -196,19 +252,20 @@ bool Track::outgoing(message_ptr message) {
 	}
 
 	if (handler) {
-		message_vector messages{std::move(message)};
+		// Frames go through the handlers in a per-thread vector whose capacity is kept, it is
+		// borrowed so a nested send on the same thread gets its own
+		static thread_local message_vector Reusable;
+		message_vector messages;
+		messages.swap(Reusable);
+		messages.push_back(std::move(message));
 
-		handler->outgoingChain(messages, [this, weak_this = weak_from_this()](message_ptr m) {
-			if (auto locked = weak_this.lock()) {
-				transportSend(m);
-			}
-		});
+		handler->outgoingChain(messages, mSendCallback);
 
-		bool ret = false;
-		for (auto &m : messages)
-			ret = transportSend(std::move(m));
-
-		return ret;
+		// Packets of a frame are protected and sent as a batch
+		bool sent = !messages.empty() && transportSendMultiple(messages);
+		messages.clear();
+		Reusable.swap(messages);
+		return sent;
 
 	} else {
 		return transportSend(std::move(message));
@@ -217,31 +274,60 @@ bool Track::outgoing(message_ptr message) {
 
 bool Track::transportSend([[maybe_unused]] message_ptr message) {
 #if RTC_ENABLE_MEDIA
-	shared_ptr<DtlsSrtpTransport> transport;
-	{
-		std::shared_lock lock(mMutex);
-		transport = mDtlsSrtpTransport.lock();
-		if (!transport)
-			throw std::runtime_error("Track is not open");
-
-		// Set recommended medium-priority DSCP value
-		// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
-		if (mMediaDescription.type() == "audio")
-			message->dscp = 46; // EF: Expedited Forwarding
-		else
-			message->dscp = 36; // AF42: Assured Forwarding class 4, medium drop probability
-	}
+	MemoryTracker::Scope scope(mMemoryTag);
+	Epoch::Guard guard;
+	auto session = mSrtpSessionPtr.load(std::memory_order_acquire);
+	if (!session || !session->isOpen())
+		throw std::runtime_error("Track is not open");
+
+	if (message)
+		markTrafficClass(*message);
 
-	return transport->sendMedia(message);
+	return session->send(std::move(message), mSendExtensions.load(std::memory_order_relaxed));
 #else
 	throw std::runtime_error("Track is disabled (not compiled with media support)");
 #endif
 }
 
+bool Track::transportSendMultiple([[maybe_unused]] message_vector &messages) {
+#if RTC_ENABLE_MEDIA
+	MemoryTracker::Scope scope(mMemoryTag);
+	Epoch::Guard guard;
+	auto session = mSrtpSessionPtr.load(std::memory_order_acquire);
+	if (!session || !session->isOpen())
+		throw std::runtime_error("Track is not open");
+
+	for (const auto &message : messages)
+		if (message)
+			markTrafficClass(*message);
+
+	return session->sendMultiple(messages, mSendExtensions.load(std::memory_order_relaxed));
+#else
+	throw std::runtime_error("Track is disabled (not compiled with media support)");
+#endif
+}
+
+void Track::markTrafficClass(Message &message) const {
+	// Handlers mark keyframes and retransmissions, other packets get the track class
+	if (message.trafficClass == TrafficClass::Default)
+		message.trafficClass =
+		    IsRtcp(message) ? TrafficClass::Rtcp : mTrafficClass.load(std::memory_order_relaxed);
+
+	message.dscp = GetTrafficClassDscp(message.trafficClass);
+}
+
 void Track::setMediaHandler(shared_ptr<MediaHandler> handler) {
 	{
 		std::unique_lock lock(mMutex);
 		mMediaHandler = handler;
+
+		// Handlers may keep the callback for deferred sends (e.g. pacing), so it must not
+		// outlive the track. Building it once saves a std::function allocation per packet.
+		if (!mSendCallback)
+			mSendCallback = [weak_this = weak_from_this()](message_ptr m) {
+				if (auto locked = weak_this.lock())
+					locked->transportSend(std::move(m));
+			};
 	}
 
 	if (handler)
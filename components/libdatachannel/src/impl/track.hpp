@@ -13,6 +13,7 @@
 #include "common.hpp"
 #include "description.hpp"
 #include "mediahandler.hpp"
+#include "memorytracker.hpp"
 #include "queue.hpp"
 
 #if RTC_ENABLE_MEDIA
@@ -60,17 +61,30 @@ public:
 #endif
 
 	bool transportSend(message_ptr message);
+	bool transportSendMultiple(message_vector &messages); // false if any was dropped
 
 	synchronized_callback<binary, FrameInfo> frameCallback;
 
 private:
+	void markTrafficClass(Message &message) const;
+
 	const weak_ptr<PeerConnection> mPeerConnection;
 #if RTC_ENABLE_MEDIA
 	weak_ptr<DtlsSrtpTransport> mDtlsSrtpTransport;
+	shared_ptr<DtlsSrtpTransport::Session> mSrtpSession; // owning reference, under mMutex
+	std::atomic<DtlsSrtpTransport::Session *> mSrtpSessionPtr = nullptr; // read in Epoch::Guard
 #endif
 
+	// Send path state is mirrored in atomics so that sending never locks mMutex
 	Description::Media mMediaDescription;
+	std::atomic<Description::Direction> mDirection;
+	std::atomic<TrafficClass> mTrafficClass;
+	MemoryTracker::Tag mMemoryTag; // media subsystem of the owning connection
+#if RTC_ENABLE_MEDIA
+	std::atomic<DtlsSrtpTransport::SendExtensions> mSendExtensions;
+#endif
 	shared_ptr<MediaHandler> mMediaHandler;
+	message_callback mSendCallback; // set once, handed by reference to every chain call
 
 	mutable std::shared_mutex mMutex;
 
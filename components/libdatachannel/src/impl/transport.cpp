@@ -25,7 +25,10 @@ Transport::~Transport() {
 void Transport::registerIncoming() {
 	if (mLower) {
 		PLOG_VERBOSE << "Registering incoming callback";
-		mLower->onRecv(std::bind(&Transport::incoming, this, std::placeholders::_1));
+		mLower->onRecv([this](message_ptr message) {
+			MemoryTracker::Scope scope(mMemoryTag);
+			incoming(std::move(message));
+		});
 	}
 }
 
@@ -50,6 +53,15 @@ void Transport::stop() { unregisterIncoming(); }
 
 bool Transport::send(message_ptr message) { return outgoing(message); }
 
+bool Transport::sendMultiple(message_vector &messages) {
+	bool result = true;
+	for (auto &message : messages)
+		if (!send(std::move(message)))
+			result = false;
+
+	return result;
+}
+
 void Transport::recv(message_ptr message) {
 	try {
 		mRecvCallback(message);
@@ -70,10 +82,19 @@ void Transport::changeState(State state) {
 void Transport::incoming(message_ptr message) { recv(message); }
 
 bool Transport::outgoing(message_ptr message) {
-	if (mLower)
-		return mLower->send(message);
-	else
+	if (!mLower)
+		return false;
+
+	MemoryTracker::Scope scope(mLower->mMemoryTag);
+	return mLower->send(message);
+}
+
+bool Transport::outgoingMultiple(message_vector &messages) {
+	if (!mLower)
 		return false;
+
+	MemoryTracker::Scope scope(mLower->mMemoryTag);
+	return mLower->sendMultiple(messages);
 }
 
 } // namespace rtc::impl
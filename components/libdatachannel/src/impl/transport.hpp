@@ -12,6 +12,7 @@
 #include "common.hpp"
 #include "init.hpp"
 #include "internals.hpp"
+#include "memorytracker.hpp"
 #include "message.hpp"
 
 #include <atomic>
@@ -38,15 +39,21 @@ public:
 	virtual void start();
 	virtual void stop();
 	virtual bool send(message_ptr message);
+	virtual bool sendMultiple(message_vector &messages); // false if any was dropped
 
 protected:
 	void recv(message_ptr message);
 	void changeState(State state);
 	virtual void incoming(message_ptr message);
 	virtual bool outgoing(message_ptr message);
+	bool outgoingMultiple(message_vector &messages);
+
+	// Memory accounting tag, captured from the scope the transport is created in
+	MemoryTracker::Tag memoryTag() const { return mMemoryTag; }
 
 private:
 	const init_token mInitToken = Init::Instance().token();
+	const MemoryTracker::Tag mMemoryTag = MemoryTracker::CurrentTag();
 
 	shared_ptr<Transport> mLower;
 	synchronized_callback<State> mStateChangeCallback;
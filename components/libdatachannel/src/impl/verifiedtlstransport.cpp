@@ -13,7 +13,7 @@
 
 namespace rtc::impl {
 
-static const string PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
+static const char *const PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
 
 VerifiedTlsTransport::VerifiedTlsTransport(
     variant<shared_ptr<TcpTransport>, shared_ptr<HttpProxyTransport>> lower, string host,
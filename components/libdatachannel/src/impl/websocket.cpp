@@ -17,12 +17,18 @@
 #include "httpproxytransport.hpp"
 #include "tcptransport.hpp"
 #include "tlstransport.hpp"
-#include "verifiedtlstransport.hpp"
 #include "wstransport.hpp"
 
+#ifndef ESP32_PORT
+#include "verifiedtlstransport.hpp"
+#endif
+
 #include <array>
 #include <chrono>
+
+#ifndef ESP32_PORT
 #include <regex>
+#endif
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -34,7 +40,8 @@ using namespace std::placeholders;
 using namespace std::chrono_literals;
 using std::chrono::milliseconds;
 
-const string PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
+// Not a string, so that no allocation happens in a static constructor
+const char *const PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
 
 WebSocket::WebSocket(optional<Configuration> optConfig, certificate_ptr certificate)
     : config(optConfig ? std::move(*optConfig) : Configuration()),
@@ -68,7 +75,12 @@ WebSocket::WebSocket(optional<Configuration> optConfig, certificate_ptr certific
 
 WebSocket::~WebSocket() { PLOG_VERBOSE << "Destroying WebSocket"; }
 
-void WebSocket::open(const string &url) {
+void WebSocket::open([[maybe_unused]] const string &url) {
+#ifdef ESP32_PORT
+	// ESP32: server side only, local clients connect to the device. This leaves out the URL
+	// parser (std::regex) and certificate verification.
+	throw std::logic_error("WebSocket client is not supported");
+#else
 	PLOG_VERBOSE << "Opening WebSocket to URL: " << url;
 
 	if (state != State::Closed)
@@ -136,6 +148,7 @@ void WebSocket::open(const string &url) {
 	} else {
 		setTcpTransport(std::make_shared<TcpTransport>(hostname, service, nullptr));
 	}
+#endif
 }
 
 void WebSocket::close() {
@@ -378,11 +391,13 @@ shared_ptr<TlsTransport> WebSocket::initTlsTransport() {
 #endif
 
 		shared_ptr<TlsTransport> transport;
+#ifndef ESP32_PORT
 		if (verify)
 			transport = std::make_shared<VerifiedTlsTransport>(lower, mHostname.value(),
 			                                                   mCertificate, stateChangeCallback,
 			                                                   config.caCertificatePemFile);
 		else
+#endif
 			transport =
 			    std::make_shared<TlsTransport>(lower, mHostname, mCertificate, stateChangeCallback);
 
@@ -18,7 +18,7 @@ namespace rtc::impl {
 
 using namespace std::placeholders;
 
-const string PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
+const char *const PemBeginCertificateTag = "-----BEGIN CERTIFICATE-----";
 
 WebSocketServer::WebSocketServer(Configuration config_)
     : config(std::move(config_)), mStopped(false) {
@@ -8,6 +8,7 @@
 
 #include "mediahandler.hpp"
 
+#include "impl/epoch.hpp"
 #include "impl/internals.hpp"
 
 namespace rtc {
@@ -19,7 +20,13 @@ MediaHandler::~MediaHandler() {}
 void MediaHandler::addToChain(shared_ptr<MediaHandler> handler) { last()->setNext(handler); }
 
 void MediaHandler::setNext(shared_ptr<MediaHandler> handler) {
-	return std::atomic_store(&mNext, handler);
+	MediaHandler *raw = handler.get();
+	auto previous = std::atomic_exchange(&mNext, std::move(handler));
+	mNextRaw.store(raw, std::memory_order_release);
+
+	// A chain walk might still be in the previous handler, it is released after the walk
+	if (previous)
+		impl::Epoch::Instance().retire(new shared_ptr<MediaHandler>(std::move(previous)));
 }
 
 shared_ptr<MediaHandler> MediaHandler::next() { return std::atomic_load(&mNext); }
@@ -64,17 +71,20 @@ void MediaHandler::mediaChain(const Description::Media &desc) {
 }
 
 void MediaHandler::incomingChain(message_vector &messages, const message_callback &send) {
-	if (auto handler = next())
+	// Per-packet path: follow the raw pointers instead of the locked shared_ptr load of next(),
+	// the guard keeps a replaced handler alive until the walk is over
+	impl::Epoch::Guard guard;
+	if (auto handler = mNextRaw.load(std::memory_order_acquire))
 		handler->incomingChain(messages, send);
 
 	incoming(messages, send);
 }
 
 void MediaHandler::outgoingChain(message_vector &messages, const message_callback &send) {
-	outgoing(messages, send);
-
-	if (auto handler = next())
-		return handler->outgoingChain(messages, send);
+	impl::Epoch::Guard guard;
+	for (MediaHandler *handler = this; handler;
+	     handler = handler->mNextRaw.load(std::memory_order_acquire))
+		handler->outgoing(messages, send);
 }
 
 } // namespace rtc
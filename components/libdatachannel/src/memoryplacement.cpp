@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "memoryplacement.hpp"
+
+#ifdef ESP32_PORT
+#include "esp32_psram_init.h"
+#endif
+
+namespace rtc {
+
+#ifdef ESP32_PORT
+
+static_assert(int(MemoryClass::Hot) == ESP32_MEM_HOT && int(MemoryClass::Bulk) == ESP32_MEM_BULK &&
+                  int(MemoryClass::Dma) == ESP32_MEM_DMA,
+              "MemoryClass must match esp32_mem_class_t");
+
+MemoryPlacement::MemoryPlacement(MemoryClass memoryClass)
+    : mPrevious(static_cast<MemoryClass>(esp32_get_task_mem_class())) {
+	esp32_set_task_mem_class(static_cast<esp32_mem_class_t>(memoryClass));
+}
+
+MemoryPlacement::~MemoryPlacement() {
+	esp32_set_task_mem_class(static_cast<esp32_mem_class_t>(mPrevious));
+}
+
+void MemoryPlacement::SetBudget(MemoryClass memoryClass, size_t budget) {
+	esp32_mem_class_set_budget(static_cast<esp32_mem_class_t>(memoryClass), budget);
+}
+
+MemoryClassUsage MemoryPlacement::Usage(MemoryClass memoryClass) {
+	esp32_mem_class_stats_t stats;
+	esp32_mem_class_get_stats(static_cast<esp32_mem_class_t>(memoryClass), &stats);
+	MemoryClassUsage usage;
+	usage.budget = stats.budget;
+	usage.used = stats.used;
+	usage.peak = stats.peak;
+	usage.fallbacks = stats.fallbacks;
+	return usage;
+}
+
+#else
+
+MemoryPlacement::MemoryPlacement(MemoryClass) : mPrevious(MemoryClass::Default) {}
+
+MemoryPlacement::~MemoryPlacement() {}
+
+void MemoryPlacement::SetBudget(MemoryClass, size_t) {}
+
+MemoryClassUsage MemoryPlacement::Usage(MemoryClass) { return {}; }
+
+#endif
+
+} // namespace rtc
@@ -28,9 +28,16 @@ message_ptr make_message(binary &&data, Message::Type type, unsigned int stream,
 	message->reliability = reliability;
 	return message;
 }
+message_ptr make_message(binary &&data, FrameInfo frameInfo) {
+	auto message = std::make_shared<Message>(std::move(data));
+	message->frameInfo.emplace(std::move(frameInfo));
+	return message;
+}
+
 message_ptr make_message(binary &&data, shared_ptr<FrameInfo> frameInfo) {
 	auto message = std::make_shared<Message>(std::move(data));
-	message->frameInfo = frameInfo;
+	if (frameInfo)
+		message->frameInfo.emplace(*frameInfo);
 	return message;
 }
 
@@ -41,6 +48,8 @@ message_ptr make_message(size_t size, message_ptr orig) {
 	auto message = std::make_shared<Message>(size, orig->type);
 	std::copy(orig->begin(), orig->begin() + std::min(size, orig->size()), message->begin());
 	message->stream = orig->stream;
+	message->dscp = orig->dscp;
+	message->trafficClass = orig->trafficClass;
 	message->reliability = orig->reliability;
 	message->frameInfo = orig->frameInfo;
 	return message;
@@ -12,7 +12,9 @@
 
 #include "impl/internals.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #ifdef ESP32_PORT
 #include <esp_heap_caps.h>
@@ -27,25 +29,134 @@
 
 namespace rtc {
 
+namespace {
+
+const uint8_t naluTypeSTAPA = 24;
+const uint8_t naluTypeFUA = 28;
+
+} // namespace
+
 #ifdef ESP32_PORT
 psram_vector<binary> NalUnit::GenerateFragments(const psram_vector<NalUnit> &nalus,
-                                               size_t maxFragmentSize) {
+                                               size_t maxFragmentSize, bool aggregate) {
 	psram_vector<binary> result;
 #else
 std::vector<binary> NalUnit::GenerateFragments(const std::vector<NalUnit> &nalus,
-                                               size_t maxFragmentSize) {
+                                               size_t maxFragmentSize, bool aggregate) {
 	std::vector<binary> result;
 #endif
-	for (const auto &nalu : nalus) {
-		if (nalu.size() > maxFragmentSize) {
-			auto fragments = nalu.generateFragments(maxFragmentSize);
-			result.insert(result.end(), fragments.begin(), fragments.end());
+	FrameArena arena(maxFragmentSize);
+	arena_vector<FramePayload> units(arena);
+	units.reserve(nalus.size());
+	for (const auto &nalu : nalus)
+		if (!nalu.empty())
+			units.push_back(FramePayload{{}, 0, nalu.data(), nalu.size()});
+
+	arena_vector<FramePayload> payloads(arena);
+	GeneratePayloads(units, maxFragmentSize, aggregate, arena, payloads);
+
+	result.reserve(payloads.size());
+	for (const auto &payload : payloads) {
+		binary data(payload.totalSize());
+		std::copy(payload.prefix.begin(), payload.prefix.begin() + payload.prefixSize, data.begin());
+		std::copy(payload.data, payload.data + payload.size, data.begin() + payload.prefixSize);
+		result.push_back(std::move(data));
+	}
+	return result;
+}
+
+void NalUnit::GeneratePayloads(const arena_vector<FramePayload> &nalus, size_t maxFragmentSize,
+                               bool aggregate, FrameArena &arena,
+                               arena_vector<FramePayload> &payloads) {
+	// Consecutive small NAL units [pendingBegin, i) are waiting to be aggregated
+	size_t pendingBegin = 0;
+	size_t pendingSize = 1; // STAP-A NAL header
+
+	auto flush = [&](size_t pendingEnd) {
+		if (pendingEnd - pendingBegin == 1) {
+			const auto &nalu = nalus[pendingBegin];
+			payloads.push_back(FramePayload{{}, 0, nalu.data, nalu.size});
+
+		} else if (pendingEnd - pendingBegin > 1) {
+			// RFC 6184 5.7.1: F is set if any aggregated unit has F set, NRI is the maximum
+			bool forbiddenBit = false;
+			uint8_t nri = 0;
+			auto aggregated = static_cast<byte *>(arena.allocate(pendingSize, 1));
+			size_t offset = 1;
+			for (size_t i = pendingBegin; i < pendingEnd; ++i) {
+				const auto &nalu = nalus[i];
+				NalUnitHeader unitHeader{uint8_t(nalu.data[0])};
+				forbiddenBit |= unitHeader.forbiddenBit();
+				nri = std::max(nri, unitHeader.nri());
+				aggregated[offset++] = byte(nalu.size >> 8);
+				aggregated[offset++] = byte(nalu.size & 0xFF);
+				std::memcpy(aggregated + offset, nalu.data, nalu.size);
+				offset += nalu.size;
+			}
+
+			NalUnitHeader header;
+			header.setForbiddenBit(forbiddenBit);
+			header.setNRI(nri);
+			header.setUnitType(naluTypeSTAPA);
+			aggregated[0] = byte(header._first);
+			payloads.push_back(FramePayload{{}, 0, aggregated, pendingSize});
+		}
+		pendingBegin = pendingEnd;
+		pendingSize = 1;
+	};
+
+	// The unit payload is cut into evenly sized FU-A fragments, sized after the 2 bytes of FU
+	// indicator and FU header so that no short trailing fragment is needed
+	auto fragment = [&](const FramePayload &nalu) {
+		const byte *payload = nalu.data + 1;
+		size_t payloadSize = nalu.size - 1;
+		size_t maxPayloadSize = maxFragmentSize - 2;
+		size_t fragmentsCount = (payloadSize + maxPayloadSize - 1) / maxPayloadSize;
+		size_t fragmentSize = (payloadSize + fragmentsCount - 1) / fragmentsCount;
+
+		NalUnitHeader unitHeader{uint8_t(nalu.data[0])};
+		NalUnitHeader indicator;
+		indicator.setForbiddenBit(unitHeader.forbiddenBit());
+		indicator.setNRI(unitHeader.nri());
+		indicator.setUnitType(naluTypeFUA);
+
+		size_t offset = 0;
+		while (offset < payloadSize) {
+			NalUnitFragmentHeader fragmentHeader;
+			fragmentHeader.setUnitType(unitHeader.unitType());
+			size_t size = fragmentSize;
+			if (offset == 0) {
+				fragmentHeader.setStart(true);
+			} else if (offset + size >= payloadSize) {
+				size = payloadSize - offset;
+				fragmentHeader.setEnd(true);
+			}
+			payloads.push_back(FramePayload{{byte(indicator._first), byte(fragmentHeader._first)},
+			                                2,
+			                                payload + offset,
+			                                size});
+			offset += size;
+		}
+	};
+
+	for (size_t i = 0; i < nalus.size(); ++i) {
+		const auto &nalu = nalus[i];
+		if (nalu.size > maxFragmentSize) {
+			flush(i);
+			fragment(nalu);
+			pendingBegin = i + 1;
+		} else if (aggregate) {
+			// Each aggregated unit is prefixed with its 16-bit size
+			if (pendingSize + 2 + nalu.size > maxFragmentSize)
+				flush(i);
+
+			pendingSize += 2 + nalu.size;
 		} else {
-			// TODO: check this
-			result.push_back(nalu);
+			payloads.push_back(FramePayload{{}, 0, nalu.data, nalu.size});
+			pendingBegin = i + 1;
 		}
 	}
-	return result;
+	flush(nalus.size());
 }
 
 #ifdef ESP32_PORT
@@ -143,6 +254,57 @@ NalUnitStartSequenceMatch NalUnit::StartSequenceMatchSucc(NalUnitStartSequenceMa
 	return NUSM_noMatch;
 }
 
+namespace {
+
+// True if any byte of the word is zero (Mycroft's trick)
+inline bool hasZeroByte(size_t word) {
+	constexpr size_t lows = ~size_t(0) / 0xFF; // 0x01 in every byte
+	constexpr size_t highs = lows << 7;        // 0x80 in every byte
+	return ((word - lows) & ~word & highs) != 0;
+}
+
+} // namespace
+
+size_t NalUnit::FindStartSequence(const byte *data, size_t size, size_t from,
+                                  Separator separator, size_t &length) {
+	assert(separator != Separator::Length);
+	const auto *p = reinterpret_cast<const uint8_t *>(data);
+	size_t index = from;
+	while (index + 2 < size) {
+		// A start sequence always begins with a zero byte, so words without one are skipped whole.
+		// Slice data is mostly non-zero thanks to emulation prevention, so this runs near memory
+		// bandwidth and only falls back to bytes around zeros.
+		if (index + sizeof(size_t) <= size) {
+			size_t word;
+			std::memcpy(&word, p + index, sizeof(word));
+			if (!hasZeroByte(word)) {
+				index += sizeof(word);
+				continue;
+			}
+		}
+
+		size_t end = std::min(index + sizeof(size_t), size - 2);
+		for (; index < end; ++index) {
+			// 0x00 0x00 0x03 is an emulation prevention sequence and never matches here
+			if (p[index] != 0x00 || p[index + 1] != 0x00 || p[index + 2] != 0x01)
+				continue;
+
+			bool leadingZero = index > from && p[index - 1] == 0x00;
+			if (separator == Separator::LongStartSequence && !leadingZero)
+				continue;
+
+			if (leadingZero && separator != Separator::ShortStartSequence) {
+				length = 4;
+				return index - 1;
+			}
+			length = 3;
+			return index;
+		}
+	}
+	length = 0;
+	return size;
+}
+
 NalUnitFragmentA::NalUnitFragmentA(FragmentType type, bool forbiddenBit, uint8_t nri,
                                    uint8_t unitType, binary data)
     : NalUnit(data.size() + 2) {
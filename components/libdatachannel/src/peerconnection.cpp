@@ -408,6 +408,18 @@ optional<std::chrono::milliseconds> PeerConnection::rtt() {
 	return sctpTransport ? sctpTransport->rtt() : nullopt;
 }
 
+optional<std::chrono::milliseconds> PeerConnection::handshakeDuration() {
+	auto dtlsTransport = impl()->getDtlsTransport();
+	return dtlsTransport ? dtlsTransport->handshakeDuration() : nullopt;
+}
+
+QosStats PeerConnection::qosStats() {
+	auto iceTransport = impl()->getIceTransport();
+	return iceTransport ? iceTransport->qosStats() : QosStats{};
+}
+
+MemoryUsage PeerConnection::memoryUsage() const { return impl()->memoryUsage(); }
+
 CertificateFingerprint PeerConnection::remoteFingerprint() {
 	return impl()->remoteFingerprint();
 }
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "qos.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace rtc {
+
+namespace {
+
+// See https://www.rfc-editor.org/rfc/rfc8837.html#section-5
+std::array<std::atomic<uint8_t>, TrafficClassCount> TrafficClassDscp = {
+    0,  // Default, resolved before sending
+    46, // Audio: EF, Expedited Forwarding
+    34, // Rtcp: AF41, Assured Forwarding class 4, low drop probability
+    34, // Retransmission: AF41
+    34, // KeyFrame: AF41
+    36, // DeltaFrame: AF42, Assured Forwarding class 4, medium drop probability
+    18, // Control: AF21, Assured Forwarding class 2, low drop probability
+    10, // Bulk: AF11, Assured Forwarding class 1, low drop probability
+};
+
+} // namespace
+
+void SetTrafficClassDscp(TrafficClass trafficClass, unsigned int dscp) {
+	size_t index = size_t(trafficClass);
+	if (index >= TrafficClassCount)
+		throw std::invalid_argument("Invalid traffic class");
+	if (dscp > 63)
+		throw std::invalid_argument("Invalid DSCP value");
+
+	TrafficClassDscp[index].store(uint8_t(dscp), std::memory_order_relaxed);
+}
+
+unsigned int GetTrafficClassDscp(TrafficClass trafficClass) {
+	size_t index = size_t(trafficClass);
+	return index < TrafficClassCount ? TrafficClassDscp[index].load(std::memory_order_relaxed) : 0;
+}
+
+AccessCategory DscpAccessCategory(unsigned int dscp) {
+	// See https://www.rfc-editor.org/rfc/rfc8325.html#section-4.3
+	switch (dscp) {
+	case 46: // EF
+	case 44: // VOICE-ADMIT
+	case 48: // CS6, network control
+		return AccessCategory::Voice;
+	case 24: // CS3, broadcast video
+	case 26: // AF31, multimedia streaming
+	case 28: // AF32
+	case 30: // AF33
+	case 32: // CS4, real-time interactive
+	case 34: // AF41
+	case 36: // AF42
+	case 38: // AF43
+	case 40: // CS5, signaling
+		return AccessCategory::Video;
+	case 8: // CS1, lower-effort
+		return AccessCategory::Background;
+	default:
+		return AccessCategory::BestEffort;
+	}
+}
+
+} // namespace rtc
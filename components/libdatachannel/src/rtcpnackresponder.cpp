@@ -8,11 +8,14 @@
 
 #if RTC_ENABLE_MEDIA
 
+#include "memoryplacement.hpp"
 #include "rtcpnackresponder.hpp"
 #include "rtp.hpp"
 
 #include "impl/internals.hpp"
+#include "impl/memorytracker.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 namespace rtc {
@@ -48,8 +51,11 @@ void RtcpNackResponder::incoming(message_vector &messages, const message_callbac
 
 			for (auto sequenceNumber : missingSequenceNumbers) {
 				auto packet = mStorage->get(sequenceNumber);
-				if (packet)
+				if (packet) {
+					// The stored packet has already been sent, it is only kept for retransmission
+					packet->trafficClass = TrafficClass::Retransmission;
 					send(packet);
+				}
 			}
 		}
 	}
@@ -57,56 +63,37 @@ void RtcpNackResponder::incoming(message_vector &messages, const message_callbac
 
 void RtcpNackResponder::outgoing(message_vector &messages,
                                  [[maybe_unused]] const message_callback &send) {
-	for (const auto &message : messages)
-		if (message->type != Message::Control)
-			mStorage->store(message);
+	mStorage->store(messages);
 }
 
-RtcpNackResponder::Storage::Element::Element(message_ptr packet, uint16_t sequenceNumber,
-                                             shared_ptr<Element> next)
-    : packet(packet), sequenceNumber(sequenceNumber), next(next) {}
-
-size_t RtcpNackResponder::Storage::size() { return storage.size(); }
-
-RtcpNackResponder::Storage::Storage(size_t _maxSize) : maxSize(_maxSize) {
+RtcpNackResponder::Storage::Storage(size_t maxSize) {
 	assert(maxSize > 0);
-	storage.reserve(maxSize);
+	MemoryPlacement placement(MemoryClass::Hot); // looked up for every NACK
+	slots.resize(std::min(maxSize, size_t(65536)));
 }
 
 message_ptr RtcpNackResponder::Storage::get(uint16_t sequenceNumber) {
 	std::lock_guard lock(mutex);
-	auto position = storage.find(sequenceNumber);
-	return position != storage.end() ? storage.at(sequenceNumber)->packet
-	                                 : nullptr;
+	const auto &slot = slots[sequenceNumber % slots.size()];
+	return slot.packet && slot.sequenceNumber == sequenceNumber ? slot.packet : nullptr;
 }
 
-void RtcpNackResponder::Storage::store(message_ptr packet) {
-	if (!packet || packet->size() < sizeof(RtpHeader))
-		return;
-
-	auto rtp = reinterpret_cast<RtpHeader *>(packet->data());
-	auto sequenceNumber = rtp->seqNumber();
+void RtcpNackResponder::Storage::store(const message_vector &packets) {
+	// Retained packets are accounted to the NACK store rather than to the media path
+	impl::MemoryTracker::Scope scope(MemorySubsystem::Nack);
 
 	std::lock_guard lock(mutex);
-	assert((storage.empty() && !oldest && !newest) || (!storage.empty() && oldest && newest));
-
-	if (size() == 0) {
-		newest = std::make_shared<Element>(packet, sequenceNumber);
-		oldest = newest;
-	} else {
-		auto current = std::make_shared<Element>(packet, sequenceNumber);
-		newest->next = current;
-		newest = current;
-	}
+	for (const auto &packet : packets) {
+		if (!packet || packet->type == Message::Control || packet->size() < sizeof(RtpHeader))
+			continue;
 
-	storage.emplace(sequenceNumber, newest);
+		auto rtp = reinterpret_cast<RtpHeader *>(packet->data());
+		auto sequenceNumber = rtp->seqNumber();
+		impl::MemoryTracker::Retag(packet->data(), MemorySubsystem::Nack);
 
-	if (size() > maxSize) {
-		assert(oldest);
-		if (oldest) {
-			storage.erase(oldest->sequenceNumber);
-			oldest = oldest->next;
-		}
+		auto &slot = slots[sequenceNumber % slots.size()];
+		slot.packet = packet;
+		slot.sequenceNumber = sequenceNumber;
 	}
 }
 
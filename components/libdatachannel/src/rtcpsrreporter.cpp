@@ -63,6 +63,12 @@ void RtcpSrReporter::outgoing(message_vector &messages, const message_callback &
 
 	auto now = std::chrono::steady_clock::now();
 	if (now >= mLastReportTime + 1s) {
+		// Map the report time on the shared capture clock, same as the packetizer does for frames
+		if (rtpConfig->timestampOrigin)
+			timestamp = rtpConfig->startTimestamp +
+			            rtpConfig->secondsToTimestamp(
+			                std::chrono::duration<double>(now - *rtpConfig->timestampOrigin).count());
+
 		send(getSenderReport(timestamp));
 		mLastReportedTimestamp = timestamp;
 		mLastReportTime = now;
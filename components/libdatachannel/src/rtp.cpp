@@ -172,6 +172,51 @@ size_t RtpExtensionHeader::writeHeader(bool twoByteHeader, size_t offset, uint8_
 	}
 }
 
+byte *RtpExtensionHeader::findHeader(uint8_t id, size_t &size) {
+	const bool twoByteHeader = (profileSpecificId() & 0xFFF0) == 0x1000;
+	if (!twoByteHeader && profileSpecificId() != 0xBEDE)
+		return nullptr;
+
+	auto body = reinterpret_cast<byte *>(getBody());
+	size_t total = getSize();
+	size_t offset = 0;
+	while (offset < total) {
+		uint8_t first = std::to_integer<uint8_t>(body[offset]);
+		if (first == 0) { // padding
+			++offset;
+			continue;
+		}
+
+		uint8_t elementId;
+		size_t elementSize, headerSize;
+		if (twoByteHeader) {
+			if (offset + 2 > total)
+				break;
+
+			elementId = first;
+			elementSize = std::to_integer<uint8_t>(body[offset + 1]);
+			headerSize = 2;
+		} else {
+			elementId = first >> 4;
+			if (elementId == 15) // reserved, parsing must stop (RFC 8285 4.2)
+				break;
+
+			elementSize = (first & 0x0F) + 1;
+			headerSize = 1;
+		}
+
+		if (offset + headerSize + elementSize > total)
+			break;
+
+		if (elementId == id) {
+			size = elementSize;
+			return body + offset + headerSize;
+		}
+		offset += headerSize + elementSize;
+	}
+	return nullptr;
+}
+
 SSRC RtcpReportBlock::getSSRC() const { return ntohl(_ssrc); }
 
 void RtcpReportBlock::preparePacket(SSRC in_ssrc, uint8_t fraction,
@@ -44,13 +44,12 @@ void RtpDepacketizer::incoming(message_vector &messages,
 	messages.swap(result);
 }
 
-shared_ptr<FrameInfo> RtpDepacketizer::createFrameInfo(uint32_t timestamp,
-                                                       uint8_t payloadType) const {
-	auto frameInfo = std::make_shared<FrameInfo>(timestamp);
+FrameInfo RtpDepacketizer::createFrameInfo(uint32_t timestamp, uint8_t payloadType) const {
+	FrameInfo frameInfo(timestamp);
 	if (mClockRate > 0)
-		frameInfo->timestampSeconds =
+		frameInfo.timestampSeconds =
 		    std::chrono::duration<double>(double(timestamp) / double(mClockRate));
-	frameInfo->payloadType = payloadType;
+	frameInfo.payloadType = payloadType;
 	return frameInfo;
 }
 
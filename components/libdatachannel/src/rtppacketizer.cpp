@@ -10,8 +10,10 @@
 
 #include "rtppacketizer.hpp"
 
+#include <array>
 #include <cmath>
 #include <cstring>
+#include <iterator>
 
 #ifdef ESP32_PORT
 #include <esp_heap_caps.h>
@@ -45,23 +47,90 @@ std::vector<binary> RtpPacketizer::fragment(binary data) {
 }
 #endif
 
-message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
-	size_t rtpExtHeaderSize = 0;
-	bool twoByteHeader = false;
+void RtpPacketizer::fragmentPayloads(binary &data, arena_vector<FramePayload> &payloads) {
+	// Keep the fragments alive until the frame is packetized
+	mFragments = fragment(std::move(data));
+	payloads.reserve(mFragments.size());
+	for (const auto &fragment : mFragments)
+		payloads.push_back(FramePayload{{}, 0, fragment.data(), fragment.size()});
+}
 
-	const bool setVideoRotation =
-	    (rtpConfig->videoOrientationId != 0) && mark && (rtpConfig->videoOrientation != 0);
+message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
+	return packetize(FramePayload{{}, 0, payload.data(), payload.size()}, mark);
+}
 
+message_ptr RtpPacketizer::packetize(const FramePayload &payload, bool mark) {
 	std::optional<DependencyDescriptorWriter> ddWriter;
 	if (rtpConfig->dependencyDescriptorContext.has_value()) {
 		ddWriter.emplace(*rtpConfig->dependencyDescriptorContext);
 	}
+	size_t ddSize = ddWriter.has_value() ? ddWriter->getSize() : 0;
+
+	// The video orientation is only sent on marked packets, so each marker value has its template
+	auto &header = mHeaderTemplates[mark ? 1 : 0];
+	if (!header.matches(*rtpConfig, ddSize))
+		compileHeaderTemplate(header, mark, ddSize);
+
+	auto message = make_message(header.bytes.size() + payload.totalSize());
+	auto data = message->data();
+	std::memcpy(data, header.bytes.data(), header.bytes.size());
+
+	auto *rtp = reinterpret_cast<RtpHeader *>(data);
+	rtp->setSeqNumber(rtpConfig->sequenceNumber++); // increase sequence number
+	rtp->setTimestamp(rtpConfig->timestamp);
+
+	if (header.ddOffset)
+		ddWriter->writeTo(data + header.ddOffset, ddSize);
+
+	auto body = data + header.bytes.size();
+	std::memcpy(body, payload.prefix.data(), payload.prefixSize);
+	std::memcpy(body + payload.prefixSize, payload.data, payload.size);
+
+	return message;
+}
+
+bool RtpPacketizer::HeaderTemplate::matches(const RtpPacketizationConfig &config,
+                                            size_t ddSize) const {
+	return valid && payloadType == config.payloadType && ssrc == config.ssrc &&
+	       videoOrientationId == config.videoOrientationId &&
+	       videoOrientation == config.videoOrientation && midId == config.midId &&
+	       mid == config.mid && ridId == config.ridId && rid == config.rid &&
+	       dependencyDescriptorId == config.dependencyDescriptorId &&
+	       this->ddSize == ddSize && playoutDelayId == config.playoutDelayId &&
+	       playoutDelayMin == config.playoutDelayMin && playoutDelayMax == config.playoutDelayMax &&
+	       transportSequenceNumberId == config.transportSequenceNumberId &&
+	       absSendTimeId == config.absSendTimeId;
+}
+
+void RtpPacketizer::compileHeaderTemplate(HeaderTemplate &header, bool mark, size_t ddSize) {
+	header.valid = true;
+	header.payloadType = rtpConfig->payloadType;
+	header.ssrc = rtpConfig->ssrc;
+	header.videoOrientationId = rtpConfig->videoOrientationId;
+	header.videoOrientation = rtpConfig->videoOrientation;
+	header.midId = rtpConfig->midId;
+	header.mid = rtpConfig->mid;
+	header.ridId = rtpConfig->ridId;
+	header.rid = rtpConfig->rid;
+	header.dependencyDescriptorId = rtpConfig->dependencyDescriptorId;
+	header.ddSize = ddSize;
+	header.ddOffset = 0;
+	header.playoutDelayId = rtpConfig->playoutDelayId;
+	header.playoutDelayMin = rtpConfig->playoutDelayMin;
+	header.playoutDelayMax = rtpConfig->playoutDelayMax;
+	header.transportSequenceNumberId = rtpConfig->transportSequenceNumberId;
+	header.absSendTimeId = rtpConfig->absSendTimeId;
+
+	size_t rtpExtHeaderSize = 0;
+	bool twoByteHeader = false;
+
+	const bool setVideoRotation =
+	    (rtpConfig->videoOrientationId != 0) && mark && (rtpConfig->videoOrientation != 0);
 
 	// Determine if a two-byte header is necessary
 	// Check for dependency descriptor extension
-	if (ddWriter.has_value()) {
-		auto sizeBytes = ddWriter->getSize();
-		if (sizeBytes > 16 || rtpConfig->dependencyDescriptorId > 14) {
+	if (ddSize > 0) {
+		if (ddSize > 16 || rtpConfig->dependencyDescriptorId > 14) {
 			twoByteHeader = true;
 		}
 	}
@@ -69,11 +138,21 @@ message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
 	if ((setVideoRotation && rtpConfig->videoOrientationId > 14) ||
 	    (rtpConfig->mid.has_value() && rtpConfig->midId > 14) ||
 	    (rtpConfig->rid.has_value() && rtpConfig->ridId > 14) ||
-	    rtpConfig->playoutDelayId > 14) {
+	    rtpConfig->playoutDelayId > 14 || rtpConfig->transportSequenceNumberId > 14 ||
+	    rtpConfig->absSendTimeId > 14) {
 		twoByteHeader = true;
 	}
 	size_t headerSize = twoByteHeader ? 2 : 1;
 
+	const bool setTransportSequenceNumber = rtpConfig->transportSequenceNumberId > 0;
+	const bool setAbsSendTime = rtpConfig->absSendTimeId > 0;
+
+	if (setTransportSequenceNumber)
+		rtpExtHeaderSize += headerSize + 2;
+
+	if (setAbsSendTime)
+		rtpExtHeaderSize += headerSize + 3;
+
 	if (setVideoRotation)
 		rtpExtHeaderSize += headerSize + 1;
 
@@ -88,8 +167,8 @@ message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
 	if (rtpConfig->rid.has_value())
 		rtpExtHeaderSize += headerSize + rtpConfig->rid->length();
 
-	if (ddWriter.has_value()) {
-		rtpExtHeaderSize += headerSize + ddWriter->getSize();
+	if (ddSize > 0) {
+		rtpExtHeaderSize += headerSize + ddSize;
 	}
 
 	if (rtpExtHeaderSize != 0)
@@ -99,11 +178,9 @@ message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
 	// according to RFC 3550, sec. 5.3.1.
 	rtpExtHeaderSize = (rtpExtHeaderSize + 3) & ~3;
 
-	auto message = make_message(RtpHeaderSize + rtpExtHeaderSize + payload.size());
-	auto *rtp = (RtpHeader *)message->data();
+	header.bytes.assign(RtpHeaderSize + rtpExtHeaderSize, byte(0));
+	auto *rtp = reinterpret_cast<RtpHeader *>(header.bytes.data());
 	rtp->setPayloadType(rtpConfig->payloadType);
-	rtp->setSeqNumber(rtpConfig->sequenceNumber++); // increase sequence number
-	rtp->setTimestamp(rtpConfig->timestamp);
 	rtp->setSsrc(rtpConfig->ssrc);
 
 	if (mark) {
@@ -141,12 +218,18 @@ message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
 			                           rtpConfig->rid->length());
 		}
 
-		if (ddWriter.has_value()) {
-			auto sizeBytes = ddWriter->getSize();
-			std::vector<std::byte> buf(sizeBytes);
-			ddWriter->writeTo(buf.data(), sizeBytes);
-			offset += extHeader->writeHeader(
-			    twoByteHeader, offset, rtpConfig->dependencyDescriptorId, buf.data(), sizeBytes);
+		if (ddSize > 0) {
+			// Reserve the slot, the descriptor itself is written for each packet. The template is
+			// recompiled whenever the descriptor size changes, so the placeholder is not allocated.
+			const std::array<byte, 255> placeholder = {}; // Maximum element size
+			auto written = extHeader->writeHeader(twoByteHeader, offset,
+			                                      rtpConfig->dependencyDescriptorId,
+			                                      placeholder.data(), ddSize);
+			if (written > 0)
+				header.ddOffset = reinterpret_cast<byte *>(extHeader->getBody()) + offset +
+				                  headerSize - header.bytes.data();
+
+			offset += written;
 		}
 
 		if (setPlayoutDelay) {
@@ -160,13 +243,22 @@ message_ptr RtpPacketizer::packetize(const binary &payload, bool mark) {
 			offset += extHeader->writeHeader(
 			    twoByteHeader, offset, rtpConfig->playoutDelayId, data, 3);
 		}
-	}
 
-	rtp->preparePacket();
+		// Zeroed slots, filled in by the transport at send time
+		if (setTransportSequenceNumber) {
+			byte zero[2] = {};
+			offset += extHeader->writeHeader(twoByteHeader, offset,
+			                                 rtpConfig->transportSequenceNumberId, zero, 2);
+		}
 
-	std::memcpy(message->data() + RtpHeaderSize + rtpExtHeaderSize, payload.data(), payload.size());
+		if (setAbsSendTime) {
+			byte zero[3] = {};
+			offset += extHeader->writeHeader(twoByteHeader, offset, rtpConfig->absSendTimeId,
+			                                 zero, 3);
+		}
+	}
 
-	return message;
+	rtp->preparePacket();
 }
 
 message_ptr RtpPacketizer::packetize(shared_ptr<binary> payload, bool mark) {
@@ -177,7 +269,7 @@ void RtpPacketizer::media([[maybe_unused]] const Description::Media &desc) {}
 
 void RtpPacketizer::outgoing(message_vector &messages,
                              [[maybe_unused]] const message_callback &send) {
-	message_vector result;
+	mPackets.clear();
 
 #ifdef ESP32_PORT
 	uint64_t total_start_us = esp_timer_get_time();
@@ -187,11 +279,18 @@ void RtpPacketizer::outgoing(message_vector &messages,
 	size_t total_message_bytes = 0;
 #endif
 
+	auto &ddContext = rtpConfig->dependencyDescriptorContext;
 	for (const auto &message : messages) {
-		if (const auto &frameInfo = message->frameInfo) {
+		// Other frames are left to the track default class
+		auto trafficClass = message->trafficClass;
+		const auto &frameInfo = message->frameInfo;
+		if (frameInfo) {
 			if (frameInfo->payloadType && frameInfo->payloadType != rtpConfig->payloadType)
 				continue;
 
+			if (frameInfo->isKeyframe && trafficClass == TrafficClass::Default)
+				trafficClass = TrafficClass::KeyFrame;
+
 			if (frameInfo->timestampSeconds)
 				rtpConfig->timestamp =
 				    rtpConfig->startTimestamp +
@@ -201,22 +300,37 @@ void RtpPacketizer::outgoing(message_vector &messages,
 				rtpConfig->timestamp = frameInfo->timestamp;
 		}
 
+		// With temporal layers, the descriptor is derived from the frame info
+		bool attachStructure = false;
+		if (ddContext && ddContext->temporalLayerCount > 0) {
+			uint32_t frameNumber = frameInfo && frameInfo->frameNumber ? *frameInfo->frameNumber
+			                                                           : ddContext->nextFrameNumber;
+			ddContext->nextFrameNumber = frameNumber + 1;
+			ddContext->describeFrame(frameNumber, frameInfo ? frameInfo->temporalLayer : 0,
+			                         frameInfo && frameInfo->isKeyframe);
+			attachStructure = ddContext->descriptor.structureAttached;
+		}
+
 #ifdef ESP32_PORT
 		total_message_bytes += message->size();
 		uint64_t fragment_start_us = esp_timer_get_time();
 #endif
-		auto payloads = fragment(std::move(*message));
+		arena_vector<FramePayload> payloads(mArena);
+		fragmentPayloads(*message, payloads);
 #ifdef ESP32_PORT
 		uint64_t fragment_end_us = esp_timer_get_time();
 		fragment_total_us += (fragment_end_us - fragment_start_us);
 		total_payloads += payloads.size();
 #endif
+		mPackets.reserve(mPackets.size() + payloads.size());
 
 		for (size_t i = 0; i < payloads.size(); i++) {
 			if (rtpConfig->dependencyDescriptorContext.has_value()) {
 				auto &ctx = *rtpConfig->dependencyDescriptorContext;
 				ctx.descriptor.startOfFrame = i == 0;
 				ctx.descriptor.endOfFrame = i == payloads.size() - 1;
+				if (attachStructure)
+					ctx.descriptor.structureAttached = i == 0; // Only in the first packet
 			}
 			bool mark = i == payloads.size() - 1;
 
@@ -224,15 +338,24 @@ void RtpPacketizer::outgoing(message_vector &messages,
 			uint64_t packetize_start_us = esp_timer_get_time();
 #endif
 			auto packet = packetize(payloads[i], mark);
+			packet->trafficClass = trafficClass;
 #ifdef ESP32_PORT
 			uint64_t packetize_end_us = esp_timer_get_time();
 			packetize_total_us += (packetize_end_us - packetize_start_us);
 #endif
-			result.push_back(packet);
+			mPackets.push_back(packet);
 		}
 	}
 
-	messages.swap(result);
+	// Release the input frames, then hand over the packets while keeping the buffer for next frame
+	messages.clear();
+	messages.insert(messages.end(), std::make_move_iterator(mPackets.begin()),
+	                std::make_move_iterator(mPackets.end()));
+
+	// Release per-frame temporaries
+	mPackets.clear();
+	mFragments.clear();
+	mArena.reset();
 
 #ifdef ESP32_PORT
 	uint64_t total_end_us = esp_timer_get_time();
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#if RTC_ENABLE_MEDIA
+
+#include "temporallayerselector.hpp"
+
+#include <algorithm>
+
+namespace rtc {
+
+TemporalLayerSelector::TemporalLayerSelector(shared_ptr<RtpPacketizationConfig> rtpConfig)
+    : mRtpConfig(std::move(rtpConfig)) {}
+
+void TemporalLayerSelector::setMaxTemporalLayer(uint8_t layer) {
+	mMaxTemporalLayer.store(layer, std::memory_order_relaxed);
+}
+
+uint8_t TemporalLayerSelector::maxTemporalLayer() const {
+	return mMaxTemporalLayer.load(std::memory_order_relaxed);
+}
+
+size_t TemporalLayerSelector::skippedFrames() const {
+	return mSkippedFrames.load(std::memory_order_relaxed);
+}
+
+void TemporalLayerSelector::outgoing(message_vector &messages,
+                                     [[maybe_unused]] const message_callback &send) {
+	uint8_t maxLayer = mMaxTemporalLayer.load(std::memory_order_relaxed);
+
+	// Upper layer frames only reference lower layer ones, so they can be skipped at any time
+	auto end = std::remove_if(messages.begin(), messages.end(), [maxLayer](const message_ptr &m) {
+		return m->type != Message::Control && m->frameInfo &&
+		       m->frameInfo->temporalLayer > maxLayer;
+	});
+	mSkippedFrames.fetch_add(size_t(messages.end() - end), std::memory_order_relaxed);
+	messages.erase(end, messages.end());
+
+	// The context is only touched on the sending thread, like by the packetizer
+	if (!mRtpConfig || !mRtpConfig->dependencyDescriptorContext)
+		return;
+
+	auto &context = *mRtpConfig->dependencyDescriptorContext;
+	if (context.temporalLayerCount <= 0)
+		return;
+
+	// Receivers keep the last active decode targets until the next structure, which resets them
+	int targets = context.structure.decodeTargetCount;
+	auto &bitmask = context.descriptor.activeDecodeTargetsBitmask;
+	bool keyframe = std::any_of(messages.begin(), messages.end(), [](const message_ptr &m) {
+		return m->frameInfo && m->frameInfo->isKeyframe;
+	});
+	if (maxLayer + 1 < targets) {
+		bitmask = (uint32_t(1) << (maxLayer + 1)) - 1;
+		mBitmaskSignalled = true;
+	} else if (mBitmaskSignalled && !keyframe) {
+		bitmask = (uint32_t(1) << targets) - 1;
+	} else {
+		bitmask.reset();
+		mBitmaskSignalled = false;
+	}
+}
+
+} // namespace rtc
+
+#endif // RTC_ENABLE_MEDIA
@@ -41,7 +41,7 @@ bool Track::isClosed(void) const { return impl()->isClosed(); }
 size_t Track::maxMessageSize() const { return impl()->maxMessageSize(); }
 
 void Track::sendFrame(binary data, FrameInfo info) {
-	impl()->outgoing(make_message(std::move(data), std::make_shared<FrameInfo>(std::move(info))));
+	impl()->outgoing(make_message(std::move(data), std::move(info)));
 }
 
 void Track::sendFrame(const byte *data, size_t size, FrameInfo info) {
@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2024 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "transportcchandler.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if RTC_ENABLE_MEDIA
+
+namespace rtc {
+
+namespace {
+
+const uint8_t PayloadTypeRtpfb = 205;
+const uint8_t FormatTransportFeedback = 15;
+const size_t FixedSize = sizeof(RtcpFbHeader) + 8;
+const int64_t ReferenceTimeUnitUs = 64000;
+const int64_t DeltaUnitUs = 250;
+
+enum Symbol : uint8_t { NotReceived = 0, SmallDelta = 1, LargeDelta = 2 };
+
+uint16_t read16(const byte *p) {
+	return uint16_t(std::to_integer<uint8_t>(p[0]) << 8 | std::to_integer<uint8_t>(p[1]));
+}
+
+void write16(byte *p, uint16_t value) {
+	p[0] = byte(value >> 8);
+	p[1] = byte(value & 0xFF);
+}
+
+} // namespace
+
+optional<TransportFeedback> TransportFeedback::Parse(const byte *data, size_t size) {
+	if (size < FixedSize)
+		return nullopt;
+
+	auto header = reinterpret_cast<const RtcpFbHeader *>(data);
+	if (header->header.payloadType() != PayloadTypeRtpfb ||
+	    header->header.reportCount() != FormatTransportFeedback)
+		return nullopt;
+
+	size_t length = header->header.lengthInBytes();
+	if (length < FixedSize || length > size)
+		return nullopt;
+
+	TransportFeedback feedback;
+	feedback.senderSsrc = header->packetSenderSSRC();
+	feedback.mediaSsrc = header->mediaSourceSSRC();
+
+	const byte *fields = data + sizeof(RtcpFbHeader);
+	feedback.baseSequenceNumber = read16(fields);
+	uint16_t statusCount = read16(fields + 2);
+	uint32_t reference = uint32_t(std::to_integer<uint8_t>(fields[4])) << 16 |
+	                     uint32_t(std::to_integer<uint8_t>(fields[5])) << 8 |
+	                     uint32_t(std::to_integer<uint8_t>(fields[6]));
+	int32_t signedReference = reference & 0x800000 ? int32_t(reference) - 0x1000000
+	                                               : int32_t(reference);
+	feedback.referenceTimeUs = int64_t(signedReference) * ReferenceTimeUnitUs;
+	feedback.feedbackCount = std::to_integer<uint8_t>(fields[7]);
+
+	// Packet status chunks
+	size_t offset = FixedSize;
+	std::vector<uint8_t> symbols;
+	symbols.reserve(statusCount);
+	while (symbols.size() < statusCount) {
+		if (offset + 2 > length)
+			return nullopt;
+
+		uint16_t chunk = read16(data + offset);
+		offset += 2;
+
+		size_t remaining = statusCount - symbols.size();
+		if (!(chunk & 0x8000)) {
+			// Run length chunk: 2-bit symbol, 13-bit run length
+			size_t run = std::min(size_t(chunk & 0x1FFF), remaining);
+			symbols.insert(symbols.end(), run, uint8_t((chunk >> 13) & 0x03));
+		} else if (!(chunk & 0x4000)) {
+			// Status vector chunk with 14 one-bit symbols
+			for (int shift = 13; shift >= 0 && remaining > 0; --shift, --remaining)
+				symbols.push_back(uint8_t((chunk >> shift) & 0x01));
+		} else {
+			// Status vector chunk with 7 two-bit symbols
+			for (int shift = 12; shift >= 0 && remaining > 0; shift -= 2, --remaining)
+				symbols.push_back(uint8_t((chunk >> shift) & 0x03));
+		}
+	}
+
+	// Receive deltas, in multiples of 250us
+	int64_t time = feedback.referenceTimeUs;
+	feedback.packets.reserve(statusCount);
+	for (size_t i = 0; i < symbols.size(); ++i) {
+		Packet packet;
+		packet.sequenceNumber = uint16_t(feedback.baseSequenceNumber + i);
+		switch (symbols[i]) {
+		case NotReceived:
+			break;
+
+		case SmallDelta:
+			if (offset + 1 > length)
+				return nullopt;
+
+			time += int64_t(std::to_integer<uint8_t>(data[offset])) * DeltaUnitUs;
+			offset += 1;
+			packet.received = true;
+			packet.arrivalTimeUs = time;
+			break;
+
+		case LargeDelta:
+			if (offset + 2 > length)
+				return nullopt;
+
+			time += int64_t(int16_t(read16(data + offset))) * DeltaUnitUs;
+			offset += 2;
+			packet.received = true;
+			packet.arrivalTimeUs = time;
+			break;
+
+		default: // reserved
+			return nullopt;
+		}
+		feedback.packets.push_back(packet);
+	}
+
+	return feedback;
+}
+
+binary TransportFeedback::serialize() const {
+	if (packets.size() > std::numeric_limits<uint16_t>::max())
+		throw std::invalid_argument("Too many packets in transport feedback");
+
+	int64_t reference = referenceTimeUs / ReferenceTimeUnitUs;
+	std::vector<uint8_t> symbols;
+	symbols.reserve(packets.size());
+	binary deltas;
+	int64_t time = reference * ReferenceTimeUnitUs;
+	for (const auto &packet : packets) {
+		if (!packet.received) {
+			symbols.push_back(NotReceived);
+			continue;
+		}
+
+		int64_t ticks = (packet.arrivalTimeUs - time) / DeltaUnitUs;
+		if (ticks >= 0 && ticks <= 0xFF) {
+			symbols.push_back(SmallDelta);
+			deltas.push_back(byte(ticks));
+		} else if (ticks >= std::numeric_limits<int16_t>::min() &&
+		           ticks <= std::numeric_limits<int16_t>::max()) {
+			symbols.push_back(LargeDelta);
+			deltas.resize(deltas.size() + 2);
+			write16(deltas.data() + deltas.size() - 2, uint16_t(int16_t(ticks)));
+		} else {
+			throw std::invalid_argument("Transport feedback delta out of range");
+		}
+		time += ticks * DeltaUnitUs;
+	}
+
+	// Two-bit status vector chunks hold 7 symbols each, which is valid even if not the most
+	// compact encoding
+	size_t chunkCount = (symbols.size() + 6) / 7;
+	size_t size = FixedSize + chunkCount * 2 + deltas.size();
+	size_t paddedSize = (size + 3) & ~size_t(3);
+
+	binary result(paddedSize);
+	auto header = reinterpret_cast<RtcpFbHeader *>(result.data());
+	header->header.prepareHeader(PayloadTypeRtpfb, FormatTransportFeedback,
+	                             uint16_t(paddedSize / 4 - 1));
+	header->setPacketSenderSSRC(senderSsrc);
+	header->setMediaSourceSSRC(mediaSsrc);
+
+	byte *fields = result.data() + sizeof(RtcpFbHeader);
+	write16(fields, baseSequenceNumber);
+	write16(fields + 2, uint16_t(packets.size()));
+	uint32_t wireReference = uint32_t(reference) & 0xFFFFFF;
+	fields[4] = byte(wireReference >> 16);
+	fields[5] = byte((wireReference >> 8) & 0xFF);
+	fields[6] = byte(wireReference & 0xFF);
+	fields[7] = byte(feedbackCount);
+
+	size_t offset = FixedSize;
+	for (size_t c = 0; c < chunkCount; ++c) {
+		uint16_t chunk = 0xC000;
+		for (size_t j = 0; j < 7; ++j) {
+			size_t index = c * 7 + j;
+			uint8_t symbol = index < symbols.size() ? symbols[index] : uint8_t(NotReceived);
+			chunk |= uint16_t(symbol) << (12 - 2 * j);
+		}
+		write16(result.data() + offset, chunk);
+		offset += 2;
+	}
+
+	std::copy(deltas.begin(), deltas.end(), result.begin() + offset);
+
+	// RFC 3550 6.4.1: the last octet of the padding is its length
+	if (paddedSize > size) {
+		result[0] |= byte(0x20);
+		result.back() = byte(paddedSize - size);
+	}
+
+	return result;
+}
+
+TransportCcHandler::TransportCcHandler(std::function<void(const TransportFeedback &)> onFeedback)
+    : mOnFeedback(std::move(onFeedback)) {}
+
+void TransportCcHandler::incoming(message_vector &messages,
+                                  [[maybe_unused]] const message_callback &send) {
+	for (const auto &message : messages) {
+		if (message->type != Message::Control)
+			continue;
+
+		size_t offset = 0;
+		while ((sizeof(RtcpHeader) + offset) <= message->size()) {
+			auto header = reinterpret_cast<RtcpHeader *>(message->data() + offset);
+			size_t length = header->lengthInBytes();
+			if (length == 0 || length > message->size() - offset)
+				break;
+
+			if (header->payloadType() == PayloadTypeRtpfb &&
+			    header->reportCount() == FormatTransportFeedback) {
+				if (auto feedback = TransportFeedback::Parse(message->data() + offset, length))
+					mOnFeedback(*feedback);
+			}
+
+			offset += length;
+		}
+	}
+}
+
+} // namespace rtc
+
+#endif // RTC_ENABLE_MEDIA
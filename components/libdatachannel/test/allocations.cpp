@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new to count allocations, only on threads that asked for it
+
+namespace {
+
+thread_local bool counting = false;
+thread_local size_t count = 0;
+
+} // namespace
+
+void *operator new(size_t size) {
+	if (counting)
+		++count;
+
+	if (void *ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+size_t countAllocations(const std::function<void()> &func) {
+	size_t before = count;
+	counting = true;
+	func();
+	counting = false;
+	return count - before;
+}
@@ -0,0 +1,447 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/epoch.hpp"
+#include "impl/pollservice.hpp"
+#include "impl/reactor.hpp"
+
+#include "rtc/h264rtppacketizer.hpp"
+#include "rtc/nalunit.hpp"
+#include "rtc/rtppacketizer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+using impl::PollService;
+using impl::Reactor;
+
+namespace {
+
+const auto Duration = 1s;
+const vector<size_t> IdleCounts = {0, 100, 1000, 5000};
+const size_t ChurnPairs = 64;
+
+struct SocketPair {
+	SocketPair() {
+		int fds[2];
+		check(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "socketpair failed");
+		polled = fds[0];
+		peer = fds[1];
+	}
+	~SocketPair() {
+		::close(polled);
+		::close(peer);
+	}
+
+	int polled;
+	int peer;
+};
+
+vector<unique_ptr<SocketPair>> makePairs(size_t count) {
+	vector<unique_ptr<SocketPair>> pairs;
+	for (size_t i = 0; i < count; ++i)
+		pairs.push_back(make_unique<SocketPair>());
+
+	return pairs;
+}
+
+// Each callback reads the byte and sends it back, so the pair stays readable
+void bounce(const SocketPair &pair, atomic<long> &calls) {
+	char c;
+	if (::read(pair.polled, &c, 1) == 1 && ::write(pair.peer, &c, 1) == 1)
+		++calls;
+}
+
+void raiseFileLimit() {
+	struct rlimit limit;
+	if (::getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+		limit.rlim_cur = limit.rlim_max;
+		::setrlimit(RLIMIT_NOFILE, &limit);
+	}
+}
+
+template <typename Add, typename Remove>
+void measure(const string &name, size_t idleCount, Add add, Remove remove,
+             function<size_t()> pending) {
+	auto idle = makePairs(idleCount);
+	for (const auto &pair : idle)
+		add(pair->polled, [] {});
+
+	SocketPair active;
+	atomic<long> calls = 0;
+	add(active.polled, [&]() { bounce(active, calls); });
+	check(::write(active.peer, "x", 1) == 1, "write failed");
+
+	this_thread::sleep_for(Duration);
+	long quiet = calls.exchange(0);
+
+	// Connections come and go meanwhile, each one registered with a timeout then removed
+	auto churn = makePairs(ChurnPairs);
+	long churned = 0;
+	auto start = chrono::steady_clock::now();
+	while (chrono::steady_clock::now() - start < Duration) {
+		for (const auto &pair : churn)
+			add(pair->polled, [] {});
+		for (const auto &pair : churn)
+			remove(pair->polled);
+		churned += ChurnPairs;
+	}
+	long busy = calls.exchange(0);
+
+	remove(active.polled);
+	for (const auto &pair : idle)
+		remove(pair->polled);
+
+	cout << name << ": " << idleCount << " idle sockets, " << quiet << " callbacks/s, under churn "
+	     << busy << " callbacks/s and " << churned << " add+remove/s, " << pending()
+	     << " pending timeouts" << endl;
+}
+
+void benchmarkPollService() {
+	auto &service = PollService::Instance();
+	service.start();
+	auto add = [&](int sock, function<void()> func) {
+		service.add(sock, {PollService::Direction::In, 30s, [func](PollService::Event event) {
+			                   if (event == PollService::Event::In)
+				                   func();
+		                   }});
+	};
+	auto remove = [&](int sock) { service.remove(sock); };
+	for (size_t idleCount : IdleCounts)
+		measure(RTC_POLL_USE_EPOLL ? "PollService (epoll)" : "PollService (poll)", idleCount, add,
+		        remove, [&]() { return service.pendingTimeouts(); });
+
+	service.join();
+}
+
+void benchmarkReactor() {
+	auto &reactor = Reactor::Instance();
+	reactor.enable();
+	reactor.start();
+
+	// Connections are paired with a timeout timer, cancelled when they are removed
+	std::mutex mutex;
+	std::unordered_map<int, Reactor::TimerId> timers;
+	auto add = [&](int sock, function<void()> func) {
+		reactor.add(sock, std::move(func));
+		std::lock_guard lock(mutex);
+		timers[sock] = reactor.schedule(30s, [] {});
+	};
+	auto remove = [&](int sock) {
+		reactor.remove(sock);
+		std::lock_guard lock(mutex);
+		reactor.cancel(timers[sock]);
+		timers.erase(sock);
+	};
+	for (size_t idleCount : IdleCounts)
+		measure("Reactor", idleCount, add, remove, [&]() { return reactor.pendingTimers(); });
+
+	// Timers spread over a few revolutions of the wheel, half of them cancelled
+	const size_t TimerCount = 100000;
+	mt19937 generator(42);
+	uniform_int_distribution<int> delay(0, 2000);
+	vector<Reactor::TimerId> ids;
+	ids.reserve(TimerCount);
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < TimerCount; ++i)
+		ids.push_back(reactor.schedule(chrono::milliseconds(1000 + delay(generator)), [] {}));
+	for (size_t i = 0; i < TimerCount; i += 2)
+		reactor.cancel(ids[i]);
+	auto elapsed = chrono::steady_clock::now() - start;
+	cout << "Reactor: " << TimerCount << " timers scheduled and " << TimerCount / 2
+	     << " cancelled in " << chrono::duration_cast<chrono::milliseconds>(elapsed).count()
+	     << " ms, " << reactor.pendingTimers() << " pending" << endl;
+
+	reactor.join();
+	reactor.enable(false);
+}
+
+// Slices of random data like entropy-coded video, with emulation prevention applied
+binary sliceFrame(size_t size, size_t slices) {
+	mt19937 generator(42);
+	uniform_int_distribution<int> value(0, 255);
+	binary frame;
+	frame.reserve(size + size / 64);
+	for (size_t s = 0; s < slices; ++s) {
+		frame.insert(frame.end(), {byte(0), byte(0), byte(0), byte(1), byte(0x65)});
+		size_t zeros = 0;
+		for (size_t i = 0; i < size / slices; ++i) {
+			int v = value(generator);
+			if (zeros >= 2 && v <= 3) {
+				frame.push_back(byte(3));
+				zeros = 0;
+			}
+			frame.push_back(byte(v));
+			zeros = v == 0 ? zeros + 1 : 0;
+		}
+		frame.push_back(byte(0x80));
+	}
+	return frame;
+}
+
+template <typename Func> double nanosecondsPerMegabyte(const binary &frame, Func func) {
+	const int Iterations = 50;
+	auto start = chrono::steady_clock::now();
+	for (int i = 0; i < Iterations; ++i)
+		func();
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	return elapsed.count() / Iterations / (double(frame.size()) / (1 << 20));
+}
+
+void benchmarkStartSequence() {
+	auto separator = NalUnit::Separator::StartSequence;
+	for (size_t slices : {1, 8}) {
+		auto frame = sliceFrame(4 << 20, slices);
+		size_t units = 0;
+		double wordTime = nanosecondsPerMegabyte(frame, [&]() {
+			NalUnit::ForEachStartSequenceUnit(frame, separator, [&](size_t, size_t) { ++units; });
+		});
+
+		// The previous byte-at-a-time state machine
+		size_t matches = 0;
+		double byteTime = nanosecondsPerMegabyte(frame, [&]() {
+			NalUnitStartSequenceMatch match = NUSM_noMatch;
+			for (auto b : frame) {
+				match = NalUnit::StartSequenceMatchSucc(match, b, separator);
+				if (match == NUSM_longMatch || match == NUSM_shortMatch) {
+					match = NUSM_noMatch;
+					++matches;
+				}
+			}
+		});
+		check(units == matches, "Scans found different start sequence counts");
+
+		cout << "Start sequences: " << slices << " slices in " << frame.size() / 1024
+		     << " KiB, word-at-a-time " << wordTime / 1000 << " us/MB, byte-wise "
+		     << byteTime / 1000 << " us/MB" << endl;
+	}
+}
+
+// Exposes packetize() to time it alone
+class BenchmarkPacketizer final : public RtpPacketizer {
+public:
+	using RtpPacketizer::packetize;
+	using RtpPacketizer::RtpPacketizer;
+};
+
+shared_ptr<RtpPacketizationConfig> packetizationConfig(bool extensions) {
+	auto config = make_shared<RtpPacketizationConfig>(0x1234, "cname", 96,
+	                                                  H264RtpPacketizer::ClockRate, 0);
+	if (extensions) {
+		config->videoOrientationId = 1;
+		config->videoOrientation = 1;
+		config->midId = 2;
+		config->mid = "video";
+		config->ridId = 3;
+		config->rid = "hi";
+		config->playoutDelayId = 4;
+		config->transportSequenceNumberId = 5;
+		config->absSendTimeId = 6;
+	}
+	return config;
+}
+
+template <typename Func> double nanosecondsPerPacket(size_t packets, Func func) {
+	auto start = chrono::steady_clock::now();
+	func();
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	return elapsed.count() / packets;
+}
+
+void benchmarkPacketize() {
+	const size_t Packets = 200000;
+	const binary payload(1200, byte(0x55));
+	struct Case {
+		const char *name;
+		bool extensions;
+		bool dependencyDescriptor;
+	};
+	for (auto c : {Case{"no extension", false, false}, Case{"6 extensions", true, false},
+	               Case{"6 extensions and dependency descriptor", true, true}}) {
+		auto config = packetizationConfig(c.extensions);
+		if (c.dependencyDescriptor) {
+			config->dependencyDescriptorId = 7;
+			// A delta frame, like outgoing() describes before packetizing
+			auto &context = config->dependencyDescriptorContext.emplace(
+			    DependencyDescriptorContext::TemporalLayers(3));
+			context.describeFrame(0, 0, true);
+			context.describeFrame(1, 2, false);
+		}
+		BenchmarkPacketizer packetizer(config);
+
+		// The header template is compiled once, then each packet copies it
+		double cached = nanosecondsPerPacket(Packets, [&]() {
+			for (size_t i = 0; i < Packets; ++i)
+				packetizer.packetize(payload, i % 8 == 7);
+		});
+
+		// A config change on every packet compiles the template every time, which is what
+		// building the header from the config costs
+		double compiled = nanosecondsPerPacket(Packets, [&]() {
+			for (size_t i = 0; i < Packets; ++i) {
+				config->ssrc ^= 1;
+				packetizer.packetize(payload, i % 8 == 7);
+			}
+		});
+
+		cout << "packetize, " << c.name << ": " << cached << " ns/packet with the template, "
+		     << compiled << " ns/packet compiling it" << endl;
+	}
+
+	// Whole frames through outgoing(), fragmentation included
+	const size_t Frames = 2000;
+	binary frame = {byte(0), byte(0), byte(0), byte(1), byte(0x65)};
+	frame.resize(frame.size() + 60000, byte(0x55));
+	H264RtpPacketizer packetizer(NalUnit::Separator::LongStartSequence,
+	                             packetizationConfig(true));
+	size_t packets = 0;
+	double frameTime = nanosecondsPerPacket(1, [&]() {
+		for (size_t i = 0; i < Frames; ++i) {
+			message_vector messages{make_message(binary(frame))};
+			packetizer.outgoing(messages, [](message_ptr) {});
+			packets += messages.size();
+		}
+	});
+	cout << "outgoing, " << frame.size() / 1000 << " kB frames: " << frameTime / packets
+	     << " ns/packet" << endl;
+}
+
+void benchmarkFrameDelivery() {
+	// Single-packet frames as Track::sendFrame() hands them to the chain, so per-frame costs show
+	const size_t Frames = 200000;
+	binary frame = {byte(0), byte(0), byte(0), byte(1), byte(0x41)};
+	frame.resize(frame.size() + 800, byte(0x55));
+	auto packetizer = make_shared<H264RtpPacketizer>(NalUnit::Separator::LongStartSequence,
+	                                                 packetizationConfig(false));
+	message_vector messages;
+	messages.reserve(8);
+	auto send = [](message_ptr) {};
+
+	auto deliver = [&](auto makeFrame) {
+		size_t allocations = 0;
+		double frameTime = nanosecondsPerPacket(Frames, [&]() {
+			for (size_t i = 0; i < Frames; ++i) {
+				binary data(frame);
+				messages.clear();
+				allocations += countAllocations([&]() {
+					messages.push_back(makeFrame(std::move(data), uint32_t(i * 3000)));
+					packetizer->outgoingChain(messages, send);
+				});
+			}
+		});
+		return pair(double(allocations) / Frames, frameTime);
+	};
+
+	// The frame info in its own shared allocation, as before it was held by value
+	auto [sharedAllocations, sharedTime] = deliver([](binary data, uint32_t timestamp) {
+		return make_message(std::move(data), make_shared<FrameInfo>(timestamp));
+	});
+	auto [inlineAllocations, inlineTime] = deliver([](binary data, uint32_t timestamp) {
+		return make_message(std::move(data), FrameInfo(timestamp));
+	});
+	cout << "frame delivery, shared frame info: " << sharedAllocations << " allocations and "
+	     << sharedTime << " ns per frame" << endl;
+	cout << "frame delivery, inline frame info: " << inlineAllocations << " allocations and "
+	     << inlineTime << " ns per frame" << endl;
+
+	// The chain walk enters one epoch guard per call, nested ones only count
+	const size_t Guards = 10000000;
+	double guardTime = nanosecondsPerPacket(Guards, [&]() {
+		for (size_t i = 0; i < Guards; ++i)
+			impl::Epoch::Guard guard;
+	});
+	cout << "epoch guard: " << guardTime << " ns to enter and leave" << endl;
+}
+
+void benchmarkCallbackDispatch() {
+	// Every channel and transport holds several callbacks, most of them never set
+	cout << "callback size: " << sizeof(synchronized_callback<message_ptr>) << " bytes, stored "
+	     << sizeof(synchronized_stored_callback<>) << " bytes" << endl;
+
+	// The library always runs threads, so reference counts are atomic as they would be
+	thread([]() {}).join();
+
+	const size_t Calls = 10000000;
+	atomic<size_t> counter = 0;
+	synchronized_callback<int> stateCallback([&](int) { ++counter; });
+	double stateTime = nanosecondsPerPacket(Calls, [&]() {
+		for (size_t i = 0; i < Calls; ++i)
+			stateCallback(int(i));
+	});
+	synchronized_callback<message_ptr> callback([&](message_ptr) { ++counter; });
+	message_ptr message = make_message(0);
+	double messageTime = nanosecondsPerPacket(Calls, [&]() {
+		for (size_t i = 0; i < Calls; ++i)
+			callback(message);
+	});
+	synchronized_callback<message_ptr> unset;
+	double unsetTime = nanosecondsPerPacket(Calls, [&]() {
+		for (size_t i = 0; i < Calls; ++i)
+			unset(message);
+	});
+	cout << "callback dispatch: " << stateTime << " ns per call with an int, " << messageTime
+	     << " ns with a message, " << unsetTime << " ns when unset" << endl;
+
+	// Invokers firing continuously must not delay a replacement much
+	const int Invokers = 4;
+	const size_t Replacements = 1000;
+	atomic<bool> stop = false;
+	vector<thread> invokers;
+	for (int i = 0; i < Invokers; ++i)
+		invokers.emplace_back([&]() {
+			while (!stop)
+				callback(message);
+		});
+
+	double replaceTime = nanosecondsPerPacket(Replacements, [&]() {
+		for (size_t i = 0; i < Replacements; ++i)
+			callback = [&](message_ptr) { ++counter; };
+	});
+	stop = true;
+	for (auto &t : invokers)
+		t.join();
+
+	cout << "callback replacement under " << Invokers << " invokers: " << replaceTime / 1000
+	     << " us" << endl;
+}
+
+} // namespace
+
+void benchmark_poll() {
+	raiseFileLimit();
+	benchmarkPollService();
+	benchmarkReactor();
+}
+
+void benchmark_start_sequence() { benchmarkStartSequence(); }
+
+void benchmark_packetize() { benchmarkPacketize(); }
+
+void benchmark_callback_dispatch() { benchmarkCallbackDispatch(); }
+
+void benchmark_frame_delivery() { benchmarkFrameDelivery(); }
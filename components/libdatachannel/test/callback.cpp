@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/utils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+namespace {
+
+void testConcurrentReplace() {
+	// Functions are numbered, once a replacement returns the former ones must not run anymore
+	synchronized_callback<int> callback;
+	atomic<int> retired = 0;
+	atomic<bool> ranAfterReplace = false;
+	atomic<long> calls = 0;
+	auto make = [&](int id) {
+		return [&, id](int) {
+			if (id < retired.load())
+				ranAfterReplace = true;
+
+			++calls;
+		};
+	};
+	callback = make(0);
+
+	const int Invokers = 4;
+	atomic<bool> stop = false;
+	vector<thread> invokers;
+	for (int i = 0; i < Invokers; ++i)
+		invokers.emplace_back([&, i]() {
+			while (!stop)
+				callback(i);
+		});
+
+	// Replacements and resets must not be starved by invocations firing continuously
+	const int Replacements = 2000;
+	auto start = chrono::steady_clock::now();
+	for (int id = 1; id <= Replacements; ++id) {
+		if (id % 10 == 0)
+			callback = nullptr;
+
+		callback = make(id);
+		retired = id;
+	}
+	auto elapsed = chrono::steady_clock::now() - start;
+
+	stop = true;
+	for (auto &t : invokers)
+		t.join();
+
+	check(!ranAfterReplace, "A replaced callback ran after the replacement returned");
+	check(elapsed < 5s, "Replacements were starved by invocations");
+	cout << Replacements << " replacements in "
+	     << chrono::duration_cast<chrono::milliseconds>(elapsed).count() << " ms during "
+	     << calls << " invocations" << endl;
+}
+
+void testReentrantReset() {
+	// A callback may reset itself, and another thread may copy it meanwhile
+	synchronized_callback<> callback;
+	int count = 0;
+	callback = [&]() {
+		++count;
+		callback = nullptr;
+	};
+	synchronized_callback<> copy = callback;
+	check(callback() && count == 1, "Callback did not run");
+	check(!callback, "Callback did not reset itself");
+	check(!callback() && count == 1, "Reset callback ran");
+	check(copy() && count == 2, "Copied callback did not run");
+}
+
+void testStoredReplay() {
+	// The last call missed before the callback is set is replayed once, concurrently or not
+	for (int i = 0; i < 200; ++i) {
+		synchronized_stored_callback<int> callback;
+		atomic<int> received = 0;
+		atomic<bool> wrongValue = false;
+		thread caller([&]() { callback(42); });
+		callback = [&](int value) {
+			if (value != 42)
+				wrongValue = true;
+
+			++received;
+		};
+		caller.join();
+		check(!wrongValue, "Wrong replayed value");
+		check(received == 1, "Missed call was not delivered exactly once");
+	}
+}
+
+} // namespace
+
+void test_synchronized_callback() {
+	testConcurrentReplace();
+	testReentrantReset();
+	testStoredReplay();
+}
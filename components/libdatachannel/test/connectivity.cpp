@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/rtc.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+namespace {
+
+using clock_type = chrono::steady_clock;
+
+const size_t Joins = 8;
+const auto FrameInterval = 33ms;
+
+const size_t BulkSize = 256 * 1024 * 1024;
+const size_t BulkMessageSize = 64 * 1024;
+const size_t BulkBufferedAmount = 4 * 1024 * 1024;
+
+struct Join {
+	chrono::milliseconds gathering;
+	chrono::milliseconds firstFrame;
+};
+
+// A device and a viewer in the same process, with the LAN flow of the device: no ICE server, and
+// a single offer with the host candidates once gathering is complete
+Join join() {
+	auto start = clock_type::now();
+	auto device = make_shared<PeerConnection>(Configuration());
+	auto viewer = make_shared<PeerConnection>(Configuration());
+	weak_ptr<PeerConnection> weakDevice = device, weakViewer = viewer;
+
+	promise<clock_type::time_point> gathered;
+	device->onGatheringStateChange([weakDevice, weakViewer, &gathered](
+	                                   PeerConnection::GatheringState state) {
+		auto device = weakDevice.lock();
+		auto viewer = weakViewer.lock();
+		if (device && viewer && state == PeerConnection::GatheringState::Complete) {
+			gathered.set_value(clock_type::now());
+			viewer->setRemoteDescription(*device->localDescription());
+		}
+	});
+	viewer->onLocalDescription([weakDevice](Description description) {
+		if (auto device = weakDevice.lock())
+			device->setRemoteDescription(description);
+	});
+	viewer->onLocalCandidate([weakDevice](Candidate candidate) {
+		if (auto device = weakDevice.lock())
+			device->addRemoteCandidate(candidate);
+	});
+
+	// The first RTP packet of the video stream, RTCP aside
+	promise<clock_type::time_point> firstFrame;
+	atomic<bool> received = false;
+	shared_ptr<Track> viewerTrack;
+	viewer->onTrack([&](shared_ptr<Track> track) {
+		viewerTrack = track;
+		track->onMessage(
+		    [&](binary packet) {
+			    auto payloadType = packet.size() >= 2 ? uint8_t(packet[1]) & 0x7F : 0;
+			    if (payloadType == 96 && !received.exchange(true))
+				    firstFrame.set_value(clock_type::now());
+		    },
+		    nullptr);
+	});
+
+	auto config = make_shared<RtpPacketizationConfig>(1, "cname", 96, H264RtpPacketizer::ClockRate);
+	Description::Video media("video", Description::Direction::SendOnly);
+	media.addH264Codec(96);
+	media.addSSRC(1, "cname", "stream", "video");
+	auto track = device->addTrack(media);
+	track->setMediaHandler(
+	    make_shared<H264RtpPacketizer>(NalUnit::Separator::StartSequence, config));
+	atomic<bool> open = false;
+	track->onOpen([&open]() { open = true; });
+	device->setLocalDescription();
+
+	// Frames are sent as captured, the first one once the track is open
+	auto firstFrameFuture = firstFrame.get_future();
+	auto deadline = start + 10s;
+	const binary frame = {byte{0}, byte{0}, byte{0}, byte{1}, byte{0x65}, byte{0x88}, byte{0x84}};
+	uint32_t timestamp = 0;
+	while (firstFrameFuture.wait_for(FrameInterval) != future_status::ready) {
+		check(clock_type::now() < deadline, "No frame received");
+		if (open)
+			track->sendFrame(frame, FrameInfo(timestamp));
+
+		timestamp += 3000;
+	}
+
+	auto gatheringEnd = gathered.get_future().get();
+	auto firstFrameTime = firstFrameFuture.get();
+	viewer->close();
+	device->close();
+	return {chrono::duration_cast<chrono::milliseconds>(gatheringEnd - start),
+	        chrono::duration_cast<chrono::milliseconds>(firstFrameTime - start)};
+}
+
+// CPU time of the whole process, so of both ends
+chrono::nanoseconds processCpuTime() {
+	timespec ts;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return chrono::seconds(ts.tv_sec) + chrono::nanoseconds(ts.tv_nsec);
+}
+
+} // namespace
+
+void test_connection_time() {
+	// Host candidates only: gathering does not wait on any server, and the first frame arrives
+	// after the ICE checks and the DTLS handshake over loopback
+	Preload();
+	vector<chrono::milliseconds> gathering, firstFrame;
+	for (size_t i = 0; i < Joins; ++i) {
+		auto result = join();
+		gathering.push_back(result.gathering);
+		firstFrame.push_back(result.firstFrame);
+	}
+
+	sort(gathering.begin(), gathering.end());
+	sort(firstFrame.begin(), firstFrame.end());
+	auto median = [](const vector<chrono::milliseconds> &values) { return values[values.size() / 2]; };
+	cout << "Host-only joins: gathering median " << median(gathering).count() << " ms, max "
+	     << gathering.back().count() << " ms, time to first frame median "
+	     << median(firstFrame).count() << " ms, max " << firstFrame.back().count() << " ms" << endl;
+
+	check(gathering.back() < 200ms, "Host-only gathering did not complete immediately");
+	check(median(firstFrame) < 500ms, "Host-only time to first frame is too long");
+}
+
+void benchmark_datachannel_throughput() {
+	// Bulk transfer on a reliable DataChannel over loopback: SCTP fills its congestion window, so
+	// DTLS sees batches of full-sized packets one way and of SACKs the other way
+	Preload();
+	auto sender = make_shared<PeerConnection>(Configuration());
+	auto receiver = make_shared<PeerConnection>(Configuration());
+	weak_ptr<PeerConnection> weakSender = sender, weakReceiver = receiver;
+	sender->onLocalDescription([weakReceiver](Description description) {
+		if (auto receiver = weakReceiver.lock())
+			receiver->setRemoteDescription(description);
+	});
+	sender->onLocalCandidate([weakReceiver](Candidate candidate) {
+		if (auto receiver = weakReceiver.lock())
+			receiver->addRemoteCandidate(candidate);
+	});
+	receiver->onLocalDescription([weakSender](Description description) {
+		if (auto sender = weakSender.lock())
+			sender->setRemoteDescription(description);
+	});
+	receiver->onLocalCandidate([weakSender](Candidate candidate) {
+		if (auto sender = weakSender.lock())
+			sender->addRemoteCandidate(candidate);
+	});
+
+	atomic<size_t> received = 0;
+	promise<void> done;
+	shared_ptr<DataChannel> receiverChannel;
+	receiver->onDataChannel([&](shared_ptr<DataChannel> channel) {
+		receiverChannel = channel;
+		channel->onMessage(
+		    [&](binary message) {
+			    if (received.fetch_add(message.size()) + message.size() == BulkSize)
+				    done.set_value();
+		    },
+		    nullptr);
+	});
+
+	mutex mutex;
+	condition_variable condition;
+	auto channel = sender->createDataChannel("bulk");
+	promise<void> open;
+	channel->onOpen([&open]() { open.set_value(); });
+	channel->setBufferedAmountLowThreshold(BulkBufferedAmount / 2);
+	channel->onBufferedAmountLow([&]() {
+		lock_guard lock(mutex);
+		condition.notify_all();
+	});
+	check(open.get_future().wait_for(10s) == future_status::ready, "DataChannel did not open");
+
+	const binary message(BulkMessageSize, byte{0x55});
+	auto start = clock_type::now();
+	auto cpuStart = processCpuTime();
+	for (size_t sent = 0; sent < BulkSize; sent += message.size()) {
+		unique_lock lock(mutex);
+		condition.wait_for(lock, 10ms,
+		                   [&]() { return channel->bufferedAmount() < BulkBufferedAmount; });
+		lock.unlock();
+		channel->send(message);
+	}
+	auto doneFuture = done.get_future();
+	check(doneFuture.wait_for(60s) == future_status::ready, "Transfer did not complete");
+	auto elapsed = chrono::duration<double>(clock_type::now() - start).count();
+	auto cpu = chrono::duration<double>(processCpuTime() - cpuStart).count();
+
+	double megabytes = double(BulkSize) / (1024 * 1024);
+	cout << "DataChannel bulk transfer of " << megabytes << " MB: " << megabytes / elapsed
+	     << " MB/s, " << cpu * 1000 / megabytes << " ms of CPU per MB (both ends)" << endl;
+
+	channel->close();
+	sender->close();
+	receiver->close();
+}
@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/certificate.hpp"
+#include "impl/dtlstransport.hpp"
+#include "impl/icetransport.hpp"
+#include "impl/internals.hpp"
+#include "rtc/global.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+using chrono::milliseconds;
+
+using impl::DtlsTransport;
+using impl::IceTransport;
+
+namespace {
+
+const size_t Mtu = 1280;
+const size_t MaxDatagramSize = Mtu - 8 - 40; // UDP/IPv6
+const size_t SackSize = 28;                   // SCTP common header and a SACK chunk
+const unsigned int DscpDefault = 0;
+const unsigned int DscpExpedited = 46;
+
+// DTLS transport whose datagrams are recorded, then handed to the peer transport instead of ICE,
+// unless they are lost
+class LoopbackDtlsTransport final : public DtlsTransport {
+public:
+	using DtlsTransport::DtlsTransport;
+
+	void connect(shared_ptr<LoopbackDtlsTransport> peer) { mPeer = peer; }
+
+	// Drops the first datagrams, then each one with the probability
+	void setLoss(size_t first, double probability, unsigned int seed) {
+		std::lock_guard lock(mMutex);
+		mDropFirst = first;
+		mLoss = probability;
+		mGenerator.seed(seed);
+	}
+
+	vector<message_ptr> takeDatagrams() {
+		std::lock_guard lock(mMutex);
+		return std::move(mDatagrams);
+	}
+
+private:
+	bool outgoing(message_ptr message) override {
+		message->dscp = mCurrentDscp;
+		{
+			std::lock_guard lock(mMutex);
+			if (mDropFirst > 0) {
+				--mDropFirst;
+				return true;
+			}
+			if (mLoss > 0 && uniform_real_distribution<double>(0, 1)(mGenerator) < mLoss)
+				return true;
+
+			mDatagrams.push_back(message);
+		}
+		if (auto peer = mPeer.lock())
+			peer->incoming(make_message(message->begin(), message->end()));
+
+		return true;
+	}
+
+	weak_ptr<LoopbackDtlsTransport> mPeer;
+	std::mutex mMutex;
+	vector<message_ptr> mDatagrams;
+	size_t mDropFirst = 0;
+	double mLoss = 0;
+	mt19937 mGenerator;
+};
+
+// Messages received by a transport, in order
+class Receiver {
+public:
+	void push(message_ptr message) {
+		if (!message)
+			return;
+
+		std::lock_guard lock(mMutex);
+		mMessages.push_back(std::move(message));
+		mCondition.notify_all();
+	}
+
+	vector<message_ptr> wait(size_t count) {
+		std::unique_lock lock(mMutex);
+		check(mCondition.wait_for(lock, 5s, [&]() { return mMessages.size() >= count; }),
+		      "Messages were not received");
+		check(mMessages.size() == count, "Too many messages were received");
+		return std::move(mMessages);
+	}
+
+private:
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	vector<message_ptr> mMessages;
+};
+
+// Application data as SCTP hands it to DTLS, filled so that received messages can be matched
+message_ptr packet(size_t size, unsigned int dscp, uint8_t tag) {
+	auto message = make_message(size, Message::Binary);
+	std::memset(message->data(), tag, size);
+	message->dscp = dscp;
+	return message;
+}
+
+struct Timeouts {
+	milliseconds initial = DEFAULT_DTLS_INITIAL_RETRANSMIT_TIMEOUT;
+	milliseconds max = DEFAULT_DTLS_MAX_RETRANSMIT_TIMEOUT;
+};
+
+class Pair {
+public:
+	explicit Pair(Timeouts timeouts = {}) {
+		// ICE only settles the roles, from an offer and an answer, and is never connected
+		auto config = Configuration();
+		mIceServer = make_shared<IceTransport>(config, nullptr, nullptr, nullptr);
+		mIceClient = make_shared<IceTransport>(config, nullptr, nullptr, nullptr);
+		mIceClient->setRemoteDescription(mIceServer->getLocalDescription(Description::Type::Offer));
+		mIceServer->setRemoteDescription(mIceClient->getLocalDescription(Description::Type::Answer));
+
+		auto certificate = impl::make_certificate(CertificateType::Ecdsa).get();
+		auto verifier = [](const string &) { return true; };
+		auto stateCallback = [this](DtlsTransport::State state) {
+			std::lock_guard lock(mMutex);
+			if (state == DtlsTransport::State::Connected)
+				++mConnected;
+			else if (state == DtlsTransport::State::Failed)
+				mFailed = true;
+
+			mCondition.notify_all();
+		};
+		server = make_shared<LoopbackDtlsTransport>(mIceServer, certificate, Mtu,
+		                                            CertificateFingerprint::Algorithm::Sha256,
+		                                            verifier, stateCallback);
+		client = make_shared<LoopbackDtlsTransport>(mIceClient, certificate, Mtu,
+		                                            CertificateFingerprint::Algorithm::Sha256,
+		                                            verifier, stateCallback);
+		check(client->isClient() && !server->isClient(), "Wrong DTLS roles");
+
+		server->connect(client);
+		client->connect(server);
+		server->setRetransmitTimeouts(timeouts.initial, timeouts.max);
+		client->setRetransmitTimeouts(timeouts.initial, timeouts.max);
+		server->onRecv([this](message_ptr message) { serverReceiver.push(std::move(message)); });
+		client->onRecv([this](message_ptr message) { clientReceiver.push(std::move(message)); });
+	}
+
+	~Pair() {
+		client->stop();
+		server->stop();
+	}
+
+	// Runs the handshake, returns its duration on the client or nothing if it failed
+	optional<milliseconds> handshake(milliseconds timeout = 5s) {
+		server->start();
+		client->start();
+
+		std::unique_lock lock(mMutex);
+		mCondition.wait_for(lock, timeout, [&]() { return mConnected == 2 || mFailed; });
+		if (mConnected != 2)
+			return nullopt;
+
+		client->takeDatagrams();
+		server->takeDatagrams();
+		return client->handshakeDuration();
+	}
+
+	bool failed() {
+		std::lock_guard lock(mMutex);
+		return mFailed;
+	}
+
+	shared_ptr<LoopbackDtlsTransport> client, server;
+	Receiver clientReceiver, serverReceiver;
+
+private:
+	shared_ptr<IceTransport> mIceClient, mIceServer;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	int mConnected = 0;
+	bool mFailed = false;
+};
+
+// Sends the batch from the client, and checks the server gets every message intact and in order
+vector<message_ptr> sendBatch(Pair &pair, const message_vector &batch) {
+	message_vector messages = batch;
+	check(pair.client->sendMultiple(messages), "Batch was dropped");
+	auto datagrams = pair.client->takeDatagrams();
+
+	auto received = pair.serverReceiver.wait(batch.size());
+	for (size_t i = 0; i < batch.size(); ++i)
+		check(binary(*received[i]) == binary(*batch[i]), "Message corrupted or out of order");
+
+	return datagrams;
+}
+
+} // namespace
+
+void test_dtls_packing() {
+	Preload();
+	Pair pair;
+	check(pair.handshake().has_value(), "DTLS handshake did not complete");
+
+	// SACK-only packets of a batch share a single datagram
+	message_vector sacks;
+	for (uint8_t i = 0; i < 8; ++i)
+		sacks.push_back(packet(SackSize, DscpDefault, i));
+
+	auto datagrams = sendBatch(pair, sacks);
+	cout << sacks.size() << " SACK-only records in " << datagrams.size() << " datagram of "
+	     << datagrams[0]->size() << " bytes" << endl;
+	check(datagrams.size() == 1, "SACK-only records were not coalesced");
+
+	// A DSCP change flushes the datagram, which keeps the DSCP of its records
+	message_vector mixed;
+	for (unsigned int dscp : {DscpDefault, DscpExpedited, DscpDefault})
+		for (uint8_t i = 0; i < 4; ++i)
+			mixed.push_back(packet(SackSize, dscp, uint8_t(dscp + i)));
+
+	datagrams = sendBatch(pair, mixed);
+	check(datagrams.size() == 3, "DSCP change did not flush the datagram");
+	check(datagrams[0]->dscp == DscpDefault && datagrams[1]->dscp == DscpExpedited &&
+	          datagrams[2]->dscp == DscpDefault,
+	      "Datagram sent with the DSCP of another record");
+
+	// Full-sized packets go one per datagram, a SACK fills the room left after one
+	message_vector large;
+	for (uint8_t i = 0; i < 3; ++i) {
+		large.push_back(packet(1000, DscpDefault, i));
+		large.push_back(packet(SackSize, DscpDefault, uint8_t(0x80 + i)));
+	}
+
+	datagrams = sendBatch(pair, large);
+	check(datagrams.size() == 3, "Records were not packed up to the MTU");
+	for (const auto &datagram : datagrams)
+		check(datagram->size() <= MaxDatagramSize, "Datagram exceeds the MTU");
+
+	// A single send is not held back
+	check(pair.client->send(packet(SackSize, DscpDefault, 0xFF)), "Message was dropped");
+	check(pair.client->takeDatagrams().size() == 1, "Single send was not flushed");
+	pair.serverReceiver.wait(1);
+
+	// Packed datagrams also decrypt the other way
+	message_vector reply;
+	for (uint8_t i = 0; i < 8; ++i)
+		reply.push_back(packet(SackSize, DscpDefault, i));
+
+	check(pair.server->sendMultiple(reply), "Batch was dropped");
+	check(pair.server->takeDatagrams().size() == 1, "Server records were not coalesced");
+	check(pair.clientReceiver.wait(reply.size()).size() == reply.size(), "Messages were lost");
+}
+
+void test_dtls_retransmission() {
+	Preload();
+	const Timeouts timeouts = {200ms, 800ms};
+
+	// A lost ClientHello is sent again after the initial timeout
+	{
+		Pair pair(timeouts);
+		pair.client->setLoss(1, 0, 0);
+		auto duration = pair.handshake();
+		check(duration.has_value(), "Handshake did not recover from a lost flight");
+		cout << "Handshake with a lost first flight: " << duration->count() << " ms" << endl;
+		check(*duration >= timeouts.initial && *duration < 2 * timeouts.initial,
+		      "Lost flight was not retransmitted after the initial timeout");
+	}
+
+	// Lost answers are retransmitted by the server, and by the client from its own timer
+	{
+		Pair pair(timeouts);
+		pair.server->setLoss(2, 0, 0);
+		check(pair.handshake().has_value(), "Handshake did not recover from lost answers");
+	}
+
+	// Without answers, the client backs off from the initial to the maximum timeout, then fails
+	{
+		Pair pair(timeouts);
+		pair.client->setLoss(0, 1, 0);
+		auto start = chrono::steady_clock::now();
+		check(!pair.handshake(5s).has_value() && pair.failed(), "Handshake did not time out");
+		auto elapsed = chrono::duration_cast<milliseconds>(chrono::steady_clock::now() - start);
+		cout << "Handshake timed out after " << elapsed.count() << " ms" << endl;
+
+		// 200, 400 and 800 ms, the next 1600 ms timeout is past the maximum
+		check(elapsed >= 1300ms && elapsed < 2500ms, "Handshake timeout does not follow the backoff");
+	}
+}
+
+void benchmark_dtls_loss() {
+	// Handshakes over a lossy path, with the default initial timeout of a path whose round-trip
+	// time is unknown, and with the minimum one that a LAN round-trip time gives
+	Preload();
+	const size_t Handshakes = 20;
+	for (auto initial : {DEFAULT_DTLS_INITIAL_RETRANSMIT_TIMEOUT,
+	                     MIN_DTLS_RETRANSMIT_TIMEOUT}) {
+		for (double loss : {0.0, 0.1, 0.2, 0.3}) {
+			vector<milliseconds> durations;
+			size_t failures = 0;
+			for (size_t i = 0; i < Handshakes; ++i) {
+				Pair pair({initial, DEFAULT_DTLS_MAX_RETRANSMIT_TIMEOUT});
+				pair.client->setLoss(0, loss, unsigned(2 * i));
+				pair.server->setLoss(0, loss, unsigned(2 * i + 1));
+				if (auto duration = pair.handshake(60s))
+					durations.push_back(*duration);
+				else
+					++failures;
+			}
+
+			sort(durations.begin(), durations.end());
+			auto percentile = [&](size_t p) {
+				return durations.empty() ? 0 : durations[(durations.size() - 1) * p / 100].count();
+			};
+			cout << "Initial timeout " << initial.count() << " ms, " << loss * 100 << "% loss: "
+			     << "median " << percentile(50) << " ms, p90 " << percentile(90) << " ms, max "
+			     << percentile(100) << " ms, " << failures << " failed" << endl;
+		}
+	}
+}
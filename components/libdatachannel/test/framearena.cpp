@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/framearena.hpp"
+#include "rtc/h264rtppacketizer.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+const size_t WarmupFrames = 60; // Two keyframe intervals, so buffers have seen every frame shape
+const size_t Frames = 300;
+
+void testArena() {
+	FrameArena arena(1024);
+	for (int round = 0; round < 3; ++round) {
+		for (size_t size : {1, 3, 100, 700, 2000, 8}) {
+			auto ptr = reinterpret_cast<uintptr_t>(arena.allocate(size, 8));
+			check(ptr % 8 == 0, "Arena memory is misaligned");
+		}
+		arena.reset();
+	}
+
+	// The chunks of the first round serve the next ones
+	check(arena.chunkAllocations() == 3, "Arena allocated chunks after a reset");
+	check(arena.capacity() == 1024 + 1024 + 2000, "Wrong arena capacity");
+}
+
+binary nalUnit(uint8_t header, size_t size) {
+	binary nalu(size, byte(0x55));
+	nalu[0] = byte(header);
+	return nalu;
+}
+
+// A keyframe every 30 frames, with small units for STAP-A and a large one for FU-A, and delta
+// frames of several slices of varying sizes
+binary frame(size_t index) {
+	vector<binary> nalus;
+	if (index % 30 == 0) {
+		nalus = {nalUnit(0x67, 20), nalUnit(0x68, 4), nalUnit(0x06, 30), nalUnit(0x65, 40000)};
+	} else {
+		for (size_t slice = 0; slice < 4; ++slice)
+			nalus.push_back(nalUnit(0x41, 200 + (index * 997 + slice * 331) % 3000));
+	}
+
+	binary frame;
+	for (const auto &nalu : nalus) {
+		frame.insert(frame.end(), {byte(0), byte(0), byte(0), byte(1)});
+		frame.insert(frame.end(), nalu.begin(), nalu.end());
+	}
+	return frame;
+}
+
+void testPacketizer() {
+	auto config = make_shared<RtpPacketizationConfig>(0x1234, "cname", 96,
+	                                                  H264RtpPacketizer::ClockRate);
+	config->midId = 1;
+	config->mid = "video";
+	config->dependencyDescriptorId = 2;
+	config->dependencyDescriptorContext.emplace(DependencyDescriptorContext::TemporalLayers(3));
+	H264RtpPacketizer packetizer(NalUnit::Separator::LongStartSequence, config, 1200);
+
+	message_vector messages;
+	messages.reserve(256);
+	auto send = [](message_ptr) {};
+	auto packetize = [&](size_t index) {
+		FrameInfo info(uint32_t(index * 3000));
+		info.isKeyframe = index % 30 == 0;
+		info.temporalLayer = index % 4 == 0 ? 0 : (index % 2 == 0 ? 1 : 2);
+		binary data = frame(index);
+		messages.clear();
+
+		// As Track::sendFrame() does, the frame info goes into the message
+		size_t allocations = countAllocations([&]() {
+			messages.push_back(make_message(std::move(data), info));
+			packetizer.outgoing(messages, send);
+		});
+		return pair(allocations, messages.size());
+	};
+
+	for (size_t i = 0; i < WarmupFrames; ++i)
+		packetize(i);
+
+	size_t chunks = packetizer.arena().chunkAllocations();
+	size_t allocations = 0, packets = 0;
+	for (size_t i = WarmupFrames; i < WarmupFrames + Frames; ++i) {
+		auto [a, p] = packetize(i);
+		allocations += a;
+		packets += p;
+	}
+
+	cout << Frames << " frames, " << packets << " packets, " << allocations << " allocations, "
+	     << packetizer.arena().chunkAllocations() << " arena chunks of "
+	     << packetizer.arena().capacity() << " bytes" << endl;
+
+	check(packetizer.arena().chunkAllocations() == chunks, "Arena is still growing after warm-up");
+
+	// The frame is a single message, with the frame info inline. Each packet is a message and its
+	// buffer, everything else comes from the arena.
+	check(allocations == Frames + 2 * packets, "Packetization allocates beyond the packets");
+}
+
+} // namespace
+
+void test_frame_arena() {
+	testArena();
+	testPacketizer();
+}
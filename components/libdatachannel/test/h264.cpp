@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/h264rtpdepacketizer.hpp"
+#include "rtc/h264rtppacketizer.hpp"
+#include "rtc/rtp.hpp"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+const size_t MaxFragmentSize = 1200;
+
+const uint8_t TypeSTAPA = 24;
+const uint8_t TypeFUA = 28;
+
+// NAL unit with the given header byte, the body has no zero byte so it contains no start code
+binary nalUnit(uint8_t header, size_t size) {
+	binary nalu(size);
+	nalu[0] = byte(header);
+	for (size_t i = 1; i < size; ++i)
+		nalu[i] = byte(1 + (i * 7 + header) % 255);
+	return nalu;
+}
+
+binary annexB(const vector<binary> &nalus, bool shortStartCodes = false) {
+	binary frame;
+	for (const auto &nalu : nalus) {
+		if (!shortStartCodes)
+			frame.push_back(byte(0));
+		frame.insert(frame.end(), {byte(0), byte(0), byte(1)});
+		frame.insert(frame.end(), nalu.begin(), nalu.end());
+	}
+	return frame;
+}
+
+message_vector packetize(const binary &frame, NalUnit::Separator separator) {
+	auto config = make_shared<RtpPacketizationConfig>(0x1234, "cname", 96,
+	                                                  H264RtpPacketizer::ClockRate);
+	H264RtpPacketizer packetizer(separator, config, MaxFragmentSize);
+	message_vector messages{make_message(binary(frame))};
+	packetizer.outgoing(messages, [](message_ptr) {});
+	return messages;
+}
+
+binary depacketize(message_vector packets) {
+	H264RtpDepacketizer depacketizer(NalUnit::Separator::LongStartSequence);
+	static_cast<MediaHandler &>(depacketizer).incoming(packets, [](message_ptr) {});
+	check(packets.size() == 1, "Depacketizer did not output exactly one frame");
+	return *packets[0];
+}
+
+const byte *payload(const message_ptr &packet) {
+	auto header = reinterpret_cast<const RtpHeader *>(packet->data());
+	return packet->data() + header->getSize() + header->getExtensionHeaderSize();
+}
+
+size_t payloadSize(const message_ptr &packet) {
+	return packet->size() - size_t(payload(packet) - packet->data());
+}
+
+uint8_t unitType(const message_ptr &packet) { return uint8_t(payload(packet)[0]) & 0x1F; }
+
+// Checks sizes and markers of the packets of one frame, then that it depacketizes to expected
+void checkPackets(const message_vector &packets, const binary &expected) {
+	check(!packets.empty(), "No packets");
+	for (size_t i = 0; i < packets.size(); ++i) {
+		auto header = reinterpret_cast<const RtpHeader *>(packets[i]->data());
+		check(payloadSize(packets[i]) <= MaxFragmentSize, "Payload is larger than the maximum");
+		check(bool(header->marker()) == (i == packets.size() - 1),
+		      "Marker is not on the last packet");
+	}
+	check(depacketize(packets) == expected, "Depacketized frame differs from the original");
+}
+
+void testKeyframe() {
+	// Parameter sets and SEI are aggregated, the IDR slice is fragmented
+	vector<binary> nalus = {nalUnit(0x67, 20), nalUnit(0x68, 4), nalUnit(0x06, 30),
+	                        nalUnit(0x65, 5000)};
+	auto frame = annexB(nalus);
+	auto packets = packetize(frame, NalUnit::Separator::LongStartSequence);
+
+	check(unitType(packets[0]) == TypeSTAPA, "Small NAL units are not aggregated");
+	check(payloadSize(packets[0]) == 1 + (2 + 20) + (2 + 4) + (2 + 30), "Wrong STAP-A size");
+	check(uint8_t(payload(packets[0])[0]) == 0x78, "Wrong STAP-A header"); // NRI 3 from the SPS
+
+	check(packets.size() == 1 + 5, "Wrong FU-A fragment count");
+	for (size_t i = 1; i < packets.size(); ++i) {
+		check(unitType(packets[i]) == TypeFUA, "Large NAL unit is not fragmented");
+		uint8_t indicator = uint8_t(payload(packets[i])[0]);
+		uint8_t fuHeader = uint8_t(payload(packets[i])[1]);
+		check((indicator & 0xE0) == 0x60, "FU indicator does not carry the NRI of the unit");
+		check((fuHeader & 0x1F) == 5, "FU header does not carry the type of the unit");
+		check(bool(fuHeader & 0x80) == (i == 1), "Wrong FU-A start bit");
+		check(bool(fuHeader & 0x40) == (i == packets.size() - 1), "Wrong FU-A end bit");
+	}
+
+	checkPackets(packets, frame);
+}
+
+void testHeaderMerging() {
+	// RFC 6184 5.7.1: F is set if any unit has F set, NRI is the maximum NRI of the units
+	vector<binary> nalus = {nalUnit(0x06, 10), nalUnit(0x21, 10), nalUnit(0xC1, 10)};
+	auto frame = annexB(nalus);
+	auto packets = packetize(frame, NalUnit::Separator::LongStartSequence);
+
+	check(packets.size() == 1, "Small NAL units are not aggregated in one packet");
+	check(uint8_t(payload(packets[0])[0]) == (0x80 | 0x40 | TypeSTAPA), "Wrong STAP-A header");
+	checkPackets(packets, frame);
+
+	auto zero = annexB({nalUnit(0x06, 10), nalUnit(0x01, 10)});
+	packets = packetize(zero, NalUnit::Separator::LongStartSequence);
+	check(uint8_t(payload(packets[0])[0]) == TypeSTAPA, "STAP-A header has F or NRI set");
+	checkPackets(packets, zero);
+}
+
+void testAggregationLimits() {
+	// 1 + 11 * (2 + 100) fits in a packet, 12 units do not
+	vector<binary> nalus(40, nalUnit(0x41, 100));
+	auto frame = annexB(nalus);
+	auto packets = packetize(frame, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 4, "Wrong STAP-A count");
+	for (size_t i = 0; i < packets.size(); ++i) {
+		check(unitType(packets[i]) == TypeSTAPA, "Small NAL units are not aggregated");
+		size_t units = i < 3 ? 11 : 7;
+		check(payloadSize(packets[i]) == 1 + units * 102, "Wrong STAP-A size");
+	}
+	checkPackets(packets, frame);
+
+	// A STAP-A of exactly the maximum size
+	auto exact = annexB({nalUnit(0x41, 597), nalUnit(0x41, 598)});
+	packets = packetize(exact, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 1 && payloadSize(packets[0]) == MaxFragmentSize,
+	      "Units filling exactly a packet are not aggregated");
+	checkPackets(packets, exact);
+
+	// One byte more, the units are sent alone and not as single-unit STAP-As
+	auto over = annexB({nalUnit(0x41, 597), nalUnit(0x41, 599)});
+	packets = packetize(over, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 2, "Units overflowing a packet are aggregated");
+	check(unitType(packets[0]) == 1 && unitType(packets[1]) == 1, "Units are not sent alone");
+	checkPackets(packets, over);
+}
+
+void testFragmentationLimits() {
+	// A unit of exactly the maximum size is sent as is, one byte more is fragmented
+	auto exact = annexB({nalUnit(0x41, MaxFragmentSize)});
+	auto packets = packetize(exact, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 1 && unitType(packets[0]) == 1, "Unit of maximum size is fragmented");
+	checkPackets(packets, exact);
+
+	auto over = annexB({nalUnit(0x41, MaxFragmentSize + 1)});
+	packets = packetize(over, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 2 && unitType(packets[0]) == TypeFUA, "Large unit is not fragmented");
+	checkPackets(packets, over);
+
+	// Aggregation does not span a fragmented unit
+	auto mixed = annexB({nalUnit(0x06, 10), nalUnit(0x41, 3000), nalUnit(0x06, 10),
+	                     nalUnit(0x06, 10)});
+	packets = packetize(mixed, NalUnit::Separator::LongStartSequence);
+	check(packets.size() == 1 + 3 + 1, "Wrong packet count around a fragmented unit");
+	check(unitType(packets[0]) == 6, "Unit before a fragmented unit is not sent alone");
+	check(unitType(packets.back()) == TypeSTAPA,
+	      "Units after a fragmented unit are not aggregated");
+	checkPackets(packets, mixed);
+}
+
+void testShortStartCodes() {
+	// Depacketized frames always use long start codes
+	vector<binary> nalus = {nalUnit(0x67, 20), nalUnit(0x68, 4), nalUnit(0x65, 2000)};
+	auto packets = packetize(annexB(nalus, true), NalUnit::Separator::StartSequence);
+	checkPackets(packets, annexB(nalus));
+}
+
+} // namespace
+
+void test_h264_packetization() {
+	testKeyframe();
+	testHeaderMerging();
+	testAggregationLimits();
+	testFragmentationLimits();
+	testShortStartCodes();
+}
@@ -0,0 +1,131 @@
+# Full libdatachannel for host tests that connect PeerConnections over loopback
+#
+# libjuice, usrsctp, libsrtp and the library are built with OpenSSL in place of Mbed TLS and
+# without the WebSocket server. Sets HOST_LIBRARY_FOUND and defines the datachannel_host target if
+# OpenSSL is available. Expects LDC_DIR, PLOG_DIR and HOST_INCLUDE_DIR to be set.
+
+if(TARGET datachannel_host)
+	set(HOST_LIBRARY_FOUND TRUE)
+	return()
+endif()
+
+set(HOST_LIBRARY_FOUND FALSE)
+find_package(OpenSSL)
+if(NOT OpenSSL_FOUND)
+	message(STATUS "OpenSSL not found, connectivity tests are disabled")
+	return()
+endif()
+set(HOST_LIBRARY_FOUND TRUE)
+
+enable_language(C)
+set(COMPONENTS_DIR ${LDC_DIR}/..)
+
+# libsrtp with its own build, OpenSSL provides the GCM profiles
+set(ENABLE_OPENSSL ON CACHE BOOL "" FORCE)
+set(LIBSRTP_TEST_APPS OFF CACHE BOOL "" FORCE)
+set(ENABLE_WARNINGS_AS_ERRORS OFF CACHE BOOL "" FORCE)
+add_subdirectory(${LDC_DIR}/deps/libsrtp ${CMAKE_CURRENT_BINARY_DIR}/libsrtp EXCLUDE_FROM_ALL)
+
+# The include/ directory of libjuice also holds lwIP shims (ifaddrs.h, netdb.h, poll.h), so only
+# include/juice is exposed, as <juice/...> through a link
+set(JUICE_INCLUDE_DIR ${CMAKE_CURRENT_BINARY_DIR}/juice_include)
+file(MAKE_DIRECTORY ${JUICE_INCLUDE_DIR})
+file(CREATE_LINK ${COMPONENTS_DIR}/libjuice/include/juice ${JUICE_INCLUDE_DIR}/juice SYMBOLIC)
+
+file(GLOB JUICE_SOURCES ${COMPONENTS_DIR}/libjuice/src/*.c)
+add_library(juice_host STATIC ${JUICE_SOURCES})
+target_include_directories(juice_host PUBLIC ${JUICE_INCLUDE_DIR}
+	PRIVATE ${COMPONENTS_DIR}/libjuice/include/juice)
+target_compile_definitions(juice_host PUBLIC JUICE_STATIC PRIVATE _GNU_SOURCE)
+target_compile_options(juice_host PRIVATE -w)
+
+# Likewise without the include/ directory of the component
+file(GLOB USRSCTP_SOURCES
+	${COMPONENTS_DIR}/usrsctp/src/netinet/*.c
+	${COMPONENTS_DIR}/usrsctp/src/netinet6/*.c
+	${COMPONENTS_DIR}/usrsctp/src/user_*.c)
+add_library(usrsctp_host STATIC ${USRSCTP_SOURCES})
+target_include_directories(usrsctp_host PUBLIC ${COMPONENTS_DIR}/usrsctp/src
+	PRIVATE ${COMPONENTS_DIR}/usrsctp/src/netinet ${COMPONENTS_DIR}/usrsctp/src/netinet6)
+target_compile_definitions(usrsctp_host PRIVATE __Userspace__ SCTP_SIMPLE_ALLOCATOR
+	SCTP_PROCESS_LEVEL_LOCKS _GNU_SOURCE INET INET6 HAVE_STDATOMIC_H)
+target_compile_options(usrsctp_host PRIVATE -w)
+
+set(HOST_LIBRARY_SOURCES
+	${LDC_DIR}/src/impl/certificate.cpp
+	${LDC_DIR}/src/impl/channel.cpp
+	${LDC_DIR}/src/impl/datachannel.cpp
+	${LDC_DIR}/src/impl/dtlssrtptransport.cpp
+	${LDC_DIR}/src/impl/dtlstransport.cpp
+	${LDC_DIR}/src/impl/epoch.cpp
+	${LDC_DIR}/src/impl/heapprofiler.cpp
+	${LDC_DIR}/src/impl/icetransport.cpp
+	${LDC_DIR}/src/impl/init.cpp
+	${LDC_DIR}/src/impl/logcounter.cpp
+	${LDC_DIR}/src/impl/memorytracker.cpp
+	${LDC_DIR}/src/impl/peerconnection.cpp
+	${LDC_DIR}/src/impl/pollinterrupter.cpp
+	${LDC_DIR}/src/impl/processor.cpp
+	${LDC_DIR}/src/impl/reactor.cpp
+	${LDC_DIR}/src/impl/sctptransport.cpp
+	${LDC_DIR}/src/impl/streamscheduler.cpp
+	${LDC_DIR}/src/impl/threadpool.cpp
+	${LDC_DIR}/src/impl/tls.cpp
+	${LDC_DIR}/src/impl/tlstransport.cpp
+	${LDC_DIR}/src/impl/track.cpp
+	${LDC_DIR}/src/impl/transport.cpp
+	${LDC_DIR}/src/impl/utils.cpp
+	${LDC_DIR}/src/av1rtppacketizer.cpp
+	${LDC_DIR}/src/candidate.cpp
+	${LDC_DIR}/src/channel.cpp
+	${LDC_DIR}/src/configuration.cpp
+	${LDC_DIR}/src/datachannel.cpp
+	${LDC_DIR}/src/dependencydescriptor.cpp
+	${LDC_DIR}/src/description.cpp
+	${LDC_DIR}/src/framearena.cpp
+	${LDC_DIR}/src/global.cpp
+	${LDC_DIR}/src/h264rtpdepacketizer.cpp
+	${LDC_DIR}/src/h264rtppacketizer.cpp
+	${LDC_DIR}/src/h265nalunit.cpp
+	${LDC_DIR}/src/h265rtpdepacketizer.cpp
+	${LDC_DIR}/src/h265rtppacketizer.cpp
+	${LDC_DIR}/src/heapprofiler.cpp
+	${LDC_DIR}/src/mediahandler.cpp
+	${LDC_DIR}/src/memoryplacement.cpp
+	${LDC_DIR}/src/message.cpp
+	${LDC_DIR}/src/nalunit.cpp
+	${LDC_DIR}/src/pacinghandler.cpp
+	${LDC_DIR}/src/peerconnection.cpp
+	${LDC_DIR}/src/plihandler.cpp
+	${LDC_DIR}/src/qos.cpp
+	${LDC_DIR}/src/rembhandler.cpp
+	${LDC_DIR}/src/rtcpnackresponder.cpp
+	${LDC_DIR}/src/rtcpreceivingsession.cpp
+	${LDC_DIR}/src/rtcpsrreporter.cpp
+	${LDC_DIR}/src/rtp.cpp
+	${LDC_DIR}/src/rtpdepacketizer.cpp
+	${LDC_DIR}/src/rtppacketizationconfig.cpp
+	${LDC_DIR}/src/rtppacketizer.cpp
+	${LDC_DIR}/src/temporallayerselector.cpp
+	${LDC_DIR}/src/track.cpp
+	${LDC_DIR}/src/transportcchandler.cpp
+)
+
+add_library(datachannel_host STATIC ${HOST_LIBRARY_SOURCES})
+target_include_directories(datachannel_host PUBLIC
+	${HOST_INCLUDE_DIR}
+	${LDC_DIR}/include/rtc
+	${LDC_DIR}/src
+	${PLOG_DIR}/include
+)
+target_compile_definitions(datachannel_host PUBLIC
+	RTC_ENABLE_MEDIA=1
+	RTC_ENABLE_WEBSOCKET=0
+	RTC_STATIC
+	USE_GNUTLS=0
+	USE_MBEDTLS=0
+	USE_NICE=0
+)
+target_compile_options(datachannel_host PRIVATE -Wno-deprecated-declarations)
+target_link_libraries(datachannel_host PUBLIC srtp2 juice_host usrsctp_host OpenSSL::SSL
+	OpenSSL::Crypto Threads::Threads)
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2019 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#if RTC_TEST_CONNECTIVITY
+
+void test_connection_time();
+void test_dtls_packing();
+void test_dtls_retransmission();
+
+void benchmark_datachannel_throughput();
+void benchmark_dtls_loss();
+
+#else
+
+void test_frame_arena();
+void test_h264_packetization();
+void test_mediahandler_chain();
+void test_memory_tracker();
+void test_nalunit_start_sequence();
+void test_poll_service();
+void test_reactor();
+void test_stream_scheduler();
+void test_synchronized_callback();
+void test_temporal_layers();
+void test_transport_cc_feedback();
+
+void benchmark_callback_dispatch();
+void benchmark_frame_delivery();
+void benchmark_packetize();
+void benchmark_poll();
+void benchmark_start_sequence();
+
+#endif
+
+namespace {
+
+struct Test {
+	const char *name;
+	function<void()> func;
+};
+
+#if RTC_TEST_CONNECTIVITY
+
+// PeerConnections connected over loopback, with the full library
+const vector<Test> tests = {
+    {"connection_time", test_connection_time},
+    {"dtls_packing", test_dtls_packing},
+    {"dtls_retransmission", test_dtls_retransmission},
+};
+
+const vector<Test> benchmarks = {
+    {"datachannel_throughput_benchmark", benchmark_datachannel_throughput},
+    {"dtls_loss_benchmark", benchmark_dtls_loss},
+};
+
+#else
+
+const vector<Test> tests = {
+    {"frame_arena", test_frame_arena},
+    {"h264_packetization", test_h264_packetization},
+    {"mediahandler_chain", test_mediahandler_chain},
+    {"memory_tracker", test_memory_tracker},
+    {"nalunit_start_sequence", test_nalunit_start_sequence},
+    {"poll_service", test_poll_service},
+    {"reactor", test_reactor},
+    {"stream_scheduler", test_stream_scheduler},
+    {"synchronized_callback", test_synchronized_callback},
+    {"temporal_layers", test_temporal_layers},
+    {"transport_cc_feedback", test_transport_cc_feedback},
+};
+
+// Only run when named on the command line
+const vector<Test> benchmarks = {
+    {"callback_dispatch_benchmark", benchmark_callback_dispatch},
+    {"frame_delivery_benchmark", benchmark_frame_delivery},
+    {"packetize_benchmark", benchmark_packetize},
+    {"poll_benchmark", benchmark_poll},
+    {"start_sequence_benchmark", benchmark_start_sequence},
+};
+
+#endif
+
+bool run(const Test &test) {
+	try {
+		cout << endl << "*** Running " << test.name << " test..." << endl;
+		test.func();
+		cout << "*** Finished " << test.name << " test" << endl;
+		return true;
+	} catch (const exception &e) {
+		cerr << test.name << " test failed: " << e.what() << endl;
+		return false;
+	}
+}
+
+} // namespace
+
+void check(bool condition, const string &what) {
+	if (!condition)
+		throw runtime_error(what);
+}
+
+// Runs the test or benchmark named on the command line, or all the tests
+int main(int argc, char **argv) {
+	bool success = true;
+	bool found = false;
+	for (const auto &test : tests) {
+		if (argc > 1 && strcmp(argv[1], test.name) != 0)
+			continue;
+
+		found = true;
+		success = run(test) && success;
+	}
+	for (const auto &benchmark : benchmarks) {
+		if (argc <= 1 || strcmp(argv[1], benchmark.name) != 0)
+			continue;
+
+		found = true;
+		success = run(benchmark) && success;
+	}
+
+	if (!found) {
+		cerr << "Unknown test: " << argv[1] << endl;
+		return -1;
+	}
+
+	return success ? 0 : -1;
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "rtc/mediahandler.hpp"
+
+#include "impl/epoch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+namespace {
+
+atomic<int> probesAlive = 0;
+atomic<bool> destroyedInUse = false;
+
+// Handler that stays in outgoing() for a while and reports if it is destroyed meanwhile
+class Probe final : public MediaHandler {
+public:
+	Probe() { ++probesAlive; }
+	~Probe() {
+		if (mInside.load())
+			destroyedInUse = true;
+		--probesAlive;
+	}
+
+	void outgoing(message_vector &messages, const message_callback &send) override {
+		++mInside;
+		for (int i = 0; i < 1000; ++i)
+			mSpin.fetch_add(1, memory_order_relaxed);
+		--mInside;
+	}
+
+private:
+	atomic<int> mInside = 0;
+	atomic<int> mSpin = 0;
+};
+
+class Passthrough final : public MediaHandler {};
+
+} // namespace
+
+void test_mediahandler_chain() {
+	auto head = make_shared<Passthrough>();
+	head->setNext(make_shared<Probe>());
+
+	atomic<bool> stop = false;
+	atomic<int> walks = 0;
+	thread walker([&]() {
+		message_vector messages;
+		while (!stop) {
+			head->outgoingChain(messages, [](message_ptr) {});
+			head->incomingChain(messages, [](message_ptr) {});
+			++walks;
+		}
+	});
+
+	// Replace the handler the walker is in, the previous one must outlive the walk
+	int replacements = 0;
+	auto end = chrono::steady_clock::now() + 200ms;
+	while (chrono::steady_clock::now() < end || walks < 100) {
+		head->setNext(make_shared<Probe>());
+		++replacements;
+		this_thread::yield();
+	}
+
+	stop = true;
+	walker.join();
+
+	if (destroyedInUse)
+		throw runtime_error("A replaced handler was destroyed while a chain walk was in it");
+
+	// Without walkers, every replaced handler can be released
+	head->setNext(nullptr);
+	impl::Epoch::Instance().collect();
+	if (probesAlive != 0)
+		throw runtime_error("Replaced handlers were not released");
+
+	cout << replacements << " replacements during " << walks << " chain walks" << endl;
+}
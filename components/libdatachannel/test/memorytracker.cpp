@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/memorytracker.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+using impl::MemoryTracker;
+
+namespace {
+
+// The tracker only records addresses, blocks are never dereferenced
+void *block(uintptr_t index) { return reinterpret_cast<void *>(0x10000000 + index * 64); }
+
+} // namespace
+
+void test_memory_tracker() {
+	auto &tracker = MemoryTracker::Instance();
+	auto connection = tracker.acquire();
+	check(connection != 0, "No connection slot");
+
+	// Untagged allocations and frees are ignored
+	MemoryTracker::Allocated(block(0), 1000, true);
+	MemoryTracker::Freed(block(0));
+	check(tracker.usage(connection).current() == 0, "Untagged allocation is accounted");
+
+	{
+		MemoryTracker::Scope scope(connection, MemorySubsystem::Dtls);
+		MemoryTracker::Allocated(block(1), 100, true);
+		MemoryTracker::Allocated(block(2), 200, false);
+		{
+			MemoryTracker::Scope nested(MemorySubsystem::Srtp);
+			MemoryTracker::Allocated(block(3), 300, true);
+		}
+	}
+	auto usage = tracker.usage(connection);
+	check(usage.tracked, "Connection is not tracked");
+	check(usage.internal == 400 && usage.external == 200, "Wrong usage by memory");
+	check(usage[MemorySubsystem::Dtls] == 300 && usage[MemorySubsystem::Srtp] == 300,
+	      "Wrong usage by subsystem");
+
+	// Untagged frees of other blocks leave the account untouched, tagged blocks freed on another
+	// thread are credited back
+	for (uintptr_t i = 100; i < 10100; ++i)
+		MemoryTracker::Freed(block(i));
+	check(tracker.usage(connection).current() == 600, "Untagged free is accounted");
+
+	thread([]() {
+		MemoryTracker::Freed(block(1));
+		MemoryTracker::Freed(block(2));
+		MemoryTracker::Freed(block(3));
+	}).join();
+	usage = tracker.usage(connection);
+	check(usage.current() == 0, "Cross-thread free is not accounted");
+	check(usage.internalPeak == 400 && usage.externalPeak == 200, "Wrong peaks");
+
+	// Many blocks, some sharing filter counters, are all credited back
+	{
+		MemoryTracker::Scope scope(connection, MemorySubsystem::Media);
+		for (uintptr_t i = 0; i < 5000; ++i)
+			MemoryTracker::Allocated(block(20000 + i * 3), 16, false);
+	}
+	check(tracker.usage(connection).external == 5000 * 16, "Wrong usage of many blocks");
+	for (uintptr_t i = 0; i < 15000; ++i)
+		MemoryTracker::Freed(block(20000 + i));
+	check(tracker.usage(connection).current() == 0, "Blocks are not all credited back");
+	check(tracker.dropped() == 0, "Blocks were dropped");
+
+	tracker.release(connection);
+	check(!tracker.usage(connection).tracked, "Released connection is still tracked");
+}
@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/nalunit.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+using Separator = NalUnit::Separator;
+using Units = vector<pair<size_t, size_t>>;
+
+const size_t FrameCount = 20000;
+const size_t WordSize = sizeof(size_t);
+
+// Byte-wise splitter with the StartSequenceMatchSucc state machine, as the packetizers did before
+// FindStartSequence. Empty units are dropped like ForEachStartSequenceUnit does.
+Units referenceSplit(const binary &frame, Separator separator) {
+	Units units;
+	NalUnitStartSequenceMatch match = NUSM_noMatch;
+	size_t index = 0;
+	while (index < frame.size()) {
+		match = NalUnit::StartSequenceMatchSucc(match, frame[index++], separator);
+		if (match == NUSM_longMatch || match == NUSM_shortMatch) {
+			match = NUSM_noMatch;
+			break;
+		}
+	}
+
+	size_t naluStartIndex = index;
+	while (index < frame.size()) {
+		match = NalUnit::StartSequenceMatchSucc(match, frame[index], separator);
+		if (match == NUSM_longMatch || match == NUSM_shortMatch) {
+			size_t sequenceLength = match == NUSM_longMatch ? 4 : 3;
+			size_t naluEndIndex = index + 1 - sequenceLength;
+			match = NUSM_noMatch;
+			if (naluEndIndex > naluStartIndex)
+				units.emplace_back(naluStartIndex, naluEndIndex);
+
+			naluStartIndex = index + 1;
+		}
+		index++;
+	}
+	if (frame.size() > naluStartIndex)
+		units.emplace_back(naluStartIndex, frame.size());
+
+	return units;
+}
+
+Units split(const binary &frame, Separator separator) {
+	Units units;
+	NalUnit::ForEachStartSequenceUnit(frame, separator,
+	                                  [&](size_t begin, size_t end) { units.emplace_back(begin, end); });
+	return units;
+}
+
+// Generates Annex-B frames of random NAL units, with start sequences at every alignment
+class Corpus {
+public:
+	explicit Corpus(unsigned seed) : mGenerator(seed) {}
+
+	// Returns the frame and the number of NAL units it holds
+	pair<binary, size_t> frame() {
+		binary frame;
+
+		// Leading garbage moves the whole frame relative to words
+		for (size_t i = random(0, 2); i > 0; --i)
+			frame.push_back(byte(0));
+
+		// Parameter sets sometimes, then one or several slices
+		size_t count = 0;
+		if (random(0, 3) == 0) {
+			append(frame, 0x67, random(4, 30));
+			append(frame, 0x68, random(2, 8));
+			count += 2;
+		}
+		for (size_t i = random(1, 12); i > 0; --i) {
+			// Mostly small units, so start sequences fall at any offset within a word, and a few
+			// large ones so the word-at-a-time path runs over long stretches
+			size_t size = random(0, 9) == 0 ? random(500, 3000) : random(1, 40);
+			append(frame, random(0, 1) ? 0x65 : 0x41, size);
+			++count;
+		}
+		return {std::move(frame), count};
+	}
+
+	// Offsets of the 3-byte start sequences of the last frame, modulo the word size
+	const vector<size_t> &shortOffsets() const { return mShortOffsets; }
+	const vector<size_t> &longOffsets() const { return mLongOffsets; }
+
+private:
+	size_t random(size_t min, size_t max) {
+		return uniform_int_distribution<size_t>(min, max)(mGenerator);
+	}
+
+	// Slice data with a high density of zeros, emulation prevention applied as an encoder does
+	void append(binary &frame, uint8_t header, size_t size) {
+		if (random(0, 1)) {
+			mLongOffsets.push_back(frame.size() % WordSize);
+			frame.push_back(byte(0));
+		} else {
+			mShortOffsets.push_back(frame.size() % WordSize);
+		}
+		frame.insert(frame.end(), {byte(0), byte(0), byte(1), byte(header)});
+
+		size_t zeros = 0;
+		for (size_t i = 0; i < size; ++i) {
+			auto value = random(0, 2) == 0 ? uint8_t(0) : uint8_t(random(0, 255));
+			if (i == size - 1 && value == 0)
+				value = 0x80; // rbsp_stop_one_bit
+
+			if (zeros >= 2 && value <= 3) {
+				frame.push_back(byte(3)); // emulation_prevention_three_byte
+				zeros = 0;
+			}
+			frame.push_back(byte(value));
+			zeros = value == 0 ? zeros + 1 : 0;
+		}
+
+		// trailing_zero_8bits
+		if (random(0, 3) == 0)
+			for (size_t i = random(1, 3); i > 0; --i)
+				frame.push_back(byte(0));
+	}
+
+	mt19937 mGenerator;
+	vector<size_t> mShortOffsets;
+	vector<size_t> mLongOffsets;
+};
+
+bool coversAllOffsets(const vector<size_t> &offsets) {
+	vector<bool> seen(WordSize, false);
+	for (size_t offset : offsets)
+		seen[offset] = true;
+
+	for (bool s : seen)
+		if (!s)
+			return false;
+
+	return true;
+}
+
+void testCorpus() {
+	Corpus corpus(42);
+	for (size_t i = 0; i < FrameCount; ++i) {
+		auto [frame, count] = corpus.frame();
+		for (auto separator :
+		     {Separator::StartSequence, Separator::LongStartSequence, Separator::ShortStartSequence})
+			check(split(frame, separator) == referenceSplit(frame, separator),
+			      "Split differs from the byte-wise splitter in frame " + to_string(i));
+
+		// Emulation prevention keeps start sequences out of the units, so every unit is found
+		check(split(frame, Separator::StartSequence).size() == count,
+		      "Wrong unit count in frame " + to_string(i));
+	}
+
+	check(coversAllOffsets(corpus.shortOffsets()) && coversAllOffsets(corpus.longOffsets()),
+	      "Start sequences do not straddle every word offset");
+}
+
+void testEdges() {
+	auto bytes = [](initializer_list<uint8_t> values) {
+		binary result;
+		for (auto v : values)
+			result.push_back(byte(v));
+		return result;
+	};
+
+	// No start sequence, only a start sequence, start sequence at the very end
+	for (auto frame : {binary{}, bytes({0, 0}), bytes({0, 0, 1}), bytes({0, 0, 0, 1}),
+	                   bytes({0, 0, 1, 0x65, 0, 0, 1}), bytes({0, 0, 0, 0, 0, 0})})
+		for (auto separator :
+		     {Separator::StartSequence, Separator::LongStartSequence, Separator::ShortStartSequence})
+			check(split(frame, separator) == referenceSplit(frame, separator),
+			      "Split differs from the byte-wise splitter on an edge case");
+
+	// 00 00 03 never matches, whatever follows
+	auto escaped = bytes({0, 0, 1, 0x41, 0, 0, 3, 1, 0, 0, 3, 0, 0, 3, 0x80});
+	check(split(escaped, Separator::StartSequence) == Units{{3, escaped.size()}},
+	      "Emulation prevention sequence was taken for a start sequence");
+}
+
+} // namespace
+
+void test_nalunit_start_sequence() {
+	testEdges();
+	testCorpus();
+}
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/pollservice.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+using impl::PollService;
+using Event = PollService::Event;
+
+namespace {
+
+struct SocketPair {
+	SocketPair() {
+		int fds[2];
+		check(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "socketpair failed");
+		polled = fds[0];
+		peer = fds[1];
+	}
+	~SocketPair() {
+		PollService::Instance().remove(polled);
+		::close(polled);
+		::close(peer);
+	}
+
+	void send() const { check(::write(peer, "x", 1) == 1, "write failed"); }
+	void receive() const {
+		char c;
+		::read(polled, &c, 1);
+	}
+
+	int polled;
+	int peer;
+};
+
+// Events received by numbered callbacks, in order
+class Recorder {
+public:
+	void record(int id, Event event) {
+		std::lock_guard lock(mMutex);
+		mEvents.emplace_back(id, event);
+		mCondition.notify_all();
+	}
+
+	bool waitFor(size_t count, chrono::milliseconds timeout = 2s) {
+		std::unique_lock lock(mMutex);
+		return mCondition.wait_for(lock, timeout, [&]() { return mEvents.size() >= count; });
+	}
+
+	vector<pair<int, Event>> events() {
+		std::lock_guard lock(mMutex);
+		return mEvents;
+	}
+
+private:
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	vector<pair<int, Event>> mEvents;
+};
+
+PollService::Params readParams(const SocketPair &pair, Recorder &recorder, int id,
+                               optional<PollService::clock::duration> timeout = nullopt) {
+	return {PollService::Direction::In, timeout, [&pair, &recorder, id](Event event) {
+		        if (event == Event::In)
+			        pair.receive();
+
+		        recorder.record(id, event);
+	        }};
+}
+
+void testRestore() {
+	// The callback is handed back to its entry after each event
+	SocketPair pair;
+	Recorder recorder;
+	PollService::Instance().add(pair.polled, readParams(pair, recorder, 1));
+	for (size_t i = 1; i <= 3; ++i) {
+		pair.send();
+		check(recorder.waitFor(i), "Callback was not restored after an event");
+	}
+	for (auto [id, event] : recorder.events())
+		check(id == 1 && event == Event::In, "Wrong event");
+}
+
+void testAddedFromCallback() {
+	// A callback adding its socket again, like TcpTransport::setPoll(), must not be overwritten by
+	// the callback being handed back
+	SocketPair pair;
+	Recorder recorder;
+	PollService::Instance().add(pair.polled, {PollService::Direction::In, nullopt, [&](Event) {
+		                                          pair.receive();
+		                                          recorder.record(1, Event::In);
+		                                          PollService::Instance().add(
+		                                              pair.polled, readParams(pair, recorder, 2));
+	                                          }});
+	pair.send();
+	check(recorder.waitFor(1), "First callback was not called");
+	pair.send();
+	check(recorder.waitFor(2), "Second callback was not called");
+	pair.send();
+	check(recorder.waitFor(3), "Second callback was not restored");
+	auto events = recorder.events();
+	check(events[1].first == 2 && events[2].first == 2,
+	      "Callback replaced from itself was restored over its replacement");
+}
+
+void testAddedConcurrently() {
+	// The same from another thread while the callback runs without the lock
+	SocketPair pair;
+	Recorder recorder;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool running = false, replaced = false;
+	PollService::Instance().add(pair.polled, {PollService::Direction::In, nullopt, [&](Event) {
+		                                          pair.receive();
+		                                          std::unique_lock lock(mutex);
+		                                          running = true;
+		                                          condition.notify_all();
+		                                          condition.wait(lock, [&]() { return replaced; });
+		                                          recorder.record(1, Event::In);
+	                                          }});
+	pair.send();
+	{
+		std::unique_lock lock(mutex);
+		condition.wait(lock, [&]() { return running; });
+		PollService::Instance().add(pair.polled, readParams(pair, recorder, 2));
+		replaced = true;
+		condition.notify_all();
+	}
+	check(recorder.waitFor(1), "First callback did not return");
+	pair.send();
+	check(recorder.waitFor(2), "Second callback was not called");
+	check(recorder.events()[1].first == 2,
+	      "Callback replaced while running was restored over its replacement");
+}
+
+void testRemovedFromCallback() {
+	// A removed socket gets no more events, and its callback is not handed back to a new entry
+	SocketPair pair;
+	Recorder recorder;
+	PollService::Instance().add(pair.polled, {PollService::Direction::In, nullopt, [&](Event) {
+		                                          pair.receive();
+		                                          recorder.record(1, Event::In);
+		                                          PollService::Instance().remove(pair.polled);
+	                                          }});
+	pair.send();
+	check(recorder.waitFor(1), "Callback was not called");
+	pair.send();
+	check(!recorder.waitFor(2, 100ms), "Removed socket got an event");
+
+	PollService::Instance().add(pair.polled, readParams(pair, recorder, 2));
+	check(recorder.waitFor(2), "Socket added again got no event");
+	check(recorder.events()[1].first == 2, "Removed callback was called");
+}
+
+void testTimeouts() {
+	// An idle socket times out and is removed, activity pushes the deadline back
+	SocketPair idle, active;
+	Recorder idleRecorder, activeRecorder;
+	auto start = PollService::clock::now();
+	PollService::Instance().add(idle.polled, readParams(idle, idleRecorder, 1, 50ms));
+	PollService::Instance().add(active.polled, readParams(active, activeRecorder, 2, 200ms));
+	for (size_t i = 1; i <= 6; ++i) {
+		this_thread::sleep_for(50ms);
+		active.send();
+		check(activeRecorder.waitFor(i), "Active socket got no event");
+	}
+
+	check(idleRecorder.waitFor(1), "Idle socket did not time out");
+	check(idleRecorder.events()[0].second == Event::Timeout, "Idle socket got a wrong event");
+	for (auto [id, event] : activeRecorder.events())
+		check(event == Event::In, "Active socket timed out");
+
+	check(activeRecorder.waitFor(7), "Active socket did not time out once idle");
+	check(activeRecorder.events()[6].second == Event::Timeout, "Active socket got a wrong event");
+	check(PollService::clock::now() - start >= 500ms, "Active socket timed out early");
+
+	idle.send();
+	check(!idleRecorder.waitFor(2, 100ms), "Timed out socket got an event");
+}
+
+void testRemovedTimeouts() {
+	// Timeouts of removed sockets do not pile up in the heap under connection churn
+	SocketPair pair;
+	Recorder recorder;
+	for (int i = 0; i < 10000; ++i) {
+		PollService::Instance().add(pair.polled, readParams(pair, recorder, 1, 30s));
+		PollService::Instance().remove(pair.polled);
+	}
+	check(PollService::Instance().pendingTimeouts() < 1000, "Timeouts of removed sockets are kept");
+}
+
+} // namespace
+
+void test_poll_service() {
+	PollService::Instance().start();
+	try {
+		testRestore();
+		testAddedFromCallback();
+		testAddedConcurrently();
+		testRemovedFromCallback();
+		testTimeouts();
+		testRemovedTimeouts();
+	} catch (...) {
+		PollService::Instance().join();
+		throw;
+	}
+	PollService::Instance().join();
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/reactor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace rtc;
+using namespace std;
+using namespace chrono_literals;
+
+using impl::Reactor;
+
+namespace {
+
+// Values pushed by callbacks on the reactor thread
+class Recorder {
+public:
+	void record(int value) {
+		std::lock_guard lock(mMutex);
+		mValues.push_back(value);
+		mCondition.notify_all();
+	}
+
+	bool waitFor(size_t count, chrono::milliseconds timeout = 2s) {
+		std::unique_lock lock(mMutex);
+		return mCondition.wait_for(lock, timeout, [&]() { return mValues.size() >= count; });
+	}
+
+	vector<int> values() {
+		std::lock_guard lock(mMutex);
+		return mValues;
+	}
+
+private:
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	vector<int> mValues;
+};
+
+void testTimers() {
+	// Timers fire in order and never early, including past a wheel revolution, cancelled ones don't
+	auto &reactor = Reactor::Instance();
+	Recorder recorder;
+	auto start = Reactor::clock::now();
+	vector<chrono::milliseconds> delays = {600ms, 5ms, 40ms, 20ms, 300ms};
+	vector<Reactor::clock::time_point> fired(delays.size());
+	for (size_t i = 0; i < delays.size(); ++i)
+		reactor.schedule(start + delays[i], [&, i]() {
+			fired[i] = Reactor::clock::now();
+			recorder.record(int(i));
+		});
+
+	auto cancelled = reactor.schedule(start + 10ms, [&]() { recorder.record(-1); });
+	auto farCancelled = reactor.schedule(start + 700ms, [&]() { recorder.record(-2); });
+	reactor.cancel(cancelled);
+	reactor.cancel(farCancelled);
+
+	check(recorder.waitFor(delays.size()), "Timers did not fire");
+	check(recorder.values() == vector<int>({1, 3, 2, 4, 0}), "Timers fired out of order");
+	for (size_t i = 0; i < delays.size(); ++i)
+		check(fired[i] >= start + delays[i], "Timer fired early");
+
+	this_thread::sleep_for(150ms);
+	check(recorder.values().size() == delays.size(), "Cancelled timer fired");
+	check(reactor.pendingTimers() == 0, "Timers are left pending");
+}
+
+void testSockets() {
+	// The callback is called while the socket is readable, and not anymore once removed
+	auto &reactor = Reactor::Instance();
+	int fds[2];
+	check(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "socketpair failed");
+	Recorder recorder;
+	reactor.add(fds[0], [&]() {
+		char c;
+		if (::read(fds[0], &c, 1) == 1)
+			recorder.record(c);
+	});
+
+	for (char c = 'a'; c <= 'c'; ++c) {
+		check(::write(fds[1], &c, 1) == 1, "write failed");
+		check(recorder.waitFor(size_t(c - 'a' + 1)), "Socket callback was not called");
+	}
+	check(recorder.values() == vector<int>({'a', 'b', 'c'}), "Wrong data read");
+
+	reactor.remove(fds[0]);
+	check(::write(fds[1], "d", 1) == 1, "write failed");
+	check(!recorder.waitFor(4, 100ms), "Removed socket callback was called");
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+} // namespace
+
+void test_reactor() {
+	auto &reactor = Reactor::Instance();
+	reactor.enable();
+	reactor.start();
+	try {
+		testTimers();
+		testSockets();
+	} catch (...) {
+		reactor.join();
+		reactor.enable(false);
+		throw;
+	}
+	reactor.join();
+	reactor.enable(false);
+}
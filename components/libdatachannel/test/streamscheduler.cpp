@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "impl/streamscheduler.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+using impl::StreamScheduler;
+
+namespace {
+
+const size_t MessageSize = 1200;
+
+// Binary message carrying its sequence number within the stream, sized like an SCTP payload
+message_ptr message(uint16_t stream, uint32_t sequence, size_t size = MessageSize) {
+	auto m = make_message(max(size, sizeof(sequence)), Message::Binary, stream);
+	std::memcpy(m->data(), &sequence, sizeof(sequence));
+	return m;
+}
+
+uint32_t sequenceOf(const message_ptr &m) {
+	uint32_t sequence;
+	std::memcpy(&sequence, m->data(), sizeof(sequence));
+	return sequence;
+}
+
+// Pops a message after checking that peek() announced it
+message_ptr pop(StreamScheduler &scheduler) {
+	auto next = scheduler.peek();
+	check(next.has_value(), "Scheduler is empty");
+	check(scheduler.peek() == next, "peek() is not stable");
+	auto popped = scheduler.pop();
+	check(popped == next, "pop() returned another message than peek()");
+	return *popped;
+}
+
+void testStrictPriority() {
+	StreamScheduler scheduler(message_size_func);
+	scheduler.setPriority(1, 512);
+	scheduler.setPriority(2, 256);
+	scheduler.setPriority(3, 128, 100); // A large weight does not outrank a priority
+	for (uint32_t i = 0; i < 10; ++i) {
+		scheduler.push(message(3, i));
+		scheduler.push(message(2, i));
+		scheduler.push(message(1, i));
+	}
+
+	for (uint16_t stream : {1, 2, 3})
+		for (uint32_t i = 0; i < 10; ++i) {
+			auto m = pop(scheduler);
+			check(m->stream == stream, "Lower priority stream served first");
+
+			// Higher priority messages arriving meanwhile go first
+			if (stream == 2 && i == 4) {
+				scheduler.push(message(1, 10));
+				check(pop(scheduler)->stream == 1, "New higher priority message was not first");
+			}
+		}
+
+	check(scheduler.empty() && scheduler.amount() == 0, "Scheduler is not empty");
+}
+
+void testWeights() {
+	StreamScheduler scheduler(message_size_func);
+	scheduler.setPriority(1, 256, 3);
+	scheduler.setPriority(2, 256, 1);
+
+	// Both streams stay backlogged over many rounds
+	const size_t Count = 2000;
+	for (uint32_t i = 0; i < Count; ++i) {
+		scheduler.push(message(1, i));
+		scheduler.push(message(2, i));
+	}
+
+	map<unsigned int, size_t> bytes;
+	const size_t Total = 40 * StreamScheduler::Quantum;
+	size_t sent = 0;
+	while (sent < Total) {
+		auto m = pop(scheduler);
+		bytes[m->stream] += m->size();
+		sent += m->size();
+	}
+
+	double ratio = double(bytes[1]) / double(bytes[2]);
+	cout << "Weights 3:1, " << bytes[1] << " and " << bytes[2] << " bytes sent, ratio " << ratio
+	     << endl;
+	check(ratio > 2.8 && ratio < 3.2, "Bytes are not shared according to the weights");
+
+	// Changing the weight takes effect on the next rounds
+	scheduler.setPriority(1, 256, 1);
+	bytes.clear();
+	sent = 0;
+	while (sent < Total) {
+		auto m = pop(scheduler);
+		bytes[m->stream] += m->size();
+		sent += m->size();
+	}
+	ratio = double(bytes[1]) / double(bytes[2]);
+	check(ratio > 0.9 && ratio < 1.1, "Bytes are not shared equally after a weight change");
+}
+
+void testStreamOrder() {
+	StreamScheduler scheduler(message_size_func);
+	mt19937 generator(42);
+	uniform_int_distribution<int> streamDistribution(0, 7);
+	uniform_int_distribution<size_t> sizeDistribution(1, 64 * 1024);
+	for (uint16_t stream = 0; stream < 8; ++stream)
+		scheduler.setPriority(stream, stream % 2 ? 256 : 512, 1 + stream % 3);
+
+	// Pushes and pops are interleaved, so streams keep entering and leaving rounds
+	map<unsigned int, uint32_t> pushed, popped;
+	size_t pushedAmount = 0;
+	for (int i = 0; i < 20000; ++i) {
+		if (generator() % 3 != 0) {
+			uint16_t stream = uint16_t(streamDistribution(generator));
+			auto m = message(stream, pushed[stream]++, sizeDistribution(generator));
+			pushedAmount += m->size();
+			scheduler.push(m);
+		} else if (!scheduler.empty()) {
+			auto m = pop(scheduler);
+			check(sequenceOf(m) == popped[m->stream]++, "Messages of a stream are out of order");
+			pushedAmount -= m->size();
+		}
+		check(scheduler.amount() == pushedAmount, "Wrong buffered amount");
+	}
+	while (!scheduler.empty()) {
+		auto m = pop(scheduler);
+		check(sequenceOf(m) == popped[m->stream]++, "Messages of a stream are out of order");
+	}
+
+	check(pushed == popped, "Messages were lost");
+	check(scheduler.size() == 0 && scheduler.amount() == 0, "Scheduler is not empty");
+}
+
+void testReset() {
+	StreamScheduler scheduler(message_size_func);
+
+	// The reset of a closing channel follows its pending data, even though it has no size
+	scheduler.setPriority(1, 256);
+	scheduler.setPriority(2, 256);
+	for (uint32_t i = 0; i < 40; ++i)
+		scheduler.push(message(1, i));
+	scheduler.push(make_message(0, Message::Reset, 1));
+	for (uint32_t i = 0; i < 40; ++i)
+		scheduler.push(message(2, i));
+
+	uint32_t sent = 0;
+	bool reset = false;
+	while (!scheduler.empty()) {
+		auto m = pop(scheduler);
+		if (m->stream != 1)
+			continue;
+
+		if (m->type == Message::Reset) {
+			check(sent == 40, "Reset overtook the data of its stream");
+			reset = true;
+		} else {
+			check(!reset, "Data sent after the reset of its stream");
+			++sent;
+		}
+	}
+	check(reset, "Reset was not sent");
+
+	// A reset of an idle stream is not held back by other streams of its priority
+	for (uint32_t i = 0; i < 40; ++i)
+		scheduler.push(message(2, i));
+	pop(scheduler);
+	scheduler.push(make_message(0, Message::Reset, 1));
+	size_t before = 0;
+	while (pop(scheduler)->type != Message::Reset)
+		++before;
+	check(before * MessageSize <= StreamScheduler::Quantum, "Reset waited for more than a round");
+
+	// The stream can be reopened afterwards
+	while (!scheduler.empty())
+		pop(scheduler);
+	scheduler.setPriority(1, 512);
+	scheduler.push(message(2, 0));
+	scheduler.push(message(1, 0));
+	check(pop(scheduler)->stream == 1, "Reopened stream lost its new priority");
+
+	// Once stopped, nothing is accepted but pending messages still go out
+	scheduler.stop();
+	scheduler.push(message(1, 1));
+	check(scheduler.size() == 1 && scheduler.running(), "Scheduler stopped with pending messages");
+	pop(scheduler);
+	check(!scheduler.running(), "Stopped scheduler is still running");
+}
+
+} // namespace
+
+void test_stream_scheduler() {
+	testStrictPriority();
+	testWeights();
+	testStreamOrder();
+	testReset();
+}
@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/h264rtppacketizer.hpp"
+#include "rtc/rtp.hpp"
+#include "rtc/temporallayerselector.hpp"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+const uint8_t DependencyDescriptorId = 5;
+const size_t Frames = 240;
+const size_t KeyframeInterval = 60;
+
+// L1T3 pattern: 0 2 1 2 0 2 1 2 ...
+uint8_t layerOf(size_t frame) { return frame % 4 == 0 ? 0 : (frame % 2 == 0 ? 1 : 2); }
+
+class BitReader {
+public:
+	BitReader(const byte *data, size_t size) : mData(data), mSize(size * 8) {}
+
+	uint32_t read(size_t bits) {
+		uint32_t v = 0;
+		for (size_t i = 0; i < bits; ++i, ++mOffset) {
+			check(mOffset < mSize, "Dependency descriptor is truncated");
+			v = (v << 1) | ((std::to_integer<uint8_t>(mData[mOffset / 8]) >> (7 - mOffset % 8)) & 1);
+		}
+		return v;
+	}
+
+	// ns(n) of the AV1 specification
+	uint32_t readNonSymmetric(uint32_t n) {
+		size_t w = 0;
+		for (uint32_t x = n; x != 0; x >>= 1)
+			++w;
+		uint32_t m = (1u << w) - n;
+		uint32_t v = read(w - 1);
+		return v < m ? v : ((v << 1) | read(1)) - m;
+	}
+
+private:
+	const byte *mData;
+	size_t mSize;
+	size_t mOffset = 0;
+};
+
+// Receiver side of the dependency descriptor, as a browser decodes it
+class DescriptorReader {
+public:
+	struct Frame {
+		bool start;
+		uint16_t number;
+		int temporalId;
+		vector<int> frameDiffs;
+		optional<uint32_t> activeDecodeTargets;
+	};
+
+	Frame read(const byte *data, size_t size) {
+		BitReader r(data, size);
+		Frame frame;
+		frame.start = r.read(1);
+		r.read(1); // end_of_frame
+		uint32_t templateId = r.read(6);
+		frame.number = uint16_t(r.read(16));
+
+		bool customDtis = false, customFdiffs = false, customChains = false;
+		if (size > 3) {
+			bool structurePresent = r.read(1);
+			bool activeDecodeTargetsPresent = r.read(1);
+			customDtis = r.read(1);
+			customFdiffs = r.read(1);
+			customChains = r.read(1);
+			if (structurePresent) {
+				// A new structure makes every decode target active again
+				readStructure(r);
+				frame.activeDecodeTargets = (1u << mDecodeTargets) - 1;
+			}
+			if (activeDecodeTargetsPresent)
+				frame.activeDecodeTargets = r.read(mDecodeTargets);
+		}
+		check(!mTemplates.empty(), "Dependency descriptor before any structure");
+
+		size_t index = (templateId + 64 - mTemplateIdOffset) % 64;
+		check(index < mTemplates.size(), "Unknown template");
+		frame.temporalId = mTemplates[index].temporalId;
+		frame.frameDiffs = mTemplates[index].frameDiffs;
+		if (customDtis)
+			r.read(2 * mDecodeTargets);
+		if (customFdiffs) {
+			frame.frameDiffs.clear();
+			while (uint32_t length = r.read(2))
+				frame.frameDiffs.push_back(int(r.read(4 * length)) + 1);
+		}
+		if (customChains)
+			r.read(8 * mChains);
+
+		return frame;
+	}
+
+private:
+	struct Template {
+		int temporalId;
+		vector<int> frameDiffs;
+	};
+
+	void readStructure(BitReader &r) {
+		mTemplateIdOffset = r.read(6);
+		mDecodeTargets = r.read(5) + 1;
+
+		mTemplates = {{0, {}}};
+		int spatialId = 0;
+		while (true) {
+			uint32_t idc = r.read(2); // next_layer_idc
+			if (idc == 3)
+				break;
+			int temporalId = mTemplates.back().temporalId;
+			if (idc == 1)
+				++temporalId;
+			if (idc == 2) {
+				++spatialId;
+				temporalId = 0;
+			}
+			mTemplates.push_back({temporalId, {}});
+		}
+
+		for (size_t i = 0; i < mTemplates.size(); ++i)
+			r.read(2 * mDecodeTargets); // template_dtis
+		for (auto &t : mTemplates)
+			while (r.read(1))
+				t.frameDiffs.push_back(int(r.read(4)) + 1);
+
+		mChains = r.readNonSymmetric(mDecodeTargets + 1);
+		if (mChains > 0) {
+			for (uint32_t i = 0; i < mDecodeTargets; ++i)
+				r.readNonSymmetric(mChains);
+			r.read(4 * mChains * uint32_t(mTemplates.size()));
+		}
+		if (r.read(1)) // render_resolutions
+			r.read(32 * (spatialId + 1));
+	}
+
+	uint32_t mTemplateIdOffset = 0;
+	uint32_t mDecodeTargets = 0;
+	uint32_t mChains = 0;
+	vector<Template> mTemplates;
+};
+
+// One viewer: its selector and packetizer, and what it received
+class Viewer {
+public:
+	Viewer() {
+		mConfig = make_shared<RtpPacketizationConfig>(0x1234, "cname", 96,
+		                                               H264RtpPacketizer::ClockRate);
+		mConfig->dependencyDescriptorId = DependencyDescriptorId;
+		mConfig->dependencyDescriptorContext.emplace(DependencyDescriptorContext::TemporalLayers(3));
+		mSelector = make_shared<TemporalLayerSelector>(mConfig);
+		mSelector->addToChain(make_shared<H264RtpPacketizer>(NalUnit::Separator::LongStartSequence,
+		                                                    mConfig, 1200));
+	}
+
+	void setMaxTemporalLayer(uint8_t layer) { mSelector->setMaxTemporalLayer(layer); }
+
+	void send(size_t index) {
+		uint8_t maxLayer = mSelector->maxTemporalLayer();
+		bool keyframe = index % KeyframeInterval == 0;
+		FrameInfo info(uint32_t(index * 3000));
+		info.isKeyframe = keyframe;
+		info.temporalLayer = keyframe ? 0 : layerOf(index);
+		info.frameNumber = uint32_t(index);
+
+		// Frames of a few packets so that some have no descriptor structure
+		binary frame = {byte(0), byte(0), byte(0), byte(1), byte(keyframe ? 0x65 : 0x41)};
+		frame.resize(frame.size() + 3000, byte(0x55));
+		message_vector messages{make_message(std::move(frame), info)};
+		mSelector->outgoingChain(messages, [](message_ptr) {});
+
+		if (info.temporalLayer <= maxLayer)
+			++mExpectedFrames;
+
+		for (const auto &packet : messages)
+			receive(packet, maxLayer);
+	}
+
+	void checkReceived(const string &name) {
+		cout << name << ": " << mDelivered.size() << " frames, " << mPackets << " packets" << endl;
+		check(mDelivered.size() == mExpectedFrames, name + ": wrong number of frames delivered");
+	}
+
+private:
+	void receive(const message_ptr &packet, uint8_t maxLayer) {
+		auto rtp = reinterpret_cast<RtpHeader *>(packet->data());
+		if (mLastSeqNumber)
+			check(rtp->seqNumber() == uint16_t(*mLastSeqNumber + 1), "Gap in sequence numbers");
+		mLastSeqNumber = rtp->seqNumber();
+		++mPackets;
+
+		size_t size = 0;
+		auto ext = rtp->extension() ? rtp->getExtensionHeader() : nullptr;
+		auto data = ext ? ext->findHeader(DependencyDescriptorId, size) : nullptr;
+		check(data != nullptr, "Packet has no dependency descriptor");
+
+		auto frame = mReader.read(data, size);
+		check(frame.temporalId <= maxLayer, "Frame above the maximum layer was sent");
+		if (frame.activeDecodeTargets)
+			mActiveDecodeTargets = *frame.activeDecodeTargets;
+		if (!frame.start)
+			return;
+
+		// Every reference was delivered and is of a lower layer, the base layer only referencing
+		// itself, so that thinning never breaks decoding. The receiver was also told which
+		// targets are decodable.
+		for (int diff : frame.frameDiffs) {
+			uint16_t reference = uint16_t(frame.number - diff);
+			auto it = mDelivered.find(reference);
+			check(it != mDelivered.end(), "Frame " + to_string(frame.number) +
+			                                  " references undelivered frame " +
+			                                  to_string(reference));
+			check(it->second < frame.temporalId || it->second == 0,
+			      "Frame " + to_string(frame.number) + " references a frame of its layer or above");
+		}
+		check(mActiveDecodeTargets == (1u << (maxLayer + 1)) - 1,
+		      "Active decode targets do not match the maximum layer");
+
+		mDelivered[frame.number] = frame.temporalId;
+	}
+
+	shared_ptr<RtpPacketizationConfig> mConfig;
+	shared_ptr<TemporalLayerSelector> mSelector;
+	DescriptorReader mReader;
+	optional<uint16_t> mLastSeqNumber;
+	map<uint16_t, int> mDelivered; // Frame number to temporal layer
+	uint32_t mActiveDecodeTargets = 0x7;
+	size_t mExpectedFrames = 0;
+	size_t mPackets = 0;
+};
+
+} // namespace
+
+void test_temporal_layers() {
+	// Viewers at a fixed maximum layer
+	for (uint8_t maxLayer = 0; maxLayer < 3; ++maxLayer) {
+		Viewer viewer;
+		viewer.setMaxTemporalLayer(maxLayer);
+		for (size_t i = 0; i < Frames; ++i)
+			viewer.send(i);
+		viewer.checkReceived("Maximum layer " + to_string(maxLayer));
+	}
+
+	// Switches in the middle of keyframe intervals and on frames of every layer
+	const map<size_t, uint8_t> switches = {{0, 2}, {37, 0}, {50, 1}, {71, 2}, {73, 0},
+	                                       {118, 2}, {130, 1}, {133, 0}, {200, 2}};
+	Viewer viewer;
+	for (size_t i = 0; i < Frames; ++i) {
+		if (auto it = switches.find(i); it != switches.end())
+			viewer.setMaxTemporalLayer(it->second);
+		viewer.send(i);
+	}
+	viewer.checkReceived("Mid-stream switches");
+}
@@ -0,0 +1,22 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef RTC_TEST_H
+#define RTC_TEST_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// Throws std::runtime_error with the message if the condition is false
+void check(bool condition, const std::string &what);
+
+// Returns the number of operator new calls made by the calling thread while func runs
+size_t countAllocations(const std::function<void()> &func);
+
+#endif
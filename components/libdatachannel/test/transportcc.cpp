@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2025 Paul-Louis Ageneau
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include "test.hpp"
+
+#include "rtc/transportcchandler.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rtc;
+using namespace std;
+
+namespace {
+
+binary bytes(const vector<uint8_t> &values) {
+	binary result;
+	for (auto v : values)
+		result.push_back(byte(v));
+	return result;
+}
+
+// Feedback written by hand after the draft, with one chunk of each kind, sequence number
+// wrap-around, a negative reference time, a negative large delta and one byte of padding
+const vector<uint8_t> ReferencePacket = {
+    0xAF, 0xCD, 0x00, 0x08, // V=2, P, FMT=15, PT=205, length 8
+    0x11, 0x22, 0x33, 0x44, // sender SSRC
+    0x55, 0x66, 0x77, 0x88, // media SSRC
+    0xFF, 0xFE, 0x00, 0x14, // base sequence number 65534, status count 20
+    0xFF, 0xFF, 0xFE, 0x07, // reference time -2 (-128 ms), feedback count 7
+    0x20, 0x03,             // run length chunk: 3 small deltas
+    0xA8, 0x01,             // one-bit vector chunk: 14 symbols, received at 0, 2 and 13
+    0xE1, 0x00,             // two-bit vector chunk: large, not received, small (4 unused)
+    0x04, 0x00, 0xFF,       // small deltas of the run
+    0x01, 0x02, 0x03,       // small deltas of the one-bit vector
+    0xFF, 0x38,             // large delta -200 (-50 ms)
+    0x10,                   // small delta
+    0x01,                   // padding
+};
+
+struct Expected {
+	uint16_t sequenceNumber;
+	bool received;
+	int64_t arrivalTimeUs;
+};
+
+const vector<Expected> ReferencePackets = {
+    {65534, true, -127000}, {65535, true, -127000}, {0, true, -63250},  {1, true, -63000},
+    {2, false, 0},          {3, true, -62500},      {4, false, 0},      {5, false, 0},
+    {6, false, 0},          {7, false, 0},          {8, false, 0},      {9, false, 0},
+    {10, false, 0},         {11, false, 0},         {12, false, 0},     {13, false, 0},
+    {14, true, -61750},     {15, true, -111750},    {16, false, 0},     {17, true, -107750},
+};
+
+void checkReference(const TransportFeedback &feedback) {
+	check(feedback.senderSsrc == 0x11223344, "Wrong sender SSRC");
+	check(feedback.mediaSsrc == 0x55667788, "Wrong media SSRC");
+	check(feedback.baseSequenceNumber == 65534, "Wrong base sequence number");
+	check(feedback.referenceTimeUs == -128000, "Wrong reference time");
+	check(feedback.feedbackCount == 7, "Wrong feedback count");
+	check(feedback.packets.size() == ReferencePackets.size(), "Wrong packet status count");
+	for (size_t i = 0; i < ReferencePackets.size(); ++i) {
+		const auto &packet = feedback.packets[i];
+		const auto &expected = ReferencePackets[i];
+		check(packet.sequenceNumber == expected.sequenceNumber, "Wrong sequence number");
+		check(packet.received == expected.received, "Wrong packet status");
+		if (expected.received)
+			check(packet.arrivalTimeUs == expected.arrivalTimeUs, "Wrong arrival time");
+	}
+}
+
+void testParse() {
+	auto packet = bytes(ReferencePacket);
+	auto feedback = TransportFeedback::Parse(packet.data(), packet.size());
+	check(feedback.has_value(), "Valid feedback is rejected");
+	checkReference(*feedback);
+
+	// Truncated packets and other RTPFB formats are rejected
+	check(!TransportFeedback::Parse(packet.data(), packet.size() - 4), "Truncated packet accepted");
+	auto truncatedDeltas = packet;
+	truncatedDeltas[3] = byte(0x07); // length 7, last small delta missing
+	check(!TransportFeedback::Parse(truncatedDeltas.data(), truncatedDeltas.size() - 4),
+	      "Packet with missing deltas accepted");
+	auto nack = packet;
+	nack[0] = byte(0xA1); // FMT=1
+	check(!TransportFeedback::Parse(nack.data(), nack.size()), "Generic NACK accepted");
+}
+
+void testRoundTrip() {
+	auto packet = bytes(ReferencePacket);
+	auto feedback = TransportFeedback::Parse(packet.data(), packet.size());
+	check(feedback.has_value(), "Valid feedback is rejected");
+
+	auto serialized = feedback->serialize();
+	auto header = reinterpret_cast<const RtcpHeader *>(serialized.data());
+	check(serialized.size() % 4 == 0, "Serialized feedback is not 32-bit aligned");
+	check(header->lengthInBytes() == serialized.size(), "Wrong serialized length");
+	check(header->payloadType() == 205 && header->reportCount() == 15, "Wrong serialized header");
+	if (header->padding())
+		check(size_t(serialized.back()) > 0 && size_t(serialized.back()) < 4, "Wrong padding");
+
+	auto reparsed = TransportFeedback::Parse(serialized.data(), serialized.size());
+	check(reparsed.has_value(), "Serialized feedback is rejected");
+	checkReference(*reparsed);
+
+	// Arrival times that are multiples of 250us survive the round trip, status count included
+	TransportFeedback generated;
+	generated.baseSequenceNumber = 100;
+	generated.referenceTimeUs = 64000 * 1000;
+	for (int i = 0; i < 50; ++i) {
+		TransportFeedback::Packet p;
+		p.sequenceNumber = uint16_t(100 + i);
+		p.received = i % 5 != 3;
+		p.arrivalTimeUs = generated.referenceTimeUs + (i % 11 == 0 ? -20000 : 0) + i * 7000;
+		generated.packets.push_back(p);
+	}
+	serialized = generated.serialize();
+	reparsed = TransportFeedback::Parse(serialized.data(), serialized.size());
+	check(reparsed.has_value(), "Serialized feedback is rejected");
+	check(reparsed->packets.size() == generated.packets.size(), "Wrong status count");
+	for (size_t i = 0; i < generated.packets.size(); ++i) {
+		const auto &p = reparsed->packets[i];
+		check(p.sequenceNumber == generated.packets[i].sequenceNumber, "Wrong sequence number");
+		check(p.received == generated.packets[i].received, "Wrong packet status");
+		if (p.received)
+			check(p.arrivalTimeUs == generated.packets[i].arrivalTimeUs, "Wrong arrival time");
+	}
+
+	// A delta beyond the 16-bit range cannot be serialized
+	generated.packets[1].arrivalTimeUs += 10000000;
+	bool thrown = false;
+	try {
+		generated.serialize();
+	} catch (const std::invalid_argument &) {
+		thrown = true;
+	}
+	check(thrown, "Out of range delta is serialized");
+}
+
+void testHandler() {
+	// Compound RTCP: an empty receiver report followed by the feedback
+	binary compound = bytes({0x80, 0xC9, 0x00, 0x01, 0x11, 0x22, 0x33, 0x44});
+	auto packet = bytes(ReferencePacket);
+	compound.insert(compound.end(), packet.begin(), packet.end());
+
+	int count = 0;
+	TransportCcHandler handler([&](const TransportFeedback &feedback) {
+		checkReference(feedback);
+		++count;
+	});
+	message_vector messages{make_message(std::move(compound), Message::Control)};
+	handler.incoming(messages, [](message_ptr) {});
+	check(count == 1, "Feedback in compound RTCP is not reported once");
+}
+
+} // namespace
+
+void test_transport_cc_feedback() {
+	testParse();
+	testRoundTrip();
+	testHandler();
+}
@@ -88,8 +88,12 @@ typedef enum juice_concurrency_mode {
 	JUICE_CONCURRENCY_MODE_POLL = 0, // Connections share a single thread
 	JUICE_CONCURRENCY_MODE_MUX,      // Connections are multiplexed on a single UDP socket
 	JUICE_CONCURRENCY_MODE_THREAD,   // Each connection runs in its own thread
+	JUICE_CONCURRENCY_MODE_USER,     // The user polls each connection from its own event loop
 } juice_concurrency_mode_t;
 
+// Called in user mode when the agent must be polled without waiting for its socket or deadline
+typedef void (*juice_cb_user_interrupt_t)(juice_agent_t *agent, void *user_ptr);
+
 typedef struct juice_config {
 	juice_concurrency_mode_t concurrency_mode;
 
@@ -108,11 +112,20 @@ typedef struct juice_config {
 	juice_cb_candidate_t cb_candidate;
 	juice_cb_gathering_done_t cb_gathering_done;
 	juice_cb_recv_t cb_recv;
+	juice_cb_user_interrupt_t cb_user_interrupt; // User mode only
 
 	void *user_ptr;
 
 } juice_config_t;
 
+// Differentiated Services counters, for datagrams sent with a non-zero DS field
+typedef struct juice_diffserv_stats {
+	unsigned int marked;   // sent with the DS field applied on the socket
+	unsigned int unmarked; // sent without, as the system refused the DS field
+	unsigned int updates;  // DS field changes on the socket
+	unsigned int failures; // DS field changes refused by the system
+} juice_diffserv_stats_t;
+
 JUICE_EXPORT juice_agent_t *juice_create(const juice_config_t *config);
 JUICE_EXPORT void juice_destroy(juice_agent_t *agent);
 
@@ -129,10 +142,20 @@ JUICE_EXPORT int juice_get_selected_candidates(juice_agent_t *agent, char *local
                                                char *remote, size_t remote_size);
 JUICE_EXPORT int juice_get_selected_addresses(juice_agent_t *agent, char *local, size_t local_size,
                                               char *remote, size_t remote_size);
+JUICE_EXPORT int juice_get_selected_rtt(juice_agent_t *agent); // milliseconds
+JUICE_EXPORT int juice_get_diffserv_stats(juice_agent_t *agent, juice_diffserv_stats_t *stats);
 JUICE_EXPORT int juice_set_local_ice_attributes(juice_agent_t *agent, const char *ufrag, const char *pwd);
 JUICE_EXPORT const char *juice_state_to_string(juice_state_t state);
 JUICE_EXPORT int juice_mux_listen(const char *bind_address, int local_port, juice_cb_mux_incoming_t cb, void *user_ptr);
 
+// User concurrency mode
+// Once candidates are gathered, the user watches the agent socket for readability and calls
+// juice_user_poll() when it is readable, when the returned delay has elapsed, or when requested
+// by cb_user_interrupt. juice_user_poll() returns the delay in milliseconds until it must be
+// called again, or a negative value if the agent is stopped or failed.
+JUICE_EXPORT int juice_user_get_socket(juice_agent_t *agent);
+JUICE_EXPORT int juice_user_poll(juice_agent_t *agent);
+
 // ICE server
 
 typedef struct juice_server juice_server_t;
@@ -102,6 +102,7 @@ juice_agent_t *agent_create(const juice_config_t *config) {
 	agent->config.cb_candidate = config->cb_candidate;
 	agent->config.cb_gathering_done = config->cb_gathering_done;
 	agent->config.cb_recv = config->cb_recv;
+	agent->config.cb_user_interrupt = config->cb_user_interrupt;
 	agent->config.user_ptr = config->user_ptr;
 	if (alloc_failed) {
 		JLOG_FATAL("Memory allocation for configuration copy failed");
@@ -745,6 +746,22 @@ int agent_get_selected_candidate_pair(juice_agent_t *agent, ice_candidate_t *loc
 	return 0;
 }
 
+timediff_t agent_get_selected_rtt(juice_agent_t *agent) {
+	conn_lock(agent);
+	agent_stun_entry_t *entry = atomic_load(&agent->selected_entry);
+	timediff_t rtt = entry ? entry->rtt : 0;
+	conn_unlock(agent);
+	return rtt;
+}
+
+void agent_get_diffserv_stats(juice_agent_t *agent, juice_diffserv_stats_t *stats) {
+	const conn_diffserv_stats_t *counters = &agent->diffserv_stats;
+	stats->marked = atomic_load(&counters->marked);
+	stats->unmarked = atomic_load(&counters->unmarked);
+	stats->updates = atomic_load(&counters->updates);
+	stats->failures = atomic_load(&counters->failures);
+}
+
 int agent_conn_update(juice_agent_t *agent, timestamp_t *next_timestamp) {
 	return agent_bookkeeping(agent, next_timestamp);
 }
@@ -1430,6 +1447,19 @@ int agent_process_stun_binding(juice_agent_t *agent, const stun_message_t *msg,
 		JLOG_DEBUG("Received STUN Binding success response from %s",
 		           entry->type == AGENT_STUN_ENTRY_TYPE_CHECK ? "peer" : "server");
 
+		// A response to a retransmitted request is ambiguous, only time the others
+		if (entry->timed_request_transmissions == 1 &&
+		    memcmp(entry->timed_transaction_id, msg->transaction_id, STUN_TRANSACTION_ID_SIZE) ==
+		        0) {
+			timediff_t sample = current_timestamp() - entry->timed_request_timestamp;
+			if (sample < 1)
+				sample = 1;
+			entry->rtt = entry->rtt > 0 ? (7 * entry->rtt + sample) / 8 : sample;
+			entry->timed_request_transmissions = 0;
+			JLOG_VERBOSE("STUN round-trip time is %d ms, smoothed %d ms", (int)sample,
+			             (int)entry->rtt);
+		}
+
 		if (entry->type == AGENT_STUN_ENTRY_TYPE_SERVER)
 			JLOG_INFO("STUN server binding successful");
 
@@ -1667,6 +1697,16 @@ int agent_send_stun_binding(juice_agent_t *agent, agent_stun_entry_t *entry, stu
 		return -1;
 	}
 
+	if (msg_class == STUN_CLASS_REQUEST) {
+		// Retransmissions keep the transaction ID, a new ID starts a new timed request
+		if (memcmp(entry->timed_transaction_id, msg.transaction_id, STUN_TRANSACTION_ID_SIZE) != 0) {
+			memcpy(entry->timed_transaction_id, msg.transaction_id, STUN_TRANSACTION_ID_SIZE);
+			entry->timed_request_transmissions = 0;
+		}
+		if (entry->timed_request_transmissions++ == 0)
+			entry->timed_request_timestamp = current_timestamp();
+	}
+
 	if (entry->relay_entry) {
 		// The datagram must be sent through the relay
 		JLOG_DEBUG("Sending STUN message via relay");
@@ -115,6 +115,12 @@ typedef struct agent_stun_entry {
 	int retransmissions;
 	bool transaction_id_expired;
 
+	// Round-trip time, sampled from responses to requests sent only once (Karn's algorithm)
+	uint8_t timed_transaction_id[STUN_TRANSACTION_ID_SIZE];
+	timestamp_t timed_request_timestamp;
+	int timed_request_transmissions;
+	timediff_t rtt; // smoothed, 0 if unknown
+
 	// TURN
 	agent_turn_state_t *turn;
 	unsigned int turn_redirections;
@@ -147,6 +153,7 @@ struct juice_agent {
 	conn_registry_t *registry;
 	int conn_index;
 	void *conn_impl;
+	conn_diffserv_stats_t diffserv_stats;
 
 	thread_t resolver_thread;
 	bool resolver_thread_started;
@@ -173,6 +180,8 @@ int agent_channel_send(juice_agent_t *agent, agent_stun_entry_t *entry, const ad
 juice_state_t agent_get_state(juice_agent_t *agent);
 int agent_get_selected_candidate_pair(juice_agent_t *agent, ice_candidate_t *local,
                                       ice_candidate_t *remote);
+timediff_t agent_get_selected_rtt(juice_agent_t *agent);
+void agent_get_diffserv_stats(juice_agent_t *agent, juice_diffserv_stats_t *stats);
 
 int agent_conn_recv(juice_agent_t *agent, char *buf, size_t len, const addr_record_t *src);
 int agent_conn_update(juice_agent_t *agent, timestamp_t *next_timestamp);
@@ -11,6 +11,7 @@
 #include "conn_mux.h"
 #include "conn_poll.h"
 #include "conn_thread.h"
+#include "conn_user.h"
 #include "log.h"
 
 #include <assert.h>
@@ -18,7 +19,7 @@
 
 #define INITIAL_REGISTRY_SIZE 16
 
-#define MODE_ENTRIES_SIZE 3
+#define MODE_ENTRIES_SIZE 4
 
 static conn_mode_entry_t mode_entries[MODE_ENTRIES_SIZE] = {
     {conn_poll_registry_init, conn_poll_registry_cleanup, conn_poll_init, conn_poll_cleanup,
@@ -29,10 +30,13 @@ static conn_mode_entry_t mode_entries[MODE_ENTRIES_SIZE] = {
      conn_mux_listen, conn_mux_get_registry, conn_mux_can_release_registry, MUTEX_INITIALIZER, NULL},
     {NULL, NULL, conn_thread_init, conn_thread_cleanup,
      conn_thread_lock, conn_thread_unlock, conn_thread_interrupt, conn_thread_send, conn_thread_get_addrs,
+     NULL, NULL, NULL, MUTEX_INITIALIZER, NULL},
+    {NULL, NULL, conn_user_init, conn_user_cleanup,
+     conn_user_lock, conn_user_unlock, conn_user_interrupt, conn_user_send, conn_user_get_addrs,
      NULL, NULL, NULL, MUTEX_INITIALIZER, NULL}
 };
 
-#define MODE_ENTRIES_SIZE 3
+#define MODE_ENTRIES_SIZE 4
 
 static conn_mode_entry_t mode_entries[MODE_ENTRIES_SIZE];
 
@@ -253,6 +257,29 @@ int conn_send(juice_agent_t *agent, const addr_record_t *dst, const char *data,
 	return get_agent_mode_entry(agent)->send_func(agent, dst, data, size, ds);
 }
 
+void conn_apply_diffserv(juice_agent_t *agent, socket_t sock, int *send_ds, int ds) {
+	// Requires the send mutex of the socket to be locked
+	conn_diffserv_stats_t *stats = &agent->diffserv_stats;
+	if (*send_ds >= 0 && *send_ds != ds) {
+		JLOG_VERBOSE("Setting Differentiated Services field to 0x%X", ds);
+		atomic_store(&stats->updates, atomic_load(&stats->updates) + 1);
+		if (udp_set_diffserv(sock, ds) == 0) {
+			*send_ds = ds;
+		} else {
+			*send_ds = -1; // disable for next time
+			atomic_store(&stats->failures, atomic_load(&stats->failures) + 1);
+		}
+	}
+
+	if (ds == 0)
+		return;
+
+	if (*send_ds == ds)
+		atomic_store(&stats->marked, atomic_load(&stats->marked) + 1);
+	else
+		atomic_store(&stats->unmarked, atomic_load(&stats->unmarked) + 1);
+}
+
 int conn_get_addrs(juice_agent_t *agent, addr_record_t *records, size_t size) {
 	if (!agent->conn_impl)
 		return -1;
@@ -53,6 +53,14 @@ typedef struct conn_mode_entry {
 	conn_registry_t *registry;
 } conn_mode_entry_t;
 
+// Written under the send mutex of the socket, read without locking
+typedef struct conn_diffserv_stats {
+	atomic(unsigned int) marked;
+	atomic(unsigned int) unmarked;
+	atomic(unsigned int) updates;
+	atomic(unsigned int) failures;
+} conn_diffserv_stats_t;
+
 conn_mode_entry_t *conn_get_mode_entry(juice_concurrency_mode_t mode);
 int conn_create(juice_agent_t *agent, udp_socket_config_t *config);
 void conn_destroy(juice_agent_t *agent);
@@ -62,5 +70,6 @@ int conn_interrupt(juice_agent_t *agent);
 int conn_send(juice_agent_t *agent, const addr_record_t *dst, const char *data, size_t size,
               int ds);
 int conn_get_addrs(juice_agent_t *agent, addr_record_t *records, size_t size);
+void conn_apply_diffserv(juice_agent_t *agent, socket_t sock, int *send_ds, int ds);
 
 #endif
@@ -618,13 +618,7 @@ int conn_mux_send(juice_agent_t *agent, const addr_record_t *dst, const char *da
 
 	mutex_lock(&registry_impl->send_mutex);
 
-	if (registry_impl->send_ds >= 0 && registry_impl->send_ds != ds) {
-		JLOG_VERBOSE("Setting Differentiated Services field to 0x%X", ds);
-		if (udp_set_diffserv(registry_impl->sock, ds) == 0)
-			registry_impl->send_ds = ds;
-		else
-			registry_impl->send_ds = -1; // disable for next time
-	}
+	conn_apply_diffserv(agent, registry_impl->sock, &registry_impl->send_ds, ds);
 
 	JLOG_VERBOSE("Sending datagram, size=%d", size);
 
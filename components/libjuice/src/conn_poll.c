@@ -400,13 +400,7 @@ int conn_poll_send(juice_agent_t *agent, const addr_record_t *dst, const char *d
 
 	mutex_lock(&conn_impl->send_mutex);
 
-	if (conn_impl->send_ds >= 0 && conn_impl->send_ds != ds) {
-		JLOG_VERBOSE("Setting Differentiated Services field to 0x%X", ds);
-		if (udp_set_diffserv(conn_impl->sock, ds) == 0)
-			conn_impl->send_ds = ds;
-		else
-			conn_impl->send_ds = -1; // disable for next time
-	}
+	conn_apply_diffserv(agent, conn_impl->sock, &conn_impl->send_ds, ds);
 
 	JLOG_VERBOSE("Sending datagram, size=%d", size);
 
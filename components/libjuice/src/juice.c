@@ -9,6 +9,7 @@
 #include "juice.h"
 #include "addr.h"
 #include "agent.h"
+#include "conn_user.h"
 #include "ice.h"
 
 #ifndef NO_SERVER
@@ -102,6 +103,25 @@ JUICE_EXPORT int juice_send_diffserv(juice_agent_t *agent, const char *data, siz
 	return JUICE_ERR_FAILED;
 }
 
+JUICE_EXPORT int juice_user_get_socket(juice_agent_t *agent) {
+	if (!agent || agent->config.concurrency_mode != JUICE_CONCURRENCY_MODE_USER)
+		return JUICE_ERR_INVALID;
+
+	socket_t sock = conn_user_get_socket(agent);
+	if (sock == INVALID_SOCKET)
+		return JUICE_ERR_NOT_AVAIL;
+
+	return (int)sock;
+}
+
+JUICE_EXPORT int juice_user_poll(juice_agent_t *agent) {
+	if (!agent || agent->config.concurrency_mode != JUICE_CONCURRENCY_MODE_USER)
+		return JUICE_ERR_INVALID;
+
+	int ret = conn_user_poll(agent);
+	return ret >= 0 ? ret : JUICE_ERR_FAILED;
+}
+
 JUICE_EXPORT juice_state_t juice_get_state(juice_agent_t *agent) { return agent_get_state(agent); }
 
 JUICE_EXPORT int juice_get_selected_candidates(juice_agent_t *agent, char *local, size_t local_size,
@@ -140,6 +160,25 @@ JUICE_EXPORT int juice_get_selected_addresses(juice_agent_t *agent, char *local,
 	return JUICE_ERR_SUCCESS;
 }
 
+JUICE_EXPORT int juice_get_selected_rtt(juice_agent_t *agent) {
+	if (!agent)
+		return JUICE_ERR_INVALID;
+
+	timediff_t rtt = agent_get_selected_rtt(agent);
+	if (rtt <= 0)
+		return JUICE_ERR_NOT_AVAIL;
+
+	return (int)rtt;
+}
+
+JUICE_EXPORT int juice_get_diffserv_stats(juice_agent_t *agent, juice_diffserv_stats_t *stats) {
+	if (!agent || !stats)
+		return JUICE_ERR_INVALID;
+
+	agent_get_diffserv_stats(agent, stats);
+	return JUICE_ERR_SUCCESS;
+}
+
 int juice_set_local_ice_attributes(juice_agent_t *agent, const char *ufrag, const char *pwd)
 {
 	if (!ufrag || !pwd)
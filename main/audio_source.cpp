@@ -0,0 +1,246 @@
+/**
+ * AudioSource Implementations
+ */
+
+#include "audio_source.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+
+static const char* TAG = "AudioSource";
+
+//=============================================================================
+// I2S Microphone
+//=============================================================================
+
+I2sAudioSource::I2sAudioSource(gpio_num_t bclk, gpio_num_t ws, gpio_num_t din)
+    : bclk_(bclk), ws_(ws), din_(din), rx_channel_(nullptr), sample_rate_(0) {}
+
+I2sAudioSource::~I2sAudioSource() {
+    stop();
+}
+
+bool I2sAudioSource::start(uint32_t sample_rate) {
+    sample_rate_ = sample_rate;
+
+    i2s_chan_config_t chan_config = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_AUTO, I2S_ROLE_MASTER);
+    chan_config.dma_desc_num = DMA_DESC_NUM;
+    chan_config.dma_frame_num = DMA_FRAME_NUM;
+    esp_err_t ret = i2s_new_channel(&chan_config, nullptr, &rx_channel_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create I2S channel: %s", esp_err_to_name(ret));
+        rx_channel_ = nullptr;
+        return false;
+    }
+
+    i2s_std_config_t std_config = {
+        .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(sample_rate),
+        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_32BIT, I2S_SLOT_MODE_MONO),
+        .gpio_cfg = {
+            .mclk = I2S_GPIO_UNUSED,
+            .bclk = bclk_,
+            .ws = ws_,
+            .dout = I2S_GPIO_UNUSED,
+            .din = din_,
+            .invert_flags = {
+                .mclk_inv = false,
+                .bclk_inv = false,
+                .ws_inv = false,
+            },
+        },
+    };
+    std_config.slot_cfg.slot_mask = I2S_STD_SLOT_LEFT;
+
+    ret = i2s_channel_init_std_mode(rx_channel_, &std_config);
+    if (ret == ESP_OK) {
+        ret = i2s_channel_enable(rx_channel_);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start I2S capture: %s", esp_err_to_name(ret));
+        i2s_del_channel(rx_channel_);
+        rx_channel_ = nullptr;
+        return false;
+    }
+
+    ESP_LOGI(TAG, "I2S microphone started: %u Hz (BCLK %d, WS %d, DIN %d)",
+             (unsigned)sample_rate, (int)bclk_, (int)ws_, (int)din_);
+    return true;
+}
+
+void I2sAudioSource::stop() {
+    if (rx_channel_) {
+        i2s_channel_disable(rx_channel_);
+        i2s_del_channel(rx_channel_);
+        rx_channel_ = nullptr;
+    }
+}
+
+bool I2sAudioSource::read(int16_t* samples, size_t count, int64_t& capture_us) {
+    if (!rx_channel_) {
+        return false;
+    }
+
+    slots_.resize(count);
+    size_t bytes_read = 0;
+    esp_err_t ret = i2s_channel_read(rx_channel_, slots_.data(), count * sizeof(int32_t),
+                                     &bytes_read, READ_TIMEOUT_MS);
+    if (ret != ESP_OK || bytes_read != count * sizeof(int32_t)) {
+        ESP_LOGW(TAG, "I2S read failed: %s (%u bytes)", esp_err_to_name(ret), (unsigned)bytes_read);
+        return false;
+    }
+
+    // The read returns once the last sample is in, the first one was captured before it
+    capture_us = esp_timer_get_time() - (int64_t)count * 1000000 / sample_rate_;
+
+    // Samples are left-aligned in the slots, keep the 16 most significant bits
+    for (size_t i = 0; i < count; i++) {
+        samples[i] = (int16_t)(slots_[i] >> 16);
+    }
+    return true;
+}
+
+//=============================================================================
+// WAV File
+//=============================================================================
+
+static uint32_t readLE32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t readLE16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+WavFileAudioSource::WavFileAudioSource(const std::string& path)
+    : path_(path), file_(nullptr), data_offset_(0), data_size_(0), data_read_(0),
+      channels_(0), sample_rate_(0), start_us_(0), position_(0) {}
+
+WavFileAudioSource::~WavFileAudioSource() {
+    stop();
+}
+
+bool WavFileAudioSource::start(uint32_t sample_rate) {
+    file_ = fopen(path_.c_str(), "rb");
+    if (!file_) {
+        ESP_LOGE(TAG, "Failed to open %s", path_.c_str());
+        return false;
+    }
+
+    if (!parseHeader(sample_rate)) {
+        stop();
+        return false;
+    }
+
+    sample_rate_ = sample_rate;
+    data_read_ = 0;
+    position_ = 0;
+    start_us_ = esp_timer_get_time();
+
+    ESP_LOGI(TAG, "Playing %s: %u Hz, %u channel(s), %.1f s", path_.c_str(),
+             (unsigned)sample_rate, (unsigned)channels_,
+             data_size_ / (2.0 * channels_ * sample_rate));
+    return true;
+}
+
+bool WavFileAudioSource::parseHeader(uint32_t sample_rate) {
+    uint8_t header[12];
+    if (fread(header, 1, sizeof(header), file_) != sizeof(header) ||
+        memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+        ESP_LOGE(TAG, "%s is not a WAV file", path_.c_str());
+        return false;
+    }
+
+    // Chunks until "data", "fmt " must come first
+    bool format_ok = false;
+    uint8_t chunk[8];
+    while (fread(chunk, 1, sizeof(chunk), file_) == sizeof(chunk)) {
+        uint32_t size = readLE32(chunk + 4);
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[16];
+            if (size < sizeof(fmt) || fread(fmt, 1, sizeof(fmt), file_) != sizeof(fmt)) {
+                break;
+            }
+            uint16_t format = readLE16(fmt);
+            channels_ = readLE16(fmt + 2);
+            uint32_t rate = readLE32(fmt + 4);
+            uint16_t bits = readLE16(fmt + 14);
+            // 1 is PCM, 0xFFFE is WAVE_FORMAT_EXTENSIBLE, checked through the sample size only
+            if ((format != 1 && format != 0xFFFE) || bits != 16 || channels_ < 1 || channels_ > 2 ||
+                rate != sample_rate) {
+                ESP_LOGE(TAG, "%s: unsupported format %u, %u bits, %u channels, %u Hz (expected "
+                         "16-bit PCM at %u Hz)", path_.c_str(), format, bits, channels_,
+                         (unsigned)rate, (unsigned)sample_rate);
+                return false;
+            }
+            format_ok = true;
+            fseek(file_, size - sizeof(fmt) + (size & 1), SEEK_CUR);
+
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!format_ok) {
+                break;
+            }
+            data_offset_ = ftell(file_);
+            data_size_ = size - size % (2 * channels_);
+            return data_size_ > 0;
+
+        } else {
+            fseek(file_, size + (size & 1), SEEK_CUR);  // Chunks are word-aligned
+        }
+    }
+
+    ESP_LOGE(TAG, "%s: no PCM data", path_.c_str());
+    return false;
+}
+
+void WavFileAudioSource::stop() {
+    if (file_) {
+        fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool WavFileAudioSource::read(int16_t* samples, size_t count, int64_t& capture_us) {
+    if (!file_) {
+        return false;
+    }
+
+    // Paced like a live source: samples are returned once the last one would be captured
+    capture_us = start_us_ + (int64_t)(position_ * 1000000 / sample_rate_);
+    int64_t ready_us = start_us_ + (int64_t)((position_ + count) * 1000000 / sample_rate_);
+    int64_t wait_us = ready_us - esp_timer_get_time();
+    if (wait_us > 0) {
+        usleep(wait_us);
+    }
+
+    frames_.resize(count * channels_);
+    size_t bytes = frames_.size() * sizeof(int16_t);
+    uint8_t* out = reinterpret_cast<uint8_t*>(frames_.data());
+    while (bytes > 0) {
+        if (data_read_ == data_size_) {
+            fseek(file_, data_offset_, SEEK_SET);  // Loop
+            data_read_ = 0;
+        }
+        size_t chunk = std::min<size_t>(bytes, data_size_ - data_read_);
+        if (fread(out, 1, chunk, file_) != chunk) {
+            ESP_LOGE(TAG, "Failed to read %s", path_.c_str());
+            return false;
+        }
+        data_read_ += chunk;
+        out += chunk;
+        bytes -= chunk;
+    }
+
+    // WAV samples are little-endian like the CPU
+    if (channels_ == 2) {
+        for (size_t i = 0; i < count; i++) {
+            samples[i] = (int16_t)((frames_[2 * i] + frames_[2 * i + 1]) / 2);
+        }
+    } else {
+        memcpy(samples, frames_.data(), count * sizeof(int16_t));
+    }
+
+    position_ += count;
+    return true;
+}
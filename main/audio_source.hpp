@@ -0,0 +1,82 @@
+/**
+ * AudioSource - Mono 16-bit PCM input of the audio pipeline
+ *
+ * I2sAudioSource captures an I2S MEMS microphone, WavFileAudioSource plays a WAV file (from
+ * LittleFS) in real time, for testing without a microphone.
+ */
+
+#ifndef AUDIO_SOURCE_HPP
+#define AUDIO_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "driver/i2s_std.h"
+
+class AudioSource {
+public:
+    virtual ~AudioSource() = default;
+
+    virtual bool start(uint32_t sample_rate) = 0;
+    virtual void stop() = 0;
+
+    // Blocks until count samples are read, returns false on error
+    // capture_us: esp_timer time at which the first sample was captured
+    virtual bool read(int16_t* samples, size_t count, int64_t& capture_us) = 0;
+};
+
+class I2sAudioSource : public AudioSource {
+public:
+    // Standard (Philips) I2S microphone like the INMP441: 24-bit samples in 32-bit slots, with
+    // L/R tied low so that it sends on the left slot
+    I2sAudioSource(gpio_num_t bclk, gpio_num_t ws, gpio_num_t din);
+    ~I2sAudioSource() override;
+
+    bool start(uint32_t sample_rate) override;
+    void stop() override;
+    bool read(int16_t* samples, size_t count, int64_t& capture_us) override;
+
+private:
+    // DMA buffers of 5 ms at 48 kHz: a read returns at most that late
+    static constexpr uint32_t DMA_FRAME_NUM = 240;
+    static constexpr uint32_t DMA_DESC_NUM = 6;
+    static constexpr uint32_t READ_TIMEOUT_MS = 100;
+
+    gpio_num_t bclk_;
+    gpio_num_t ws_;
+    gpio_num_t din_;
+    i2s_chan_handle_t rx_channel_;
+    uint32_t sample_rate_;
+    std::vector<int32_t> slots_;  // Raw 32-bit slots of the last read
+};
+
+class WavFileAudioSource : public AudioSource {
+public:
+    // The file must be 16-bit PCM at the pipeline sample rate, stereo is mixed down.
+    // Playback loops at the end of the file.
+    explicit WavFileAudioSource(const std::string& path);
+    ~WavFileAudioSource() override;
+
+    bool start(uint32_t sample_rate) override;
+    void stop() override;
+    bool read(int16_t* samples, size_t count, int64_t& capture_us) override;
+
+private:
+    bool parseHeader(uint32_t sample_rate);
+
+    std::string path_;
+    FILE* file_;
+    long data_offset_;       // First sample in the file
+    uint32_t data_size_;     // Bytes of samples
+    uint32_t data_read_;     // Bytes read since the last loop
+    uint16_t channels_;
+    uint32_t sample_rate_;
+    int64_t start_us_;       // Time of the first sample, playback is paced on it
+    uint64_t position_;      // Samples read since start
+    std::vector<int16_t> frames_;  // Interleaved samples of the last read
+};
+
+#endif // AUDIO_SOURCE_HPP
@@ -0,0 +1,391 @@
+/**
+ * AudioStreamer Implementation
+ *
+ * Opus audio pipeline: source → ring → encoder → RTP
+ */
+
+#include "audio_streamer.hpp"
+#include "media_clock.hpp"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_opus_enc.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// libdatachannel headers
+#include "rtc/frameinfo.hpp"
+
+static const char* TAG = "AudioStreamer";
+
+//=============================================================================
+// Constructor / Destructor
+//=============================================================================
+
+AudioStreamer::AudioStreamer(std::unique_ptr<AudioSource> source, uint32_t frame_ms,
+                             uint32_t bitrate)
+    : source_(std::move(source)),
+      frame_ms_(frame_ms == 10 ? 10 : 20),  // Chunk multiples the encoder supports
+      bitrate_(bitrate),
+      encoder_(nullptr),
+      capture_task_(nullptr), send_task_(nullptr), task_stopped_(nullptr),
+      running_(false),
+      anchor_us_(0), anchor_samples_(0),
+      overruns_(0), resyncs_(0), frame_count_(0) {}
+
+AudioStreamer::~AudioStreamer() {
+    stopStreaming();
+}
+
+//=============================================================================
+// Initialization
+//=============================================================================
+
+bool AudioStreamer::initEncoder() {
+    esp_opus_enc_config_t config = ESP_OPUS_ENC_CONFIG_DEFAULT();
+    config.sample_rate = SAMPLE_RATE;
+    config.channel = ESP_AUDIO_MONO;
+    config.bits_per_sample = ESP_AUDIO_BIT16;
+    config.bitrate = bitrate_;
+    config.frame_duration = frame_ms_ == 10 ? ESP_OPUS_ENC_FRAME_DURATION_10_MS
+                                            : ESP_OPUS_ENC_FRAME_DURATION_20_MS;
+    config.application_mode = ESP_OPUS_ENC_APPLICATION_LOWDELAY;  // Shortest look-ahead
+    config.enable_vbr = true;
+
+    esp_audio_err_t ret = esp_opus_enc_open(&config, sizeof(config), &encoder_);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Failed to open Opus encoder: %d", ret);
+        encoder_ = nullptr;
+        return false;
+    }
+
+    int in_size = 0;
+    int out_size = 0;
+    esp_opus_enc_get_frame_size(encoder_, &in_size, &out_size);
+    if (in_size != (int)(SAMPLE_RATE / 1000 * frame_ms_ * sizeof(int16_t))) {
+        ESP_LOGE(TAG, "Unexpected Opus frame size: %d bytes", in_size);
+        return false;
+    }
+    encoded_.resize(out_size);
+
+    ESP_LOGI(TAG, "Opus encoder: %u Hz mono, %u ms frames, %u bit/s",
+             (unsigned)SAMPLE_RATE, (unsigned)frame_ms_, (unsigned)bitrate_);
+    return true;
+}
+
+void AudioStreamer::cleanup() {
+    if (encoder_) {
+        esp_opus_enc_close(encoder_);
+        encoder_ = nullptr;
+    }
+
+    if (source_) {
+        source_->stop();
+    }
+
+    if (task_stopped_) {
+        vSemaphoreDelete(task_stopped_);
+        task_stopped_ = nullptr;
+    }
+}
+
+//=============================================================================
+// Track Management
+//=============================================================================
+
+bool AudioStreamer::addTrack(const std::string& client_id, std::shared_ptr<rtc::Track> track) {
+    if (!track) {
+        ESP_LOGE(TAG, "Track is null");
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Adding track for client: %s", client_id.c_str());
+
+    {
+        std::lock_guard<std::mutex> lock(tracks_mutex_);
+        tracks_[client_id] = track;
+    }
+
+    // Start streaming if this is the first track
+    if (!running_) {
+        if (!startStreaming()) {
+            ESP_LOGE(TAG, "Failed to start streaming");
+            std::lock_guard<std::mutex> lock(tracks_mutex_);
+            tracks_.erase(client_id);
+            return false;
+        }
+    }
+
+    ESP_LOGI(TAG, "Track added for client: %s (total tracks: %d)",
+             client_id.c_str(), (int)tracks_.size());
+    return true;
+}
+
+void AudioStreamer::removeTrack(const std::string& client_id) {
+    ESP_LOGI(TAG, "Removing track for client: %s", client_id.c_str());
+
+    bool should_stop = false;
+    {
+        std::lock_guard<std::mutex> lock(tracks_mutex_);
+        auto it = tracks_.find(client_id);
+        if (it != tracks_.end()) {
+            tracks_.erase(it);
+            ESP_LOGI(TAG, "Track removed for client: %s (remaining: %d)",
+                     client_id.c_str(), (int)tracks_.size());
+
+            // Stop streaming if no more tracks
+            if (tracks_.empty()) {
+                should_stop = true;
+            }
+        }
+    }
+
+    if (should_stop) {
+        ESP_LOGI(TAG, "No more tracks, stopping streaming");
+        stopStreaming();
+    }
+}
+
+//=============================================================================
+// Internal Start / Stop
+//=============================================================================
+
+bool AudioStreamer::startStreaming() {
+    if (running_) {
+        return true;  // Already running
+    }
+
+    ESP_LOGI(TAG, "Starting audio streamer");
+
+    if (!source_ || !source_->start(SAMPLE_RATE)) {
+        ESP_LOGE(TAG, "Failed to start audio source");
+        return false;
+    }
+
+    if (!initEncoder()) {
+        cleanup();
+        return false;
+    }
+
+    task_stopped_ = xSemaphoreCreateCounting(2, 0);
+    if (!task_stopped_) {
+        ESP_LOGE(TAG, "Failed to create task semaphore");
+        cleanup();
+        return false;
+    }
+
+    // Initialize state
+    ring_.clear();
+    running_ = true;
+    anchor_us_ = 0;
+    anchor_samples_ = 0;
+    overruns_ = 0;
+    resyncs_ = 0;
+    frame_count_ = 0;
+
+    // Send task first, the capture task notifies it
+    BaseType_t ret = xTaskCreate(
+        sendTaskEntry,
+        "audio_send",
+        SEND_TASK_STACK,
+        this,
+        SEND_TASK_PRIORITY,
+        &send_task_
+    );
+
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create send task");
+        send_task_ = nullptr;
+        stopStreaming();
+        return false;
+    }
+
+    ret = xTaskCreate(
+        captureTaskEntry,
+        "audio_capture",
+        CAPTURE_TASK_STACK,
+        this,
+        CAPTURE_TASK_PRIORITY,
+        &capture_task_
+    );
+
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create capture task");
+        capture_task_ = nullptr;
+        stopStreaming();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Audio streamer started");
+    return true;
+}
+
+void AudioStreamer::stopStreaming() {
+    if (!running_) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Stopping audio streamer...");
+    running_ = false;
+
+    // Wait for tasks to finish: a source read and a send loop wait return within 100 ms
+    int tasks = (capture_task_ ? 1 : 0) + (send_task_ ? 1 : 0);
+    for (int i = 0; i < tasks; i++) {
+        if (xSemaphoreTake(task_stopped_, pdMS_TO_TICKS(1000)) != pdTRUE) {
+            ESP_LOGW(TAG, "Audio task did not stop in time");
+        }
+    }
+    capture_task_ = nullptr;
+    send_task_ = nullptr;
+
+    ring_.clear();
+    cleanup();
+
+    // Clear tracks
+    {
+        std::lock_guard<std::mutex> lock(tracks_mutex_);
+        tracks_.clear();
+    }
+
+    ESP_LOGI(TAG, "Stopped: %llu frames sent, %u overruns, %u resyncs",
+             (unsigned long long)frame_count_, (unsigned)overruns_.load(), (unsigned)resyncs_);
+}
+
+//=============================================================================
+// Capture Loop (Source → Ring)
+//=============================================================================
+
+void AudioStreamer::captureTaskEntry(void* arg) {
+    AudioStreamer* self = static_cast<AudioStreamer*>(arg);
+    self->captureLoop();
+    xSemaphoreGive(self->task_stopped_);
+    vTaskDelete(NULL);
+}
+
+void AudioStreamer::captureLoop() {
+    ESP_LOGI(TAG, "Capture loop started (%u ms chunks, %u in ring)",
+             (unsigned)CHUNK_MS, (unsigned)RING_CHUNKS);
+
+    Chunk discarded;  // Read when the ring is full, to keep draining the source
+
+    while (running_) {
+        Chunk* slot = ring_.writeSlot();
+        Chunk& chunk = slot ? *slot : discarded;
+        if (!source_->read(chunk.samples, CHUNK_SAMPLES, chunk.capture_us)) {
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        if (!slot) {
+            overruns_++;
+            continue;
+        }
+
+        ring_.push();
+        xTaskNotifyGive(send_task_);
+    }
+
+    ESP_LOGI(TAG, "Capture loop exited");
+}
+
+//=============================================================================
+// Send Loop (Ring → Encoder → RTP)
+//=============================================================================
+
+void AudioStreamer::sendTaskEntry(void* arg) {
+    AudioStreamer* self = static_cast<AudioStreamer*>(arg);
+    self->sendLoop();
+    xSemaphoreGive(self->task_stopped_);
+    vTaskDelete(NULL);
+}
+
+int64_t AudioStreamer::frameCaptureTime(int64_t capture_us) {
+    int64_t expected_us = anchor_us_ + (int64_t)(anchor_samples_ * 1000000 / SAMPLE_RATE);
+    if (anchor_us_ == 0 || std::abs(capture_us - expected_us) >= CHUNK_MS * 1000 / 2) {
+        if (anchor_us_ != 0) {
+            resyncs_++;
+            ESP_LOGW(TAG, "Capture clock off by %lld us, resync", (long long)(capture_us - expected_us));
+        }
+        anchor_us_ = capture_us;
+        anchor_samples_ = 0;
+        expected_us = capture_us;
+    }
+
+    anchor_samples_ += SAMPLE_RATE / 1000 * frame_ms_;
+    return expected_us;
+}
+
+void AudioStreamer::sendLoop() {
+    ESP_LOGI(TAG, "Send task started");
+
+    const size_t chunks_per_frame = frame_ms_ / CHUNK_MS;
+    std::vector<int16_t> pcm(chunks_per_frame * CHUNK_SAMPLES);
+
+    uint64_t last_stats_time = esp_timer_get_time();
+    uint64_t window_frames = 0;
+    int64_t window_latency_us = 0;
+    int64_t window_max_latency_us = 0;
+
+    while (running_) {
+        // Woken by the capture task, the timeout only checks for stop
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+
+        while (running_ && ring_.size() >= chunks_per_frame) {
+            int64_t capture_us = ring_.peek(0).capture_us;
+            for (size_t i = 0; i < chunks_per_frame; i++) {
+                memcpy(&pcm[i * CHUNK_SAMPLES], ring_.peek(i).samples, sizeof(Chunk::samples));
+            }
+            ring_.pop(chunks_per_frame);
+
+            esp_audio_enc_in_frame_t in_frame = {};
+            in_frame.buffer = reinterpret_cast<uint8_t*>(pcm.data());
+            in_frame.len = pcm.size() * sizeof(int16_t);
+            esp_audio_enc_out_frame_t out_frame = {};
+            out_frame.buffer = encoded_.data();
+            out_frame.len = encoded_.size();
+            esp_audio_err_t ret = esp_opus_enc_process(encoder_, &in_frame, &out_frame);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                ESP_LOGW(TAG, "Opus encoding failed: %d", ret);
+                continue;
+            }
+
+            rtc::FrameInfo info(MediaClock::timestamp(frameCaptureTime(capture_us)));
+
+            try {
+                std::lock_guard<std::mutex> lock(tracks_mutex_);
+                for (auto& [client_id, track] : tracks_) {
+                    if (track && track->isOpen()) {
+                        track->sendFrame(reinterpret_cast<const std::byte*>(encoded_.data()),
+                                         out_frame.encoded_bytes, info);
+                    }
+                }
+            } catch (const std::exception& e) {
+                ESP_LOGE(TAG, "Send failed: %s", e.what());
+            }
+
+            // Latency from the capture of the first sample to the frame being sent
+            int64_t now = esp_timer_get_time();
+            int64_t latency_us = now - capture_us;
+            frame_count_++;
+            window_frames++;
+            window_latency_us += latency_us;
+            window_max_latency_us = std::max(window_max_latency_us, latency_us);
+
+            // Log stats every 5 seconds
+            if (now - last_stats_time >= 5000000) {
+                ESP_LOGI(TAG, "Send: %llu frames, latency avg=%.1f ms max=%.1f ms, "
+                         "%u overruns, %u resyncs",
+                         (unsigned long long)frame_count_,
+                         window_latency_us / 1000.0 / window_frames,
+                         window_max_latency_us / 1000.0,
+                         (unsigned)overruns_.load(), (unsigned)resyncs_);
+                last_stats_time = now;
+                window_frames = 0;
+                window_latency_us = 0;
+                window_max_latency_us = 0;
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "Send loop exited");
+}
@@ -0,0 +1,123 @@
+/**
+ * AudioStreamer - Opus audio pipeline for WebRTC, parallel to VideoStreamer
+ *
+ * A capture task reads 10 ms chunks from an AudioSource into a lock-free ring, a send task
+ * encodes them into Opus frames and sends them to the tracks. Both run above the video tasks, so
+ * that audio frames are never queued behind a video keyframe.
+ */
+
+#ifndef AUDIO_STREAMER_HPP
+#define AUDIO_STREAMER_HPP
+
+#include "rtc/rtc.hpp"
+#include "audio_source.hpp"
+#include "spsc_ring.hpp"
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+}
+
+class AudioStreamer {
+public:
+    static constexpr uint32_t SAMPLE_RATE = 48000;  // Opus RTP clock rate, mono
+
+    // source: PCM input, started with the first track
+    // frame_ms: Opus frame duration, 10 or 20 ms
+    // bitrate: Opus bitrate in bit/s
+    AudioStreamer(std::unique_ptr<AudioSource> source, uint32_t frame_ms = 20,
+                  uint32_t bitrate = 32000);
+    ~AudioStreamer();
+
+    // Add a track to send audio to
+    // Automatically starts streaming if this is the first track
+    // Returns true on success
+    bool addTrack(const std::string& client_id, std::shared_ptr<rtc::Track> track);
+
+    // Remove a track
+    // Automatically stops streaming if this was the last track
+    void removeTrack(const std::string& client_id);
+
+    // Check if streaming is active
+    bool isRunning() const { return running_; }
+
+    uint32_t getFrameMs() const { return frame_ms_; }
+
+private:
+    // Capture chunks, a frame is 1 or 2 of them
+    static constexpr uint32_t CHUNK_MS = 10;
+    static constexpr uint32_t CHUNK_SAMPLES = SAMPLE_RATE * CHUNK_MS / 1000;
+    static constexpr size_t RING_CHUNKS = 16;  // 160 ms
+    struct Chunk {
+        int16_t samples[CHUNK_SAMPLES];
+        int64_t capture_us;  // First sample
+    };
+
+    // Capture task above the video tasks, it only copies samples; send task above the video
+    // send task, Opus encoding and the libdatachannel call chain need a large stack
+    static constexpr UBaseType_t CAPTURE_TASK_PRIORITY = 8;
+    static constexpr UBaseType_t SEND_TASK_PRIORITY = 7;
+    static constexpr uint32_t CAPTURE_TASK_STACK = 4096;
+    static constexpr uint32_t SEND_TASK_STACK = 32768;
+
+    // Configuration
+    std::unique_ptr<AudioSource> source_;
+    uint32_t frame_ms_;
+    uint32_t bitrate_;
+
+    // Opus encoder (esp_audio_codec handle)
+    void* encoder_;
+    std::vector<uint8_t> encoded_;
+
+    // Capture → send
+    SpscRing<Chunk, RING_CHUNKS> ring_;
+
+    // Tasks
+    TaskHandle_t capture_task_;
+    TaskHandle_t send_task_;
+    SemaphoreHandle_t task_stopped_;  // Given by each task on exit
+
+    // State
+    std::atomic<bool> running_;
+
+    // Track management (one track per client)
+    std::map<std::string, std::shared_ptr<rtc::Track>> tracks_;
+    std::mutex tracks_mutex_;
+
+    // RTP timestamps count samples from an anchor on the capture clock, re-anchored when capture
+    // is off by half a chunk (overrun, source stall)
+    int64_t anchor_us_;
+    uint64_t anchor_samples_;
+
+    // Statistics
+    std::atomic<uint32_t> overruns_;  // Chunks dropped because the ring was full
+    uint32_t resyncs_;
+    uint64_t frame_count_;
+
+    // Initialization
+    bool initEncoder();
+    void cleanup();
+
+    // Internal start/stop (called by addTrack/removeTrack)
+    bool startStreaming();
+    void stopStreaming();
+
+    // Capture loop (runs in capture_task_)
+    static void captureTaskEntry(void* arg);
+    void captureLoop();
+
+    // Send loop (runs in send_task_)
+    static void sendTaskEntry(void* arg);
+    void sendLoop();
+    int64_t frameCaptureTime(int64_t capture_us);
+};
+
+#endif // AUDIO_STREAMER_HPP
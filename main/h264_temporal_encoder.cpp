@@ -0,0 +1,211 @@
+/**
+ * H264TemporalEncoder Implementation
+ *
+ * openh264 with iTemporalLayerNum > 1 encodes the dyadic pattern T0 T2 T1 T2 (L1T3) or T0 T1
+ * (L1T2): each frame references the last frame of a lower layer, T0 frames the previous T0.
+ */
+
+#include "h264_temporal_encoder.hpp"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <cstring>
+
+#include "codec_api.h"
+
+static const char* TAG = "H264TemporalEnc";
+
+H264TemporalEncoder::H264TemporalEncoder()
+    : encoder_(nullptr), width_(0), height_(0), temporal_layers_(1),
+      i420_(nullptr), bitstream_(nullptr), bitstream_size_(0) {}
+
+H264TemporalEncoder::~H264TemporalEncoder() {
+    deinit();
+}
+
+bool H264TemporalEncoder::init(uint32_t width, uint32_t height, uint32_t fps, uint32_t bitrate,
+                               uint32_t gop, int temporal_layers) {
+    if (temporal_layers < 1 || temporal_layers > 3 || width % 2 != 0 || height % 2 != 0) {
+        ESP_LOGE(TAG, "Invalid configuration: %ux%u, %d temporal layers",
+                 (unsigned)width, (unsigned)height, temporal_layers);
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    temporal_layers_ = temporal_layers;
+
+    // Frames are large, they go to PSRAM like the encoder reference pictures
+    size_t picture_size = width * height * 3 / 2;
+    i420_ = (uint8_t*)heap_caps_malloc(picture_size, MALLOC_CAP_SPIRAM);
+    bitstream_size_ = picture_size;
+    bitstream_ = (uint8_t*)heap_caps_malloc(bitstream_size_, MALLOC_CAP_SPIRAM);
+    if (!i420_ || !bitstream_) {
+        ESP_LOGE(TAG, "Failed to allocate encoder buffers (%zu bytes)", 2 * picture_size);
+        deinit();
+        return false;
+    }
+
+    if (WelsCreateSVCEncoder(&encoder_) != 0 || !encoder_) {
+        ESP_LOGE(TAG, "Failed to create openh264 encoder");
+        encoder_ = nullptr;
+        deinit();
+        return false;
+    }
+
+    // Same settings as the esp_h264 software encoder, except for temporal layers
+    SEncParamExt param;
+    encoder_->GetDefaultParams(&param);
+    param.iUsageType = CAMERA_VIDEO_REAL_TIME;
+    param.fMaxFrameRate = fps;
+    param.iPicWidth = width;
+    param.iPicHeight = height;
+    param.iTargetBitrate = bitrate;
+    param.iMaxBitrate = bitrate;
+    param.iRCMode = RC_QUALITY_MODE;
+    param.iMinQp = 10;
+    param.iMaxQp = 35;
+    param.bEnableFrameSkip = false;
+    param.iTemporalLayerNum = temporal_layers;
+    param.iSpatialLayerNum = 1;
+    param.iNumRefFrame = AUTO_REF_PIC_COUNT;  // One reference per layer
+    param.iComplexityMode = LOW_COMPLEXITY;
+    param.uiIntraPeriod = gop;
+    param.eSpsPpsIdStrategy = CONSTANT_ID;
+    param.bPrefixNalAddingCtrl = false;       // No SVC prefix NAL units, plain AVC for browsers
+    param.bEnableSSEI = false;
+    param.bSimulcastAVC = false;
+    param.iEntropyCodingModeFlag = 0;
+    param.bEnableLongTermReference = false;
+    param.iMultipleThreadIdc = 1;
+    param.iLoopFilterDisableIdc = 1;
+    param.bEnableDenoise = false;
+    param.bEnableAdaptiveQuant = true;
+    param.bEnableBackgroundDetection = false;
+    param.bEnableFrameCroppingFlag = (width % 16 != 0) || (height % 16 != 0);
+    param.bEnableSceneChangeDetect = false;
+
+    SSpatialLayerConfig& layer = param.sSpatialLayers[0];
+    layer.uiProfileIdc = PRO_BASELINE;
+    layer.iVideoWidth = width;
+    layer.iVideoHeight = height;
+    layer.fFrameRate = fps;
+    layer.iSpatialBitrate = bitrate;
+    layer.iMaxSpatialBitrate = bitrate;
+    layer.sSliceArgument.uiSliceMode = SM_SINGLE_SLICE;
+    layer.iDLayerQp = (param.iMaxQp + param.iMinQp) / 2;
+
+    int ret = encoder_->InitializeExt(&param);
+    if (ret != cmResultSuccess) {
+        ESP_LOGE(TAG, "Failed to initialize openh264 encoder: %d", ret);
+        deinit();
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Encoder initialized: %ux%u @ %u fps, %u bps, GOP %u, L1T%d",
+             (unsigned)width, (unsigned)height, (unsigned)fps, (unsigned)bitrate, (unsigned)gop,
+             temporal_layers);
+    return true;
+}
+
+void H264TemporalEncoder::deinit() {
+    if (encoder_) {
+        encoder_->Uninitialize();
+        WelsDestroySVCEncoder(encoder_);
+        encoder_ = nullptr;
+    }
+
+    if (i420_) {
+        heap_caps_free(i420_);
+        i420_ = nullptr;
+    }
+
+    if (bitstream_) {
+        heap_caps_free(bitstream_);
+        bitstream_ = nullptr;
+        bitstream_size_ = 0;
+    }
+}
+
+void H264TemporalEncoder::convertToI420(const uint8_t* input) {
+    const size_t line_size = width_ * 3 / 2;
+    const size_t chroma_width = width_ / 2;
+    uint8_t* y_plane = i420_;
+    uint8_t* u_plane = y_plane + width_ * height_;
+    uint8_t* v_plane = u_plane + chroma_width * (height_ / 2);
+
+    // Each pair of lines carries one line of U (first line) and one line of V (second line)
+    for (uint32_t row = 0; row < height_; row += 2) {
+        const uint8_t* u_line = input + row * line_size;
+        const uint8_t* v_line = u_line + line_size;
+        uint8_t* y0 = y_plane + row * width_;
+        uint8_t* y1 = y0 + width_;
+        uint8_t* u = u_plane + (row / 2) * chroma_width;
+        uint8_t* v = v_plane + (row / 2) * chroma_width;
+
+        for (size_t x = 0; x < chroma_width; x++) {
+            u[x] = u_line[3 * x];
+            y0[2 * x] = u_line[3 * x + 1];
+            y0[2 * x + 1] = u_line[3 * x + 2];
+            v[x] = v_line[3 * x];
+            y1[2 * x] = v_line[3 * x + 1];
+            y1[2 * x + 1] = v_line[3 * x + 2];
+        }
+    }
+}
+
+bool H264TemporalEncoder::encode(const uint8_t* input, uint32_t pts_ms, Frame& frame) {
+    if (!encoder_) {
+        return false;
+    }
+
+    convertToI420(input);
+
+    SSourcePicture picture;
+    memset(&picture, 0, sizeof(picture));
+    picture.iColorFormat = videoFormatI420;
+    picture.iPicWidth = width_;
+    picture.iPicHeight = height_;
+    picture.iStride[0] = width_;
+    picture.iStride[1] = width_ / 2;
+    picture.iStride[2] = width_ / 2;
+    picture.pData[0] = i420_;
+    picture.pData[1] = i420_ + width_ * height_;
+    picture.pData[2] = picture.pData[1] + (width_ / 2) * (height_ / 2);
+    picture.uiTimeStamp = pts_ms;
+
+    // The esp_h264 build of openh264 writes the access unit to the buffer of the first layer
+    SFrameBSInfo info;
+    memset(&info, 0, sizeof(info));
+    info.iFrameSizeInBytes = bitstream_size_;
+    info.sLayerInfo[0].pBsBuf = bitstream_;
+
+    int ret = encoder_->EncodeFrame(&picture, &info);
+    if (ret != cmResultSuccess) {
+        ESP_LOGE(TAG, "Failed to encode frame: %d", ret);
+        return false;
+    }
+
+    if (info.eFrameType == videoFrameTypeSKIP || info.eFrameType == videoFrameTypeInvalid ||
+        info.iFrameSizeInBytes <= 0) {
+        return false;
+    }
+
+    // Parameter sets come as a separate layer on IDR frames, the temporal ID is the picture's
+    frame.temporal_layer = 0;
+    for (int i = 0; i < info.iLayerNum; i++) {
+        if (info.sLayerInfo[i].uiLayerType == VIDEO_CODING_LAYER) {
+            frame.temporal_layer = info.sLayerInfo[i].uiTemporalId;
+        }
+    }
+
+    frame.data = info.sLayerInfo[0].pBsBuf;
+    frame.size = info.iFrameSizeInBytes;
+    frame.keyframe = info.eFrameType == videoFrameTypeIDR;
+    return true;
+}
+
+void H264TemporalEncoder::forceKeyframe() {
+    if (encoder_) {
+        encoder_->ForceIntraFrame(true);
+    }
+}
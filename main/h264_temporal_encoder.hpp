@@ -0,0 +1,56 @@
+/**
+ * H264TemporalEncoder - Software H.264 encoder with temporal scalability
+ *
+ * The hardware encoder only produces IPPP streams, where every frame references the previous
+ * one, so no frame can be skipped for a slow viewer. This wraps openh264 (linked by esp_h264)
+ * to produce L1T2/L1T3 streams: upper layer frames are never referenced by lower layers, so a
+ * per-viewer rtc::TemporalLayerSelector can drop them and halve or quarter the frame rate.
+ */
+
+#ifndef H264_TEMPORAL_ENCODER_HPP
+#define H264_TEMPORAL_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+class ISVCEncoder;
+
+class H264TemporalEncoder {
+public:
+    struct Frame {
+        const uint8_t* data;    // Annex-B access unit, valid until the next encode()
+        size_t size;
+        uint8_t temporal_layer; // 0 for the base layer
+        bool keyframe;
+    };
+
+    H264TemporalEncoder();
+    ~H264TemporalEncoder();
+
+    // temporal_layers: 1 to 3, gop: keyframe period in frames (a multiple of the layer pattern)
+    bool init(uint32_t width, uint32_t height, uint32_t fps, uint32_t bitrate, uint32_t gop,
+              int temporal_layers);
+    void deinit();
+
+    // input: camera YUV420 (O_UYY_E_VYY: lines alternate "u y y u y y..." and "v y y v y y...")
+    // Returns false if the frame was not encoded or skipped by rate control
+    bool encode(const uint8_t* input, uint32_t pts_ms, Frame& frame);
+
+    // Next frame is encoded as an IDR
+    void forceKeyframe();
+
+    int temporalLayers() const { return temporal_layers_; }
+
+private:
+    ISVCEncoder* encoder_;
+    uint32_t width_;
+    uint32_t height_;
+    int temporal_layers_;
+    uint8_t* i420_;          // Planar input of the encoder
+    uint8_t* bitstream_;     // Encoded access unit
+    size_t bitstream_size_;
+
+    void convertToI420(const uint8_t* input);
+};
+
+#endif // H264_TEMPORAL_ENCODER_HPP
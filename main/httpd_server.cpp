@@ -9,18 +9,29 @@
 
 #include "httpd_server.hpp"
 #include "video_streamer.hpp"
+#include "audio_streamer.hpp"
+#include "media_clock.hpp"
 #include <cJSON.h>
+#include <algorithm>
 #include <cstring>
 #include "esp_log.h"
 #include "esp_crt_bundle.h"
+#include "esp_heap_caps.h"
 #include "esp32_psram_init.h"
 #include "esp_timer.h"
+#include "freertos/idf_additions.h"
+#include "mdns.h"
 
 // libdatachannel headers for video streaming
 #include "rtc/h264rtppacketizer.hpp"
+#include "rtc/rtppacketizer.hpp"
 #include "rtc/rtcpsrreporter.hpp"
 #include "rtc/rtcpnackresponder.hpp"
+#include "rtc/temporallayerselector.hpp"
+#include "rtc/mediapipeline.hpp"
 #include "rtc/frameinfo.hpp"
+#include "rtc/transportcchandler.hpp"
+#include "rtc/memoryplacement.hpp"
 
 static const char* TAG = "WebRTC";
 
@@ -33,6 +44,58 @@ using namespace rtc;
 // Global flag to synchronize logging across all pipeline layers
 bool g_log_frame_timing = false;
 
+//=============================================================================
+// Temporal Layer Control
+//=============================================================================
+
+// Steps the highest temporal layer sent to a viewer from transport-cc loss, with the thresholds
+// of the loss-based controller of Google congestion control: one layer is dropped above 10%
+// loss, one is restored after two windows below 2%
+class TemporalLayerController {
+public:
+    explicit TemporalLayerController(int layers) : max_layer_(layers - 1), layer_(layers - 1) {}
+
+    // Returns true if the layer changed
+    bool update(size_t received, size_t reported) {
+        received_ += received;
+        reported_ += reported;
+        if (reported_ < WINDOW_PACKETS) {
+            return false;
+        }
+
+        float loss = 1.0f - float(received_) / float(reported_);
+        received_ = reported_ = 0;
+
+        if (loss > 0.10f) {
+            clear_windows_ = 0;
+            if (layer_ > 0) {
+                layer_--;
+                return true;
+            }
+        } else if (loss < 0.02f) {
+            if (++clear_windows_ >= 2 && layer_ < max_layer_) {
+                clear_windows_ = 0;
+                layer_++;
+                return true;
+            }
+        } else {
+            clear_windows_ = 0;
+        }
+        return false;
+    }
+
+    uint8_t layer() const { return layer_; }
+
+private:
+    static constexpr size_t WINDOW_PACKETS = 100;  // About 1.5 s of video at 720 kbps
+
+    const uint8_t max_layer_;
+    uint8_t layer_;
+    size_t received_ = 0;
+    size_t reported_ = 0;
+    int clear_windows_ = 0;
+};
+
 //=============================================================================
 // WebRTCSession Implementation
 //=============================================================================
@@ -160,7 +223,13 @@ void WebRTCSession::handleSwspFrame(const rtc::binary& frame_data) {
 
         // Find and dispatch handler to Internal RAM task
         const httpd_uri_t* handler = findHandler(req.uri, (httpd_method_t)req.method);
-        if (handler) {
+        if (heap_caps_get_free_size(MALLOC_CAP_INTERNAL) < REQUEST_INTERNAL_RESERVE) {
+            ESP_LOGW(TAG, "Low internal RAM (%d KB free), shedding request: %s",
+                     (int)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024), req.uri);
+            httpd_resp_set_status(&req, "503 Service Unavailable");
+            httpd_resp_set_type(&req, "text/plain");
+            httpd_resp_send(&req, "Service Unavailable", HTTPD_RESP_USE_STRLEN);
+        } else if (handler) {
             req.user_ctx = handler->user_ctx;
 
             // CRITICAL: Execute handler on Internal RAM task to allow file I/O
@@ -184,15 +253,33 @@ void WebRTCSession::handleSwspFrame(const rtc::binary& frame_data) {
 // WebRTCServer Implementation
 //=============================================================================
 
-WebRTCServer::WebRTCServer(const std::string& uid, const std::string& server_url)
-    : uid_(uid), server_url_(server_url) {
+WebRTCServer::WebRTCServer(const std::string& uid, const std::string& server_url, bool lan_mode,
+                           bool local_signaling)
+    : uid_(uid), server_url_(server_url), lan_mode_(lan_mode), local_signaling_(local_signaling) {
     ESP_LOGI(TAG, "WebRTCServer created for UID: %s", uid.c_str());
 
     // Create video streamer
     // Output: 640x360 @ 25fps
     // Camera resolution auto-detected (set via menuconfig: 1280x720 or 1920x1080)
     // PPA scaling automatically enabled if output != camera
-    video_streamer_ = std::make_unique<VideoStreamer>(640, 360, 25);
+    video_streamer_ = std::make_unique<VideoStreamer>(640, 360, 25, VIDEO_TEMPORAL_LAYERS);
+
+    // Create audio streamer: Opus, 48 kHz mono, from the I2S microphone or a WAV file
+    if (AUDIO_ENABLED) {
+        std::unique_ptr<AudioSource> source;
+        if (AUDIO_WAV_FILE[0] != '\0') {
+            source = std::make_unique<WavFileAudioSource>(AUDIO_WAV_FILE);
+        } else {
+            source = std::make_unique<I2sAudioSource>((gpio_num_t)AUDIO_I2S_BCLK_GPIO,
+                                                      (gpio_num_t)AUDIO_I2S_WS_GPIO,
+                                                      (gpio_num_t)AUDIO_I2S_DIN_GPIO);
+        }
+        audio_streamer_ = std::make_unique<AudioStreamer>(std::move(source), AUDIO_FRAME_MS,
+                                                          AUDIO_BITRATE);
+    }
+
+    // Both streamers timestamp frames on the shared capture clock, fix its origin now
+    MediaClock::originUs();
 }
 
 WebRTCServer::~WebRTCServer() {
@@ -201,11 +288,6 @@ WebRTCServer::~WebRTCServer() {
 
 void WebRTCServer::websocketEventHandler(void* handler_args, esp_event_base_t base,
                                           int32_t event_id, void* event_data) {
-    // Configure pthread to use PSRAM for the WebSocket client's task
-    // This ensures PeerConnection creation (which spawns libjuice threads) uses PSRAM stacks
-    // Call this once per event to ensure config is set (it's idempotent)
-    esp32_ensure_pthread_psram();
-
     WebRTCServer* server = static_cast<WebRTCServer*>(handler_args);
     esp_websocket_event_data_t* data = static_cast<esp_websocket_event_data_t*>(event_data);
 
@@ -231,28 +313,7 @@ void WebRTCServer::websocketEventHandler(void* handler_args, esp_event_base_t ba
             break;
 
         case WEBSOCKET_EVENT_DATA:
-            if (data->op_code == 0x01 && data->data_len > 0) {  // Text frame
-                // Append received data to buffer
-                server->ws_message_buffer_.append((char*)data->data_ptr, data->data_len);
-
-                // Check if we have a complete JSON message
-                bool is_complete = false;
-                if (!server->ws_message_buffer_.empty() &&
-                    server->ws_message_buffer_.front() == '{' &&
-                    server->ws_message_buffer_.back() == '}') {
-                    is_complete = true;
-                }
-
-                if (is_complete) {
-                    ESP_LOGI(TAG, "Received complete WebSocket message (len=%d)",
-                             (int)server->ws_message_buffer_.length());
-                    server->handleWebSocketMessage(server->ws_message_buffer_);
-                    server->ws_message_buffer_.clear();
-                } else {
-                    ESP_LOGD(TAG, "Received WebSocket fragment (len=%d), buffering...",
-                             data->data_len);
-                }
-            }
+            server->handleWebSocketData(data);
             break;
 
         case WEBSOCKET_EVENT_ERROR:
@@ -264,7 +325,39 @@ void WebRTCServer::websocketEventHandler(void* handler_args, esp_event_base_t ba
     }
 }
 
-void WebRTCServer::handleWebSocketMessage(const std::string& message) {
+void WebRTCServer::handleWebSocketData(const esp_websocket_event_data_t* data) {
+    auto result = ws_assembler_.feed(data->op_code, data->fin, data->data_ptr, data->data_len,
+                                     data->payload_offset, data->payload_len);
+    switch (result) {
+        case WsMessageAssembler::Result::Pending:
+            ESP_LOGD(TAG, "Received WebSocket fragment (len=%d), buffering...", data->data_len);
+            break;
+
+        case WsMessageAssembler::Result::Complete:
+            ESP_LOGI(TAG, "Received complete WebSocket message (len=%d)",
+                     (int)ws_assembler_.message().length());
+            handleSignalingMessage(ws_assembler_.message());
+            break;
+
+        case WsMessageAssembler::Result::Skipped:
+            break;  // Binary and control frames are not signaling messages
+
+        case WsMessageAssembler::Result::Orphan:
+            ESP_LOGW(TAG, "Ignoring WebSocket continuation without a message start");
+            break;
+
+        case WsMessageAssembler::Result::Overflow:
+            ESP_LOGE(TAG, "Dropping signaling message larger than %d bytes",
+                     (int)ws_assembler_.capacity());
+            break;
+    }
+}
+
+void WebRTCServer::handleSignalingMessage(const std::string& message,
+                                          const struct sockaddr_in* lan_source,
+                                          const std::shared_ptr<WebSocket>& local_source) {
+    // Runs on the WebSocket client, LAN or poll thread: only parse here, the work is done by
+    // signaling workers
     cJSON* json = cJSON_Parse(message.c_str());
     if (!json) {
         ESP_LOGE(TAG, "Failed to parse signaling message");
@@ -282,13 +375,46 @@ void WebRTCServer::handleWebSocketMessage(const std::string& message) {
     std::string type = type_item->valuestring;
     std::string client_id = (client_id_item && cJSON_IsString(client_id_item))
                             ? client_id_item->valuestring : "";
+    int64_t received_us = esp_timer_get_time();
+    bool lan = lan_source != nullptr || local_source != nullptr;
+
+    // LAN and local clients register with their request: replies go back to the address or
+    // connection it came from, and later messages of the client must come from there too
+    if (lan_source) {
+        std::lock_guard<std::mutex> lock(lan_mutex_);
+        auto it = lan_clients_.find(client_id);
+        if (type == "request" && !client_id.empty()) {
+            lan_clients_[client_id] = *lan_source;
+        } else if (it == lan_clients_.end() ||
+                   it->second.sin_addr.s_addr != lan_source->sin_addr.s_addr ||
+                   it->second.sin_port != lan_source->sin_port) {
+            ESP_LOGW(TAG, "Dropping LAN %s message of unregistered client: %s",
+                     type.c_str(), client_id.c_str());
+            cJSON_Delete(json);
+            return;
+        }
+    }
+
+    if (local_source) {
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        auto it = local_clients_.find(client_id);
+        if (type == "request" && !client_id.empty()) {
+            local_clients_[client_id] = local_source;
+        } else if (it == local_clients_.end() || it->second != local_source) {
+            ESP_LOGW(TAG, "Dropping local %s message of unregistered client: %s",
+                     type.c_str(), client_id.c_str());
+            cJSON_Delete(json);
+            return;
+        }
+    }
 
     if (type == "registered") {
         ESP_LOGI(TAG, "Registered! URL: https://%s/%s", server_url_.c_str(), uid_.c_str());
     } else if (type == "request") {
         // Browser requests connection - we create the offer
         ESP_LOGI(TAG, "Received connection request from client: %s", client_id.c_str());
-        handleRequest(client_id);
+        enqueueSignalingMessage(new SignalingMessage{
+            SignalingMessage::Type::Request, client_id, "", "", "", received_us, lan});
     } else if (type == "answer") {
         // Browser sends answer - we set remote description
         cJSON* sdp_item = cJSON_GetObjectItem(json, "sdp");
@@ -307,7 +433,8 @@ void WebRTCServer::handleWebSocketMessage(const std::string& message) {
                 }
             }
 
-            handleAnswer(client_id, sdp);
+            enqueueSignalingMessage(new SignalingMessage{
+                SignalingMessage::Type::Answer, client_id, std::move(sdp), "", "", received_us, lan});
         }
     } else if (type == "candidate") {
         cJSON* cand_item = cJSON_GetObjectItem(json, "candidate");
@@ -325,7 +452,9 @@ void WebRTCServer::handleWebSocketMessage(const std::string& message) {
                     candidate = candidate.substr(10);
                 }
 
-                handleCandidate(client_id, candidate, mid);
+                enqueueSignalingMessage(new SignalingMessage{
+                    SignalingMessage::Type::Candidate, client_id, "", std::move(candidate),
+                    std::move(mid), received_us, lan});
             }
         }
     }
@@ -333,26 +462,211 @@ void WebRTCServer::handleWebSocketMessage(const std::string& message) {
     cJSON_Delete(json);
 }
 
-void WebRTCServer::handleRequest(const std::string& client_id) {
-    ESP_LOGI(TAG, "Received connection request from client: %s", client_id.c_str());
+//=============================================================================
+// Signaling Workers
+//=============================================================================
+
+bool WebRTCServer::startSignalingWorkers() {
+    for (int i = 0; i < SIGNALING_WORKERS; i++) {
+        SignalingWorker& worker = signaling_workers_[i];
+        worker.server = this;
+        worker.queue = xQueueCreate(SIGNALING_QUEUE_DEPTH, sizeof(SignalingMessage*));
+        worker.stopped = xSemaphoreCreateBinary();
+        if (!worker.queue || !worker.stopped) {
+            ESP_LOGE(TAG, "Failed to create signaling queue %d", i);
+            return false;
+        }
+
+        // PSRAM stack: signaling does no file I/O, and the stack is sized for SDP parsing
+        char name[16];
+        snprintf(name, sizeof(name), "signaling%d", i);
+        BaseType_t ret = xTaskCreateWithCaps(
+            signalingTaskEntry,
+            name,
+            SIGNALING_TASK_STACK,
+            &worker,
+            5,  // Same priority as the WebSocket task
+            &worker.task,
+            MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT
+        );
+        if (ret != pdPASS) {
+            ESP_LOGE(TAG, "Failed to create signaling task %d", i);
+            worker.task = nullptr;
+            return false;
+        }
+    }
+
+    ESP_LOGI(TAG, "Started %d signaling workers (%dKB PSRAM stacks)",
+             SIGNALING_WORKERS, (int)(SIGNALING_TASK_STACK / 1024));
+    return true;
+}
+
+void WebRTCServer::stopSignalingWorkers() {
+    for (auto& worker : signaling_workers_) {
+        if (worker.task) {
+            // Workers finish their queue, then park until deleted from here. Neither wait is
+            // bounded: a worker still in a join must never be deleted, nor its queue.
+            SignalingMessage* stop = new SignalingMessage{SignalingMessage::Type::Stop};
+            xQueueSend(worker.queue, &stop, portMAX_DELAY);
+            xSemaphoreTake(worker.stopped, portMAX_DELAY);
+            vTaskDeleteWithCaps(worker.task);
+            worker.task = nullptr;
+        }
+
+        if (worker.queue) {
+            SignalingMessage* message;
+            while (xQueueReceive(worker.queue, &message, 0) == pdTRUE) {
+                delete message;
+            }
+            vQueueDelete(worker.queue);
+            worker.queue = nullptr;
+        }
+
+        if (worker.stopped) {
+            vSemaphoreDelete(worker.stopped);
+            worker.stopped = nullptr;
+        }
+    }
+}
+
+void WebRTCServer::enqueueSignalingMessage(SignalingMessage* message) {
+    size_t index = std::hash<std::string>{}(message->client_id) % SIGNALING_WORKERS;
+    SignalingWorker& worker = signaling_workers_[index];
+
+    if (!worker.queue || xQueueSend(worker.queue, &message, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        ESP_LOGE(TAG, "Signaling queue full, dropping message for client: %s",
+                 message->client_id.c_str());
+        delete message;
+    }
+}
+
+void WebRTCServer::signalingTaskEntry(void* arg) {
+    SignalingWorker* worker = static_cast<SignalingWorker*>(arg);
+
+    // PeerConnection creation spawns libjuice/usrsctp threads, keep their stacks in PSRAM
+    esp32_ensure_pthread_psram();
+
+    worker->server->signalingTaskLoop(*worker);
+
+    xSemaphoreGive(worker->stopped);
+    vTaskSuspend(NULL);  // Deleted by stopSignalingWorkers()
+}
+
+void WebRTCServer::signalingTaskLoop(SignalingWorker& worker) {
+    while (true) {
+        SignalingMessage* message = nullptr;
+        if (xQueueReceive(worker.queue, &message, portMAX_DELAY) != pdTRUE || !message) {
+            continue;
+        }
+
+        std::unique_ptr<SignalingMessage> owned(message);
+        try {
+            switch (message->type) {
+                case SignalingMessage::Type::Stop:
+                    return;
+
+                case SignalingMessage::Type::Request:
+                    handleRequest(message->client_id, message->received_us, message->lan);
+                    break;
+
+                case SignalingMessage::Type::Answer:
+                    handleAnswer(message->client_id, message->sdp);
+                    break;
+
+                case SignalingMessage::Type::Candidate: {
+                    // Coalesce queued candidates of the same client into one batch
+                    std::vector<std::pair<std::string, std::string>> candidates;
+                    candidates.emplace_back(std::move(message->candidate), std::move(message->mid));
+
+                    SignalingMessage* next = nullptr;
+                    while (xQueuePeek(worker.queue, &next, 0) == pdTRUE && next &&
+                           next->type == SignalingMessage::Type::Candidate &&
+                           next->client_id == message->client_id) {
+                        xQueueReceive(worker.queue, &next, 0);
+                        candidates.emplace_back(std::move(next->candidate), std::move(next->mid));
+                        delete next;
+                    }
+
+                    handleCandidates(message->client_id, candidates);
+                    break;
+                }
+            }
+        } catch (const std::exception& e) {
+            ESP_LOGE(TAG, "Signaling failed for client %s: %s",
+                     message->client_id.c_str(), e.what());
+        }
+    }
+}
+
+void WebRTCServer::handleRequest(const std::string& client_id, int64_t received_us, bool lan) {
+    ESP_LOGI(TAG, "Received connection request from %s client: %s",
+             lan ? "LAN" : "internet", client_id.c_str());
 
     // Create PeerConnection with ICE servers
+    // LAN clients use host candidates only: no STUN, so gathering completes immediately
     Configuration config;
-    config.iceServers.emplace_back("stun:stun.l.google.com:19302");
-    // Add TURN servers if needed
-    // config.iceServers.emplace_back("turn:...", port, "user", "pass", IceServer::RelayType::TurnUdp);
-
-    auto pc = std::make_shared<PeerConnection>(config);
+    if (!lan) {
+        config.iceServers.emplace_back("stun:stun.l.google.com:19302");
+        // Add TURN servers if needed
+        // config.iceServers.emplace_back("turn:...", port, "user", "pass", IceServer::RelayType::TurnUdp);
+    }
 
-    // Store PeerConnection for later candidate additions
+    // Admit on measured headroom, then create and store the PeerConnection for later candidate
+    // additions. All under one lock so that concurrent joins account for each other; rejected
+    // requests never create a PeerConnection, which would start tracking its memory.
+    std::shared_ptr<PeerConnection> pc;
     {
         std::lock_guard<std::mutex> lock(sessions_mutex_);
-        peer_connections_[client_id] = pc;
+        if (admitSession(client_id)) {
+            pc = std::make_shared<PeerConnection>(config);
+            peer_connections_[client_id] = pc;
+        }
     }
+    if (!pc) {
+        cJSON* msg = cJSON_CreateObject();
+        cJSON_AddStringToObject(msg, "type", "busy");
+        cJSON_AddStringToObject(msg, "client_id", client_id.c_str());
+
+        char* msg_str = cJSON_PrintUnformatted(msg);
+        if (msg_str) {
+            sendSignalingMessage(client_id, msg_str);
+            free(msg_str);
+        }
+        cJSON_Delete(msg);
+
+        {
+            std::lock_guard<std::mutex> lock(lan_mutex_);
+            lan_clients_.erase(client_id);
+        }
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        local_clients_.erase(client_id);
+        return;
+    }
+
+    // Offer is sent as soon as it is ready (internet) or once gathering completes (LAN)
+    auto send_offer = [this, client_id, received_us](const Description& description) {
+        ESP_LOGI(TAG, "Local Description Ready (Offer) for client %s, %lld ms after request",
+                 client_id.c_str(), (long long)((esp_timer_get_time() - received_us) / 1000));
+
+        cJSON* msg = cJSON_CreateObject();
+        cJSON_AddStringToObject(msg, "type", "offer");
+        cJSON_AddStringToObject(msg, "sdp", std::string(description).c_str());
+        cJSON_AddStringToObject(msg, "client_id", client_id.c_str());
 
-    // Handle ICE candidates
-    pc->onLocalCandidate([this, client_id](Candidate candidate) {
+        char* msg_str = cJSON_PrintUnformatted(msg);
+        if (msg_str) {
+            sendSignalingMessage(client_id, msg_str);
+            free(msg_str);
+        }
+        cJSON_Delete(msg);
+    };
+
+    // Handle ICE candidates (trickled to internet clients only, LAN offers embed them)
+    pc->onLocalCandidate([this, client_id, lan](Candidate candidate) {
         ESP_LOGI(TAG, "New local candidate");
+        if (lan) {
+            return;
+        }
 
         cJSON* msg = cJSON_CreateObject();
         cJSON_AddStringToObject(msg, "type", "candidate");
@@ -367,28 +681,29 @@ void WebRTCServer::handleRequest(const std::string& client_id) {
 
         char* msg_str = cJSON_PrintUnformatted(msg);
         if (msg_str) {
-            sendSignalingMessage(msg_str);
+            sendSignalingMessage(client_id, msg_str);
             free(msg_str);
         }
         cJSON_Delete(msg);
     });
 
     // Handle local description (send OFFER, not answer)
-    pc->onLocalDescription([this, client_id](Description description) {
-        ESP_LOGI(TAG, "Local Description Ready (Offer)");
-
-        cJSON* msg = cJSON_CreateObject();
-        cJSON_AddStringToObject(msg, "type", "offer");
-        cJSON_AddStringToObject(msg, "sdp", std::string(description).c_str());
-        cJSON_AddStringToObject(msg, "client_id", client_id.c_str());
-
-        char* msg_str = cJSON_PrintUnformatted(msg);
-        if (msg_str) {
-            sendSignalingMessage(msg_str);
-            free(msg_str);
-        }
-        cJSON_Delete(msg);
-    });
+    if (lan) {
+        // Single offer with all host candidates, one datagram each way
+        std::weak_ptr<PeerConnection> weak_pc = pc;
+        pc->onGatheringStateChange([weak_pc, send_offer](PeerConnection::GatheringState state) {
+            auto pc = weak_pc.lock();
+            if (pc && state == PeerConnection::GatheringState::Complete) {
+                if (auto description = pc->localDescription()) {
+                    send_offer(*description);
+                }
+            }
+        });
+    } else {
+        pc->onLocalDescription([send_offer](Description description) {
+            send_offer(description);
+        });
+    }
 
     // Create DataChannel (device creates it, not browser)
     ESP_LOGI(TAG, "Creating datachannel...");
@@ -427,35 +742,92 @@ void WebRTCServer::handleRequest(const std::string& client_id) {
     ESP_LOGI(TAG, "Adding video track...");
     const uint8_t payloadType = 96;
     const uint32_t ssrc = std::hash<std::string>{}(client_id) & 0xFFFFFFFF;  // Unique SSRC per client
-    const std::string cname = "video-stream";
-
-    Description::Video media(cname, Description::Direction::SendOnly);
+    const std::string mid = "video-stream";
+    // Audio and video share the CNAME and the stream, so that the browser synchronizes them
+    const std::string cname = "psi-" + uid_;
+    const std::string streamId = "stream1";
+    const int absSendTimeId = 2;
+    const int transportSequenceNumberId = 3;
+    const int dependencyDescriptorId = 4;
+    const int temporalLayers = video_streamer_ ? video_streamer_->getTemporalLayers() : 1;
+
+    Description::Video media(mid, Description::Direction::SendOnly);
     media.addH264Codec(payloadType);
-    media.addSSRC(ssrc, cname, "stream1", cname);
+    media.rtpMap(payloadType)->addFeedback("transport-cc");
+    media.addExtMap(Description::Media::ExtMap(
+        absSendTimeId, "http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time"));
+    media.addExtMap(Description::Media::ExtMap(
+        transportSequenceNumberId, "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01"));
+    if (temporalLayers > 1) {
+        // Tells the browser which frames it may miss when upper layers are skipped
+        media.addExtMap(Description::Media::ExtMap(
+            dependencyDescriptorId,
+            "https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension"));
+    }
+    media.addSSRC(ssrc, cname, streamId, mid);
     ESP_LOGI(TAG, "Calling pc->addTrack()...");
     auto video_track = pc->addTrack(media);
     ESP_LOGI(TAG, "pc->addTrack() returned");
 
-    // Create RTP configuration
-    auto rtpConfig = std::make_shared<RtpPacketizationConfig>(ssrc, cname, payloadType, H264RtpPacketizer::ClockRate);
-
-    // Create H.264 packetizer - use StartSequence for Annex-B format from ESP32 encoder
-    auto packetizer = std::make_shared<H264RtpPacketizer>(NalUnit::Separator::StartSequence, rtpConfig);
-
-    // Add RTCP SR handler
-    auto srReporter = std::make_shared<RtcpSrReporter>(rtpConfig);
-    packetizer->addToChain(srReporter);
+    // The sender chain is fixed, so it is composed at compile time: temporal layer selector,
+    // packetizer, then RTCP SR reporter, then NACK responder (with reduced size for ESP32 memory
+    // constraints)
+    using VideoSenderPipeline = MediaPipeline<TemporalLayerSelector, H264RtpPacketizer,
+                                              RtcpSrReporter, RtcpNackResponder>;
+    std::shared_ptr<VideoSenderPipeline> pipeline;
+    {
+        // Sequence numbers, timestamps and SR counters are updated for every packet
+        MemoryPlacement placement(MemoryClass::Hot);
+
+        // Create RTP configuration
+        auto rtpConfig = std::make_shared<RtpPacketizationConfig>(ssrc, cname, payloadType, H264RtpPacketizer::ClockRate);
+        rtpConfig->absSendTimeId = absSendTimeId;
+        rtpConfig->transportSequenceNumberId = transportSequenceNumberId;
+        rtpConfig->timestampOrigin = MediaClock::steadyOrigin();
+        if (temporalLayers > 1) {
+            rtpConfig->dependencyDescriptorId = dependencyDescriptorId;
+            rtpConfig->dependencyDescriptorContext =
+                DependencyDescriptorContext::TemporalLayers(temporalLayers);
+        }
 
-    // Add RTCP NACK handler (with reduced size for ESP32 memory constraints)
-    auto nackResponder = std::make_shared<RtcpNackResponder>();
-    packetizer->addToChain(nackResponder);
+        // Use StartSequence for Annex-B format from ESP32 encoder
+        pipeline = std::make_shared<VideoSenderPipeline>(
+            std::make_tuple(rtpConfig),
+            std::make_tuple(NalUnit::Separator::StartSequence, rtpConfig),
+            std::make_tuple(rtpConfig),
+            std::make_tuple());
+    }
 
     // Set media handler
-    video_track->setMediaHandler(packetizer);
+    video_track->setMediaHandler(pipeline);
+
+    // Transport-wide congestion control feedback covers every track of the connection. With
+    // temporal layers, loss lowers the frame rate of this viewer only.
+    std::weak_ptr<VideoSenderPipeline> weak_pipeline = pipeline;
+    auto layers = std::make_shared<TemporalLayerController>(temporalLayers);
+    pc->setMediaHandler(std::make_shared<TransportCcHandler>(
+        [client_id, weak_pipeline, layers, temporalLayers](const TransportFeedback& feedback) {
+            size_t received = std::count_if(feedback.packets.begin(), feedback.packets.end(),
+                                            [](const TransportFeedback::Packet& p) { return p.received; });
+            ESP_LOGD(TAG, "transport-cc #%u from %s: %u/%u packets received from seq %u",
+                     feedback.feedbackCount, client_id.c_str(), (unsigned)received,
+                     (unsigned)feedback.packets.size(), feedback.baseSequenceNumber);
+
+            if (temporalLayers <= 1 || !layers->update(received, feedback.packets.size())) {
+                return;
+            }
+
+            if (auto pipeline = weak_pipeline.lock()) {
+                pipeline->stage<0>().setMaxTemporalLayer(layers->layer());
+                ESP_LOGI(TAG, "Client %s: sending temporal layers up to T%u",
+                         client_id.c_str(), (unsigned)layers->layer());
+            }
+        }));
 
     // Set onOpen callback - add track to video streamer
-    video_track->onOpen([this, client_id, video_track]() {
-        ESP_LOGI(TAG, "Video track opened for client: %s", client_id.c_str());
+    video_track->onOpen([this, client_id, video_track, received_us]() {
+        ESP_LOGI(TAG, "Video track opened for client: %s, %lld ms after request", client_id.c_str(),
+                 (long long)((esp_timer_get_time() - received_us) / 1000));
 
         if (video_streamer_) {
             video_streamer_->addTrack(client_id, video_track);
@@ -473,6 +845,53 @@ void WebRTCServer::handleRequest(const std::string& client_id) {
 
     ESP_LOGI(TAG, "Added video track for client: %s (SSRC: %u)", client_id.c_str(), ssrc);
 
+    // Add audio track (will be included in offer)
+    if (audio_streamer_) {
+        const uint8_t audioPayloadType = 111;
+        const uint32_t audioSsrc = std::hash<std::string>{}(client_id + "/audio") & 0xFFFFFFFF;
+        const std::string audioMid = "audio-stream";
+
+        Description::Audio audio(audioMid, Description::Direction::SendOnly);
+        audio.addOpusCodec(audioPayloadType);
+        audio.addSSRC(audioSsrc, cname, streamId, audioMid);
+        auto audio_track = pc->addTrack(audio);
+
+        // Packetizer then RTCP SR reporter. No NACK responder: a retransmitted audio frame
+        // would arrive after its playout time.
+        using AudioSenderPipeline = MediaPipeline<OpusRtpPacketizer, RtcpSrReporter>;
+        std::shared_ptr<AudioSenderPipeline> audioPipeline;
+        {
+            MemoryPlacement placement(MemoryClass::Hot);
+
+            auto audioConfig = std::make_shared<RtpPacketizationConfig>(
+                audioSsrc, cname, audioPayloadType, OpusRtpPacketizer::DefaultClockRate);
+            audioConfig->timestampOrigin = MediaClock::steadyOrigin();
+
+            audioPipeline = std::make_shared<AudioSenderPipeline>(
+                std::make_tuple(audioConfig),
+                std::make_tuple(audioConfig));
+        }
+        audio_track->setMediaHandler(audioPipeline);
+
+        audio_track->onOpen([this, client_id, audio_track]() {
+            ESP_LOGI(TAG, "Audio track opened for client: %s", client_id.c_str());
+
+            if (audio_streamer_) {
+                audio_streamer_->addTrack(client_id, audio_track);
+            }
+        });
+
+        audio_track->onClosed([this, client_id]() {
+            ESP_LOGI(TAG, "Audio track closed for client: %s", client_id.c_str());
+
+            if (audio_streamer_) {
+                audio_streamer_->removeTrack(client_id);
+            }
+        });
+
+        ESP_LOGI(TAG, "Added audio track for client: %s (SSRC: %u)", client_id.c_str(), audioSsrc);
+    }
+
     // Create offer (no remote description yet)
     ESP_LOGI(TAG, "Calling setLocalDescription() to create offer...");
     pc->setLocalDescription();
@@ -498,9 +917,10 @@ void WebRTCServer::handleAnswer(const std::string& client_id, const std::string&
     ESP_LOGI(TAG, "Remote description set for client: %s", client_id.c_str());
 }
 
-void WebRTCServer::handleCandidate(const std::string& client_id, const std::string& candidate,
-                                    const std::string& mid) {
-    ESP_LOGI(TAG, "Received candidate from client: %s", client_id.c_str());
+void WebRTCServer::handleCandidates(const std::string& client_id,
+                                     const std::vector<std::pair<std::string, std::string>>& candidates) {
+    ESP_LOGI(TAG, "Received %d candidate(s) from client: %s",
+             (int)candidates.size(), client_id.c_str());
 
     std::shared_ptr<PeerConnection> pc;
     {
@@ -513,15 +933,50 @@ void WebRTCServer::handleCandidate(const std::string& client_id, const std::stri
         pc = it->second;
     }
 
-    try {
-        pc->addRemoteCandidate(Candidate(candidate, mid));
-        ESP_LOGI(TAG, "Added remote candidate");
-    } catch (const std::exception& e) {
-        ESP_LOGE(TAG, "Failed to add candidate: %s", e.what());
+    for (const auto& [candidate, mid] : candidates) {
+        try {
+            pc->addRemoteCandidate(Candidate(candidate, mid));
+            ESP_LOGI(TAG, "Added remote candidate");
+        } catch (const std::exception& e) {
+            ESP_LOGE(TAG, "Failed to add candidate: %s", e.what());
+        }
     }
 }
 
-void WebRTCServer::sendSignalingMessage(const std::string& message) {
+void WebRTCServer::sendSignalingMessage(const std::string& client_id, const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(lan_mutex_);
+        auto it = lan_clients_.find(client_id);
+        if (it != lan_clients_.end()) {
+            ESP_LOGI(TAG, "Sending LAN signaling message, len=%d", (int)message.length());
+            int ret = sendto(lan_socket_, message.data(), message.length(), 0,
+                             reinterpret_cast<const struct sockaddr*>(&it->second), sizeof(it->second));
+            if (ret < 0) {
+                ESP_LOGE(TAG, "Failed to send LAN signaling message, errno=%d", errno);
+            }
+            return;
+        }
+    }
+
+    std::shared_ptr<WebSocket> local_ws;
+    {
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        auto it = local_clients_.find(client_id);
+        if (it != local_clients_.end()) {
+            local_ws = it->second;
+        }
+    }
+    if (local_ws) {
+        // Sent outside the lock: a failed send closes the connection, and onClosed takes the lock
+        ESP_LOGI(TAG, "Sending local signaling message, len=%d", (int)message.length());
+        try {
+            local_ws->send(message);
+        } catch (const std::exception& e) {
+            ESP_LOGE(TAG, "Failed to send local signaling message: %s", e.what());
+        }
+        return;
+    }
+
     if (!ws_client_ || !esp_websocket_client_is_connected(ws_client_)) {
         ESP_LOGE(TAG, "WebSocket not connected");
         return;
@@ -535,11 +990,8 @@ void WebRTCServer::sendSignalingMessage(const std::string& message) {
 }
 
 void WebRTCServer::addSession(const std::string& client_id, std::shared_ptr<WebRTCSession> session) {
+    // Admission happened on request, see admitSession()
     std::lock_guard<std::mutex> lock(sessions_mutex_);
-    if (sessions_.size() >= MAX_SESSIONS) {
-        ESP_LOGE(TAG, "Max sessions reached, rejecting client: %s", client_id.c_str());
-        return;
-    }
     sessions_[client_id] = session;
     session->setHandlers(&uri_handlers_);
     ESP_LOGI(TAG, "Session added: %s (total: %d)", client_id.c_str(), (int)sessions_.size());
@@ -555,12 +1007,76 @@ void WebRTCServer::removeSession(const std::string& client_id) {
     // Also remove PeerConnection
     auto pc_it = peer_connections_.find(client_id);
     if (pc_it != peer_connections_.end()) {
+        recordSessionMemory(client_id, *pc_it->second);
         peer_connections_.erase(pc_it);
     }
 
+    {
+        std::lock_guard<std::mutex> lan_lock(lan_mutex_);
+        lan_clients_.erase(client_id);
+    }
+
+    {
+        std::lock_guard<std::mutex> local_lock(local_mutex_);
+        local_clients_.erase(client_id);
+    }
+
     // Note: Video track cleanup handled by onClosed() callback
 }
 
+bool WebRTCServer::admitSession(const std::string& client_id) {
+    // Established sessions raise the cost, sessions still setting up will grow up to it
+    std::vector<MemoryUsage> others;
+    for (const auto& [id, pc] : peer_connections_) {
+        MemoryUsage usage = pc->memoryUsage();
+        if (pc->state() == PeerConnection::State::Connected) {
+            admission_.established(usage);
+        }
+        if (id != client_id) {  // Otherwise replaced by this request
+            others.push_back(usage);
+        }
+    }
+
+    SessionAdmission::Budget needed = admission_.needed(others);
+    size_t internal_needed = needed.internal;
+    size_t psram_needed = needed.psram;
+    size_t internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    size_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    bool admitted = admission_.admit(needed, {internal_free, psram_free});
+    if (admitted) {
+        ESP_LOGI(TAG, "Admitting client %s: internal %d/%d KB, PSRAM %d/%d KB (needed/free)",
+                 client_id.c_str(), (int)(internal_needed / 1024), (int)(internal_free / 1024),
+                 (int)(psram_needed / 1024), (int)(psram_free / 1024));
+    } else {
+        ESP_LOGW(TAG, "Rejecting client %s, not enough memory: internal %d/%d KB, PSRAM %d/%d KB (needed/free)",
+                 client_id.c_str(), (int)(internal_needed / 1024), (int)(internal_free / 1024),
+                 (int)(psram_needed / 1024), (int)(psram_free / 1024));
+    }
+    return admitted;
+}
+
+void WebRTCServer::recordSessionMemory(const std::string& client_id, const PeerConnection& pc) {
+    MemoryUsage usage = pc.memoryUsage();
+    if (!usage.tracked) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Session memory for %s: internal %d KB (peak %d KB), PSRAM %d KB (peak %d KB)",
+             client_id.c_str(), (int)(usage.internal / 1024), (int)(usage.internalPeak / 1024),
+             (int)(usage.external / 1024), (int)(usage.externalPeak / 1024));
+    ESP_LOGI(TAG, "  by subsystem (KB): ICE %d, DTLS %d, SCTP %d, SRTP %d, media %d, NACK %d, other %d",
+             (int)(usage[MemorySubsystem::Ice] / 1024), (int)(usage[MemorySubsystem::Dtls] / 1024),
+             (int)(usage[MemorySubsystem::Sctp] / 1024), (int)(usage[MemorySubsystem::Srtp] / 1024),
+             (int)(usage[MemorySubsystem::Media] / 1024), (int)(usage[MemorySubsystem::Nack] / 1024),
+             (int)(usage[MemorySubsystem::Other] / 1024));
+    MemoryClassUsage hot = MemoryPlacement::Usage(MemoryClass::Hot);
+    ESP_LOGI(TAG, "  hot pool: %d/%d KB (peak %d KB), %d allocations spilled to PSRAM",
+             (int)(hot.used / 1024), (int)(hot.budget / 1024), (int)(hot.peak / 1024),
+             (int)hot.fallbacks);
+
+    admission_.closed(usage);
+}
+
 std::shared_ptr<WebRTCSession> WebRTCServer::getSession(const std::string& client_id) {
     std::lock_guard<std::mutex> lock(sessions_mutex_);
     auto it = sessions_.find(client_id);
@@ -590,17 +1106,35 @@ void WebRTCServer::start() {
     // Initialize handler dispatcher with Internal RAM stack (for file I/O)
     HandlerDispatcher::Instance().initialize();
 
+    // Signaling work runs off the WebSocket client task
+    if (!startSignalingWorkers()) {
+        stopSignalingWorkers();
+        return;
+    }
+
+    // The LAN and local signaling tasks loop while running_ is set, so it is set before they start
     running_ = true;
 
+    // LAN fast-connect runs alongside cloud signaling
+    if (lan_mode_ && !startLanSignaling()) {
+        ESP_LOGW(TAG, "LAN signaling unavailable, continuing with cloud signaling only");
+        stopLanSignaling();
+    }
+
+    // Local viewers can also signal to the device directly, without the cloud server
+    if (local_signaling_ && !startLocalSignaling()) {
+        ESP_LOGW(TAG, "Local signaling unavailable, continuing with cloud signaling only");
+        stopLocalSignaling();
+    }
+
     // Build WebSocket URL
     std::string ws_url = "wss://" + server_url_ + "/ws/device/" + uid_;
 
     esp_websocket_client_config_t websocket_cfg = {};
     websocket_cfg.uri = ws_url.c_str();
-    // 32KB stack: Required for regex-based SDP parsing in libdatachannel
-    // (complex RFC 3986 URL regex causes deep recursion)
-    // Parent project dispatches SDP parsing to MainThread to avoid this
-    websocket_cfg.task_stack = 32768;
+    // 12KB stack: TLS and JSON parsing only, SDP parsing (deep regex recursion)
+    // runs on the signaling workers
+    websocket_cfg.task_stack = 12288;
     websocket_cfg.buffer_size = 4096;  // Increased from 2KB to handle large server headers
     websocket_cfg.reconnect_timeout_ms = 10000;  // Explicit to suppress warning
     websocket_cfg.network_timeout_ms = 10000;  // Explicit to suppress warning
@@ -650,6 +1184,10 @@ void WebRTCServer::stop() {
         video_streamer_.reset();
     }
 
+    if (audio_streamer_) {
+        audio_streamer_.reset();
+    }
+
     // Close all sessions
     {
         std::lock_guard<std::mutex> lock(sessions_mutex_);
@@ -663,6 +1201,233 @@ void WebRTCServer::stop() {
         esp_websocket_client_destroy(ws_client_);
         ws_client_ = nullptr;
     }
+
+    stopLanSignaling();
+    stopLocalSignaling();
+    stopAdvertising();
+
+    // No more signaling messages can arrive
+    stopSignalingWorkers();
+}
+
+//=============================================================================
+// LAN Fast-Connect Signaling
+//=============================================================================
+
+bool WebRTCServer::startLanSignaling() {
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "Failed to create LAN signaling socket, errno=%d", errno);
+        return false;
+    }
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(LAN_SIGNALING_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ESP_LOGE(TAG, "Failed to bind LAN signaling port %d, errno=%d", LAN_SIGNALING_PORT, errno);
+        close(fd);
+        return false;
+    }
+
+    // lwIP cannot shut down a UDP socket to unblock recvfrom(), the task polls running_ instead
+    struct timeval timeout = {};
+    timeout.tv_usec = LAN_RECEIVE_TIMEOUT_MS * 1000;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    {
+        std::lock_guard<std::mutex> lock(lan_mutex_);
+        lan_socket_ = fd;
+    }
+
+    lan_task_stopped_ = xSemaphoreCreateBinary();
+    if (!lan_task_stopped_) {
+        return false;
+    }
+
+    // Small PSRAM stack: the task only receives and parses JSON
+    BaseType_t ret = xTaskCreateWithCaps(lanTaskEntry, "lan_signal", 8192, this, 5, &lan_task_,
+                                         MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create LAN signaling task");
+        lan_task_ = nullptr;
+        return false;
+    }
+
+    // Advertise the bootstrap endpoint so local viewers can find the device
+    advertiseSignaling("_udp", LAN_SIGNALING_PORT, "swsp");
+    return true;
+}
+
+void WebRTCServer::stopLanSignaling() {
+    // The LAN task sees running_ cleared within a receive timeout, the socket is closed once it
+    // has stopped so that it never receives on a closed or reused descriptor
+    if (lan_task_) {
+        xSemaphoreTake(lan_task_stopped_, portMAX_DELAY);
+        vTaskDeleteWithCaps(lan_task_);
+        lan_task_ = nullptr;
+    }
+
+    if (lan_task_stopped_) {
+        vSemaphoreDelete(lan_task_stopped_);
+        lan_task_stopped_ = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(lan_mutex_);
+    if (lan_socket_ >= 0) {
+        close(lan_socket_);
+        lan_socket_ = -1;
+    }
+    lan_clients_.clear();
+}
+
+void WebRTCServer::lanTaskEntry(void* arg) {
+    WebRTCServer* server = static_cast<WebRTCServer*>(arg);
+    // Set before the task was created, and only closed after it stopped
+    server->lanTaskLoop(server->lan_socket_);
+
+    xSemaphoreGive(server->lan_task_stopped_);
+    vTaskSuspend(NULL);  // Deleted by stopLanSignaling()
+}
+
+void WebRTCServer::lanTaskLoop(int fd) {
+    // One signaling message per datagram
+    std::vector<char> buffer(WS_MESSAGE_BUFFER_SIZE);
+
+    while (running_) {
+        struct sockaddr_in source = {};
+        socklen_t source_len = sizeof(source);
+        int len = recvfrom(fd, buffer.data(), buffer.size(), 0,
+                           reinterpret_cast<struct sockaddr*>(&source), &source_len);
+        if (len < 0) {
+            if (!running_ || errno == EAGAIN || errno == EWOULDBLOCK) {
+                continue;  // Receive timeout
+            }
+            ESP_LOGW(TAG, "LAN signaling receive failed, errno=%d", errno);
+            vTaskDelay(pdMS_TO_TICKS(100));
+            continue;
+        }
+
+        if (len > 0) {
+            handleSignalingMessage(std::string(buffer.data(), len), &source);
+        }
+    }
+}
+
+//=============================================================================
+// Local WebSocket Signaling
+//=============================================================================
+
+bool WebRTCServer::startLocalSignaling() {
+    // Plain WebSocket: local clients skip the cloud, not the DTLS of the media
+    WebSocketServerConfiguration config;
+    config.port = LOCAL_SIGNALING_PORT;
+    config.maxMessageSize = WS_MESSAGE_BUFFER_SIZE;
+    config.connectionTimeout = std::chrono::milliseconds(10000);
+
+    try {
+        local_server_ = std::make_unique<WebSocketServer>(std::move(config));
+    } catch (const std::exception& e) {
+        ESP_LOGE(TAG, "Failed to start local signaling server: %s", e.what());
+        return false;
+    }
+
+    local_server_->onClient([this](std::shared_ptr<WebSocket> ws) {
+        acceptLocalClient(std::move(ws));
+    });
+
+    advertiseSignaling("_tcp", LOCAL_SIGNALING_PORT, "ws");
+    return true;
+}
+
+void WebRTCServer::stopLocalSignaling() {
+    // Joins the accept thread, no client can be added after this
+    local_server_.reset();
+
+    std::vector<std::shared_ptr<WebSocket>> sockets;
+    {
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        sockets.swap(local_sockets_);
+        local_clients_.clear();
+    }
+
+    // The callbacks reference this server
+    for (auto& ws : sockets) {
+        ws->resetCallbacks();
+        ws->close();
+    }
+}
+
+void WebRTCServer::acceptLocalClient(std::shared_ptr<WebSocket> ws) {
+    // Runs on the accept thread, messages arrive on the poll thread
+    {
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        if (!running_ || local_sockets_.size() >= LOCAL_SIGNALING_MAX_CLIENTS) {
+            ESP_LOGW(TAG, "Rejecting local signaling client, %d connected", (int)local_sockets_.size());
+            ws->close();
+            return;
+        }
+        local_sockets_.push_back(ws);
+    }
+
+    ESP_LOGI(TAG, "Local signaling client connected");
+
+    // Messages that arrived during the handshake are delivered by onMessage() on this thread,
+    // so it is called without holding local_mutex_
+    std::weak_ptr<WebSocket> weak_ws = ws;
+    ws->onMessage([this, weak_ws](message_variant data) {
+        auto ws = weak_ws.lock();
+        if (ws && std::holds_alternative<std::string>(data)) {
+            handleSignalingMessage(std::get<std::string>(data), nullptr, ws);
+        }
+    });
+
+    // Callbacks are safe to reset while running, so the last reference can go here
+    const WebSocket* raw = ws.get();
+    ws->onClosed([this, raw]() {
+        ESP_LOGI(TAG, "Local signaling client disconnected");
+        std::lock_guard<std::mutex> lock(local_mutex_);
+        for (auto it = local_clients_.begin(); it != local_clients_.end();) {
+            it = (it->second.get() == raw) ? local_clients_.erase(it) : std::next(it);
+        }
+        local_sockets_.erase(std::remove_if(local_sockets_.begin(), local_sockets_.end(),
+                                            [raw](const auto& s) { return s.get() == raw; }),
+                             local_sockets_.end());
+    });
+}
+
+//=============================================================================
+// mDNS Advertisement
+//=============================================================================
+
+void WebRTCServer::advertiseSignaling(const char* proto, uint16_t port, const char* protocol) {
+    std::string hostname = "psi-" + uid_;
+    if (!mdns_started_) {
+        esp_err_t err = mdns_init();
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "mDNS init failed (%s), signaling on port %d reachable by address only",
+                     esp_err_to_name(err), port);
+            return;
+        }
+        mdns_started_ = true;
+        mdns_hostname_set(hostname.c_str());
+        mdns_instance_name_set("PSI device");
+    }
+
+    mdns_txt_item_t txt[] = {
+        {"uid", uid_.c_str()},
+        {"proto", protocol},
+    };
+    mdns_service_add(nullptr, "_psi", proto, port, txt, 2);
+    ESP_LOGI(TAG, "Signaling (_psi.%s, %s) on %s.local:%d", proto, protocol, hostname.c_str(), port);
+}
+
+void WebRTCServer::stopAdvertising() {
+    if (mdns_started_) {
+        mdns_free();
+        mdns_started_ = false;
+    }
 }
 
 //=============================================================================
@@ -690,8 +1455,16 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config) {
     const char* server_env = getenv("PSI_SERVER");
     std::string server_url = server_env ? server_env : "psi.vizycam.com";
 
+    // LAN fast-connect signaling (mDNS-advertised, host candidates only)
+    const char* lan_env = getenv("PSI_LAN_MODE");
+    bool lan_mode = lan_env && strcmp(lan_env, "1") == 0;
+
+    // Local WebSocket signaling (mDNS-advertised, no cloud hop)
+    const char* local_env = getenv("PSI_LOCAL_SIGNALING");
+    bool local_signaling = local_env && strcmp(local_env, "1") == 0;
+
     auto ctx = new httpd_server_context();
-    ctx->server = new WebRTCServer(uid, server_url);
+    ctx->server = new WebRTCServer(uid, server_url, lan_mode, local_signaling);
     ctx->server->start();
 
     *handle = (httpd_handle_t)ctx;
@@ -15,6 +15,8 @@
 #define HTTPD_SERVER_HPP
 
 #include "rtc/rtc.hpp"
+#include "session_admission.hpp"
+#include "ws_message_assembler.hpp"
 #include "esp_http_server.h"
 #include "esp_websocket_client.h"
 #include "esp_timer.h"
@@ -22,6 +24,7 @@
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "freertos/semphr.h"
+#include "lwip/sockets.h"
 
 #include <string>
 #include <vector>
@@ -29,6 +32,7 @@
 #include <memory>
 #include <mutex>
 #include <atomic>
+#include <utility>
 
 // SWSP Protocol Constants
 const uint16_t FLAG_SYN = 0x0001;  // Metadata frame
@@ -92,6 +96,10 @@ public:
     }
 
 private:
+    // Requests are shed with 503 below this much free internal RAM, so a burst of SWSP
+    // traffic cannot starve WiFi and lwIP
+    static constexpr size_t REQUEST_INTERNAL_RESERVE = 32 * 1024;
+
     std::string client_id_;
     std::shared_ptr<rtc::PeerConnection> pc_;
     std::shared_ptr<rtc::DataChannel> dc_;
@@ -109,7 +117,8 @@ private:
 
 class WebRTCServer {
 public:
-    WebRTCServer(const std::string& uid, const std::string& server_url);
+    WebRTCServer(const std::string& uid, const std::string& server_url, bool lan_mode = false,
+                 bool local_signaling = false);
     ~WebRTCServer();
 
     // Lifecycle
@@ -125,12 +134,73 @@ public:
     esp_err_t registerHandler(const httpd_uri_t* uri_handler);
 
 private:
-    static constexpr size_t MAX_SESSIONS = 4;  // Limited for ESP32 memory
+    // Admission control: a viewer is admitted only if the cost of a session fits in the free heap
+    // above these reserves (WiFi, lwIP and the video pipeline allocate after admission)
+    static constexpr size_t INTERNAL_RESERVE = 64 * 1024;
+    static constexpr size_t PSRAM_RESERVE = 1024 * 1024;
+
+    // Session cost until one has been measured (COMPONENTS_MEMORY_ANALYSIS.md, ~247 KB)
+    static constexpr size_t SESSION_INTERNAL_SEED = 247 * 1024;
+    static constexpr size_t SESSION_PSRAM_SEED = 512 * 1024;
+
+    // Signaling message reassembly: preallocated once, messages above this size are dropped
+    static constexpr size_t WS_MESSAGE_BUFFER_SIZE = 16384;
+
+    // Signaling workers: each client is pinned to one worker so its messages stay ordered,
+    // while joins from different clients proceed in parallel
+    static constexpr int SIGNALING_WORKERS = 2;
+    static constexpr int SIGNALING_QUEUE_DEPTH = 16;
+    static constexpr uint32_t SIGNALING_TASK_STACK = 32768;  // Regex-based SDP parsing recurses deeply
+
+    // Video temporal layers: 1 uses the hardware encoder (IPPP), 2 or 3 the openh264 software
+    // encoder (L1T2/L1T3), so a viewer on a lossy link gets a lower frame rate instead of a
+    // broken stream. The software encoder is much slower than the hardware one.
+    static constexpr int VIDEO_TEMPORAL_LAYERS = 1;
+
+    // Audio: Opus track next to the video track, captured from an I2S microphone, or played
+    // from a WAV file (16-bit PCM, 48 kHz) when AUDIO_WAV_FILE is set. Off by default: the
+    // capture reads an I2S microphone like the INMP441 wired to the GPIOs below, the codec chip
+    // of the board is not configured.
+    static constexpr bool AUDIO_ENABLED = false;
+    static constexpr uint32_t AUDIO_FRAME_MS = 20;  // 10 or 20
+    static constexpr uint32_t AUDIO_BITRATE = 32000;
+    static constexpr const char* AUDIO_WAV_FILE = "";  // e.g. "/littlefs/test.wav"
+    static constexpr int AUDIO_I2S_BCLK_GPIO = 12;
+    static constexpr int AUDIO_I2S_WS_GPIO = 10;
+    static constexpr int AUDIO_I2S_DIN_GPIO = 11;
+
+    // LAN fast-connect: signaling over UDP on the local network, advertised over mDNS.
+    // LAN clients use host candidates only, so there is no STUN round-trip.
+    static constexpr uint16_t LAN_SIGNALING_PORT = 8765;
+    static constexpr int LAN_RECEIVE_TIMEOUT_MS = 200;  // Stop latency of the LAN task
+
+    // Local signaling: WebSocket server on the device (mDNS _psi._tcp), same JSON messages as
+    // the cloud signaling server. Local clients are treated as LAN clients.
+    static constexpr uint16_t LOCAL_SIGNALING_PORT = 8766;
+    static constexpr size_t LOCAL_SIGNALING_MAX_CLIENTS = 4;  // One socket each, lwIP has few
 
     std::string uid_;
     std::string server_url_;
     esp_websocket_client_handle_t ws_client_ = nullptr;
 
+    // LAN fast-connect signaling
+    bool lan_mode_;
+    int lan_socket_ = -1;  // Written under lan_mutex_ while the LAN task is not running
+    TaskHandle_t lan_task_ = nullptr;
+    SemaphoreHandle_t lan_task_stopped_ = nullptr;
+    std::map<std::string, struct sockaddr_in> lan_clients_;  // client_id -> reply address
+    std::mutex lan_mutex_;
+
+    // Local WebSocket signaling
+    bool local_signaling_;
+    std::unique_ptr<rtc::WebSocketServer> local_server_;
+    std::vector<std::shared_ptr<rtc::WebSocket>> local_sockets_;  // Open connections
+    std::map<std::string, std::shared_ptr<rtc::WebSocket>> local_clients_;  // client_id -> connection
+    std::mutex local_mutex_;
+
+    // mDNS responder, shared by LAN and local signaling
+    bool mdns_started_ = false;
+
     // Session registry
     std::map<std::string, std::shared_ptr<WebRTCSession>> sessions_;
     std::mutex sessions_mutex_;
@@ -138,29 +208,85 @@ private:
     // PeerConnection registry (for adding remote candidates)
     std::map<std::string, std::shared_ptr<rtc::PeerConnection>> peer_connections_;
 
+    // Measured session cost, under sessions_mutex_
+    SessionAdmission admission_{{INTERNAL_RESERVE, PSRAM_RESERVE},
+                                {SESSION_INTERNAL_SEED, SESSION_PSRAM_SEED}};
+
     // Video streaming (single VideoStreamer handles all clients)
     std::unique_ptr<class VideoStreamer> video_streamer_;
 
+    // Audio streaming (single AudioStreamer handles all clients, null if disabled)
+    std::unique_ptr<class AudioStreamer> audio_streamer_;
+
     // HTTP handlers
     std::vector<httpd_uri_t> uri_handlers_;
 
     // Reconnection state
     std::atomic<bool> running_{false};
 
-    // Message buffer for fragmented WebSocket messages
-    std::string ws_message_buffer_;
+    // Fragmented WebSocket messages, reassembled by FIN/opcode in a preallocated buffer
+    WsMessageAssembler ws_assembler_{WS_MESSAGE_BUFFER_SIZE};
+
+    // Parsed signaling message, handed from the WebSocket task to a signaling worker
+    struct SignalingMessage {
+        enum class Type { Request, Answer, Candidate, Stop };
+        Type type;
+        std::string client_id;
+        std::string sdp;        // Answer
+        std::string candidate;  // Candidate
+        std::string mid;        // Candidate
+        int64_t received_us;    // Arrival time, for join latency measurement
+        bool lan;               // Received over LAN or local signaling
+    };
+
+    struct SignalingWorker {
+        WebRTCServer* server = nullptr;
+        QueueHandle_t queue = nullptr;
+        TaskHandle_t task = nullptr;
+        SemaphoreHandle_t stopped = nullptr;
+    };
+    SignalingWorker signaling_workers_[SIGNALING_WORKERS];
 
-    // WebSocket event handling
+    // WebSocket event handling (runs on the esp_websocket_client task, must not block)
     static void websocketEventHandler(void* handler_args, esp_event_base_t base,
                                        int32_t event_id, void* event_data);
-    void handleWebSocketMessage(const std::string& message);
+    void handleWebSocketData(const esp_websocket_event_data_t* data);
+    void handleSignalingMessage(const std::string& message,
+                                const struct sockaddr_in* lan_source = nullptr,
+                                const std::shared_ptr<rtc::WebSocket>& local_source = nullptr);
+
+    // LAN fast-connect signaling
+    bool startLanSignaling();
+    void stopLanSignaling();
+    static void lanTaskEntry(void* arg);
+    void lanTaskLoop(int fd);
+
+    // Local WebSocket signaling
+    bool startLocalSignaling();
+    void stopLocalSignaling();
+    void acceptLocalClient(std::shared_ptr<rtc::WebSocket> ws);
+
+    // mDNS advertisement of the signaling endpoints
+    void advertiseSignaling(const char* proto, uint16_t port, const char* protocol);
+    void stopAdvertising();
+
+    // Signaling workers
+    bool startSignalingWorkers();
+    void stopSignalingWorkers();
+    void enqueueSignalingMessage(SignalingMessage* message);
+    static void signalingTaskEntry(void* arg);
+    void signalingTaskLoop(SignalingWorker& worker);
+
+    // Admission control (requires sessions_mutex_)
+    bool admitSession(const std::string& client_id);
+    void recordSessionMemory(const std::string& client_id, const rtc::PeerConnection& pc);
 
     // Signaling
-    void handleRequest(const std::string& client_id);
+    void handleRequest(const std::string& client_id, int64_t received_us, bool lan);
     void handleAnswer(const std::string& client_id, const std::string& sdp);
-    void handleCandidate(const std::string& client_id, const std::string& candidate,
-                         const std::string& mid);
-    void sendSignalingMessage(const std::string& message);
+    void handleCandidates(const std::string& client_id,
+                          const std::vector<std::pair<std::string, std::string>>& candidates);
+    void sendSignalingMessage(const std::string& client_id, const std::string& message);
 };
 
 //=============================================================================
@@ -0,0 +1,36 @@
+/**
+ * MediaClock - Capture clock shared by the audio and video pipelines
+ *
+ * Frame timestamps of both tracks count from one origin, taken at capture, and sender reports
+ * map that origin to NTP time (rtc::RtpPacketizationConfig::timestampOrigin), so that browsers
+ * can synchronize audio and video.
+ */
+
+#ifndef MEDIA_CLOCK_HPP
+#define MEDIA_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include "esp_timer.h"
+
+class MediaClock {
+public:
+    // Origin in esp_timer time, fixed on first use
+    static int64_t originUs() {
+        static const int64_t origin = esp_timer_get_time();
+        return origin;
+    }
+
+    // Frame timestamp of a capture time (esp_timer_get_time())
+    static std::chrono::duration<double> timestamp(int64_t capture_us) {
+        return std::chrono::duration<double>((capture_us - originUs()) / 1000000.0);
+    }
+
+    // Origin on the clock of sender reports (steady_clock and esp_timer share the systimer)
+    static std::chrono::steady_clock::time_point steadyOrigin() {
+        int64_t elapsed_us = esp_timer_get_time() - originUs();
+        return std::chrono::steady_clock::now() - std::chrono::microseconds(elapsed_us);
+    }
+};
+
+#endif // MEDIA_CLOCK_HPP
@@ -30,6 +30,7 @@
 #include "httpd_test.h"
 #include "esp32_psram_init.h"
 #include "example_video_common.h"
+#include "mbedtls/base64.h"
 
 static const char *TAG = "psi_main";
 
@@ -45,6 +46,23 @@ static const char *TAG = "psi_main";
 #define PSI_SERVER_URL "psi.vizycam.com"
 #define DEVICE_UID "0123456789"
 
+// LAN fast-connect: local viewers signal directly over UDP (mDNS _psi._udp), host candidates only
+#define LAN_MODE 1
+
+// Local signaling: WebSocket server on the device (mDNS _psi._tcp, port 8766) speaking the same
+// JSON messages as the cloud signaling server, so local viewers need no internet access
+#define LOCAL_SIGNALING 1
+
+// Sampling heap profiler: GET /debug/heap returns a pprof profile, symbolize with the app ELF
+// e.g. pprof -top build/psi.elf heap.pb
+#define HEAP_PROFILER 1
+#define HEAP_PROFILE_INTERVAL (16 * 1024)  // Mean bytes allocated between samples
+#define HEAP_PROFILE_DUMP_PERIOD_S 0       // Also print the profile on serial periodically, 0 to disable
+
+// DTLS certificates generated in the background for the next viewers, so they don't wait for key
+// generation when joining, 0 to disable
+#define CERTIFICATE_POOL_SIZE 1
+
 // FreeRTOS event group for WiFi connection
 static EventGroupHandle_t s_wifi_event_group;
 #define WIFI_CONNECTED_BIT BIT0
@@ -270,6 +288,53 @@ extern "C" void app_main(void) {
 }
 
 #else
+#if HEAP_PROFILER
+// Print the heap profile on serial as base64, extract it from the monitor log with:
+// sed -n '/BEGIN HEAP PROFILE/,/END HEAP PROFILE/{//!p}' log.txt | base64 -d > heap.pb
+static void dump_heap_profile(void) {
+    rtc::binary profile = rtc::ExportHeapProfile();
+    rtc::HeapProfilerStats stats = rtc::GetHeapProfilerStats();
+    ESP_LOGI(TAG, "Heap profile: %u bytes, %u samples, %u live, %u sites, %u dropped",
+             (unsigned)profile.size(), (unsigned)stats.samples, (unsigned)stats.liveSamples,
+             (unsigned)stats.sites, (unsigned)stats.dropped);
+
+    const size_t chunk = 57;  // 76 base64 characters per line
+    unsigned char line[80];
+    printf("-----BEGIN HEAP PROFILE-----\n");
+    for (size_t offset = 0; offset < profile.size(); offset += chunk) {
+        size_t written = 0;
+        size_t len = std::min(chunk, profile.size() - offset);
+        mbedtls_base64_encode(line, sizeof(line), &written,
+                              reinterpret_cast<const unsigned char *>(profile.data()) + offset, len);
+        printf("%.*s\n", (int)written, line);
+    }
+    printf("-----END HEAP PROFILE-----\n");
+}
+
+// Serve the heap profile over SWSP, e.g. fetch /debug/heap from the viewer and save as heap.pb
+// /debug/heap?serial prints it on serial instead
+static esp_err_t heap_profile_handler(httpd_req_t *req) {
+    char query[16];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK && strstr(query, "serial")) {
+        dump_heap_profile();
+        httpd_resp_set_type(req, "text/plain");
+        return httpd_resp_send(req, "Heap profile printed on serial\n", HTTPD_RESP_USE_STRLEN);
+    }
+
+    rtc::binary profile = rtc::ExportHeapProfile();
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"heap.pb\"");
+    return httpd_resp_send(req, reinterpret_cast<const char *>(profile.data()), profile.size());
+}
+
+static const httpd_uri_t uri_heap_profile = {
+    .uri       = "/debug/heap",
+    .method    = HTTP_GET,
+    .handler   = heap_profile_handler,
+    .user_ctx  = NULL
+};
+#endif
+
 // Normal mode: Full WebRTC server
 extern "C" void app_main(void) {
     ESP_LOGI(TAG, "Starting PSI ESP32 WebRTC Server...");
@@ -290,6 +355,12 @@ extern "C" void app_main(void) {
     // Enable PSRAM as default malloc target
     enable_psram_malloc();
 
+#if HEAP_PROFILER
+    // Start early so that WiFi and libdatachannel setup show up in the profile
+    if (!rtc::StartHeapProfiler(HEAP_PROFILE_INTERVAL))
+        ESP_LOGW(TAG, "Failed to start heap profiler");
+#endif
+
     // Initialize LittleFS for static files
     littlefs_init();
 
@@ -338,7 +409,13 @@ extern "C" void app_main(void) {
     // Initialize libdatachannel
     ESP_LOGI(TAG, "Initializing libdatachannel...");
     rtc::InitLogger(rtc::LogLevel::Info);
+
+    // One event loop serves ICE sockets and network timers instead of a thread each
+    rtc::ThreadingSettings threading;
+    threading.singleReactor = true;
+    rtc::SetThreadingSettings(threading);
     rtc::StartNetworking();
+    rtc::SetCertificatePoolSize(CERTIFICATE_POOL_SIZE);
 
     ESP_LOGI(TAG, "After libdatachannel init - Internal RAM: %d KB free",
              heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024);
@@ -358,6 +435,8 @@ extern "C" void app_main(void) {
     // Set environment variables for httpd_start() to use
     setenv("DEVICE_UID", DEVICE_UID, 1);
     setenv("PSI_SERVER", PSI_SERVER_URL, 1);
+    setenv("PSI_LAN_MODE", LAN_MODE ? "1" : "0", 1);
+    setenv("PSI_LOCAL_SIGNALING", LOCAL_SIGNALING ? "1" : "0", 1);
 
     // Start HTTP server (uses WebRTC DataChannel transport)
     // This is the ESP-IDF compatible API - same code works on desktop and ESP32
@@ -367,14 +446,28 @@ extern "C" void app_main(void) {
         return;
     }
 
+#if HEAP_PROFILER
+    httpd_register_uri_handler(httpd_test_get_handle(), &uri_heap_profile);
+#endif
+
     ESP_LOGI(TAG, "Server started! Access via: https://%s/%s", PSI_SERVER_URL, DEVICE_UID);
     ESP_LOGI(TAG, "After server start - Internal RAM: %d KB free",
              heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024);
 
     // Main loop - monitor heap and tasks
+#if HEAP_PROFILER && HEAP_PROFILE_DUMP_PERIOD_S > 0
+    int64_t last_heap_dump_us = esp_timer_get_time();
+#endif
     while (true) {
         vTaskDelay(pdMS_TO_TICKS(5000));  // Log every 5 seconds
 
+#if HEAP_PROFILER && HEAP_PROFILE_DUMP_PERIOD_S > 0
+        if (esp_timer_get_time() - last_heap_dump_us >= HEAP_PROFILE_DUMP_PERIOD_S * 1000000LL) {
+            dump_heap_profile();
+            last_heap_dump_us = esp_timer_get_time();
+        }
+#endif
+
         size_t free_heap = esp_get_free_heap_size();
         size_t free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
         UBaseType_t num_tasks = uxTaskGetNumberOfTasks();
@@ -0,0 +1,71 @@
+/**
+ * SessionAdmission - Admits viewers on measured heap headroom
+ *
+ * The cost of a session is the high watermark of established sessions with a 25% margin, or a
+ * seed until one has been measured. It decays by 1/8 per closed session so that it follows the
+ * current workload. A viewer is admitted if the free heap covers a reserve, the cost of the new
+ * session, and what the other sessions have left to grow up to the cost.
+ */
+
+#ifndef SESSION_ADMISSION_HPP
+#define SESSION_ADMISSION_HPP
+
+#include "rtc/memoryusage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+class SessionAdmission {
+public:
+    struct Budget {
+        size_t internal;
+        size_t psram;
+    };
+
+    // reserve: heap kept free for WiFi, lwIP and the media pipelines
+    // seed: session cost until one has been measured
+    SessionAdmission(Budget reserve, Budget seed) : reserve_(reserve), seed_(seed), measured_{0, 0} {}
+
+    // An established session has reached its working size: its watermarks raise the cost
+    void established(const rtc::MemoryUsage& usage) {
+        if (usage.tracked) {
+            measured_.internal = std::max(measured_.internal, usage.internalPeak);
+            measured_.psram = std::max(measured_.psram, usage.externalPeak);
+        }
+    }
+
+    // A session closed: decay toward its watermarks
+    void closed(const rtc::MemoryUsage& usage) {
+        if (usage.tracked) {
+            measured_.internal = std::max(usage.internalPeak, measured_.internal - measured_.internal / 8);
+            measured_.psram = std::max(usage.externalPeak, measured_.psram - measured_.psram / 8);
+        }
+    }
+
+    Budget cost() const {
+        return {measured_.internal ? measured_.internal * 5 / 4 : seed_.internal,
+                measured_.psram ? measured_.psram * 5 / 4 : seed_.psram};
+    }
+
+    // Heap needed to admit one more session next to others (current usage of each)
+    Budget needed(const std::vector<rtc::MemoryUsage>& others) const {
+        Budget c = cost();
+        Budget result = {reserve_.internal + c.internal, reserve_.psram + c.psram};
+        for (const auto& usage : others) {
+            result.internal += c.internal - std::min(c.internal, usage.internal);
+            result.psram += c.psram - std::min(c.psram, usage.external);
+        }
+        return result;
+    }
+
+    bool admit(const Budget& needed, const Budget& free) const {
+        return free.internal >= needed.internal && free.psram >= needed.psram;
+    }
+
+private:
+    Budget reserve_;
+    Budget seed_;
+    Budget measured_;  // High watermarks, 0 until measured
+};
+
+#endif // SESSION_ADMISSION_HPP
@@ -0,0 +1,61 @@
+/**
+ * SpscRing - Lock-free single-producer single-consumer ring of fixed-size slots
+ *
+ * The producer fills the slot returned by writeSlot() in place and publishes it with push(), the
+ * consumer reads slots with peek() and releases them with pop(). Indexes only grow, the capacity
+ * is a power of two so that wrapping is a mask.
+ */
+
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer: free slot, or nullptr if the ring is full
+    T* writeSlot() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) {
+            return nullptr;
+        }
+        return &slots_[head & (N - 1)];
+    }
+
+    // Producer: publishes the slot returned by writeSlot()
+    void push() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: index-th published slot from the oldest, size() must be greater than index
+    const T& peek(size_t index) const {
+        return slots_[(tail_.load(std::memory_order_relaxed) + index) & (N - 1)];
+    }
+
+    // Consumer: releases the count oldest slots
+    void pop(size_t count = 1) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer: published slots
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+    // Consumer, with the producer stopped
+    void clear() { tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    std::array<T, N> slots_;
+    alignas(64) std::atomic<size_t> head_{0};  // Written by the producer
+    alignas(64) std::atomic<size_t> tail_{0};  // Written by the consumer
+};
+
+#endif // SPSC_RING_HPP
@@ -0,0 +1,213 @@
+/**
+ * Audio latency test - WAV source to viewer over loopback
+ *
+ * The device side is the audio part of WebRTCServer: an AudioStreamer playing a WAV file into an
+ * Opus track with the packetizer and SR reporter pipeline of handleRequest(). The viewer maps RTP
+ * timestamps to capture times through sender reports like a browser does for lip sync, and the
+ * end-to-end latency of each packet is its arrival time minus that capture time.
+ *
+ * A frame is sent once captured in full, so the latency is expected to be the frame duration
+ * plus encoding, packetization and loopback transport.
+ */
+
+#include "audio_streamer.hpp"
+#include "media_clock.hpp"
+#include "rtc/rtc.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace rtc;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint32_t FRAME_MS = 20;    // As WebRTCServer::AUDIO_FRAME_MS
+constexpr uint32_t BITRATE = 32000;  // As WebRTCServer::AUDIO_BITRATE
+constexpr auto DURATION = 4s;
+constexpr double TRANSPORT_MARGIN_MS = 15;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error(what);
+    }
+}
+
+// One second of a 440 Hz tone, 16-bit mono at 48 kHz, looped by the source
+std::string writeWav() {
+    char path[] = "/tmp/audio_latency_XXXXXX";
+    int fd = mkstemp(path);
+    check(fd >= 0, "Cannot create the WAV file");
+
+    const uint32_t rate = AudioStreamer::SAMPLE_RATE;
+    std::vector<int16_t> samples(rate);
+    for (size_t i = 0; i < samples.size(); i++) {
+        samples[i] = int16_t(8000 * std::sin(2 * M_PI * 440 * i / rate));
+    }
+
+    auto le32 = [](uint32_t v) { return std::string(reinterpret_cast<const char*>(&v), 4); };
+    auto le16 = [](uint16_t v) { return std::string(reinterpret_cast<const char*>(&v), 2); };
+    uint32_t data_size = samples.size() * sizeof(int16_t);
+    std::string header = "RIFF" + le32(36 + data_size) + "WAVE" + "fmt " + le32(16) + le16(1) +
+                         le16(1) + le32(rate) + le32(rate * 2) + le16(2) + le16(16) + "data" +
+                         le32(data_size);
+    bool written = write(fd, header.data(), header.size()) == ssize_t(header.size()) &&
+                   write(fd, samples.data(), data_size) == ssize_t(data_size);
+    close(fd);
+    check(written, "Cannot write the WAV file");
+    return path;
+}
+
+double systemNow() {
+    return duration<double>(system_clock::now().time_since_epoch()).count();
+}
+
+// Viewer side: sender reports, then capture times of RTP packets
+class LatencyMeter {
+public:
+    void receive(const binary& packet) {
+        auto p = reinterpret_cast<const uint8_t*>(packet.data());
+        if (packet.size() < 20) {
+            return;
+        }
+
+        uint32_t ssrc = readU32(p + 8);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (p[1] == 200) {  // Sender report: NTP time and RTP timestamp of the same instant
+            uint32_t ntp_seconds = readU32(p + 8), ntp_fraction = readU32(p + 12);
+            report_[readU32(p + 4)] = {ntp_seconds - 2208988800.0 + ntp_fraction / 4294967296.0,
+                                       readU32(p + 16)};
+            return;
+        }
+        if (p[1] >= 192 && p[1] <= 223) {
+            return;  // Other RTCP
+        }
+
+        auto it = report_.find(ssrc);
+        if (it == report_.end()) {
+            return;
+        }
+        uint32_t timestamp = readU32(p + 4);
+        double capture = it->second.ntp + int32_t(timestamp - it->second.timestamp) /
+                                              double(AudioStreamer::SAMPLE_RATE);
+        latency_ms_.push_back((systemNow() - capture) * 1e3);
+    }
+
+    std::vector<double> latencies() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<double> result = latency_ms_;
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    static uint32_t readU32(const uint8_t* p) {
+        uint32_t value;
+        memcpy(&value, p, 4);
+        return ntohl(value);
+    }
+
+    struct Report {
+        double ntp;
+        uint32_t timestamp;
+    };
+
+    std::mutex mutex_;
+    std::map<uint32_t, Report> report_;
+    std::vector<double> latency_ms_;
+};
+
+}  // namespace
+
+int main() {
+    try {
+        std::string wav = writeWav();
+        MediaClock::originUs();
+
+        auto device = std::make_shared<PeerConnection>(Configuration());
+        auto viewer = std::make_shared<PeerConnection>(Configuration());
+        std::weak_ptr<PeerConnection> weak_device = device, weak_viewer = viewer;
+        device->onLocalDescription([weak_viewer](Description description) {
+            if (auto viewer = weak_viewer.lock()) viewer->setRemoteDescription(description);
+        });
+        device->onLocalCandidate([weak_viewer](Candidate candidate) {
+            if (auto viewer = weak_viewer.lock()) viewer->addRemoteCandidate(candidate);
+        });
+        viewer->onLocalDescription([weak_device](Description description) {
+            if (auto device = weak_device.lock()) device->setRemoteDescription(description);
+        });
+        viewer->onLocalCandidate([weak_device](Candidate candidate) {
+            if (auto device = weak_device.lock()) device->addRemoteCandidate(candidate);
+        });
+
+        LatencyMeter meter;
+        std::shared_ptr<Track> viewer_track;
+        viewer->onTrack([&](std::shared_ptr<Track> track) {
+            viewer_track = track;
+            track->onMessage([&meter](binary packet) { meter.receive(packet); }, nullptr);
+        });
+
+        auto streamer = std::make_unique<AudioStreamer>(
+            std::make_unique<WavFileAudioSource>(wav), FRAME_MS, BITRATE);
+
+        // The audio track of WebRTCServer::handleRequest()
+        const uint8_t payload_type = 111;
+        const uint32_t ssrc = 1111;
+        Description::Audio audio("audio-stream", Description::Direction::SendOnly);
+        audio.addOpusCodec(payload_type);
+        audio.addSSRC(ssrc, "psi-test", "stream1", "audio-stream");
+        auto track = device->addTrack(audio);
+        auto config = std::make_shared<RtpPacketizationConfig>(
+            ssrc, "psi-test", payload_type, OpusRtpPacketizer::DefaultClockRate);
+        config->timestampOrigin = MediaClock::steadyOrigin();
+        track->setMediaHandler(std::make_shared<MediaPipeline<OpusRtpPacketizer, RtcpSrReporter>>(
+            std::make_tuple(config), std::make_tuple(config)));
+        std::atomic<bool> open{false};
+        std::weak_ptr<Track> weak_track = track;
+        track->onOpen([&open, &streamer, weak_track]() {
+            open = true;
+            if (auto track = weak_track.lock()) streamer->addTrack("viewer", track);
+        });
+        device->setLocalDescription();
+
+        std::this_thread::sleep_for(DURATION);
+        check(open, "Audio track did not open");
+        streamer.reset();
+        device->close();
+        viewer->close();
+        track.reset();
+        viewer_track.reset();
+        device.reset();
+        viewer.reset();
+        unlink(wav.c_str());
+
+        auto latencies = meter.latencies();
+        check(latencies.size() > 50, "Too few audio packets were mapped to capture time");
+        double median = latencies[latencies.size() / 2];
+        double p99 = latencies[latencies.size() * 99 / 100];
+        printf("Audio end-to-end latency: %zu packets, median %.2f ms, p99 %.2f ms, max %.2f ms\n",
+               latencies.size(), median, p99, latencies.back());
+
+        check(median >= FRAME_MS - 1, "Latency below the frame duration, capture time is wrong");
+        check(median < FRAME_MS + TRANSPORT_MARGIN_MS, "Audio latency is too high");
+
+        Cleanup().wait();
+        printf("Audio latency test passed\n");
+        return 0;
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Audio latency test failed: %s\n", e.what());
+        return 1;
+    }
+}
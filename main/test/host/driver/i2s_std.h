@@ -0,0 +1,69 @@
+/**
+ * Host shim of driver/i2s_std.h: there is no I2S peripheral, every call fails
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+static inline const char* esp_err_to_name(esp_err_t) { return "ESP_FAIL"; }
+
+typedef enum { GPIO_NUM_NC = -1 } gpio_num_t;
+#define I2S_GPIO_UNUSED GPIO_NUM_NC
+
+typedef struct i2s_chan* i2s_chan_handle_t;
+
+typedef struct {
+    int id;
+    int role;
+    uint32_t dma_desc_num;
+    uint32_t dma_frame_num;
+    bool auto_clear;
+} i2s_chan_config_t;
+#define I2S_NUM_AUTO 2
+#define I2S_ROLE_MASTER 0
+#define I2S_CHANNEL_DEFAULT_CONFIG(i, r) { i, r, 6, 240, false }
+
+typedef struct {
+    uint32_t sample_rate_hz;
+} i2s_std_clk_config_t;
+#define I2S_STD_CLK_DEFAULT_CONFIG(rate) { rate }
+
+typedef enum { I2S_STD_SLOT_LEFT = 1, I2S_STD_SLOT_RIGHT = 2 } i2s_std_slot_mask_t;
+typedef struct {
+    int data_bit_width;
+    int slot_mode;
+    i2s_std_slot_mask_t slot_mask;
+} i2s_std_slot_config_t;
+#define I2S_DATA_BIT_WIDTH_32BIT 32
+#define I2S_SLOT_MODE_MONO 1
+#define I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(bits, mode) { bits, mode, I2S_STD_SLOT_LEFT }
+
+typedef struct {
+    gpio_num_t mclk, bclk, ws, dout, din;
+    struct {
+        uint32_t mclk_inv : 1;
+        uint32_t bclk_inv : 1;
+        uint32_t ws_inv : 1;
+    } invert_flags;
+} i2s_std_gpio_config_t;
+
+typedef struct {
+    i2s_std_clk_config_t clk_cfg;
+    i2s_std_slot_config_t slot_cfg;
+    i2s_std_gpio_config_t gpio_cfg;
+} i2s_std_config_t;
+
+static inline esp_err_t i2s_new_channel(const i2s_chan_config_t*, i2s_chan_handle_t*,
+                                        i2s_chan_handle_t*) { return ESP_FAIL; }
+static inline esp_err_t i2s_channel_init_std_mode(i2s_chan_handle_t,
+                                                  const i2s_std_config_t*) { return ESP_FAIL; }
+static inline esp_err_t i2s_channel_enable(i2s_chan_handle_t) { return ESP_FAIL; }
+static inline esp_err_t i2s_channel_disable(i2s_chan_handle_t) { return ESP_FAIL; }
+static inline esp_err_t i2s_del_channel(i2s_chan_handle_t) { return ESP_FAIL; }
+static inline esp_err_t i2s_channel_read(i2s_chan_handle_t, void*, size_t, size_t*,
+                                         uint32_t) { return ESP_FAIL; }
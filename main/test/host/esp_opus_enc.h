@@ -0,0 +1,67 @@
+/**
+ * Host shim of the esp_audio_codec Opus encoder API, implemented over libopus in freertos_host.cpp
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int esp_audio_err_t;
+#define ESP_AUDIO_ERR_OK 0
+#define ESP_AUDIO_MONO 1
+#define ESP_AUDIO_BIT16 16
+
+typedef enum {
+    ESP_OPUS_ENC_FRAME_DURATION_10_MS = 10,
+    ESP_OPUS_ENC_FRAME_DURATION_20_MS = 20,
+} esp_opus_enc_frame_duration_t;
+
+typedef enum {
+    ESP_OPUS_ENC_APPLICATION_VOIP,
+    ESP_OPUS_ENC_APPLICATION_AUDIO,
+    ESP_OPUS_ENC_APPLICATION_LOWDELAY,
+} esp_opus_enc_application_t;
+
+typedef struct {
+    int sample_rate;
+    uint8_t channel;
+    uint8_t bits_per_sample;
+    int bitrate;
+    esp_opus_enc_frame_duration_t frame_duration;
+    esp_opus_enc_application_t application_mode;
+    int complexity;
+    bool enable_fec;
+    bool enable_dtx;
+    bool enable_vbr;
+} esp_opus_enc_config_t;
+
+#define ESP_OPUS_ENC_CONFIG_DEFAULT()                                                          \
+    { 8000, 2, 16, 90000, ESP_OPUS_ENC_FRAME_DURATION_20_MS, ESP_OPUS_ENC_APPLICATION_AUDIO, 0, \
+      false, false, false }
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t len;
+} esp_audio_enc_in_frame_t;
+
+typedef struct {
+    uint8_t* buffer;
+    uint32_t len;
+    uint32_t encoded_bytes;
+    uint64_t pts;
+} esp_audio_enc_out_frame_t;
+
+esp_audio_err_t esp_opus_enc_open(void* cfg, uint32_t cfg_sz, void** enc_hd);
+esp_audio_err_t esp_opus_enc_get_frame_size(void* enc_hd, int* in_size, int* out_size);
+esp_audio_err_t esp_opus_enc_process(void* enc_hd, esp_audio_enc_in_frame_t* in,
+                                     esp_audio_enc_out_frame_t* out);
+void esp_opus_enc_close(void* enc_hd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+/**
+ * Host shim of FreeRTOS.h: ticks are milliseconds, tasks are threads (see freertos_host.cpp)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(ms) (ms)
@@ -0,0 +1,192 @@
+/**
+ * FreeRTOS and esp_audio_codec shims for the host tests of the audio pipeline
+ *
+ * Tasks are detached threads with a notification counter, semaphores are counting semaphores on
+ * a condition variable, and the Opus encoder is libopus.
+ */
+
+#include "esp_opus_enc.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+
+namespace {
+
+struct Task {
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t notifications = 0;
+};
+
+// Never freed: a task may be notified after it has deleted itself
+thread_local Task* current_task = nullptr;
+
+struct Semaphore {
+    std::mutex mutex;
+    std::condition_variable condition;
+    UBaseType_t count;
+};
+
+template <typename Predicate>
+bool waitFor(std::condition_variable& condition, std::unique_lock<std::mutex>& lock,
+             TickType_t ticks, Predicate predicate) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+
+}  // namespace
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack, void* arg,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+    Task* task = new Task;
+    if (handle) {
+        *handle = task;
+    }
+    std::thread([function, arg, task]() {
+        current_task = task;
+        function(arg);
+    }).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t handle) {
+    pthread_exit(nullptr);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    Task* task = current_task;
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitFor(task->condition, lock, ticks, [task]() { return task->notifications > 0; });
+    uint32_t notifications = task->notifications;
+    if (notifications > 0) {
+        task->notifications = clear ? 0 : notifications - 1;
+    }
+    return notifications;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle) {
+    Task* task = static_cast<Task*>(handle);
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        ++task->notifications;
+    }
+    task->condition.notify_one();
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial) {
+    Semaphore* semaphore = new Semaphore;
+    semaphore->count = initial;
+    return semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+    Semaphore* semaphore = static_cast<Semaphore*>(handle);
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!waitFor(semaphore->condition, lock, ticks,
+                 [semaphore]() { return semaphore->count > 0; })) {
+        return pdFALSE;
+    }
+    --semaphore->count;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+    Semaphore* semaphore = static_cast<Semaphore*>(handle);
+    {
+        std::lock_guard<std::mutex> lock(semaphore->mutex);
+        ++semaphore->count;
+    }
+    semaphore->condition.notify_one();
+    return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t handle) {
+    delete static_cast<Semaphore*>(handle);
+}
+
+//=============================================================================
+// Opus encoder over libopus
+//=============================================================================
+
+// libopus API, declared here as the headers are not required, only the library
+extern "C" {
+struct OpusEncoder;
+OpusEncoder* opus_encoder_create(int32_t rate, int channels, int application, int* error);
+int opus_encode(OpusEncoder* encoder, const int16_t* pcm, int frame_size, unsigned char* data,
+                int32_t max_data_bytes);
+int opus_encoder_ctl(OpusEncoder* encoder, int request, ...);
+void opus_encoder_destroy(OpusEncoder* encoder);
+}
+
+namespace {
+
+constexpr int OPUS_APPLICATION_VOIP = 2048;
+constexpr int OPUS_APPLICATION_AUDIO = 2049;
+constexpr int OPUS_APPLICATION_RESTRICTED_LOWDELAY = 2051;
+constexpr int OPUS_SET_BITRATE_REQUEST = 4002;
+constexpr int OPUS_SET_VBR_REQUEST = 4006;
+constexpr int OPUS_MAX_PACKET = 1275;
+
+struct Encoder {
+    OpusEncoder* opus;
+    int frame_samples;
+};
+
+}  // namespace
+
+esp_audio_err_t esp_opus_enc_open(void* cfg, uint32_t cfg_sz, void** enc_hd) {
+    auto config = static_cast<const esp_opus_enc_config_t*>(cfg);
+    int application = OPUS_APPLICATION_AUDIO;
+    if (config->application_mode == ESP_OPUS_ENC_APPLICATION_LOWDELAY) {
+        application = OPUS_APPLICATION_RESTRICTED_LOWDELAY;
+    } else if (config->application_mode == ESP_OPUS_ENC_APPLICATION_VOIP) {
+        application = OPUS_APPLICATION_VOIP;
+    }
+
+    int error = 0;
+    OpusEncoder* opus = opus_encoder_create(config->sample_rate, config->channel, application,
+                                            &error);
+    if (!opus) {
+        return -1;
+    }
+    opus_encoder_ctl(opus, OPUS_SET_BITRATE_REQUEST, int32_t(config->bitrate));
+    opus_encoder_ctl(opus, OPUS_SET_VBR_REQUEST, int32_t(config->enable_vbr));
+    *enc_hd = new Encoder{opus, config->sample_rate / 1000 * int(config->frame_duration)};
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_enc_get_frame_size(void* enc_hd, int* in_size, int* out_size) {
+    *in_size = static_cast<Encoder*>(enc_hd)->frame_samples * int(sizeof(int16_t));
+    *out_size = OPUS_MAX_PACKET;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_enc_process(void* enc_hd, esp_audio_enc_in_frame_t* in,
+                                     esp_audio_enc_out_frame_t* out) {
+    auto encoder = static_cast<Encoder*>(enc_hd);
+    int size = opus_encode(encoder->opus, reinterpret_cast<const int16_t*>(in->buffer),
+                           encoder->frame_samples, out->buffer, out->len);
+    if (size < 0) {
+        return -1;
+    }
+    out->encoded_bytes = size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_opus_enc_close(void* enc_hd) {
+    auto encoder = static_cast<Encoder*>(enc_hd);
+    opus_encoder_destroy(encoder->opus);
+    delete encoder;
+}
@@ -0,0 +1,320 @@
+/**
+ * Signaling latency test - viewers join through a mock signaling server
+ *
+ * The mock server sends a burst of connection requests as the esp_websocket_client task delivers
+ * them: text frames split into continuation frames, and frames split into several events. The
+ * client thread reassembles them with WsMessageAssembler, then either handles each request
+ * inline, like before the signaling workers, or hands it to workers picked by client id like
+ * WebRTCServer::enqueueSignalingMessage(). Handling a request creates the PeerConnection of
+ * WebRTCServer::handleRequest() (data channel and video track) and sends the offer back.
+ *
+ * Per-join latency is measured from the request being sent to the offer being received, and the
+ * client thread must only spend the time to parse and dispatch when workers are used.
+ */
+
+#include "ws_message_assembler.hpp"
+#include "rtc/rtc.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rtc;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr size_t BUFFER_SIZE = 16384;  // As WebRTCServer::WS_MESSAGE_BUFFER_SIZE
+constexpr int WORKERS = 2;             // As WebRTCServer::SIGNALING_WORKERS
+constexpr int VIEWERS = 8;
+constexpr size_t CLIENT_BUFFER = 16;   // Event size of the mock client, to split frames
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        throw std::runtime_error(what);
+    }
+}
+
+double threadCpuMs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// One event of the WebSocket client: a chunk of a frame
+struct Event {
+    int op_code;
+    bool fin;
+    std::string data;
+    size_t payload_offset;
+    size_t payload_len;
+};
+
+// Frames of a text message: a text frame then continuation frames of frame_size bytes, each
+// delivered in CLIENT_BUFFER byte events
+std::vector<Event> frame(const std::string& message, size_t frame_size) {
+    std::vector<Event> events;
+    for (size_t start = 0; start < message.size(); start += frame_size) {
+        std::string payload = message.substr(start, frame_size);
+        bool fin = start + frame_size >= message.size();
+        for (size_t offset = 0; offset < payload.size(); offset += CLIENT_BUFFER) {
+            events.push_back({start == 0 ? 0x01 : 0x00, fin, payload.substr(offset, CLIENT_BUFFER),
+                              offset, payload.size()});
+        }
+    }
+    return events;
+}
+
+std::string clientIdOf(const std::string& message) {
+    const std::string key = "\"client_id\":\"";
+    size_t start = message.find(key);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += key.size();
+    return message.substr(start, message.find('"', start) - start);
+}
+
+void testAssembler() {
+    WsMessageAssembler assembler(64);
+    using Result = WsMessageAssembler::Result;
+    auto feed = [&](const Event& event) {
+        return assembler.feed(event.op_code, event.fin, event.data.data(), event.data.size(),
+                              event.payload_offset, event.payload_len);
+    };
+
+    // Fragmented message with a ping between its frames, which are split into events
+    const std::string message = "{\"type\":\"request\",\"client_id\":\"a\"}";
+    auto events = frame(message, 20);
+    for (size_t i = 0; i + 1 < events.size(); ++i) {
+        check(feed(events[i]) == Result::Pending, "Message completed early");
+        if (i == 1) {
+            check(feed({0x09, true, "", 0, 0}) == Result::Skipped, "Ping was not skipped");
+        }
+    }
+    check(feed(events.back()) == Result::Complete && assembler.message() == message,
+          "Fragmented message was not reassembled");
+
+    // Not a message start, and too large
+    check(feed({0x00, true, "x", 0, 1}) == Result::Orphan, "Orphan continuation was accepted");
+    std::string large(100, 'x');
+    for (const auto& event : frame(large, 50)) {
+        Result result = feed(event);
+        check(result == (event.fin && event.payload_offset + event.data.size() == event.payload_len
+                             ? Result::Overflow : Result::Pending),
+              "Message above the capacity was not dropped");
+    }
+
+    // Valid messages follow
+    for (const auto& event : frame(message, message.size())) {
+        feed(event);
+    }
+    check(assembler.message() == message, "Message after an overflow was not reassembled");
+}
+
+// Requests handled inline or by workers, offers sent back to the mock server
+class Device {
+public:
+    using Send = std::function<void(const std::string& client_id)>;
+
+    Device(int workers, Send send_offer) : send_offer_(std::move(send_offer)) {
+        for (int i = 0; i < workers; i++) {
+            workers_.emplace_back(std::make_unique<Worker>());
+        }
+        for (auto& worker : workers_) {
+            worker->thread = std::thread([this, w = worker.get()]() { workerLoop(*w); });
+        }
+    }
+
+    ~Device() {
+        for (auto& worker : workers_) {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->stop = true;
+            }
+            worker->condition.notify_one();
+            worker->thread.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& pc : peer_connections_) {
+            pc->close();
+        }
+    }
+
+    // Runs on the client thread, like handleWebSocketData()
+    void receive(const Event& event) {
+        auto result = assembler_.feed(event.op_code, event.fin, event.data.data(),
+                                      event.data.size(), event.payload_offset, event.payload_len);
+        if (result != WsMessageAssembler::Result::Complete) {
+            return;
+        }
+
+        std::string client_id = clientIdOf(assembler_.message());
+        if (workers_.empty()) {
+            handleRequest(client_id);
+            return;
+        }
+
+        Worker& worker = *workers_[std::hash<std::string>{}(client_id) % workers_.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queue.push_back(client_id);
+        }
+        worker.condition.notify_one();
+    }
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::string> queue;
+        bool stop = false;
+    };
+
+    void workerLoop(Worker& worker) {
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        while (true) {
+            worker.condition.wait(lock, [&]() { return worker.stop || !worker.queue.empty(); });
+            if (worker.queue.empty()) {
+                return;
+            }
+            std::string client_id = std::move(worker.queue.front());
+            worker.queue.pop_front();
+            lock.unlock();
+            handleRequest(client_id);
+            lock.lock();
+        }
+    }
+
+    // The PeerConnection of WebRTCServer::handleRequest(), without ICE server as the sandbox
+    // has no Internet access
+    void handleRequest(const std::string& client_id) {
+        auto pc = std::make_shared<PeerConnection>(Configuration());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            peer_connections_.push_back(pc);
+        }
+
+        Send send_offer = send_offer_;
+        pc->onLocalDescription([send_offer, client_id](Description description) {
+            send_offer(client_id);
+        });
+        auto dc = pc->createDataChannel("http");
+
+        const uint32_t ssrc = std::hash<std::string>{}(client_id) & 0xFFFFFFFF;
+        Description::Video media("video-stream", Description::Direction::SendOnly);
+        media.addH264Codec(96);
+        media.rtpMap(96)->addFeedback("transport-cc");
+        media.addSSRC(ssrc, "psi-test", "stream1", "video-stream");
+        auto track = pc->addTrack(media);
+        auto config = std::make_shared<RtpPacketizationConfig>(ssrc, "psi-test", 96,
+                                                               H264RtpPacketizer::ClockRate);
+        track->setMediaHandler(
+            std::make_shared<MediaPipeline<H264RtpPacketizer, RtcpSrReporter, RtcpNackResponder>>(
+                std::make_tuple(NalUnit::Separator::StartSequence, config),
+                std::make_tuple(config), std::make_tuple()));
+        pc->setLocalDescription();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        channels_.push_back(dc);
+    }
+
+    Send send_offer_;
+    WsMessageAssembler assembler_{BUFFER_SIZE};
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<PeerConnection>> peer_connections_;
+    std::vector<std::shared_ptr<DataChannel>> channels_;
+};
+
+struct Run {
+    std::vector<double> latency_ms;
+    double client_cpu_ms;
+};
+
+// A burst of requests from the mock server, returns once every viewer has its offer
+Run join(int workers) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<steady_clock::time_point> answered(VIEWERS);
+    int offers = 0;
+
+    Device device(workers, [&](const std::string& client_id) {
+        int index = std::stoi(client_id.substr(client_id.find('-') + 1));
+        std::lock_guard<std::mutex> lock(mutex);
+        answered[index] = steady_clock::now();
+        ++offers;
+        condition.notify_all();
+    });
+
+    // The client thread receives the burst, as the esp_websocket_client task: the requests are all
+    // sent at once, later ones wait in the socket while the client thread is busy
+    std::promise<double> client_cpu;
+    auto sent = steady_clock::now();
+    std::thread client([&]() {
+        double start = threadCpuMs();
+        for (int i = 0; i < VIEWERS; i++) {
+            std::string message = "{\"type\":\"request\",\"client_id\":\"viewer-" +
+                                  std::to_string(i) + "\"}";
+            for (const auto& event : frame(message, 24)) {
+                device.receive(event);
+            }
+        }
+        client_cpu.set_value(threadCpuMs() - start);
+    });
+    client.join();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    check(condition.wait_for(lock, 10s, [&]() { return offers == VIEWERS; }),
+          "Some viewers got no offer");
+
+    Run run = {{}, client_cpu.get_future().get()};
+    for (int i = 0; i < VIEWERS; i++) {
+        run.latency_ms.push_back(duration<double, std::milli>(answered[i] - sent).count());
+    }
+    std::sort(run.latency_ms.begin(), run.latency_ms.end());
+    return run;
+}
+
+void report(const char* name, const Run& run) {
+    printf("%s: %d joins, latency median %.1f ms max %.1f ms, client thread CPU %.2f ms\n", name,
+           VIEWERS, run.latency_ms[run.latency_ms.size() / 2], run.latency_ms.back(),
+           run.client_cpu_ms);
+}
+
+}  // namespace
+
+int main() {
+    try {
+        testAssembler();
+
+        Preload();
+        join(WORKERS);  // Warm-up
+        Run inline_run = join(0);
+        Run worker_run = join(WORKERS);
+        report("Inline on the client thread", inline_run);
+        report("Signaling workers", worker_run);
+
+        check(worker_run.client_cpu_ms * 10 < inline_run.client_cpu_ms,
+              "Joins still run on the client thread");
+
+        Cleanup().wait();
+        printf("Signaling latency test passed\n");
+        return 0;
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Signaling latency test failed: %s\n", e.what());
+        return 1;
+    }
+}
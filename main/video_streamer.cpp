@@ -5,6 +5,7 @@
  */
 
 #include "video_streamer.hpp"
+#include "media_clock.hpp"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_heap_caps.h"
@@ -30,13 +31,17 @@ extern bool g_log_frame_timing;
 // Constructor / Destructor
 //=============================================================================
 
-VideoStreamer::VideoStreamer(uint32_t output_width, uint32_t output_height, uint32_t fps)
+VideoStreamer::VideoStreamer(uint32_t output_width, uint32_t output_height, uint32_t fps,
+                             int temporal_layers)
     : cam_width_(0), cam_height_(0),  // Will be auto-detected from sensor
       output_width_(output_width), output_height_(output_height),
       fps_(fps),
       use_ppa_(false),  // Determined after querying sensor
+      temporal_layers_(temporal_layers),
       cap_fd_(-1), m2m_fd_(-1),
+      encoded_frame_number_(0),
       ppa_scaler_(nullptr), scaled_buffer_(nullptr), scaled_buffer_size_(0),
+      encoder_capture_head_(0), encoder_capture_count_(0),
       send_queue_(nullptr),
       capture_task_(nullptr), send_task_(nullptr),
       running_(false), force_keyframe_(false),
@@ -287,6 +292,25 @@ bool VideoStreamer::initEncoder() {
     return true;
 }
 
+bool VideoStreamer::initSoftwareEncoder() {
+    // Keyframes must start a layer pattern (T0 T2 T1 T2 for 3 layers), so the period is rounded
+    // up to a multiple of the pattern length
+    uint32_t pattern = 1u << (temporal_layers_ - 1);
+    uint32_t gop = (fps_ + pattern - 1) / pattern * pattern;
+
+    sw_encoder_ = std::make_unique<H264TemporalEncoder>();
+    if (!sw_encoder_->init(getWidth(), getHeight(), fps_, (getWidth() * getHeight() * fps_) / 8,
+                           gop, temporal_layers_)) {
+        sw_encoder_.reset();
+        return false;
+    }
+
+    encoded_frame_number_ = 0;
+    ESP_LOGI(TAG, "Software H.264 encoder initialized: L1T%d, GOP %u",
+             temporal_layers_, (unsigned)gop);
+    return true;
+}
+
 bool VideoStreamer::initPPA() {
     // Only initialize PPA if scaling is needed
     if (!use_ppa_) {
@@ -362,6 +386,8 @@ void VideoStreamer::cleanup() {
         m2m_fd_ = -1;
     }
 
+    sw_encoder_.reset();
+
     // Free PPA resources
     if (scaled_buffer_) {
         heap_caps_free(scaled_buffer_);
@@ -450,7 +476,9 @@ bool VideoStreamer::startStreaming() {
         return false;
     }
 
-    if (!initEncoder()) {
+    // The hardware encoder only encodes IPPP, temporal layers need the software encoder
+    bool encoder_ok = temporal_layers_ > 1 ? initSoftwareEncoder() : initEncoder();
+    if (!encoder_ok) {
         ESP_LOGE(TAG, "Failed to initialize encoder");
         cleanup();
         return false;
@@ -478,18 +506,20 @@ bool VideoStreamer::startStreaming() {
         return false;
     }
 
-    type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    if (ioctl(m2m_fd_, VIDIOC_STREAMON, &type) < 0) {
-        ESP_LOGE(TAG, "Failed to start encoder capture stream");
-        cleanup();
-        return false;
-    }
+    if (m2m_fd_ >= 0) {
+        type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (ioctl(m2m_fd_, VIDIOC_STREAMON, &type) < 0) {
+            ESP_LOGE(TAG, "Failed to start encoder capture stream");
+            cleanup();
+            return false;
+        }
 
-    type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
-    if (ioctl(m2m_fd_, VIDIOC_STREAMON, &type) < 0) {
-        ESP_LOGE(TAG, "Failed to start encoder output stream");
-        cleanup();
-        return false;
+        type = V4L2_BUF_TYPE_VIDEO_OUTPUT;
+        if (ioctl(m2m_fd_, VIDIOC_STREAMON, &type) < 0) {
+            ESP_LOGE(TAG, "Failed to start encoder output stream");
+            cleanup();
+            return false;
+        }
     }
 
     // Initialize state
@@ -498,6 +528,8 @@ bool VideoStreamer::startStreaming() {
     capture_frame_count_ = 0;
     frames_in_encoder_ = 0;
     frames_skipped_ = 0;
+    encoder_capture_head_ = 0;
+    encoder_capture_count_ = 0;
 
     // Create sender task (16KB stack, PSRAM OK - no file I/O)
     BaseType_t ret = xTaskCreate(
@@ -515,11 +547,12 @@ bool VideoStreamer::startStreaming() {
         return false;
     }
 
-    // Create capture task (16KB stack, Internal RAM - deep libdatachannel call chain)
+    // Create capture task (16KB stack, Internal RAM - deep libdatachannel call chain,
+    // 32KB when it runs the software encoder)
     ret = xTaskCreate(
         captureTaskEntry,
         "video_capture",
-        16384,
+        sw_encoder_ ? 32768 : 16384,
         this,
         5,
         &capture_task_
@@ -602,7 +635,11 @@ void VideoStreamer::stopStreaming() {
 
 void VideoStreamer::captureTaskEntry(void* arg) {
     VideoStreamer* self = static_cast<VideoStreamer*>(arg);
-    self->captureLoop();
+    if (self->sw_encoder_) {
+        self->softwareCaptureLoop();
+    } else {
+        self->captureLoop();
+    }
     vTaskDelete(NULL);
 }
 
@@ -619,6 +656,106 @@ bool VideoStreamer::shouldSkipFrame() const {
     return queued >= (SEND_QUEUE_DEPTH * 3 / 4);
 }
 
+bool VideoStreamer::scaleFrame(const struct v4l2_buffer& cam_buf, uint8_t*& output,
+                               size_t& output_size) {
+    if (ppa_scaler_) {
+        // Use PPA to scale the frame
+        ppa_srm_oper_config_t srm_config = {
+            .in = {
+                .buffer = cap_buffer_[cam_buf.index],
+                .pic_w = cam_width_,
+                .pic_h = cam_height_,
+                .block_w = cam_width_,
+                .block_h = cam_height_,
+                .block_offset_x = 0,
+                .block_offset_y = 0,
+                .srm_cm = PPA_SRM_COLOR_MODE_YUV420,
+                .yuv_range = PPA_COLOR_RANGE_LIMIT,
+                .yuv_std = PPA_COLOR_CONV_STD_RGB_YUV_BT601,
+            },
+            .out = {
+                .buffer = scaled_buffer_,
+                .buffer_size = scaled_buffer_size_,
+                .pic_w = output_width_,
+                .pic_h = output_height_,
+                .block_offset_x = 0,
+                .block_offset_y = 0,
+                .srm_cm = PPA_SRM_COLOR_MODE_YUV420,
+                .yuv_range = PPA_COLOR_RANGE_LIMIT,
+                .yuv_std = PPA_COLOR_CONV_STD_RGB_YUV_BT601,
+            },
+            .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
+            .scale_x = (float)output_width_ / (float)cam_width_,
+            .scale_y = (float)output_height_ / (float)cam_height_,
+            .mirror_x = false,
+            .mirror_y = false,
+            .rgb_swap = false,
+            .byte_swap = false,
+            .alpha_update_mode = PPA_ALPHA_NO_CHANGE,  // No alpha blending
+            .alpha_fix_val = 0,  // Initialize union member (unused when NO_CHANGE)
+            .mode = PPA_TRANS_MODE_BLOCKING,
+            .user_data = nullptr,  // No user data callback
+        };
+
+        esp_err_t ret = ppa_do_scale_rotate_mirror(ppa_scaler_, &srm_config);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "PPA scaling failed: %d", ret);
+            return false;
+        }
+
+        output = scaled_buffer_;
+        output_size = scaled_buffer_size_;
+    } else {
+        // No scaling - pass camera buffer directly
+        output = cap_buffer_[cam_buf.index];
+        output_size = cam_buf.bytesused;
+    }
+
+    return true;
+}
+
+void VideoStreamer::queueFrame(const uint8_t* data, size_t size, bool keyframe,
+                               uint8_t temporal_layer, std::optional<uint32_t> frame_number,
+                               int64_t capture_us) {
+    // Initialize stats start time on first frame
+    if (video_start_pts_ == 0) {
+        video_start_pts_ = esp_timer_get_time();
+    }
+
+    // PTS at capture on the clock shared with audio, not after encoding, so that the encoding
+    // delay does not offset video against audio
+    rtc::FrameInfo frameInfo(MediaClock::timestamp(capture_us));
+    frameInfo.isKeyframe = keyframe;
+    frameInfo.temporalLayer = temporal_layer;
+    frameInfo.frameNumber = frame_number;
+
+    // Enable logging for every 5th frame
+    capture_frame_count_++;
+    if (capture_frame_count_ % 5 == 0) {
+        g_log_frame_timing = true;
+        ESP_LOGI(TAG, "Frame %lu [%s] T%u %u B - queuing (depth=%u)",
+                 (unsigned long)capture_frame_count_, keyframe ? "I" : "P",
+                 (unsigned)temporal_layer, (unsigned)size, uxQueueMessagesWaiting(send_queue_));
+    }
+
+    // Allocate and queue frame (will be deleted by send task)
+    QueuedFrame* frame = new QueuedFrame{
+        std::vector<uint8_t>(data, data + size),
+        frameInfo
+    };
+
+    if (xQueueSend(send_queue_, &frame, 0) != pdTRUE) {
+        // Should never happen since we skip at front-end
+        ESP_LOGW(TAG, "Send queue full despite front-end skip!");
+        delete frame;
+    }
+
+    // Disable logging
+    if (capture_frame_count_ % 5 == 0) {
+        g_log_frame_timing = false;
+    }
+}
+
 void VideoStreamer::captureLoop() {
     ESP_LOGI(TAG, "Capture loop started (pipelined mode, %d encoder buffers)", ENCODER_OUTPUT_BUFFERS);
 
@@ -634,6 +771,8 @@ void VideoStreamer::captureLoop() {
 
             // Get camera frame
             if (ioctl(cap_fd_, VIDIOC_DQBUF, &cam_buf) == 0) {
+                int64_t capture_us = esp_timer_get_time();
+
                 // Check for backpressure (front-end skip)
                 if (shouldSkipFrame()) {
                     // Skip encoding - return buffer immediately
@@ -647,61 +786,10 @@ void VideoStreamer::captureLoop() {
                 // Scale frame with PPA if enabled
                 uint8_t* encoder_input_ptr;
                 size_t encoder_input_size;
-
-                if (ppa_scaler_) {
-                    // Use PPA to scale the frame
-                    ppa_srm_oper_config_t srm_config = {
-                        .in = {
-                            .buffer = cap_buffer_[cam_buf.index],
-                            .pic_w = cam_width_,
-                            .pic_h = cam_height_,
-                            .block_w = cam_width_,
-                            .block_h = cam_height_,
-                            .block_offset_x = 0,
-                            .block_offset_y = 0,
-                            .srm_cm = PPA_SRM_COLOR_MODE_YUV420,
-                            .yuv_range = PPA_COLOR_RANGE_LIMIT,
-                            .yuv_std = PPA_COLOR_CONV_STD_RGB_YUV_BT601,
-                        },
-                        .out = {
-                            .buffer = scaled_buffer_,
-                            .buffer_size = scaled_buffer_size_,
-                            .pic_w = output_width_,
-                            .pic_h = output_height_,
-                            .block_offset_x = 0,
-                            .block_offset_y = 0,
-                            .srm_cm = PPA_SRM_COLOR_MODE_YUV420,
-                            .yuv_range = PPA_COLOR_RANGE_LIMIT,
-                            .yuv_std = PPA_COLOR_CONV_STD_RGB_YUV_BT601,
-                        },
-                        .rotation_angle = PPA_SRM_ROTATION_ANGLE_0,
-                        .scale_x = (float)output_width_ / (float)cam_width_,
-                        .scale_y = (float)output_height_ / (float)cam_height_,
-                        .mirror_x = false,
-                        .mirror_y = false,
-                        .rgb_swap = false,
-                        .byte_swap = false,
-                        .alpha_update_mode = PPA_ALPHA_NO_CHANGE,  // No alpha blending
-                        .alpha_fix_val = 0,  // Initialize union member (unused when NO_CHANGE)
-                        .mode = PPA_TRANS_MODE_BLOCKING,
-                        .user_data = nullptr,  // No user data callback
-                    };
-
-                    esp_err_t ret = ppa_do_scale_rotate_mirror(ppa_scaler_, &srm_config);
-                    if (ret != ESP_OK) {
-                        ESP_LOGE(TAG, "PPA scaling failed: %d", ret);
-                        ioctl(cap_fd_, VIDIOC_QBUF, &cam_buf);
-                        continue;
-                    }
-
-                    encoder_input_ptr = scaled_buffer_;
-                    encoder_input_size = scaled_buffer_size_;
-                } else {
-                    // No scaling - pass camera buffer directly
-                    encoder_input_ptr = cap_buffer_[cam_buf.index];
-                    encoder_input_size = cam_buf.bytesused;
+                if (!scaleFrame(cam_buf, encoder_input_ptr, encoder_input_size)) {
+                    ioctl(cap_fd_, VIDIOC_QBUF, &cam_buf);
+                    continue;
                 }
-
                 // Submit to encoder
                 memset(&enc_input_buf, 0, sizeof(enc_input_buf));
                 enc_input_buf.index = 0;
@@ -712,6 +800,10 @@ void VideoStreamer::captureLoop() {
 
                 if (ioctl(m2m_fd_, VIDIOC_QBUF, &enc_input_buf) == 0) {
                     frames_in_encoder_++;
+                    if (encoder_capture_count_ < ENCODER_OUTPUT_BUFFERS) {
+                        encoder_capture_us_[(encoder_capture_head_ + encoder_capture_count_++) %
+                                            ENCODER_OUTPUT_BUFFERS] = capture_us;
+                    }
                 } else {
                     ESP_LOGE(TAG, "Failed to queue frame to encoder: %s", strerror(errno));
                 }
@@ -728,46 +820,15 @@ void VideoStreamer::captureLoop() {
 
         if (ioctl(m2m_fd_, VIDIOC_DQBUF, &enc_output_buf) == 0) {
             // Got an encoded frame
-            uint64_t timestamp_us = esp_timer_get_time();
             bool keyframe = (enc_output_buf.flags & V4L2_BUF_FLAG_KEYFRAME) != 0;
-
-            // Initialize PTS on first frame
-            if (video_start_pts_ == 0) {
-                video_start_pts_ = timestamp_us;
-            }
-
-            // Calculate relative PTS
-            double pts_sec = (timestamp_us - video_start_pts_) / 1000000.0;
-            std::chrono::duration<double> frameTime(pts_sec);
-            rtc::FrameInfo frameInfo(frameTime);
-            frameInfo.isKeyframe = keyframe;
-
-            // Enable logging for every 5th frame
-            capture_frame_count_++;
-            if (capture_frame_count_ % 5 == 0) {
-                g_log_frame_timing = true;
-                ESP_LOGI(TAG, "Frame %lu [%s] %u B - queuing (depth=%u)",
-                         (unsigned long)capture_frame_count_, keyframe ? "I" : "P",
-                         enc_output_buf.bytesused, uxQueueMessagesWaiting(send_queue_));
-            }
-
-            // Allocate and queue frame (will be deleted by send task)
-            QueuedFrame* frame = new QueuedFrame{
-                std::vector<uint8_t>(m2m_cap_buffer_[enc_output_buf.index],
-                                     m2m_cap_buffer_[enc_output_buf.index] + enc_output_buf.bytesused),
-                frameInfo
-            };
-
-            if (xQueueSend(send_queue_, &frame, 0) != pdTRUE) {
-                // Should never happen since we skip at front-end
-                ESP_LOGW(TAG, "Send queue full despite front-end skip!");
-                delete frame;
-            }
-
-            // Disable logging
-            if (capture_frame_count_ % 5 == 0) {
-                g_log_frame_timing = false;
+            int64_t capture_us = esp_timer_get_time();
+            if (encoder_capture_count_ > 0) {
+                capture_us = encoder_capture_us_[encoder_capture_head_];
+                encoder_capture_head_ = (encoder_capture_head_ + 1) % ENCODER_OUTPUT_BUFFERS;
+                encoder_capture_count_--;
             }
+            queueFrame(m2m_cap_buffer_[enc_output_buf.index], enc_output_buf.bytesused, keyframe,
+                       0, std::nullopt, capture_us);
 
             // Return encoder buffers
             ioctl(m2m_fd_, VIDIOC_QBUF, &enc_output_buf);
@@ -795,6 +856,7 @@ void VideoStreamer::captureLoop() {
 
         // Small delay if encoder pipeline is empty
         if (frames_in_encoder_ == 0) {
+            encoder_capture_count_ = 0;  // Realign capture times after an encoder error
             vTaskDelay(pdMS_TO_TICKS(1));
         }
     }
@@ -802,6 +864,76 @@ void VideoStreamer::captureLoop() {
     ESP_LOGI(TAG, "Capture loop exited");
 }
 
+void VideoStreamer::softwareCaptureLoop() {
+    ESP_LOGI(TAG, "Capture loop started (software encoder, L1T%d)", temporal_layers_);
+
+    struct v4l2_buffer cam_buf;
+    uint64_t last_stats_time = esp_timer_get_time();
+    uint64_t encode_us = 0;
+    uint32_t encode_count = 0;
+
+    while (running_) {
+        memset(&cam_buf, 0, sizeof(cam_buf));
+        cam_buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        cam_buf.memory = V4L2_MEMORY_MMAP;
+
+        // Get camera frame, encoding is synchronous so frames the encoder cannot keep up with
+        // are dropped by the camera driver
+        if (ioctl(cap_fd_, VIDIOC_DQBUF, &cam_buf) != 0) {
+            vTaskDelay(pdMS_TO_TICKS(1));
+            continue;
+        }
+        int64_t capture_us = esp_timer_get_time();
+
+        // Check for backpressure (front-end skip)
+        if (shouldSkipFrame()) {
+            ioctl(cap_fd_, VIDIOC_QBUF, &cam_buf);
+            frames_skipped_++;
+            ESP_LOGI(TAG, "Skipped frame (queue depth=%u)", uxQueueMessagesWaiting(send_queue_));
+            continue;
+        }
+
+        uint8_t* encoder_input_ptr;
+        size_t encoder_input_size;
+        if (!scaleFrame(cam_buf, encoder_input_ptr, encoder_input_size)) {
+            ioctl(cap_fd_, VIDIOC_QBUF, &cam_buf);
+            continue;
+        }
+
+        uint64_t encode_start_us = esp_timer_get_time();
+        H264TemporalEncoder::Frame encoded;
+        bool ok = sw_encoder_->encode(encoder_input_ptr, encode_start_us / 1000, encoded);
+        encode_us += esp_timer_get_time() - encode_start_us;
+        encode_count++;
+
+        // Return camera buffer
+        ioctl(cap_fd_, VIDIOC_QBUF, &cam_buf);
+
+        if (!ok) {
+            continue;
+        }
+
+        // Frame numbers count encoded frames, so that references stay right for tracks
+        // skipping upper layers
+        queueFrame(encoded.data, encoded.size, encoded.keyframe, encoded.temporal_layer,
+                   encoded_frame_number_++, capture_us);
+
+        // Print statistics periodically
+        uint64_t current_time = esp_timer_get_time();
+        if ((current_time - last_stats_time) >= 1000000) {  // Every second
+            float elapsed_sec = (current_time - video_start_pts_) / 1000000.0f;
+            float avg_fps = capture_frame_count_ / elapsed_sec;
+
+            ESP_LOGI(TAG, "Frame %lu: %.1f fps (avg), encode %lu ms/frame, %u skipped",
+                     (unsigned long)capture_frame_count_, avg_fps,
+                     (unsigned long)(encode_us / encode_count / 1000), frames_skipped_);
+            last_stats_time = current_time;
+        }
+    }
+
+    ESP_LOGI(TAG, "Capture loop exited");
+}
+
 //=============================================================================
 // Send Loop (Queue → RTP)
 //=============================================================================
@@ -9,12 +9,14 @@
 #define VIDEO_STREAMER_HPP
 
 #include "rtc/rtc.hpp"
+#include "h264_temporal_encoder.hpp"
 #include <memory>
 #include <atomic>
 #include <cstdint>
 #include <map>
 #include <string>
 #include <mutex>
+#include <optional>
 
 extern "C" {
 #include <fcntl.h>
@@ -35,7 +37,10 @@ public:
     //   - Camera resolution is auto-detected from sensor (via menuconfig setting)
     //   - PPA scaling automatically enabled if output != camera resolution
     // fps: Frame rate
-    VideoStreamer(uint32_t output_width, uint32_t output_height, uint32_t fps = 25);
+    // temporal_layers: 1 encodes IPPP with the hardware encoder, 2 or 3 encodes L1T2 or L1T3
+    //   with the openh264 software encoder, so that tracks may skip upper layer frames
+    VideoStreamer(uint32_t output_width, uint32_t output_height, uint32_t fps = 25,
+                  int temporal_layers = 1);
     ~VideoStreamer();
 
     // Add a track to send video to
@@ -54,6 +59,7 @@ public:
     uint32_t getWidth() const { return output_width_; }
     uint32_t getHeight() const { return output_height_; }
     uint32_t getFPS() const { return fps_; }
+    int getTemporalLayers() const { return temporal_layers_; }
 
 private:
     // Configuration
@@ -63,11 +69,16 @@ private:
     uint32_t output_height_;
     uint32_t fps_;
     bool use_ppa_;             // True if PPA scaling needed (output != camera)
+    int temporal_layers_;      // Software encoder if more than 1
 
     // Device file descriptors
     int cap_fd_;       // Camera capture device
     int m2m_fd_;       // H.264 encoder device
 
+    // Software encoder with temporal layers (replaces the encoder device)
+    std::unique_ptr<H264TemporalEncoder> sw_encoder_;
+    uint32_t encoded_frame_number_;  // Frame number for the dependency descriptor
+
     // PPA (Pixel Processing Accelerator) for hardware scaling
     ppa_client_handle_t ppa_scaler_;
     uint8_t* scaled_buffer_;
@@ -83,6 +94,11 @@ private:
     uint8_t* m2m_cap_buffer_[ENCODER_OUTPUT_BUFFERS];
     size_t m2m_cap_buffer_len_[ENCODER_OUTPUT_BUFFERS];
 
+    // Capture times of the frames in the encoder, oldest first (frames come out in order)
+    int64_t encoder_capture_us_[ENCODER_OUTPUT_BUFFERS];
+    uint32_t encoder_capture_head_;
+    uint32_t encoder_capture_count_;
+
     // Send queue (for async pipelining)
     static constexpr int SEND_QUEUE_DEPTH = 8;  // ~320ms buffering at 25fps
     struct QueuedFrame {
@@ -112,6 +128,7 @@ private:
     // Initialization
     bool initCamera();
     bool initEncoder();
+    bool initSoftwareEncoder();
     bool initPPA();
     void cleanup();
 
@@ -122,6 +139,14 @@ private:
     // Capture loop (runs in capture_task_)
     static void captureTaskEntry(void* arg);
     void captureLoop();
+    void softwareCaptureLoop();
+
+    // Capture helpers shared by both loops
+    bool scaleFrame(const struct v4l2_buffer& cam_buf, uint8_t*& output, size_t& output_size);
+    // capture_us: camera dequeue time, frames are timestamped on the shared MediaClock
+    void queueFrame(const uint8_t* data, size_t size, bool keyframe,
+                    uint8_t temporal_layer, std::optional<uint32_t> frame_number,
+                    int64_t capture_us);
 
     // Send loop (runs in send_task_)
     static void sendTaskEntry(void* arg);
@@ -0,0 +1,83 @@
+/**
+ * WsMessageAssembler - Reassembles signaling messages from WebSocket client events
+ *
+ * A message is a text frame (opcode 0x1) followed by continuation frames (opcode 0x0), the last
+ * one having FIN set. Frames larger than the client buffer are delivered in several events, with
+ * payload_offset giving the position within the frame. The buffer is preallocated once, messages
+ * above its capacity are dropped.
+ */
+
+#ifndef WS_MESSAGE_ASSEMBLER_HPP
+#define WS_MESSAGE_ASSEMBLER_HPP
+
+#include <cstddef>
+#include <string>
+
+class WsMessageAssembler {
+public:
+    enum class Result {
+        Pending,   // Message not complete yet
+        Complete,  // message() holds the message until the next event
+        Skipped,   // Binary or control frame, not a signaling message
+        Orphan,    // Continuation without a message start
+        Overflow,  // Complete message larger than the capacity, dropped
+    };
+
+    explicit WsMessageAssembler(size_t capacity) : capacity_(capacity) {
+        buffer_.reserve(capacity);
+    }
+
+    // One WEBSOCKET_EVENT_DATA event: len bytes at payload_offset of a frame of payload_len bytes
+    Result feed(int op_code, bool fin, const char* data, size_t len, size_t payload_offset,
+                size_t payload_len) {
+        if (complete_) {
+            buffer_.clear();  // clear() keeps the capacity
+            complete_ = false;
+        }
+
+        if (op_code == 0x01 && payload_offset == 0) {
+            buffer_.clear();
+            active_ = true;
+            overflow_ = false;
+        } else if (op_code != 0x00 && op_code != 0x01) {
+            return Result::Skipped;
+        }
+
+        if (!active_) {
+            return Result::Orphan;
+        }
+
+        if (len > 0) {
+            if (buffer_.size() + len > capacity_) {
+                overflow_ = true;
+            } else if (!overflow_) {
+                buffer_.append(data, len);
+            }
+        }
+
+        if (!fin || payload_offset + len < payload_len) {
+            return Result::Pending;
+        }
+
+        active_ = false;
+        if (overflow_) {
+            buffer_.clear();
+            return Result::Overflow;
+        }
+
+        complete_ = true;
+        return Result::Complete;
+    }
+
+    const std::string& message() const { return buffer_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    size_t capacity_;
+    std::string buffer_;
+    bool active_ = false;    // Inside a text message (first frame seen)
+    bool overflow_ = false;  // Current message exceeded the capacity
+    bool complete_ = false;  // buffer_ holds the last complete message
+};
+
+#endif // WS_MESSAGE_ASSEMBLER_HPP